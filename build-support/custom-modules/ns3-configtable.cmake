@@ -133,6 +133,9 @@ macro(write_configtable)
   string(APPEND out "Build with runtime logging    : ")
   check_on_or_off("NS3_LOG" "NS3_LOG")
 
+  string(APPEND out "Build with trace sources      : ")
+  check_on_or_off("NS3_TRACING" "NS3_TRACING")
+
   string(APPEND out "Build version embedding       : ")
   check_on_or_off("NS3_ENABLE_BUILD_VERSION" "ENABLE_BUILD_VERSION")
 
@@ -163,6 +166,9 @@ macro(write_configtable)
   string(APPEND out "LibXml2 support               : ")
   check_on_or_off("ON" "LIBXML2_FOUND")
 
+  string(APPEND out "Compressed trace files (zlib) : ")
+  check_on_or_off("ON" "ZLIB_FOUND")
+
   string(APPEND out "MPI Support                   : ")
   check_on_or_off("NS3_MPI" "MPI_FOUND")
 
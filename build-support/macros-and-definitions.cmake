@@ -616,6 +616,14 @@ macro(process_options)
     endif()
   endif()
 
+  find_package(ZLIB QUIET)
+  if(${ZLIB_FOUND})
+    add_definitions(-DHAVE_ZLIB)
+    if(NOT ${NS3_FORCE_LOCAL_DEPENDENCIES})
+      include_directories(${ZLIB_INCLUDE_DIRS})
+    endif()
+  endif()
+
   set(THREADS_PREFER_PTHREAD_FLAG)
   find_package(Threads QUIET)
   if(NOT ${Threads_FOUND})
@@ -1138,6 +1146,11 @@ macro(process_options)
   if(${NS3_ASSERT} OR (${build_profile} STREQUAL "debug"))
     add_definitions(-DNS3_ASSERT_ENABLE)
   endif()
+  # Force enable ns-3 trace sources in debug builds, and compile them out of
+  # the other build types if requested
+  if((NOT ${NS3_TRACING}) AND (NOT (${build_profile} STREQUAL "debug")))
+    add_definitions(-DNS3_TRACING_DISABLE)
+  endif()
 
   set(ENABLE_TAP OFF)
   if(${NS3_TAP})
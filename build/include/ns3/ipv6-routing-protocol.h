@@ -0,0 +1 @@
+#include "/root/repo/src/internet/model/ipv6-routing-protocol.h"
@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This example measures how much of the queueing delay of a bottleneck is
+// spent in the device queue, below the queue disc and out of the reach of
+// its AQM, at several link rates, without BQL, with BQL, and with BQL
+// amortized over batches of completions.
+//
+// Network topology
+//
+//        access link                  bottleneck link
+// n0 ---------------------- n1 ---------------------------- n2
+//   4 x rate, 1 us               rate, 10 us
+//                                FqCoDel, device queue of 100 packets
+//                                [BQL, BQL with CompletionBatch]
+//
+// Bulk TCP flows are sent from n0 to n2.  For each rate and BQL mode, the
+// output is a line with the mean and 99th percentile of the sojourn times
+// in the queue disc and in the device queue of the bottleneck, the share of
+// the queueing delay spent in the device queue, the goodput, and the
+// number of events and wall clock time of the simulation:
+//
+//    rate      mode         qdisc(us) mean/p99   device(us) mean/p99  device%        Mbps ...
+//    1Gbps     none               596.9/1548.0         1200.4/1201.0     66.8       963.1 ...
+//    1Gbps     bql                797.7/1368.0             36.0/36.0      4.3       959.9 ...
+//    1Gbps     amortized          753.1/1344.0           198.0/252.0     20.8       963.1 ...
+//
+// Without BQL, the 100 packets of the device queue add 1.2 ms at 1 Gbps,
+// more than the queue disc with a 500 us target; at 100 Gbps, they only
+// add 12 us.  The amortized BQL keeps about a batch of bytes in the
+// device queue.
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/traffic-control-module.h"
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("DeviceQueueBenchmark");
+
+/**
+ * The sojourn times measured at the bottleneck.
+ */
+struct SojournTimes
+{
+    Time start;                 //!< Start of the measures
+    std::deque<Time> enqueued;  //!< Enqueue times of the packets in the device queue
+    std::vector<double> qdisc;  //!< Sojourn times in the queue disc, in microseconds
+    std::vector<double> device; //!< Sojourn times in the device queue, in microseconds
+};
+
+/**
+ * Record a packet enqueued in the device queue.
+ *
+ * @param times The sojourn times.
+ * @param p The packet.
+ */
+void
+DeviceEnqueue(SojournTimes* times, Ptr<const Packet> p)
+{
+    times->enqueued.push_back(Simulator::Now());
+}
+
+/**
+ * Record the sojourn time of a packet dequeued from the device queue.
+ *
+ * @param times The sojourn times.
+ * @param p The packet.
+ */
+void
+DeviceDequeue(SojournTimes* times, Ptr<const Packet> p)
+{
+    // the device queue is a FIFO
+    Time enqueued = times->enqueued.front();
+    times->enqueued.pop_front();
+    if (Simulator::Now() >= times->start)
+    {
+        times->device.push_back((Simulator::Now() - enqueued).GetMicroSeconds());
+    }
+}
+
+/**
+ * Record the sojourn time of a packet dequeued from the queue disc.
+ *
+ * @param times The sojourn times.
+ * @param sojourn The sojourn time.
+ */
+void
+QueueDiscSojourn(SojournTimes* times, Time sojourn)
+{
+    if (Simulator::Now() >= times->start)
+    {
+        times->qdisc.push_back(sojourn.GetMicroSeconds());
+    }
+}
+
+/**
+ * @param values Sojourn times.
+ * @return The mean of the sojourn times.
+ */
+double
+Mean(const std::vector<double>& values)
+{
+    double sum = 0;
+    for (double value : values)
+    {
+        sum += value;
+    }
+    return values.empty() ? 0 : sum / values.size();
+}
+
+/**
+ * @param values Sojourn times, which are reordered.
+ * @return The 99th percentile of the sojourn times.
+ */
+double
+Percentile99(std::vector<double>& values)
+{
+    if (values.empty())
+    {
+        return 0;
+    }
+    auto nth = values.begin() + (values.size() - 1) * 99 / 100;
+    std::nth_element(values.begin(), nth, values.end());
+    return *nth;
+}
+
+/**
+ * Run a simulation, and print its results.
+ *
+ * @param rateName The rate of the bottleneck.
+ * @param mode The BQL mode: "none", "bql" or "amortized".
+ * @param nFlows The number of TCP flows.
+ * @param target The target of the queue disc.
+ * @param batch The CompletionBatch of the amortized BQL, in bytes.
+ * @param duration The duration of the simulation.
+ */
+void
+RunSimulation(const std::string& rateName,
+              const std::string& mode,
+              uint32_t nFlows,
+              Time target,
+              uint32_t batch,
+              Time duration)
+{
+    DataRate rate(rateName);
+    NodeContainer nodes;
+    nodes.Create(3);
+
+    PointToPointHelper accessLink;
+    accessLink.SetDeviceAttribute("DataRate", DataRateValue(DataRate(4 * rate.GetBitRate())));
+    accessLink.SetChannelAttribute("Delay", StringValue("1us"));
+
+    PointToPointHelper bottleneckLink;
+    bottleneckLink.SetDeviceAttribute("DataRate", DataRateValue(rate));
+    bottleneckLink.SetChannelAttribute("Delay", StringValue("10us"));
+    bottleneckLink.SetQueue("ns3::DropTailQueue", "MaxSize", StringValue("100p"));
+
+    InternetStackHelper stack;
+    stack.Install(nodes);
+
+    TrafficControlHelper tchBottleneck;
+    tchBottleneck.SetRootQueueDisc(
+        "ns3::FqCoDelQueueDisc",
+        "Target",
+        StringValue(std::to_string(target.GetNanoSeconds()) + "ns"),
+        "Interval",
+        StringValue(std::to_string(20 * target.GetNanoSeconds()) + "ns"));
+    if (mode == "bql")
+    {
+        tchBottleneck.SetQueueLimits("ns3::DynamicQueueLimits");
+    }
+    else if (mode == "amortized")
+    {
+        tchBottleneck.SetQueueLimits("ns3::DynamicQueueLimits",
+                                     "CompletionBatch",
+                                     UintegerValue(batch),
+                                     "StallThreshold",
+                                     TimeValue(MilliSeconds(1)));
+    }
+    else
+    {
+        NS_ABORT_MSG_IF(mode != "none", "Unknown BQL mode " << mode);
+    }
+
+    NetDeviceContainer devicesAccessLink = accessLink.Install(nodes.Get(0), nodes.Get(1));
+    NetDeviceContainer devicesBottleneckLink = bottleneckLink.Install(nodes.Get(1), nodes.Get(2));
+    QueueDiscContainer qdiscs = tchBottleneck.Install(devicesBottleneckLink);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.1.0", "255.255.255.0");
+    address.Assign(devicesAccessLink);
+    address.SetBase("10.1.2.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfacesBottleneck = address.Assign(devicesBottleneckLink);
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+
+    SojournTimes times;
+    times.start = duration / 5;
+    Ptr<Queue<Packet>> queue =
+        StaticCast<PointToPointNetDevice>(devicesBottleneckLink.Get(0))->GetQueue();
+    queue->TraceConnectWithoutContext("Enqueue", MakeBoundCallback(&DeviceEnqueue, &times));
+    queue->TraceConnectWithoutContext("Dequeue", MakeBoundCallback(&DeviceDequeue, &times));
+    qdiscs.Get(0)->TraceConnectWithoutContext("SojournTime",
+                                              MakeBoundCallback(&QueueDiscSojourn, &times));
+
+    uint16_t port = 5000;
+    PacketSinkHelper sinkHelper("ns3::TcpSocketFactory",
+                                InetSocketAddress(Ipv4Address::GetAny(), port));
+    ApplicationContainer sinkApp = sinkHelper.Install(nodes.Get(2));
+    BulkSendHelper source("ns3::TcpSocketFactory",
+                          InetSocketAddress(interfacesBottleneck.GetAddress(1), port));
+    ApplicationContainer sourceApps;
+    for (uint32_t i = 0; i < nFlows; ++i)
+    {
+        sourceApps.Add(source.Install(nodes.Get(0)));
+    }
+    sourceApps.Start(Seconds(0));
+    Simulator::Stop(duration);
+
+    auto wallClockStart = std::chrono::steady_clock::now();
+    Simulator::Run();
+    std::chrono::duration<double> wallClock = std::chrono::steady_clock::now() - wallClockStart;
+
+    double goodput = DynamicCast<PacketSink>(sinkApp.Get(0))->GetTotalRx() * 8 /
+                     duration.GetSeconds() / 1e6;
+    double qdiscMean = Mean(times.qdisc);
+    double deviceMean = Mean(times.device);
+    double deviceShare =
+        qdiscMean + deviceMean > 0 ? 100 * deviceMean / (qdiscMean + deviceMean) : 0;
+    std::ostringstream qdisc;
+    qdisc << std::fixed << std::setprecision(1) << qdiscMean << "/" << Percentile99(times.qdisc);
+    std::ostringstream device;
+    device << std::fixed << std::setprecision(1) << deviceMean << "/"
+           << Percentile99(times.device);
+
+    std::cout << std::left << std::setw(10) << rateName << std::setw(11) << mode << std::right
+              << std::setw(20) << qdisc.str() << std::setw(22) << device.str() << std::fixed
+              << std::setprecision(1) << std::setw(9) << deviceShare << std::setw(12) << goodput
+              << std::setw(12) << Simulator::GetEventCount() << std::setw(10)
+              << wallClock.count() << std::endl;
+    std::cout.unsetf(std::ios::fixed);
+
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string rates = "1Gbps,10Gbps,100Gbps";
+    std::string modes = "none,bql,amortized";
+    uint32_t nFlows = 4;
+    Time target = MicroSeconds(500);
+    uint32_t batch = 10 * 1502;
+    Time duration = MilliSeconds(50);
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("rates", "Comma-separated rates of the bottleneck", rates);
+    cmd.AddValue("modes", "Comma-separated BQL modes (none, bql, amortized)", modes);
+    cmd.AddValue("flows", "Number of TCP flows", nFlows);
+    cmd.AddValue("target", "Target of the FqCoDel queue disc", target);
+    cmd.AddValue("batch", "CompletionBatch of the amortized BQL, in bytes", batch);
+    cmd.AddValue("duration", "Duration of each simulation", duration);
+    cmd.Parse(argc, argv);
+
+    Config::SetDefault("ns3::TcpSocket::SegmentSize", UintegerValue(1448));
+    Config::SetDefault("ns3::TcpSocket::SndBufSize", UintegerValue(1 << 24));
+    Config::SetDefault("ns3::TcpSocket::RcvBufSize", UintegerValue(1 << 24));
+
+    std::cout << std::left << std::setw(10) << "rate" << std::setw(11) << "mode" << std::right
+              << std::setw(20) << "qdisc(us) mean/p99" << std::setw(22) << "device(us) mean/p99"
+              << std::setw(9) << "device%" << std::setw(12) << "Mbps" << std::setw(12)
+              << "events" << std::setw(10) << "seconds" << std::endl;
+
+    std::istringstream rateList(rates);
+    for (std::string rate; std::getline(rateList, rate, ',');)
+    {
+        std::istringstream modeList(modes);
+        for (std::string mode; std::getline(modeList, mode, ',');)
+        {
+            RunSimulation(rate, mode, nFlows, target, batch, duration);
+        }
+    }
+    return 0;
+}
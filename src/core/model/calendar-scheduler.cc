@@ -403,4 +403,27 @@ CalendarScheduler::Resize(uint32_t newSize)
     DoResize(newSize, newWidth);
 }
 
+void
+CalendarScheduler::RemoveCancelled(std::vector<Event>& cancelled)
+{
+    NS_LOG_FUNCTION(this);
+    for (uint32_t bucket = 0; bucket < m_nBuckets; bucket++)
+    {
+        for (auto i = m_buckets[bucket].begin(); i != m_buckets[bucket].end();)
+        {
+            if (i->impl->IsCancelled())
+            {
+                cancelled.push_back(*i);
+                i = m_buckets[bucket].erase(i);
+                m_qSize--;
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+    ResizeDown();
+}
+
 } // namespace ns3
@@ -15,7 +15,10 @@
 #include "pointer.h"
 #include "singleton.h"
 
+#include <algorithm>
+#include <map>
 #include <sstream>
+#include <unordered_map>
 
 /**
  * @file
@@ -190,6 +193,8 @@ MatchContainer::DisconnectWithoutContext(std::string name, const CallbackBase& c
 /**
  * @ingroup config-impl
  * Helper to test if an array entry matches a config path specification.
+ *
+ * The specification is parsed once, into a set of index ranges.
  */
 class ArrayMatcher
 {
@@ -207,8 +212,28 @@ class ArrayMatcher
      * @returns \c true if the index matches the Config Path.
      */
     bool Matches(std::size_t i) const;
+    /**
+     * Test if the specification is a wildcard.
+     *
+     * @returns \c true if every index matches the Config Path.
+     */
+    bool MatchesAll() const;
+    /** Inclusive ranges of indexes. */
+    typedef std::vector<std::pair<uint32_t, uint32_t>> Ranges;
+    /**
+     * Get the indexes matching the Config path, unless MatchesAll().
+     *
+     * @returns The sorted and disjoint ranges of indexes.
+     */
+    const Ranges& GetRanges() const;
 
   private:
+    /**
+     * Parse one of the alternatives of the specification.
+     *
+     * @param [in] element The alternative.
+     */
+    void Parse(std::string element);
     /**
      * Convert a string to an \c uint32_t.
      *
@@ -219,78 +244,111 @@ class ArrayMatcher
     bool StringToUint32(std::string str, uint32_t* value) const;
     /** The Config path element. */
     std::string m_element;
+    /** Whether every index matches. */
+    bool m_all;
+    /** The indexes matching. */
+    Ranges m_ranges;
 
     // end of class ArrayMatcher
 };
 
 ArrayMatcher::ArrayMatcher(std::string element)
-    : m_element(element)
+    : m_element(element),
+      m_all(false)
 {
     NS_LOG_FUNCTION(this << element);
-}
-
-bool
-ArrayMatcher::Matches(std::size_t i) const
-{
-    NS_LOG_FUNCTION(this << i);
-    if (m_element == "*")
+    std::string::size_type start = 0;
+    std::string::size_type bar;
+    while ((bar = element.find('|', start)) != std::string::npos)
     {
-        NS_LOG_DEBUG("Array " << i << " matches *");
-        return true;
+        Parse(element.substr(start, bar - start));
+        start = bar + 1;
     }
-    std::string::size_type tmp;
-    tmp = m_element.find('|');
-    if (tmp != std::string::npos)
+    Parse(element.substr(start));
+
+    // Sort and merge the ranges, so that they are enumerated in the order
+    // of the indexes.
+    std::sort(m_ranges.begin(), m_ranges.end());
+    Ranges merged;
+    for (const auto& range : m_ranges)
     {
-        std::string left = m_element.substr(0, tmp - 0);
-        std::string right = m_element.substr(tmp + 1, m_element.size() - (tmp + 1));
-        ArrayMatcher matcher = ArrayMatcher(left);
-        if (matcher.Matches(i))
+        if (!merged.empty() && range.first <= static_cast<uint64_t>(merged.back().second) + 1)
         {
-            NS_LOG_DEBUG("Array " << i << " matches " << left);
-            return true;
+            merged.back().second = std::max(merged.back().second, range.second);
         }
-        matcher = ArrayMatcher(right);
-        if (matcher.Matches(i))
+        else
         {
-            NS_LOG_DEBUG("Array " << i << " matches " << right);
-            return true;
+            merged.push_back(range);
         }
-        NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
-        return false;
     }
-    std::string::size_type leftBracket = m_element.find('[');
-    std::string::size_type rightBracket = m_element.find(']');
-    std::string::size_type dash = m_element.find('-');
-    if (leftBracket == 0 && rightBracket == m_element.size() - 1 && dash > leftBracket &&
+    m_ranges.swap(merged);
+}
+
+void
+ArrayMatcher::Parse(std::string element)
+{
+    NS_LOG_FUNCTION(this << element);
+    if (element == "*")
+    {
+        m_all = true;
+        return;
+    }
+    std::string::size_type leftBracket = element.find('[');
+    std::string::size_type rightBracket = element.find(']');
+    std::string::size_type dash = element.find('-');
+    if (leftBracket == 0 && rightBracket == element.size() - 1 && dash > leftBracket &&
         dash < rightBracket)
     {
-        std::string lowerBound = m_element.substr(leftBracket + 1, dash - (leftBracket + 1));
-        std::string upperBound = m_element.substr(dash + 1, rightBracket - (dash + 1));
+        std::string lowerBound = element.substr(leftBracket + 1, dash - (leftBracket + 1));
+        std::string upperBound = element.substr(dash + 1, rightBracket - (dash + 1));
         uint32_t min;
         uint32_t max;
-        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && i >= min &&
-            i <= max)
-        {
-            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
-            return true;
-        }
-        else
+        if (StringToUint32(lowerBound, &min) && StringToUint32(upperBound, &max) && min <= max)
         {
-            NS_LOG_DEBUG("Array " << i << " does not " << m_element);
-            return false;
+            m_ranges.emplace_back(min, max);
         }
+        return;
     }
     uint32_t value;
-    if (StringToUint32(m_element, &value) && i == value)
+    if (StringToUint32(element, &value))
     {
-        NS_LOG_DEBUG("Array " << i << " matches " << m_element);
+        m_ranges.emplace_back(value, value);
+    }
+}
+
+bool
+ArrayMatcher::Matches(std::size_t i) const
+{
+    NS_LOG_FUNCTION(this << i);
+    if (m_all)
+    {
+        NS_LOG_DEBUG("Array " << i << " matches *");
         return true;
     }
+    for (const auto& range : m_ranges)
+    {
+        if (i >= range.first && i <= range.second)
+        {
+            NS_LOG_DEBUG("Array " << i << " matches " << m_element);
+            return true;
+        }
+    }
     NS_LOG_DEBUG("Array " << i << " does not match " << m_element);
     return false;
 }
 
+bool
+ArrayMatcher::MatchesAll() const
+{
+    return m_all;
+}
+
+const ArrayMatcher::Ranges&
+ArrayMatcher::GetRanges() const
+{
+    return m_ranges;
+}
+
 bool
 ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
 {
@@ -303,145 +361,256 @@ ArrayMatcher::StringToUint32(std::string str, uint32_t* value) const
 
 /**
  * @ingroup config-impl
- * Abstract class to parse Config paths into object references.
+ * A Config path parsed into object references once, and resolved
+ * from any root object.
+ *
+ * The path is split into its elements when the pattern is built: the
+ * TypeId of the \c $ elements is looked up, and the index elements are
+ * parsed.  The attributes matching an element are looked up once per
+ * TypeId of the objects met along the path, and the items of the
+ * containers are fetched by position when the element selects a few
+ * indexes.  Resolving the pattern then costs a few lookups per object
+ * matched, instead of a parse of the path and a walk of the attributes
+ * and containers for each of them.
  */
-class Resolver
+class PathPattern
 {
   public:
     /**
-     * Construct from a base Config path.
+     * Construct from a Config path.
      *
      * @param [in] path The Config path.
      */
-    Resolver(std::string path);
-    /** Destructor. */
-    virtual ~Resolver();
+    PathPattern(std::string path);
 
     /**
-     * Parse the stored Config path into an object reference,
+     * Get the Config path.
+     *
+     * @returns The Config path, as given to the constructor.
+     */
+    std::string GetPath() const;
+    /**
+     * Find the objects matching the Config path,
      * beginning at the indicated root object.
      *
-     * @param [in] root The object corresponding to the current position in
-     *                  in the Config path.
+     * @param [in] root The root object, or nullptr for the root of the
+     *                  "/Names" namespace.
+     * @param [in,out] objects The objects found are appended to this list.
+     * @param [in,out] contexts The paths of the objects found are appended
+     *                          to this list.
      */
-    void Resolve(Ptr<Object> root);
+    void Resolve(Ptr<Object> root,
+                 std::vector<Ptr<Object>>* objects,
+                 std::vector<std::string>* contexts) const;
 
   private:
-    /** Ensure the Config path starts and ends with a '/'. */
-    void Canonicalize();
+    /** An attribute of an object type matching an element of the path. */
+    struct AttributeMatch
+    {
+        std::string name;                            //!< The attribute name
+        Ptr<const AttributeAccessor> accessor;       //!< The attribute accessor
+        bool isContainer;                            //!< Whether the attribute is a container
+        const ObjectPtrContainerAccessor* container; //!< The container accessor, if known
+    };
+
+    /** The attributes matching an element. */
+    typedef std::vector<AttributeMatch> AttributeMatches;
+
+    /** An element of the path. */
+    struct Element
+    {
+        /**
+         * Parse an element.
+         *
+         * @param [in] element The element.
+         */
+        Element(std::string element);
+
+        std::string item;     //!< The element
+        bool names;           //!< Whether the element starts the "/Names" namespace
+        bool getObject;       //!< Whether the element is a call to GetObject
+        bool tidFound;        //!< Whether the TypeId of the call to GetObject exists
+        TypeId tid;           //!< The TypeId of the call to GetObject
+        ArrayMatcher matcher; //!< The element as index of a container
+        /** The attributes matching the element, by TypeId uid. */
+        mutable std::unordered_map<uint16_t, AttributeMatches> attributes;
+    };
+
+    /** The state of a resolution. */
+    struct Walk
+    {
+        std::vector<std::string> stack;     //!< The path to the current object
+        std::vector<Ptr<Object>>* objects;  //!< The objects found
+        std::vector<std::string>* contexts; //!< The paths of the objects found
+    };
+
     /**
-     * Parse the next element in the Config path.
+     * Resolve an element of the path.
      *
-     * @param [in] path The remaining portion of the Config path.
-     * @param [in] root The object corresponding to the current position
-     *                  in the Config path.
+     * @param [in] i The index of the element.
+     * @param [in] root The object corresponding to the current position in
+     *                  the Config path.
+     * @param [in,out] walk The state of the resolution.
      */
-    void DoResolve(std::string path, Ptr<Object> root);
+    void DoResolve(std::size_t i, Ptr<Object> root, Walk& walk) const;
     /**
-     * Parse an index on the Config path.
+     * Resolve an index on the Config path.
      *
-     * @param [in] path The remaining Config path.
-     * @param [in,out] vector The resulting list of matching objects.
+     * @param [in] i The index of the element.
+     * @param [in] root The object holding the container.
+     * @param [in] match The container attribute.
+     * @param [in,out] walk The state of the resolution.
      */
-    void DoArrayResolve(std::string path, const ObjectPtrContainerValue& vector);
+    void DoArrayResolve(std::size_t i,
+                        Ptr<Object> root,
+                        const AttributeMatch& match,
+                        Walk& walk) const;
     /**
-     * Handle one object found on the path.
+     * Get the pointer and container attributes matching an element.
      *
-     * @param [in] object The current object on the Config path.
+     * @param [in] element The element.
+     * @param [in] tid The TypeId of the object.
+     * @returns The attributes of the type and its parents matching the element.
      */
-    void DoResolveOne(Ptr<Object> object);
+    const AttributeMatches& LookupAttributes(const Element& element, TypeId tid) const;
     /**
      * Get the current Config path.
      *
+     * @param [in] walk The state of the resolution.
      * @returns The current Config path.
      */
-    std::string GetResolvedPath() const;
-    /**
-     * Handle one found object.
-     *
-     * @param [in] object The found object.
-     * @param [in] path The matching Config path context.
-     */
-    virtual void DoOne(Ptr<Object> object, std::string path) = 0;
+    static std::string GetResolvedPath(const Walk& walk);
 
-    /** Current list of path tokens. */
-    std::vector<std::string> m_workStack;
     /** The Config path. */
     std::string m_path;
+    /** The elements of the path. */
+    std::vector<Element> m_elements;
 
-    // end of class Resolver
+    // end of class PathPattern
 };
 
-Resolver::Resolver(std::string path)
-    : m_path(path)
+PathPattern::Element::Element(std::string element)
+    : item(element),
+      names(element.compare(0, 5, "Names") == 0),
+      getObject(element.find('$') == 0),
+      tidFound(false),
+      matcher(element)
 {
-    NS_LOG_FUNCTION(this << path);
-    Canonicalize();
-}
-
-Resolver::~Resolver()
-{
-    NS_LOG_FUNCTION(this);
+    if (getObject)
+    {
+        tidFound = TypeId::LookupByNameFailSafe(element.substr(1), &tid);
+    }
 }
 
-void
-Resolver::Canonicalize()
+PathPattern::PathPattern(std::string path)
+    : m_path(path)
 {
-    NS_LOG_FUNCTION(this);
+    NS_LOG_FUNCTION(this << path);
 
     // ensure that we start and end with a '/'
-    std::string::size_type tmp = m_path.find('/');
+    std::string::size_type tmp = path.find('/');
     if (tmp != 0)
     {
         // no slash at start
-        m_path = "/" + m_path;
+        path = "/" + path;
     }
-    tmp = m_path.find_last_of('/');
-    if (tmp != (m_path.size() - 1))
+    tmp = path.find_last_of('/');
+    if (tmp != (path.size() - 1))
     {
         // no slash at end
-        m_path = m_path + "/";
+        path = path + "/";
     }
+
+    std::string::size_type start = 1;
+    std::string::size_type next;
+    while ((next = path.find('/', start)) != std::string::npos)
+    {
+        m_elements.emplace_back(path.substr(start, next - start));
+        start = next + 1;
+    }
+}
+
+std::string
+PathPattern::GetPath() const
+{
+    return m_path;
 }
 
 void
-Resolver::Resolve(Ptr<Object> root)
+PathPattern::Resolve(Ptr<Object> root,
+                     std::vector<Ptr<Object>>* objects,
+                     std::vector<std::string>* contexts) const
 {
-    NS_LOG_FUNCTION(this << root);
+    NS_LOG_FUNCTION(this << root << objects << contexts);
 
-    DoResolve(m_path, root);
+    Walk walk;
+    walk.objects = objects;
+    walk.contexts = contexts;
+    DoResolve(0, root, walk);
 }
 
 std::string
-Resolver::GetResolvedPath() const
+PathPattern::GetResolvedPath(const Walk& walk)
 {
-    NS_LOG_FUNCTION(this);
-
     std::string fullPath = "/";
-    for (auto i = m_workStack.begin(); i != m_workStack.end(); i++)
+    for (const auto& item : walk.stack)
     {
-        fullPath += *i + "/";
+        fullPath += item + "/";
     }
     return fullPath;
 }
 
-void
-Resolver::DoResolveOne(Ptr<Object> object)
+const PathPattern::AttributeMatches&
+PathPattern::LookupAttributes(const Element& element, TypeId tid) const
 {
-    NS_LOG_FUNCTION(this << object);
+    auto it = element.attributes.find(tid.GetUid());
+    if (it != element.attributes.end())
+    {
+        return it->second;
+    }
 
-    NS_LOG_DEBUG("resolved=" << GetResolvedPath());
-    DoOne(object, GetResolvedPath());
+    AttributeMatches& matches = element.attributes[tid.GetUid()];
+    TypeId current;
+    TypeId next = tid;
+    do
+    {
+        current = next;
+        for (uint32_t i = 0; i < current.GetAttributeN(); i++)
+        {
+            TypeId::AttributeInformation info = current.GetAttribute(i);
+            if (info.name != element.item && element.item != "*")
+            {
+                continue;
+            }
+            if (!(info.flags & TypeId::ATTR_GET) || !info.accessor->HasGetter())
+            {
+                continue;
+            }
+            if (dynamic_cast<const PointerChecker*>(PeekPointer(info.checker)) != nullptr)
+            {
+                matches.push_back({info.name, info.accessor, false, nullptr});
+            }
+            if (dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker)) !=
+                nullptr)
+            {
+                const auto container =
+                    dynamic_cast<const ObjectPtrContainerAccessor*>(PeekPointer(info.accessor));
+                matches.push_back({info.name, info.accessor, true, container});
+            }
+            // this could be anything else and we don't know what to do with it.
+            // So, we just ignore it.
+        }
+        next = current.GetParent();
+    } while (next != current);
+    return matches;
 }
 
 void
-Resolver::DoResolve(std::string path, Ptr<Object> root)
+PathPattern::DoResolve(std::size_t i, Ptr<Object> root, Walk& walk) const
 {
-    NS_LOG_FUNCTION(this << path << root);
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
+    NS_LOG_FUNCTION(this << i << root);
 
-    if (next == std::string::npos)
+    if (i == m_elements.size())
     {
         //
         // If root is zero, we're beginning to see if we can use the object name
@@ -453,12 +622,13 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
         //
         if (root)
         {
-            DoResolveOne(root);
+            NS_LOG_DEBUG("resolved=" << GetResolvedPath(walk));
+            walk.objects->push_back(root);
+            walk.contexts->push_back(GetResolvedPath(walk));
         }
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    const Element& element = m_elements[i];
 
     //
     // If root is zero, we're beginning to see if we can use the object name
@@ -467,16 +637,12 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     // the root of the "/Names" namespace, so we just ignore it and move on to
     // the next segment.
     //
-    if (!root)
+    if (!root && element.names)
     {
-        std::string::size_type offset = path.find("/Names");
-        if (offset == 0)
-        {
-            m_workStack.push_back(item);
-            DoResolve(pathLeft, root);
-            m_workStack.pop_back();
-            return;
-        }
+        walk.stack.push_back(element.item);
+        DoResolve(i + 1, root, walk);
+        walk.stack.pop_back();
+        return;
     }
 
     //
@@ -485,13 +651,13 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     // zero, this means to look in the root of the "/Names" name space, otherwise
     // it refers to a name space context (level).
     //
-    Ptr<Object> namedObject = Names::Find<Object>(root, item);
+    Ptr<Object> namedObject = Names::Find<Object>(root, element.item);
     if (namedObject)
     {
-        NS_LOG_DEBUG("Name system resolved item = " << item << " to " << namedObject);
-        m_workStack.push_back(item);
-        DoResolve(pathLeft, namedObject);
-        m_workStack.pop_back();
+        NS_LOG_DEBUG("Name system resolved item = " << element.item << " to " << namedObject);
+        walk.stack.push_back(element.item);
+        DoResolve(i + 1, namedObject, walk);
+        walk.stack.pop_back();
         return;
     }
 
@@ -506,122 +672,126 @@ Resolver::DoResolve(std::string path, Ptr<Object> root)
     {
         return;
     }
-    std::string::size_type dollarPos = item.find('$');
-    if (dollarPos == 0)
+    if (element.getObject)
     {
         // This is a call to GetObject
-        std::string tidString = item.substr(1, item.size() - 1);
-        NS_LOG_DEBUG("GetObject=" << tidString << " on path=" << GetResolvedPath());
-        TypeId tid = TypeId::LookupByName(tidString);
+        NS_LOG_DEBUG("GetObject=" << element.item << " on path=" << GetResolvedPath(walk));
+        // Let TypeId::LookupByName raise the error of an unknown type
+        TypeId tid = element.tidFound ? element.tid : TypeId::LookupByName(element.item.substr(1));
         Ptr<Object> object = root->GetObject<Object>(tid);
         if (!object)
         {
-            NS_LOG_DEBUG("GetObject (" << tidString << ") failed on path=" << GetResolvedPath());
+            NS_LOG_DEBUG("GetObject (" << element.item
+                                       << ") failed on path=" << GetResolvedPath(walk));
             return;
         }
-        m_workStack.push_back(item);
-        DoResolve(pathLeft, object);
-        m_workStack.pop_back();
+        walk.stack.push_back(element.item);
+        DoResolve(i + 1, object, walk);
+        walk.stack.pop_back();
+        return;
     }
-    else
-    {
-        // this is a normal attribute.
-        TypeId tid;
-        TypeId nextTid = root->GetInstanceTypeId();
-        bool foundMatch = false;
 
-        do
+    // this is a normal attribute.
+    const AttributeMatches& matches = LookupAttributes(element, root->GetInstanceTypeId());
+    for (const auto& match : matches)
+    {
+        if (match.isContainer)
         {
-            tid = nextTid;
-
-            for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
-            {
-                TypeId::AttributeInformation info;
-                info = tid.GetAttribute(i);
-                if (info.name != item && item != "*")
-                {
-                    continue;
-                }
-                // attempt to cast to a pointer checker.
-                const auto pChecker =
-                    dynamic_cast<const PointerChecker*>(PeekPointer(info.checker));
-                if (pChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(ptr)=" << info.name
-                                                      << " on path=" << GetResolvedPath());
-                    PointerValue pValue;
-                    root->GetAttribute(info.name, pValue);
-                    Ptr<Object> object = pValue.Get<Object>();
-                    if (!object)
-                    {
-                        NS_LOG_ERROR("Requested object name=\"" << item << "\" exists on path=\""
-                                                                << GetResolvedPath()
-                                                                << "\""
-                                                                   " but is null.");
-                        continue;
-                    }
-                    foundMatch = true;
-                    m_workStack.push_back(info.name);
-                    DoResolve(pathLeft, object);
-                    m_workStack.pop_back();
-                }
-                // attempt to cast to an object vector.
-                const auto vectorChecker =
-                    dynamic_cast<const ObjectPtrContainerChecker*>(PeekPointer(info.checker));
-                if (vectorChecker != nullptr)
-                {
-                    NS_LOG_DEBUG("GetAttribute(vector)=" << info.name << " on path="
-                                                         << GetResolvedPath() << pathLeft);
-                    foundMatch = true;
-                    ObjectPtrContainerValue vector;
-                    root->GetAttribute(info.name, vector);
-                    m_workStack.push_back(info.name);
-                    DoArrayResolve(pathLeft, vector);
-                    m_workStack.pop_back();
-                }
-                // this could be anything else and we don't know what to do with it.
-                // So, we just ignore it.
-            }
-
-            nextTid = tid.GetParent();
-        } while (nextTid != tid);
-
-        if (!foundMatch)
+            NS_LOG_DEBUG("GetAttribute(vector)=" << match.name
+                                                 << " on path=" << GetResolvedPath(walk));
+            walk.stack.push_back(match.name);
+            DoArrayResolve(i + 1, root, match, walk);
+            walk.stack.pop_back();
+            continue;
+        }
+        NS_LOG_DEBUG("GetAttribute(ptr)=" << match.name << " on path=" << GetResolvedPath(walk));
+        PointerValue pValue;
+        match.accessor->Get(PeekPointer(root), pValue);
+        Ptr<Object> object = pValue.Get<Object>();
+        if (!object)
         {
-            NS_LOG_DEBUG("Requested item=" << item
-                                           << " does not exist on path=" << GetResolvedPath());
-            return;
+            NS_LOG_ERROR("Requested object name=\"" << element.item << "\" exists on path=\""
+                                                    << GetResolvedPath(walk)
+                                                    << "\""
+                                                       " but is null.");
+            continue;
         }
+        walk.stack.push_back(match.name);
+        DoResolve(i + 1, object, walk);
+        walk.stack.pop_back();
+    }
+    if (matches.empty())
+    {
+        NS_LOG_DEBUG("Requested item=" << element.item
+                                       << " does not exist on path=" << GetResolvedPath(walk));
     }
 }
 
 void
-Resolver::DoArrayResolve(std::string path, const ObjectPtrContainerValue& container)
+PathPattern::DoArrayResolve(std::size_t i,
+                            Ptr<Object> root,
+                            const AttributeMatch& match,
+                            Walk& walk) const
 {
-    NS_LOG_FUNCTION(this << path << &container);
-    NS_ASSERT(!path.empty());
-    NS_ASSERT((path.find('/')) == 0);
-    std::string::size_type next = path.find('/', 1);
-    if (next == std::string::npos)
+    NS_LOG_FUNCTION(this << i << root << match.name);
+    if (i == m_elements.size())
     {
         return;
     }
-    std::string item = path.substr(1, next - 1);
-    std::string pathLeft = path.substr(next, path.size() - next);
+    const ArrayMatcher& matcher = m_elements[i].matcher;
 
-    ArrayMatcher matcher = ArrayMatcher(item);
-    ObjectPtrContainerValue::Iterator it;
-    for (it = container.Begin(); it != container.End(); ++it)
+    // The matching items, by index
+    std::map<std::size_t, Ptr<Object>> items;
+    std::size_t n = 0;
+    bool direct = match.container != nullptr && match.container->GetN(PeekPointer(root), &n);
+    if (direct && !matcher.MatchesAll())
+    {
+        // Fetch the requested indexes only, as long as the items are
+        // stored at the position of their index.
+        for (const auto& range : matcher.GetRanges())
+        {
+            for (std::size_t position = range.first; direct && position < n; position++)
+            {
+                if (position > range.second)
+                {
+                    break;
+                }
+                std::size_t index;
+                Ptr<Object> object = match.container->GetItem(PeekPointer(root), position, &index);
+                direct = (index == position);
+                items[index] = object;
+            }
+        }
+    }
+    else if (direct)
     {
-        if (matcher.Matches((*it).first))
+        for (std::size_t position = 0; position < n; position++)
         {
-            std::ostringstream oss;
-            oss << (*it).first;
-            m_workStack.push_back(oss.str());
-            DoResolve(pathLeft, (*it).second);
-            m_workStack.pop_back();
+            std::size_t index;
+            Ptr<Object> object = match.container->GetItem(PeekPointer(root), position, &index);
+            items[index] = object;
         }
     }
+    if (!direct)
+    {
+        items.clear();
+        ObjectPtrContainerValue container;
+        match.accessor->Get(PeekPointer(root), container);
+        for (auto it = container.Begin(); it != container.End(); ++it)
+        {
+            if (matcher.Matches(it->first))
+            {
+                items[it->first] = it->second;
+            }
+        }
+    }
+
+    for (const auto& item : items)
+    {
+        walk.stack.push_back(std::to_string(item.first));
+        DoResolve(i + 1, item.second, walk);
+        walk.stack.pop_back();
+    }
 }
 
 /**
@@ -647,6 +817,19 @@ class ConfigImpl : public Singleton<ConfigImpl>
     void Disconnect(std::string path, const CallbackBase& cb);
     /** @copydoc ns3::Config::LookupMatches() */
     MatchContainer LookupMatches(std::string path);
+    /**
+     * Find the objects matching a parsed Config path.
+     * @param [in] pattern The parsed Config path.
+     * @returns A container of the objects matching the path.
+     */
+    MatchContainer LookupMatches(const PathPattern& pattern);
+    /**
+     * Get the parsed form of a Config path, from the cache of the
+     * recently used paths.
+     * @param [in] path The Config path.
+     * @returns The parsed Config path.
+     */
+    std::shared_ptr<const PathPattern> GetPattern(std::string path);
 
     /** @copydoc ns3::Config::RegisterRootNamespaceObject() */
     void RegisterRootNamespaceObject(Ptr<Object> obj);
@@ -673,6 +856,10 @@ class ConfigImpl : public Singleton<ConfigImpl>
 
     /** The list of Config path roots. */
     Roots m_roots;
+    /** The parsed Config paths, by path. */
+    std::unordered_map<std::string, std::shared_ptr<const PathPattern>> m_patterns;
+    /** Maximum number of parsed Config paths kept. */
+    static constexpr std::size_t PATTERN_CACHE_SIZE = 1024;
 
     // end of class ConfigImpl
 };
@@ -777,28 +964,19 @@ MatchContainer
 ConfigImpl::LookupMatches(std::string path)
 {
     NS_LOG_FUNCTION(this << path);
+    return LookupMatches(*GetPattern(path));
+}
 
-    class LookupMatchesResolver : public Resolver
-    {
-      public:
-        LookupMatchesResolver(std::string path)
-            : Resolver(path)
-        {
-        }
-
-        void DoOne(Ptr<Object> object, std::string path) override
-        {
-            m_objects.push_back(object);
-            m_contexts.push_back(path);
-        }
-
-        std::vector<Ptr<Object>> m_objects;
-        std::vector<std::string> m_contexts;
-    } resolver = LookupMatchesResolver(path);
+MatchContainer
+ConfigImpl::LookupMatches(const PathPattern& pattern)
+{
+    NS_LOG_FUNCTION(this << &pattern);
 
+    std::vector<Ptr<Object>> objects;
+    std::vector<std::string> contexts;
     for (auto i = m_roots.begin(); i != m_roots.end(); i++)
     {
-        resolver.Resolve(*i);
+        pattern.Resolve(*i, &objects, &contexts);
     }
 
     //
@@ -806,9 +984,30 @@ ConfigImpl::LookupMatches(std::string path)
     // the root pointer zeroed indicates to the resolver that it should start
     // looking at the root of the "/Names" namespace during this go.
     //
-    resolver.Resolve(nullptr);
+    pattern.Resolve(nullptr, &objects, &contexts);
+
+    return MatchContainer(objects, contexts, pattern.GetPath());
+}
 
-    return MatchContainer(resolver.m_objects, resolver.m_contexts, path);
+std::shared_ptr<const PathPattern>
+ConfigImpl::GetPattern(std::string path)
+{
+    NS_LOG_FUNCTION(this << path);
+
+    auto it = m_patterns.find(path);
+    if (it != m_patterns.end())
+    {
+        return it->second;
+    }
+    if (m_patterns.size() >= PATTERN_CACHE_SIZE)
+    {
+        // Paths built for each object, e.g. with their index, are seldom
+        // used again: start over rather than track their use.
+        m_patterns.clear();
+    }
+    auto pattern = std::make_shared<const PathPattern>(path);
+    m_patterns.emplace(path, pattern);
+    return pattern;
 }
 
 void
@@ -847,6 +1046,92 @@ ConfigImpl::GetRootNamespaceObject(std::size_t i) const
     return m_roots[i];
 }
 
+CompiledPath::CompiledPath(std::string path)
+    : m_path(path)
+{
+    NS_LOG_FUNCTION(this << path);
+    std::string::size_type slash = path.find_last_of('/');
+    NS_ASSERT(slash != std::string::npos);
+    m_pattern = ConfigImpl::Get()->GetPattern(path.substr(0, slash));
+    m_leaf = path.substr(slash + 1, path.size() - (slash + 1));
+}
+
+std::string
+CompiledPath::GetPath() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_path;
+}
+
+MatchContainer
+CompiledPath::LookupMatches() const
+{
+    NS_LOG_FUNCTION(this);
+    return ConfigImpl::Get()->LookupMatches(*m_pattern);
+}
+
+void
+CompiledPath::Set(const AttributeValue& value) const
+{
+    NS_LOG_FUNCTION(this << &value);
+    LookupMatches().Set(m_leaf, value);
+}
+
+bool
+CompiledPath::SetFailSafe(const AttributeValue& value) const
+{
+    NS_LOG_FUNCTION(this << &value);
+    return LookupMatches().SetFailSafe(m_leaf, value);
+}
+
+void
+CompiledPath::Connect(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    if (!ConnectFailSafe(cb))
+    {
+        NS_FATAL_ERROR("Could not connect callback to " << m_path);
+    }
+}
+
+bool
+CompiledPath::ConnectFailSafe(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    return LookupMatches().ConnectFailSafe(m_leaf, cb);
+}
+
+void
+CompiledPath::ConnectWithoutContext(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    if (!ConnectWithoutContextFailSafe(cb))
+    {
+        NS_FATAL_ERROR("Could not connect callback to " << m_path);
+    }
+}
+
+bool
+CompiledPath::ConnectWithoutContextFailSafe(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    return LookupMatches().ConnectWithoutContextFailSafe(m_leaf, cb);
+}
+
+void
+CompiledPath::Disconnect(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    LookupMatches().Disconnect(m_leaf, cb);
+}
+
+void
+CompiledPath::DisconnectWithoutContext(const CallbackBase& cb) const
+{
+    NS_LOG_FUNCTION(this << &cb);
+    LookupMatches().DisconnectWithoutContext(m_leaf, cb);
+}
+
 void
 Reset()
 {
@@ -10,6 +10,7 @@
 
 #include "ptr.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -350,6 +351,102 @@ class MatchContainer
  */
 MatchContainer LookupMatches(std::string path);
 
+class PathPattern;
+
+/**
+ * @ingroup config
+ * @brief A Config path parsed once, to be applied many times.
+ *
+ * The functions of the Config namespace parse their path on each call,
+ * although the parsed paths are cached.  A CompiledPath holds a parsed
+ * path, whose last element is an attribute or a trace source as for
+ * Config::Set and Config::Connect, and applies it to all the objects
+ * currently matching the rest of the path, e.g. to connect a sink to
+ * the first socket of the first ten nodes once the sockets are created:
+ *
+ * @code
+ *   Config::CompiledPath cwnd("/NodeList/[0-9]/$ns3::TcpL4Protocol/SocketList/0/CongestionWindow");
+ *   cwnd.Connect(MakeCallback(&CwndChange));
+ * @endcode
+ *
+ * The cost of each operation is proportional to the number of objects
+ * walked to find the matches: the elements selecting a few indexes of a
+ * container fetch these indexes only, and the attributes matching each
+ * element are looked up once per object type.
+ */
+class CompiledPath
+{
+  public:
+    /**
+     * Parse a Config path.
+     *
+     * @param [in] path A path to match attributes or trace sources.
+     */
+    CompiledPath(std::string path);
+
+    /**
+     * @returns The path given to the constructor.
+     */
+    std::string GetPath() const;
+    /**
+     * @returns The objects holding the attributes or trace sources
+     *          matching the path.
+     */
+    MatchContainer LookupMatches() const;
+
+    /**
+     * @param [in] value The value to set in all matching attributes.
+     * \sa ns3::Config::Set
+     */
+    void Set(const AttributeValue& value) const;
+    /**
+     * @param [in] value The value to set in all matching attributes.
+     * @returns \c true if any matching attributes could be set.
+     * \sa ns3::Config::SetFailSafe
+     */
+    bool SetFailSafe(const AttributeValue& value) const;
+    /**
+     * @param [in] cb The callback to connect to the matching trace sources.
+     * \sa ns3::Config::Connect
+     */
+    void Connect(const CallbackBase& cb) const;
+    /**
+     * @param [in] cb The callback to connect to the matching trace sources.
+     * @returns \c true if any trace sources could be connected.
+     * \sa ns3::Config::ConnectFailSafe
+     */
+    bool ConnectFailSafe(const CallbackBase& cb) const;
+    /**
+     * @param [in] cb The callback to connect to the matching trace sources.
+     * \sa ns3::Config::ConnectWithoutContext
+     */
+    void ConnectWithoutContext(const CallbackBase& cb) const;
+    /**
+     * @param [in] cb The callback to connect to the matching trace sources.
+     * @returns \c true if any trace sources could be connected.
+     * \sa ns3::Config::ConnectWithoutContextFailSafe
+     */
+    bool ConnectWithoutContextFailSafe(const CallbackBase& cb) const;
+    /**
+     * @param [in] cb The callback to disconnect from the matching trace sources.
+     * \sa ns3::Config::Disconnect
+     */
+    void Disconnect(const CallbackBase& cb) const;
+    /**
+     * @param [in] cb The callback to disconnect from the matching trace sources.
+     * \sa ns3::Config::DisconnectWithoutContext
+     */
+    void DisconnectWithoutContext(const CallbackBase& cb) const;
+
+  private:
+    /** The path given to the constructor. */
+    std::string m_path;
+    /** The parsed path, without its last element. */
+    std::shared_ptr<const PathPattern> m_pattern;
+    /** The last element of the path. */
+    std::string m_leaf;
+};
+
 /**
  * @ingroup config
  * @param [in] obj A new root object
@@ -8,10 +8,14 @@
 
 #include "default-simulator-impl.h"
 
+#include "abort.h"
 #include "assert.h"
+#include "double.h"
+#include "event-impl.h"
 #include "log.h"
-#include "scheduler.h"
 #include "simulator.h"
+#include "string.h"
+#include "uinteger.h"
 
 #include <cmath>
 
@@ -31,13 +35,63 @@ NS_LOG_COMPONENT_DEFINE("DefaultSimulatorImpl");
 
 NS_OBJECT_ENSURE_REGISTERED(DefaultSimulatorImpl);
 
+namespace
+{
+
+/**
+ * @ingroup simulator
+ * The batch group executed by the calling thread, if any.
+ */
+thread_local void* g_currentGroup = nullptr;
+
+} // unnamed namespace
+
 TypeId
 DefaultSimulatorImpl::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::DefaultSimulatorImpl")
-                            .SetParent<SimulatorImpl>()
-                            .SetGroupName("Core")
-                            .AddConstructor<DefaultSimulatorImpl>();
+    static TypeId tid =
+        TypeId("ns3::DefaultSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<DefaultSimulatorImpl>()
+            .AddAttribute("CompactionMinimum",
+                          "The minimum number of cancelled events in the event list "
+                          "before they are purged. Zero disables the compaction.",
+                          UintegerValue(4096),
+                          MakeUintegerAccessor(&DefaultSimulatorImpl::m_compactionMinimum),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("CompactionRatio",
+                          "The fraction of the events in the event list which must be "
+                          "cancelled before they are purged.",
+                          DoubleValue(0.5),
+                          MakeDoubleAccessor(&DefaultSimulatorImpl::m_compactionRatio),
+                          MakeDoubleChecker<double>(0, 1))
+            .AddAttribute("ParallelThreads",
+                          "The number of threads executing the events with the same "
+                          "time stamp by context. Zero disables the batch execution; "
+                          "one executes the batches on the main thread only.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&DefaultSimulatorImpl::m_parallelThreads),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("ParallelMinContexts",
+                          "The minimum number of distinct contexts in a batch of events "
+                          "with the same time stamp to execute it by context.",
+                          UintegerValue(2),
+                          MakeUintegerAccessor(&DefaultSimulatorImpl::m_parallelMinContexts),
+                          MakeUintegerChecker<uint32_t>(1))
+            .AddAttribute("ParallelRecordFile",
+                          "The file recording the time stamp, context and uid of the "
+                          "events executed in batches, if not empty.",
+                          StringValue(""),
+                          MakeStringAccessor(&DefaultSimulatorImpl::m_recordFileName),
+                          MakeStringChecker())
+            .AddAttribute("ParallelReplayFile",
+                          "The file recorded by a previous run with ParallelRecordFile; "
+                          "the simulation stops with an error at the first event "
+                          "executed out of the recorded order.",
+                          StringValue(""),
+                          MakeStringAccessor(&DefaultSimulatorImpl::m_replayFileName),
+                          MakeStringChecker());
     return tid;
 }
 
@@ -50,6 +104,21 @@ DefaultSimulatorImpl::DefaultSimulatorImpl()
     m_currentTs = 0;
     m_currentContext = Simulator::NO_CONTEXT;
     m_unscheduledEvents = 0;
+    m_cancelledEvents = 0;
+    m_compactionMinimum = 4096;
+    m_compactionRatio = 0.5;
+    m_stats = {0, 0, 0, 0};
+    m_parallelThreads = 0;
+    m_parallelMinContexts = 2;
+    m_replayed = 0;
+    m_inBatch = false;
+    m_batchUid = 0;
+    m_groupCount = 0;
+    m_nextGroup = 0;
+    m_workersGeneration = 0;
+    m_workersBusy = 0;
+    m_workersExit = false;
+    m_batchStats = {0, 0, 0, 0};
     m_eventCount = 0;
     m_eventsWithContextEmpty = true;
     m_mainThreadId = std::this_thread::get_id();
@@ -125,6 +194,10 @@ DefaultSimulatorImpl::ProcessOneEvent()
     NS_ASSERT(next.key.m_ts >= m_currentTs);
     m_unscheduledEvents--;
     m_eventCount++;
+    if (m_cancelledEvents > 0 && next.impl->IsCancelled())
+    {
+        m_cancelledEvents--;
+    }
 
     NS_LOG_LOGIC("handle " << next.key.m_ts);
     m_currentTs = next.key.m_ts;
@@ -167,9 +240,42 @@ DefaultSimulatorImpl::ProcessEventsWithContext()
         ev.key.m_context = event.context;
         ev.key.m_uid = m_uid;
         m_uid++;
-        m_unscheduledEvents++;
-        m_events->Insert(ev);
+        Insert(ev);
+    }
+}
+
+void
+DefaultSimulatorImpl::Insert(const Scheduler::Event& ev)
+{
+    m_unscheduledEvents++;
+    m_stats.scheduled++;
+    m_events->Insert(ev);
+}
+
+void
+DefaultSimulatorImpl::CompactCancelledEvents()
+{
+    if (m_compactionMinimum == 0 || m_cancelledEvents < m_compactionMinimum ||
+        m_cancelledEvents < m_compactionRatio * m_unscheduledEvents ||
+        m_mainThreadId != std::this_thread::get_id())
+    {
+        return;
+    }
+    NS_LOG_LOGIC("compact " << m_cancelledEvents << " cancelled events out of "
+                            << m_unscheduledEvents);
+
+    std::vector<Scheduler::Event> cancelled;
+    cancelled.reserve(m_cancelledEvents);
+    m_events->RemoveCancelled(cancelled);
+    for (const auto& ev : cancelled)
+    {
+        // whenever we remove an event from the event list, we have to unref it.
+        ev.impl->Unref();
     }
+    m_unscheduledEvents -= cancelled.size();
+    m_cancelledEvents = 0;
+    m_stats.compacted += cancelled.size();
+    m_stats.compactions++;
 }
 
 void
@@ -181,9 +287,21 @@ DefaultSimulatorImpl::Run()
     ProcessEventsWithContext();
     m_stop = false;
 
-    while (!m_events->IsEmpty() && !m_stop)
+    if (m_parallelThreads > 0)
+    {
+        StartBatches();
+        while (!m_events->IsEmpty() && !m_stop)
+        {
+            ProcessOneBatch();
+        }
+        StopBatches();
+    }
+    else
     {
-        ProcessOneEvent();
+        while (!m_events->IsEmpty() && !m_stop)
+        {
+            ProcessOneEvent();
+        }
     }
 
     // If the simulator stopped naturally by lack of events, make a
@@ -191,10 +309,296 @@ DefaultSimulatorImpl::Run()
     NS_ASSERT(!m_events->IsEmpty() || m_unscheduledEvents == 0);
 }
 
+void
+DefaultSimulatorImpl::StartBatches()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_recordFileName.empty() && !m_recordFile.is_open())
+    {
+        m_recordFile.open(m_recordFileName);
+        NS_ABORT_MSG_IF(!m_recordFile, "Cannot open the record file " << m_recordFileName);
+    }
+    if (!m_replayFileName.empty() && !m_replayFile.is_open())
+    {
+        m_replayFile.open(m_replayFileName);
+        NS_ABORT_MSG_IF(!m_replayFile, "Cannot open the replay file " << m_replayFileName);
+    }
+    m_workersExit = false;
+    for (uint32_t i = 1; i < m_parallelThreads; ++i)
+    {
+        m_workers.emplace_back(&DefaultSimulatorImpl::BatchWorker, this);
+    }
+}
+
+void
+DefaultSimulatorImpl::StopBatches()
+{
+    NS_LOG_FUNCTION(this);
+    {
+        std::unique_lock lock{m_workersMutex};
+        m_workersExit = true;
+    }
+    m_workersStart.notify_all();
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+    m_workers.clear();
+    if (m_recordFile.is_open())
+    {
+        m_recordFile.flush();
+    }
+}
+
+void
+DefaultSimulatorImpl::BatchWorker()
+{
+    uint64_t generation = 0;
+    while (true)
+    {
+        {
+            std::unique_lock lock{m_workersMutex};
+            m_workersStart.wait(lock, [this, generation] {
+                return m_workersExit || m_workersGeneration != generation;
+            });
+            if (m_workersExit)
+            {
+                return;
+            }
+            generation = m_workersGeneration;
+        }
+        ExecuteGroups();
+        {
+            std::unique_lock lock{m_workersMutex};
+            if (--m_workersBusy == 0)
+            {
+                m_workersDone.notify_one();
+            }
+        }
+    }
+}
+
+void
+DefaultSimulatorImpl::RecordEvent(const Scheduler::Event& ev)
+{
+    if (m_recordFile.is_open())
+    {
+        m_recordFile << ev.key.m_ts << ' ' << ev.key.m_context << ' ' << ev.key.m_uid << '\n';
+    }
+    if (m_replayFile.is_open())
+    {
+        uint64_t ts;
+        uint32_t context;
+        uint32_t uid;
+        if (!(m_replayFile >> ts >> context >> uid))
+        {
+            NS_FATAL_ERROR("Replay diverged at event " << m_replayed << ": not in "
+                                                       << m_replayFileName);
+        }
+        if (ts != ev.key.m_ts || context != ev.key.m_context || uid != ev.key.m_uid)
+        {
+            NS_FATAL_ERROR("Replay diverged at event "
+                           << m_replayed << ": expected time stamp " << ts << ", context "
+                           << context << ", uid " << uid << "; got time stamp " << ev.key.m_ts
+                           << ", context " << ev.key.m_context << ", uid " << ev.key.m_uid);
+        }
+    }
+    m_replayed++;
+}
+
+void
+DefaultSimulatorImpl::ProcessOneBatch()
+{
+    uint64_t ts = m_events->PeekNext().key.m_ts;
+    NS_ASSERT(ts >= m_currentTs);
+
+    std::vector<Scheduler::Event> batch;
+    m_groupIndex.clear();
+    m_groupCount = 0;
+    while (!m_events->IsEmpty() && m_events->PeekNext().key.m_ts == ts)
+    {
+        Scheduler::Event next = m_events->RemoveNext();
+        m_unscheduledEvents--;
+        batch.push_back(next);
+
+        auto [it, inserted] = m_groupIndex.try_emplace(next.key.m_context, m_groupCount);
+        if (inserted)
+        {
+            if (m_groupCount == m_groups.size())
+            {
+                m_groups.emplace_back();
+            }
+            BatchGroup& group = m_groups[m_groupCount];
+            group.index = m_groupCount;
+            group.context = next.key.m_context;
+            group.events.clear();
+            group.currentUid = EventId::UID::INVALID;
+            group.children = 0;
+            group.scheduled.clear();
+            group.removed.clear();
+            group.destroyEvents.clear();
+            group.cancelled = 0;
+            group.stop = false;
+            m_groupCount++;
+        }
+        m_groups[it->second].events.push_back(next);
+    }
+
+    NS_LOG_LOGIC("batch of " << batch.size() << " events at " << ts << " in " << m_groupCount
+                             << " contexts");
+    m_batchStats.batches++;
+    m_currentTs = ts;
+    m_currentUid = EventId::UID::INVALID;
+    m_batchUid = m_uid;
+    m_inBatch = true;
+    if (m_groupCount >= m_parallelMinContexts)
+    {
+        ProcessBatchByContext(batch);
+    }
+    else
+    {
+        ProcessBatchSequentially(batch);
+    }
+    m_inBatch = false;
+
+    ProcessEventsWithContext();
+}
+
+void
+DefaultSimulatorImpl::ProcessBatchSequentially(const std::vector<Scheduler::Event>& batch)
+{
+    for (std::size_t i = 0; i < batch.size(); ++i)
+    {
+        const Scheduler::Event& next = batch[i];
+        if (m_stop)
+        {
+            // Put the rest of the batch back, as if it had not been reached.
+            for (; i < batch.size(); ++i)
+            {
+                m_events->Insert(batch[i]);
+                m_unscheduledEvents++;
+            }
+            return;
+        }
+
+        PreEventHook(EventId(next.impl, next.key.m_ts, next.key.m_context, next.key.m_uid));
+        RecordEvent(next);
+        m_eventCount++;
+        if (m_cancelledEvents > 0 && next.impl->IsCancelled())
+        {
+            m_cancelledEvents--;
+        }
+        m_currentContext = next.key.m_context;
+        m_currentUid = next.key.m_uid;
+        next.impl->Invoke();
+        next.impl->Unref();
+
+        ProcessEventsWithContext();
+    }
+}
+
+void
+DefaultSimulatorImpl::ProcessBatchByContext(const std::vector<Scheduler::Event>& batch)
+{
+    m_batchStats.parallelBatches++;
+    m_batchStats.parallelGroups += m_groupCount;
+    m_batchStats.parallelEvents += batch.size();
+
+    for (const auto& next : batch)
+    {
+        PreEventHook(EventId(next.impl, next.key.m_ts, next.key.m_context, next.key.m_uid));
+        RecordEvent(next);
+        if (m_cancelledEvents > 0 && next.impl->IsCancelled())
+        {
+            m_cancelledEvents--;
+        }
+    }
+    m_eventCount += batch.size();
+
+    m_nextGroup = 0;
+    if (m_workers.empty())
+    {
+        ExecuteGroups();
+    }
+    else
+    {
+        {
+            std::unique_lock lock{m_workersMutex};
+            m_workersBusy = m_workers.size();
+            m_workersGeneration++;
+        }
+        m_workersStart.notify_all();
+        ExecuteGroups();
+        std::unique_lock lock{m_workersMutex};
+        m_workersDone.wait(lock, [this] { return m_workersBusy == 0; });
+    }
+
+    // Apply the side effects of the groups, in order.
+    uint32_t children = 0;
+    for (uint32_t i = 0; i < m_groupCount; ++i)
+    {
+        BatchGroup& group = m_groups[i];
+        children = std::max(children, group.children);
+        for (const auto& ev : group.removed)
+        {
+            m_events->Remove(ev);
+            // whenever we remove an event from the event list, we have to unref it.
+            ev.impl->Unref();
+            m_unscheduledEvents--;
+        }
+        for (const auto& ev : group.scheduled)
+        {
+            Insert(ev);
+        }
+        m_destroyEvents.insert(m_destroyEvents.end(),
+                               group.destroyEvents.begin(),
+                               group.destroyEvents.end());
+        m_cancelledEvents += group.cancelled;
+        m_stats.cancelled += group.cancelled;
+        m_stop = m_stop || group.stop;
+    }
+    m_uid = m_batchUid + children * m_groupCount;
+    m_currentUid = batch.back().key.m_uid;
+    m_currentContext = batch.back().key.m_context;
+    CompactCancelledEvents();
+}
+
+void
+DefaultSimulatorImpl::ExecuteGroups()
+{
+    uint32_t index;
+    while ((index = m_nextGroup.fetch_add(1, std::memory_order_relaxed)) < m_groupCount)
+    {
+        BatchGroup& group = m_groups[index];
+        g_currentGroup = &group;
+        for (const auto& next : group.events)
+        {
+            group.currentUid = next.key.m_uid;
+            next.impl->Invoke();
+            next.impl->Unref();
+        }
+        g_currentGroup = nullptr;
+    }
+}
+
+uint32_t
+DefaultSimulatorImpl::AllocateBatchUid(BatchGroup& group)
+{
+    // Interleave the uids of the groups, so that they depend neither on
+    // the threads nor on the execution order of the groups.
+    return m_batchUid + group.children++ * m_groupCount + group.index;
+}
+
 void
 DefaultSimulatorImpl::Stop()
 {
     NS_LOG_FUNCTION(this);
+    auto group = static_cast<BatchGroup*>(g_currentGroup);
+    if (group != nullptr)
+    {
+        group->stop = true;
+        return;
+    }
     m_stop = true;
 }
 
@@ -212,7 +616,8 @@ EventId
 DefaultSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
 {
     NS_LOG_FUNCTION(this << delay.GetTimeStep() << event);
-    NS_ASSERT_MSG(m_mainThreadId == std::this_thread::get_id(),
+    auto group = static_cast<BatchGroup*>(g_currentGroup);
+    NS_ASSERT_MSG(group != nullptr || m_mainThreadId == std::this_thread::get_id(),
                   "Simulator::Schedule Thread-unsafe invocation!");
 
     NS_ASSERT_MSG(delay.IsPositive(), "DefaultSimulatorImpl::Schedule(): Negative delay");
@@ -222,10 +627,15 @@ DefaultSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
     ev.impl = event;
     ev.key.m_ts = (uint64_t)tAbsolute.GetTimeStep();
     ev.key.m_context = GetContext();
+    if (group != nullptr)
+    {
+        ev.key.m_uid = AllocateBatchUid(*group);
+        group->scheduled.push_back(ev);
+        return EventId(event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+    }
     ev.key.m_uid = m_uid;
     m_uid++;
-    m_unscheduledEvents++;
-    m_events->Insert(ev);
+    Insert(ev);
     return EventId(event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
 }
 
@@ -234,7 +644,17 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
 {
     NS_LOG_FUNCTION(this << context << delay.GetTimeStep() << event);
 
-    if (m_mainThreadId == std::this_thread::get_id())
+    auto group = static_cast<BatchGroup*>(g_currentGroup);
+    if (group != nullptr)
+    {
+        Scheduler::Event ev;
+        ev.impl = event;
+        ev.key.m_ts = (uint64_t)(delay + TimeStep(m_currentTs)).GetTimeStep();
+        ev.key.m_context = context;
+        ev.key.m_uid = AllocateBatchUid(*group);
+        group->scheduled.push_back(ev);
+    }
+    else if (m_mainThreadId == std::this_thread::get_id())
     {
         Time tAbsolute = delay + TimeStep(m_currentTs);
         Scheduler::Event ev;
@@ -243,8 +663,7 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
         ev.key.m_context = context;
         ev.key.m_uid = m_uid;
         m_uid++;
-        m_unscheduledEvents++;
-        m_events->Insert(ev);
+        Insert(ev);
     }
     else
     {
@@ -264,7 +683,7 @@ DefaultSimulatorImpl::ScheduleWithContext(uint32_t context, const Time& delay, E
 EventId
 DefaultSimulatorImpl::ScheduleNow(EventImpl* event)
 {
-    NS_ASSERT_MSG(m_mainThreadId == std::this_thread::get_id(),
+    NS_ASSERT_MSG(g_currentGroup != nullptr || m_mainThreadId == std::this_thread::get_id(),
                   "Simulator::ScheduleNow Thread-unsafe invocation!");
 
     return Schedule(Time(0), event);
@@ -273,10 +692,16 @@ DefaultSimulatorImpl::ScheduleNow(EventImpl* event)
 EventId
 DefaultSimulatorImpl::ScheduleDestroy(EventImpl* event)
 {
-    NS_ASSERT_MSG(m_mainThreadId == std::this_thread::get_id(),
+    auto group = static_cast<BatchGroup*>(g_currentGroup);
+    NS_ASSERT_MSG(group != nullptr || m_mainThreadId == std::this_thread::get_id(),
                   "Simulator::ScheduleDestroy Thread-unsafe invocation!");
 
     EventId id(Ptr<EventImpl>(event, false), m_currentTs, 0xffffffff, 2);
+    if (group != nullptr)
+    {
+        group->destroyEvents.push_back(id);
+        return id;
+    }
     m_destroyEvents.push_back(id);
     m_uid++;
     return id;
@@ -305,6 +730,12 @@ DefaultSimulatorImpl::GetDelayLeft(const EventId& id) const
 void
 DefaultSimulatorImpl::Remove(const EventId& id)
 {
+    if (id.GetUid() == EventId::UID::WHEEL)
+    {
+        // timer wheel events are not in the event list until they are due.
+        Cancel(id);
+        return;
+    }
     if (id.GetUid() == EventId::UID::DESTROY)
     {
         // destroy events.
@@ -322,11 +753,32 @@ DefaultSimulatorImpl::Remove(const EventId& id)
     {
         return;
     }
+    if (m_inBatch && id.GetTs() == m_currentTs && id.GetUid() < m_batchUid)
+    {
+        // The event belongs to the current batch, which is out of the
+        // event list already.
+        Cancel(id);
+        return;
+    }
     Scheduler::Event event;
     event.impl = id.PeekEventImpl();
     event.key.m_ts = id.GetTs();
     event.key.m_context = id.GetContext();
     event.key.m_uid = id.GetUid();
+    auto group = static_cast<BatchGroup*>(g_currentGroup);
+    if (group != nullptr)
+    {
+        if (event.key.m_uid >= m_batchUid)
+        {
+            // Scheduled during the current batch: not inserted yet.
+            Cancel(id);
+            return;
+        }
+        // Take it out of the event list once the batch is over.
+        event.impl->Cancel();
+        group->removed.push_back(event);
+        return;
+    }
     m_events->Remove(event);
     event.impl->Cancel();
     // whenever we remove an event from the event list, we have to unref it.
@@ -341,6 +793,21 @@ DefaultSimulatorImpl::Cancel(const EventId& id)
     if (!IsExpired(id))
     {
         id.PeekEventImpl()->Cancel();
+        if (id.GetUid() == EventId::UID::DESTROY || id.GetUid() == EventId::UID::WHEEL)
+        {
+            return;
+        }
+        auto group = static_cast<BatchGroup*>(g_currentGroup);
+        if (group != nullptr)
+        {
+            group->cancelled++;
+        }
+        else
+        {
+            m_cancelledEvents++;
+            m_stats.cancelled++;
+            CompactCancelledEvents();
+        }
     }
 }
 
@@ -363,8 +830,10 @@ DefaultSimulatorImpl::IsExpired(const EventId& id) const
         }
         return true;
     }
+    auto group = static_cast<const BatchGroup*>(g_currentGroup);
+    uint32_t currentUid = group != nullptr ? group->currentUid : m_currentUid;
     return id.PeekEventImpl() == nullptr || id.GetTs() < m_currentTs ||
-           (id.GetTs() == m_currentTs && id.GetUid() <= m_currentUid) ||
+           (id.GetTs() == m_currentTs && id.GetUid() <= currentUid) ||
            id.PeekEventImpl()->IsCancelled();
 }
 
@@ -377,7 +846,8 @@ DefaultSimulatorImpl::GetMaximumSimulationTime() const
 uint32_t
 DefaultSimulatorImpl::GetContext() const
 {
-    return m_currentContext;
+    auto group = static_cast<const BatchGroup*>(g_currentGroup);
+    return group != nullptr ? group->context : m_currentContext;
 }
 
 uint64_t
@@ -386,4 +856,16 @@ DefaultSimulatorImpl::GetEventCount() const
     return m_eventCount;
 }
 
+DefaultSimulatorImpl::EventStats
+DefaultSimulatorImpl::GetEventStats() const
+{
+    return m_stats;
+}
+
+DefaultSimulatorImpl::BatchStats
+DefaultSimulatorImpl::GetBatchStats() const
+{
+    return m_batchStats;
+}
+
 } // namespace ns3
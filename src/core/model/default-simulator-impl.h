@@ -9,11 +9,18 @@
 #ifndef DEFAULT_SIMULATOR_IMPL_H
 #define DEFAULT_SIMULATOR_IMPL_H
 
+#include "scheduler.h"
 #include "simulator-impl.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
 #include <list>
 #include <mutex>
+#include <string>
 #include <thread>
+#include <unordered_map>
+#include <vector>
 
 /**
  * @file
@@ -24,13 +31,35 @@
 namespace ns3
 {
 
-// Forward
-class Scheduler;
-
 /**
  * @ingroup simulator
  *
  * The default single process simulator implementation.
+ *
+ * Cancelled events are left in the event list until they are reached,
+ * as usual.  When they accumulate, because models such as TCP re-arm
+ * their timers on almost every packet, they are purged in bulk with
+ * Scheduler::RemoveCancelled().  This happens when at least
+ * \c CompactionMinimum cancelled events are pending and they are more
+ * than the fraction \c CompactionRatio of all the pending events.
+ *
+ * When \c ParallelThreads is not zero, the events are executed in
+ * batches of events with the same time stamp.  If a batch holds events
+ * of at least \c ParallelMinContexts distinct contexts, the events of
+ * each context are executed in order by one of \c ParallelThreads
+ * threads, and the events of different contexts concurrently.  The
+ * events scheduled meanwhile are buffered by context, and receive uids
+ * which depend only on the batch, the context and their rank, so that
+ * the execution order of each context is the same whatever the number
+ * of threads, including one.  \c ParallelRecordFile records the
+ * execution order, which \c ParallelReplayFile checks against a previous
+ * record, stopping at the first divergence.
+ *
+ * This mode requires that the events of different contexts, usually
+ * nodes, do not share mutable state: a packet must not be modified by a
+ * node once sent to another one, and the TimerWheel must not be used.
+ * Simulator::Stop() called by an event of a parallel batch takes effect
+ * once the whole batch has been executed.
  */
 class DefaultSimulatorImpl : public SimulatorImpl
 {
@@ -41,6 +70,24 @@ class DefaultSimulatorImpl : public SimulatorImpl
      */
     static TypeId GetTypeId();
 
+    /** Event list statistics. */
+    struct EventStats
+    {
+        uint64_t scheduled;   /**< Events inserted in the event list. */
+        uint64_t cancelled;   /**< Events cancelled while in the event list. */
+        uint64_t compacted;   /**< Cancelled events purged by compaction. */
+        uint64_t compactions; /**< Number of compactions. */
+    };
+
+    /** Statistics of the batch execution. */
+    struct BatchStats
+    {
+        uint64_t batches;         /**< Batches of events with the same time stamp. */
+        uint64_t parallelBatches; /**< Batches executed by context on the threads. */
+        uint64_t parallelGroups;  /**< Contexts of the batches executed on the threads. */
+        uint64_t parallelEvents;  /**< Events of the batches executed on the threads. */
+    };
+
     /** Constructor. */
     DefaultSimulatorImpl();
     /** Destructor. */
@@ -67,14 +114,80 @@ class DefaultSimulatorImpl : public SimulatorImpl
     uint32_t GetContext() const override;
     uint64_t GetEventCount() const override;
 
+    /**
+     * Get the event list statistics.
+     * @returns The statistics.
+     */
+    EventStats GetEventStats() const;
+    /**
+     * Get the batch execution statistics.
+     * @returns The statistics.
+     */
+    BatchStats GetBatchStats() const;
+
   private:
     void DoDispose() override;
 
+    /**
+     * Insert an event in the event list.
+     * @param [in] ev The event.
+     */
+    void Insert(const Scheduler::Event& ev);
+    /** Purge the cancelled events from the event list, if there are enough of them. */
+    void CompactCancelledEvents();
+
     /** Process the next event. */
     void ProcessOneEvent();
     /** Move events from a different context into the main event queue. */
     void ProcessEventsWithContext();
 
+    /** The events of one context in a batch, and their side effects. */
+    struct BatchGroup
+    {
+        uint32_t index;                          /**< Index of the group in the batch. */
+        uint32_t context;                        /**< The context. */
+        std::vector<Scheduler::Event> events;    /**< The events of the batch, in order. */
+        uint32_t currentUid;                     /**< Uid of the current event. */
+        uint32_t children;                       /**< Number of events scheduled. */
+        std::vector<Scheduler::Event> scheduled; /**< Events scheduled, to insert. */
+        std::vector<Scheduler::Event> removed;   /**< Events removed, to take out. */
+        std::vector<EventId> destroyEvents;      /**< Destroy events scheduled. */
+        uint64_t cancelled;                      /**< Events cancelled. */
+        bool stop;                               /**< Whether Stop() was called. */
+    };
+
+    /** Process the events of the next time stamp, as a batch. */
+    void ProcessOneBatch();
+    /**
+     * Process the events of a batch one after the other.
+     * @param [in] batch The events, in order.
+     */
+    void ProcessBatchSequentially(const std::vector<Scheduler::Event>& batch);
+    /**
+     * Process the events of a batch by context, on the threads.
+     * @param [in] batch The events, in order.
+     */
+    void ProcessBatchByContext(const std::vector<Scheduler::Event>& batch);
+    /** Execute the groups of the current batch, until none is left. */
+    void ExecuteGroups();
+    /**
+     * Allocate the uid of an event scheduled by an event of a group.
+     * @param [in] group The group.
+     * @returns The uid.
+     */
+    uint32_t AllocateBatchUid(BatchGroup& group);
+    /**
+     * Record the execution of an event, or check it against the replay file.
+     * @param [in] ev The event.
+     */
+    void RecordEvent(const Scheduler::Event& ev);
+    /** Open the record and replay files, and start the threads. */
+    void StartBatches();
+    /** Stop the threads. */
+    void StopBatches();
+    /** Thread function: execute the groups of the batches. */
+    void BatchWorker();
+
     /** Wrap an event with its execution context. */
     struct EventWithContext
     {
@@ -122,6 +235,57 @@ class DefaultSimulatorImpl : public SimulatorImpl
      *  not counting the Destroy events; this is used for validation
      */
     int m_unscheduledEvents;
+    /** Number of cancelled events still in the event list. */
+    uint64_t m_cancelledEvents;
+    /** Minimum number of cancelled events to trigger a compaction. */
+    uint32_t m_compactionMinimum;
+    /** Fraction of the event list which must be cancelled to trigger a compaction. */
+    double m_compactionRatio;
+    /** Event list statistics. */
+    EventStats m_stats;
+
+    /** Number of threads executing the batches, 0 to disable them. */
+    uint32_t m_parallelThreads;
+    /** Minimum number of contexts in a batch to execute it by context. */
+    uint32_t m_parallelMinContexts;
+    /** Name of the file recording the execution order. */
+    std::string m_recordFileName;
+    /** Name of the file the execution order is checked against. */
+    std::string m_replayFileName;
+    /** The record file. */
+    std::ofstream m_recordFile;
+    /** The replay file. */
+    std::ifstream m_replayFile;
+    /** Number of events recorded or replayed. */
+    uint64_t m_replayed;
+    /** Whether the events of the current time stamp are being executed as a batch. */
+    bool m_inBatch;
+    /** Uid of the first event scheduled during the current batch. */
+    uint32_t m_batchUid;
+    /** The groups of the current batch; only the first m_groupCount are used. */
+    std::vector<BatchGroup> m_groups;
+    /** Number of groups in the current batch. */
+    uint32_t m_groupCount;
+    /** Group index of each context of the current batch. */
+    std::unordered_map<uint32_t, uint32_t> m_groupIndex;
+    /** Next group to execute. */
+    std::atomic<uint32_t> m_nextGroup;
+    /** The threads executing the groups, besides the main thread. */
+    std::vector<std::thread> m_workers;
+    /** Mutex protecting the batch dispatch to the threads. */
+    std::mutex m_workersMutex;
+    /** Signals a new batch, or the end of the threads. */
+    std::condition_variable m_workersStart;
+    /** Signals the end of a batch. */
+    std::condition_variable m_workersDone;
+    /** Number of the current batch dispatched to the threads. */
+    uint64_t m_workersGeneration;
+    /** Number of threads still executing the current batch. */
+    uint32_t m_workersBusy;
+    /** Set to end the threads. */
+    bool m_workersExit;
+    /** Batch statistics. */
+    BatchStats m_batchStats;
 
     /** Main execution thread. */
     std::thread::id m_mainThreadId;
@@ -56,7 +56,13 @@ class EventId
         /** Reserved UID. */
         RESERVED = 3,
         /** Schedule(), etc. events. */
-        VALID = 4
+        VALID = 4,
+        /**
+         * TimerWheel::Schedule() events, which are not held in the event
+         * list until they are due.  This is the largest UID, so that such
+         * an event is not expired before it is invoked.
+         */
+        WHEEL = 0xffffffff
     };
 
     /** Default constructor. This EventId does nothing. */
@@ -10,6 +10,9 @@
 
 #include "log.h"
 
+#include <algorithm>
+#include <new>
+
 /**
  * @file
  * @ingroup events
@@ -21,6 +24,128 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("EventImpl");
 
+namespace
+{
+
+/** Size class granularity of the event pool, in bytes. */
+constexpr std::size_t POOL_GRANULARITY = 16;
+/** Number of size classes; larger events bypass the pool. */
+constexpr std::size_t POOL_CLASSES = 16;
+/** Maximum number of free blocks kept per size class. */
+constexpr std::size_t POOL_MAX_FREE = 4096;
+
+/** A free block, linked in its size class free list. */
+struct FreeBlock
+{
+    FreeBlock* next; /**< Next free block. */
+};
+
+/** Per-thread pool of event storage. */
+struct EventImplPool
+{
+    /** Destructor: release the free blocks. */
+    ~EventImplPool();
+
+    FreeBlock* free[POOL_CLASSES]{};        /**< Free lists, one per size class. */
+    std::size_t nFree[POOL_CLASSES]{};      /**< Free list lengths. */
+    EventImpl::PoolStats stats{0, 0, 0, 0}; /**< Statistics. */
+};
+
+/**
+ * Set when the pool of the current thread has been destroyed, so events
+ * released later during thread (or program) exit go back to the heap.
+ */
+thread_local bool g_poolDestroyed = false;
+/** The event pool of the current thread. */
+thread_local EventImplPool g_pool;
+
+EventImplPool::~EventImplPool()
+{
+    g_poolDestroyed = true;
+    for (std::size_t i = 0; i < POOL_CLASSES; ++i)
+    {
+        while (free[i] != nullptr)
+        {
+            FreeBlock* block = free[i];
+            free[i] = block->next;
+            ::operator delete(block);
+        }
+        nFree[i] = 0;
+    }
+}
+
+/**
+ * Get the size class of an allocation.
+ * @param [in] size The allocation size.
+ * @returns The size class, POOL_CLASSES if too large for the pool.
+ */
+inline std::size_t
+SizeClass(std::size_t size)
+{
+    return std::min((size + POOL_GRANULARITY - 1) / POOL_GRANULARITY - 1, POOL_CLASSES);
+}
+
+} // unnamed namespace
+
+void*
+EventImpl::operator new(std::size_t size)
+{
+    std::size_t sizeClass = SizeClass(size);
+    if (sizeClass == POOL_CLASSES || g_poolDestroyed)
+    {
+        return ::operator new(size);
+    }
+    EventImplPool& pool = g_pool;
+    ++pool.stats.allocations;
+    FreeBlock* block = pool.free[sizeClass];
+    if (block != nullptr)
+    {
+        pool.free[sizeClass] = block->next;
+        --pool.nFree[sizeClass];
+        ++pool.stats.poolHits;
+        return block;
+    }
+    return ::operator new((sizeClass + 1) * POOL_GRANULARITY);
+}
+
+void
+EventImpl::operator delete(void* p, std::size_t size)
+{
+    std::size_t sizeClass = SizeClass(size);
+    if (sizeClass == POOL_CLASSES || g_poolDestroyed)
+    {
+        ::operator delete(p);
+        return;
+    }
+    EventImplPool& pool = g_pool;
+    ++pool.stats.releases;
+    if (pool.nFree[sizeClass] >= POOL_MAX_FREE)
+    {
+        ::operator delete(p);
+        return;
+    }
+    auto block = static_cast<FreeBlock*>(p);
+    block->next = pool.free[sizeClass];
+    pool.free[sizeClass] = block;
+    ++pool.nFree[sizeClass];
+}
+
+EventImpl::PoolStats
+EventImpl::GetPoolStats()
+{
+    if (g_poolDestroyed)
+    {
+        return {0, 0, 0, 0};
+    }
+    PoolStats stats = g_pool.stats;
+    stats.pooled = 0;
+    for (std::size_t i = 0; i < POOL_CLASSES; ++i)
+    {
+        stats.pooled += g_pool.nFree[i];
+    }
+    return stats;
+}
+
 EventImpl::~EventImpl()
 {
     NS_LOG_FUNCTION(this);
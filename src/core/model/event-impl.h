@@ -10,6 +10,7 @@
 
 #include "simple-ref-count.h"
 
+#include <cstddef>
 #include <stdint.h>
 
 /**
@@ -30,10 +31,26 @@ namespace ns3
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * Since an event is allocated for every Simulator::Schedule call,
+ * the storage of all subclasses comes from a per-thread pool of
+ * free blocks, sorted in size classes, rather than from the global
+ * heap.  Blocks released by Unref() are kept for reuse by the next
+ * events of the same size class.  GetPoolStats() reports the pool
+ * efficiency for the calling thread.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
   public:
+    /** Memory pool statistics, for the calling thread. */
+    struct PoolStats
+    {
+        uint64_t allocations; /**< Events allocated in a pooled size class. */
+        uint64_t poolHits;    /**< Allocations served from the pool. */
+        uint64_t releases;    /**< Events released in a pooled size class. */
+        uint64_t pooled;      /**< Free blocks currently held in the pool. */
+    };
+
     /** Default constructor. */
     EventImpl();
     /** Destructor. */
@@ -56,6 +73,24 @@ class EventImpl : public SimpleRefCount<EventImpl>
      */
     bool IsCancelled();
 
+    /**
+     * Allocate storage for an event from the pool.
+     * @param [in] size The size of the event object.
+     * @returns The storage.
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * Release the storage of an event to the pool.
+     * @param [in] p The storage.
+     * @param [in] size The size of the event object.
+     */
+    static void operator delete(void* p, std::size_t size);
+    /**
+     * Get the event memory pool statistics of the calling thread.
+     * @returns The statistics.
+     */
+    static PoolStats GetPoolStats();
+
   protected:
     /**
      * Implementation for Invoke().
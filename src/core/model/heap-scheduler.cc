@@ -225,6 +225,16 @@ HeapScheduler::Remove(const Event& ev)
             NS_ASSERT(m_heap[i].impl == ev.impl);
             Exch(i, Last());
             m_heap.pop_back();
+            if (IsBottom(i))
+            {
+                return;
+            }
+            // The event moved to i may also be earlier than its new parent.
+            while (!IsRoot(i) && IsLessStrictly(i, Parent(i)))
+            {
+                Exch(i, Parent(i));
+                i = Parent(i);
+            }
             TopDown(i);
             return;
         }
@@ -232,4 +242,28 @@ HeapScheduler::Remove(const Event& ev)
     NS_ASSERT(false);
 }
 
+void
+HeapScheduler::RemoveCancelled(std::vector<Event>& cancelled)
+{
+    NS_LOG_FUNCTION(this);
+    std::size_t last = Root();
+    for (std::size_t i = Root(); i < m_heap.size(); i++)
+    {
+        if (m_heap[i].impl->IsCancelled())
+        {
+            cancelled.push_back(m_heap[i]);
+        }
+        else
+        {
+            m_heap[last++] = m_heap[i];
+        }
+    }
+    m_heap.resize(last);
+    // Rebuild the heap from the bottom internal nodes up.
+    for (std::size_t i = Last() / 2; i >= Root(); i--)
+    {
+        TopDown(i);
+    }
+}
+
 } // namespace ns3
@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ladder-scheduler.h"
+
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+#include "type-id.h"
+#include "uinteger.h"
+
+#include <algorithm>
+#include <functional>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::LadderScheduler class implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LadderScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED(LadderScheduler);
+
+TypeId
+LadderScheduler::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::LadderScheduler")
+            .SetParent<Scheduler>()
+            .SetGroupName("Core")
+            .AddConstructor<LadderScheduler>()
+            .AddAttribute("Threshold",
+                          "Maximum number of events sorted into the bottom tier at once; "
+                          "larger buckets are split into a new rung.",
+                          TypeId::ATTR_CONSTRUCT,
+                          UintegerValue(50),
+                          MakeUintegerAccessor(&LadderScheduler::m_threshold),
+                          MakeUintegerChecker<uint32_t>(2))
+            .AddAttribute("MaxRungs",
+                          "Maximum number of rungs in the ladder.",
+                          TypeId::ATTR_CONSTRUCT,
+                          UintegerValue(8),
+                          MakeUintegerAccessor(&LadderScheduler::m_maxRungs),
+                          MakeUintegerChecker<uint32_t>(1));
+    return tid;
+}
+
+LadderScheduler::LadderScheduler()
+    : m_topMin(UINT64_MAX),
+      m_topMax(0),
+      m_topStart(0),
+      m_threshold(50),
+      m_maxRungs(8)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LadderScheduler::~LadderScheduler()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint64_t
+LadderScheduler::Rung::CurrentStart() const
+{
+    if (cur < buckets.size())
+    {
+        return start + cur * width;
+    }
+    return end;
+}
+
+uint32_t
+LadderScheduler::Rung::Hash(uint64_t ts) const
+{
+    uint64_t bucket = (ts - start) / width;
+    return static_cast<uint32_t>(std::min<uint64_t>(bucket, buckets.size() - 1));
+}
+
+int32_t
+LadderScheduler::FindTier(uint64_t ts) const
+{
+    if (ts >= m_topStart)
+    {
+        return -1;
+    }
+    for (uint32_t i = 0; i < m_rungs.size(); ++i)
+    {
+        if (ts >= m_rungs[i].CurrentStart())
+        {
+            return i;
+        }
+    }
+    return m_rungs.size();
+}
+
+void
+LadderScheduler::InsertBottom(const Event& ev)
+{
+    auto it = std::upper_bound(m_bottom.begin(), m_bottom.end(), ev, std::greater<>());
+    m_bottom.insert(it, ev);
+}
+
+void
+LadderScheduler::SpawnRung(const Bucket& events, uint64_t end)
+{
+    NS_LOG_FUNCTION(this << events.size() << end);
+    NS_ASSERT(!events.empty());
+
+    auto [minIt, maxIt] = std::minmax_element(events.begin(),
+                                              events.end(),
+                                              [](const Event& a, const Event& b) {
+                                                  return a.key.m_ts < b.key.m_ts;
+                                              });
+    uint64_t lo = minIt->key.m_ts;
+    uint64_t hi = maxIt->key.m_ts;
+    NS_ASSERT(hi < end);
+
+    Rung rung;
+    rung.start = lo;
+    rung.width = (hi - lo) / events.size() + 1;
+    rung.end = end;
+    rung.cur = 0;
+    rung.count = events.size();
+    rung.buckets.resize((hi - lo) / rung.width + 1);
+    NS_LOG_LOGIC("rung " << m_rungs.size() << ": start=" << lo << ", width=" << rung.width
+                         << ", nBuckets=" << rung.buckets.size());
+
+    for (const auto& ev : events)
+    {
+        rung.buckets[rung.Hash(ev.key.m_ts)].push_back(ev);
+    }
+    m_rungs.push_back(std::move(rung));
+}
+
+void
+LadderScheduler::Refill()
+{
+    NS_LOG_FUNCTION(this);
+
+    while (m_bottom.empty())
+    {
+        if (m_rungs.empty())
+        {
+            if (m_top.empty())
+            {
+                return;
+            }
+            uint64_t topMax = m_topMax;
+            if (m_top.size() <= m_threshold)
+            {
+                m_bottom.swap(m_top);
+                std::sort(m_bottom.begin(), m_bottom.end(), std::greater<>());
+            }
+            else
+            {
+                SpawnRung(m_top, topMax + 1);
+                m_top.clear();
+            }
+            m_topStart = topMax + 1;
+            m_topMin = UINT64_MAX;
+            m_topMax = 0;
+            continue;
+        }
+
+        Rung& rung = m_rungs.back();
+        while (rung.cur < rung.buckets.size() && rung.buckets[rung.cur].empty())
+        {
+            ++rung.cur;
+        }
+        if (rung.count == 0 || rung.cur == rung.buckets.size())
+        {
+            NS_ASSERT(rung.count == 0);
+            m_rungs.pop_back();
+            continue;
+        }
+
+        Bucket bucket;
+        bucket.swap(rung.buckets[rung.cur]);
+        ++rung.cur;
+        rung.count -= bucket.size();
+
+        if (bucket.size() > m_threshold && rung.width > 1 && m_rungs.size() < m_maxRungs)
+        {
+            SpawnRung(bucket, rung.CurrentStart());
+            continue;
+        }
+
+        m_bottom.swap(bucket);
+        std::sort(m_bottom.begin(), m_bottom.end(), std::greater<>());
+    }
+}
+
+void
+LadderScheduler::Insert(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+
+    int32_t tier = FindTier(ev.key.m_ts);
+    if (tier < 0)
+    {
+        m_top.push_back(ev);
+        m_topMin = std::min(m_topMin, ev.key.m_ts);
+        m_topMax = std::max(m_topMax, ev.key.m_ts);
+    }
+    else if (static_cast<uint32_t>(tier) < m_rungs.size())
+    {
+        Rung& rung = m_rungs[tier];
+        rung.buckets[rung.Hash(ev.key.m_ts)].push_back(ev);
+        ++rung.count;
+    }
+    else
+    {
+        InsertBottom(ev);
+        if (m_bottom.size() > m_threshold && m_rungs.size() < m_maxRungs &&
+            m_bottom.front().key.m_ts != m_bottom.back().key.m_ts)
+        {
+            // Too many events arrived below the ladder: move them to a new,
+            // finer rung rather than keep sorting them on insertion.
+            uint64_t end = m_rungs.empty() ? m_topStart : m_rungs.back().CurrentStart();
+            SpawnRung(m_bottom, end);
+            m_bottom.clear();
+        }
+    }
+
+    if (m_bottom.empty())
+    {
+        Refill();
+    }
+}
+
+bool
+LadderScheduler::IsEmpty() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_bottom.empty();
+}
+
+Scheduler::Event
+LadderScheduler::PeekNext() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+    return m_bottom.back();
+}
+
+Scheduler::Event
+LadderScheduler::RemoveNext()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!IsEmpty());
+
+    Event ev = m_bottom.back();
+    m_bottom.pop_back();
+    if (m_bottom.empty())
+    {
+        Refill();
+    }
+    NS_LOG_LOGIC("remove ts=" << ev.key.m_ts << ", uid=" << ev.key.m_uid);
+    return ev;
+}
+
+void
+LadderScheduler::Remove(const Event& ev)
+{
+    NS_LOG_FUNCTION(this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+    NS_ASSERT(!IsEmpty());
+
+    auto sameUid = [&ev](const Event& other) { return other.key.m_uid == ev.key.m_uid; };
+
+    int32_t tier = FindTier(ev.key.m_ts);
+    if (tier < 0)
+    {
+        auto it = std::find_if(m_top.begin(), m_top.end(), sameUid);
+        NS_ASSERT(it != m_top.end());
+        *it = m_top.back();
+        m_top.pop_back();
+        return;
+    }
+    if (static_cast<uint32_t>(tier) < m_rungs.size())
+    {
+        Rung& rung = m_rungs[tier];
+        Bucket& bucket = rung.buckets[rung.Hash(ev.key.m_ts)];
+        auto it = std::find_if(bucket.begin(), bucket.end(), sameUid);
+        NS_ASSERT(it != bucket.end());
+        *it = bucket.back();
+        bucket.pop_back();
+        --rung.count;
+        return;
+    }
+
+    auto it = std::find_if(m_bottom.begin(), m_bottom.end(), sameUid);
+    NS_ASSERT(it != m_bottom.end());
+    NS_ASSERT(ev.impl == it->impl);
+    m_bottom.erase(it);
+    if (m_bottom.empty())
+    {
+        Refill();
+    }
+}
+
+void
+LadderScheduler::RemoveCancelled(std::vector<Event>& cancelled)
+{
+    NS_LOG_FUNCTION(this);
+
+    // Filter a tier in place, keeping the order of the remaining events.
+    auto filter = [&cancelled](Bucket& bucket) -> std::size_t {
+        auto last = bucket.begin();
+        for (auto it = bucket.begin(); it != bucket.end(); ++it)
+        {
+            if (it->impl->IsCancelled())
+            {
+                cancelled.push_back(*it);
+            }
+            else
+            {
+                *last++ = *it;
+            }
+        }
+        std::size_t removed = bucket.end() - last;
+        bucket.erase(last, bucket.end());
+        return removed;
+    };
+
+    filter(m_top);
+    for (auto& rung : m_rungs)
+    {
+        for (uint32_t i = rung.cur; i < rung.buckets.size(); ++i)
+        {
+            rung.count -= filter(rung.buckets[i]);
+        }
+    }
+    filter(m_bottom);
+    if (m_bottom.empty())
+    {
+        Refill();
+    }
+}
+
+} // namespace ns3
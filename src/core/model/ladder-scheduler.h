@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef LADDER_SCHEDULER_H
+#define LADDER_SCHEDULER_H
+
+#include "scheduler.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup scheduler
+ * ns3::LadderScheduler class declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup scheduler
+ * @brief a ladder queue event scheduler
+ *
+ * This event scheduler implements the multi-tier priority queue
+ * known as a ladder queue, published in 2005 in
+ * ["Ladder Queue: An O(1) Priority Queue Structure for Large-Scale
+ * Discrete Event Simulation" by Wai Teng Tang, Rick Siow Mong Goh and
+ * Ian Li-Jin Thng][Tang].
+ *
+ * [Tang]: https://doi.org/10.1145/1103323.1103324 "Tang"
+ *
+ * The events are stored in three tiers:
+ *
+ * - *Top*, an unsorted `std::vector` holding all events later than
+ *   every event in the lower tiers.  Far-future events are appended
+ *   here in constant time and are not touched again until the lower
+ *   tiers are exhausted.
+ * - *Ladder*, a stack of up to `MaxRungs` rungs.  Each rung is an array
+ *   of unsorted buckets covering a contiguous time span.  When the
+ *   bucket selected for dequeue holds more than `Threshold` events
+ *   it is split into a finer rung instead of being sorted.
+ * - *Bottom*, a short sorted `std::vector` from which events are
+ *   dequeued.
+ *
+ * Unlike the CalendarScheduler, the bucket width of each rung is derived
+ * from the events actually transferred into it, so there is never a
+ * wholesale resize of the event set: every event is moved a bounded number
+ * of times (at most once per rung) before it is executed.
+ *
+ * @par Time Complexity
+ *
+ * Operation    | Amortized %Time | Reason
+ * :----------- | :-------------- | :-----
+ * Insert()     | ~Constant       | Unsorted append to top or a rung bucket
+ * IsEmpty()    | Constant        | Bottom is never empty unless the queue is empty
+ * PeekNext()   | Constant        | `std::vector::back()` of bottom
+ * Remove()     | ~Constant       | Search within a bucket (linear within top)
+ * RemoveNext() | ~Constant       | Transfer amortized over the events
+ *
+ * @par Memory Complexity
+ *
+ * Category  | Memory                           | Reason
+ * :-------- | :------------------------------- | :-----
+ * Overhead  | ~ `MaxRungs` x 64 bytes          | Top, rungs and bottom
+ * Per Event | ~ `sizeof (std::vector)`         | Bucket storage
+ *
+ * @note Events in the lower tiers are always earlier than the events in
+ * higher tiers, and the rung searched on insertion is the first one whose
+ * current dequeue position is not later than the event time stamp.
+ */
+class LadderScheduler : public Scheduler
+{
+  public:
+    /**
+     *  Register this type.
+     *  @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    LadderScheduler();
+    /** Destructor. */
+    ~LadderScheduler() override;
+
+    // Inherited
+    void Insert(const Scheduler::Event& ev) override;
+    bool IsEmpty() const override;
+    Scheduler::Event PeekNext() const override;
+    Scheduler::Event RemoveNext() override;
+    void Remove(const Scheduler::Event& ev) override;
+    void RemoveCancelled(std::vector<Scheduler::Event>& cancelled) override;
+
+  private:
+    /** Ladder bucket type: an unsorted vector of Events. */
+    typedef std::vector<Scheduler::Event> Bucket;
+
+    /** A ladder rung: an array of buckets of uniform width. */
+    struct Rung
+    {
+        std::vector<Bucket> buckets; /**< The buckets. */
+        uint64_t start;              /**< Time stamp at the start of bucket 0. */
+        uint64_t width;              /**< Bucket duration, in dimensionless time units. */
+        uint64_t end;                /**< End of the span; the last bucket extends to here. */
+        uint32_t cur;                /**< Index of the next bucket to be dequeued. */
+        uint64_t count;              /**< Number of events in this rung. */
+
+        /**
+         * Get the time stamp at the start of the current bucket.
+         * Events at or after this time stamp belong to this rung.
+         * @returns The current start time.
+         */
+        uint64_t CurrentStart() const;
+        /**
+         * Hash the dimensionless time to a bucket.
+         * @param [in] ts The dimensionless time.
+         * @returns The bucket index.
+         */
+        uint32_t Hash(uint64_t ts) const;
+    };
+
+    /**
+     * Fill a new rung with events and push it on the ladder.
+     *
+     * The rung starts at the earliest event, and its bucket width is
+     * chosen to hold about one event per bucket.
+     *
+     * @param [in] events The events to distribute in the rung.
+     * @param [in] end The upper bound (exclusive) of the span of the rung.
+     */
+    void SpawnRung(const Bucket& events, uint64_t end);
+    /**
+     * Refill the bottom from the ladder, or the ladder from the top,
+     * until bottom is not empty or the scheduler is empty.
+     */
+    void Refill();
+    /**
+     * Find the tier where an event with a given time stamp is stored.
+     *
+     * @param [in] ts The event time stamp.
+     * @returns The index of the rung, \c m_rungs.size() for the bottom,
+     * or -1 for the top.
+     */
+    int32_t FindTier(uint64_t ts) const;
+    /**
+     * Insert an event in the sorted bottom.
+     * @param [in] ev The Event.
+     */
+    void InsertBottom(const Scheduler::Event& ev);
+
+    /** Unsorted top tier. */
+    Bucket m_top;
+    /** Smallest time stamp in the top tier. */
+    uint64_t m_topMin;
+    /** Largest time stamp in the top tier. */
+    uint64_t m_topMax;
+    /** All events at or after this time stamp are stored in the top tier. */
+    uint64_t m_topStart;
+    /** The ladder rungs; the last rung is the finest. */
+    std::vector<Rung> m_rungs;
+    /** Bottom tier, sorted in decreasing order so the next event is at the back. */
+    Bucket m_bottom;
+
+    /** Maximum number of events sorted in a bucket before it is split in a new rung. */
+    uint32_t m_threshold;
+    /** Maximum number of rungs in the ladder. */
+    uint32_t m_maxRungs;
+};
+
+} // namespace ns3
+
+#endif /* LADDER_SCHEDULER_H */
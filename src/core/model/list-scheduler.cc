@@ -101,4 +101,22 @@ ListScheduler::Remove(const Event& ev)
     NS_ASSERT(false);
 }
 
+void
+ListScheduler::RemoveCancelled(std::vector<Event>& cancelled)
+{
+    NS_LOG_FUNCTION(this);
+    for (auto i = m_events.begin(); i != m_events.end();)
+    {
+        if (i->impl->IsCancelled())
+        {
+            cancelled.push_back(*i);
+            i = m_events.erase(i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
 } // namespace ns3
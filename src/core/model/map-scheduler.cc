@@ -101,4 +101,22 @@ MapScheduler::Remove(const Event& ev)
     m_list.erase(i);
 }
 
+void
+MapScheduler::RemoveCancelled(std::vector<Event>& cancelled)
+{
+    NS_LOG_FUNCTION(this);
+    for (auto i = m_list.begin(); i != m_list.end();)
+    {
+        if (i->second->IsCancelled())
+        {
+            cancelled.push_back({i->second, i->first});
+            i = m_list.erase(i);
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
 } // namespace ns3
@@ -69,6 +69,7 @@ class MapScheduler : public Scheduler
     Scheduler::Event PeekNext() const override;
     Scheduler::Event RemoveNext() override;
     void Remove(const Scheduler::Event& ev) override;
+    void RemoveCancelled(std::vector<Scheduler::Event>& cancelled) override;
 
   private:
     /** Event list type: a Map from EventKey to EventImpl. */
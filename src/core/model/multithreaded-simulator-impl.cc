@@ -0,0 +1,675 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "abort.h"
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+#include "nstime.h"
+#include "scheduler.h"
+#include "simulator.h"
+#include "uinteger.h"
+
+#include <algorithm>
+#include <thread>
+#include <tuple>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3
+{
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED(MultithreadedSimulatorImpl);
+
+namespace
+{
+
+/**
+ * @ingroup simulator
+ * The partition executed by the calling thread, during Run().
+ */
+thread_local void* g_currentPartition = nullptr;
+
+/** Partition index used for the events sent by foreign threads. */
+constexpr uint32_t EXTERNAL_SOURCE = 0xffffffff;
+
+} // unnamed namespace
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::MultithreadedSimulatorImpl")
+            .SetParent<SimulatorImpl>()
+            .SetGroupName("Core")
+            .AddConstructor<MultithreadedSimulatorImpl>()
+            .AddAttribute("ThreadCount",
+                          "The number of partitions and threads; "
+                          "0 uses the number of hardware threads.",
+                          TypeId::ATTR_CONSTRUCT,
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&MultithreadedSimulatorImpl::m_threadCount),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("LookAhead",
+                          "The minimum delay of the events scheduled for a context "
+                          "of another partition, which is the duration of the "
+                          "synchronization windows.",
+                          TimeValue(Seconds(0)),
+                          MakeTimeAccessor(&MultithreadedSimulatorImpl::m_lookAhead),
+                          MakeTimeChecker(Seconds(0)));
+    return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl()
+    : m_threadCount(0),
+      m_lookAhead(Seconds(0)),
+      m_windowEnd(0),
+      m_windowCount(0),
+      m_stopTs(UINT64_MAX),
+      m_done(false),
+      m_started(false),
+      m_currentTs(0),
+      m_uid(EventId::UID::VALID),
+      m_externalSent(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& partition : m_partitions)
+    {
+        Message* msg = partition->inbox.exchange(nullptr);
+        while (msg != nullptr)
+        {
+            Message* next = msg->next;
+            msg->ev.impl->Unref();
+            delete msg;
+            msg = next;
+        }
+        while (!partition->events->IsEmpty())
+        {
+            Scheduler::Event next = partition->events->RemoveNext();
+            next.impl->Unref();
+        }
+        partition->events = nullptr;
+    }
+    m_partitions.clear();
+    SimulatorImpl::DoDispose();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy()
+{
+    NS_LOG_FUNCTION(this);
+    while (!m_destroyEvents.empty())
+    {
+        Ptr<EventImpl> ev = m_destroyEvents.front().PeekEventImpl();
+        m_destroyEvents.pop_front();
+        NS_LOG_LOGIC("handle destroy " << ev);
+        if (!ev->IsCancelled())
+        {
+            ev->Invoke();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory)
+{
+    NS_LOG_FUNCTION(this << schedulerFactory);
+    NS_ABORT_MSG_IF(m_barrier, "Cannot change the scheduler during Run()");
+
+    if (m_partitions.empty())
+    {
+        // First call, from Simulator, once the attributes are set.
+        uint32_t count = m_threadCount;
+        if (count == 0)
+        {
+            count = std::max(1U, std::thread::hardware_concurrency());
+        }
+        NS_LOG_LOGIC("create " << count << " partitions");
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            auto partition = std::make_unique<Partition>();
+            partition->index = i;
+            partition->inbox = nullptr;
+            partition->currentTs = 0;
+            partition->currentUid = EventId::UID::INVALID;
+            partition->currentContext = Simulator::NO_CONTEXT;
+            partition->uid = EventId::UID::VALID;
+            partition->sent = 0;
+            partition->eventCount = 0;
+            partition->unscheduledEvents = 0;
+            m_partitions.push_back(std::move(partition));
+        }
+    }
+
+    for (auto& partition : m_partitions)
+    {
+        Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler>();
+        if (partition->events)
+        {
+            while (!partition->events->IsEmpty())
+            {
+                scheduler->Insert(partition->events->RemoveNext());
+            }
+        }
+        partition->events = scheduler;
+    }
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId() const
+{
+    return 0;
+}
+
+void
+MultithreadedSimulatorImpl::SetContextPartition(uint32_t context, uint32_t partition)
+{
+    NS_LOG_FUNCTION(this << context << partition);
+    NS_ABORT_MSG_IF(partition >= m_partitions.size(),
+                    "Partition " << partition << " out of range");
+    NS_ABORT_MSG_IF(m_started, "Cannot change the partitions once the simulation has run");
+    NS_ABORT_MSG_IF(context == Simulator::NO_CONTEXT && partition != 0,
+                    "Events without context run in partition 0");
+
+    if (context == Simulator::NO_CONTEXT)
+    {
+        return;
+    }
+
+    uint32_t from = GetContextPartition(context);
+    if (context >= m_contextPartition.size())
+    {
+        m_contextPartition.resize(context + 1, UINT32_MAX);
+    }
+    m_contextPartition[context] = partition;
+    if (from == partition)
+    {
+        return;
+    }
+
+    // Move the events already scheduled for this context, e.g. the
+    // application start events, to the new partition.
+    Partition& src = *m_partitions[from];
+    Partition& dst = *m_partitions[partition];
+    std::vector<Scheduler::Event> kept;
+    while (!src.events->IsEmpty())
+    {
+        Scheduler::Event ev = src.events->RemoveNext();
+        if (ev.key.m_context == context)
+        {
+            dst.events->Insert(ev);
+            dst.unscheduledEvents++;
+        }
+        else
+        {
+            kept.push_back(ev);
+        }
+        src.unscheduledEvents--;
+    }
+    for (const auto& ev : kept)
+    {
+        src.events->Insert(ev);
+        src.unscheduledEvents++;
+    }
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContextPartition(uint32_t context) const
+{
+    if (context < m_contextPartition.size() && m_contextPartition[context] != UINT32_MAX)
+    {
+        return m_contextPartition[context];
+    }
+    if (context == Simulator::NO_CONTEXT)
+    {
+        return 0;
+    }
+    return context % m_partitions.size();
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartitionCount() const
+{
+    return m_partitions.size();
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetWindowCount() const
+{
+    return m_windowCount;
+}
+
+MultithreadedSimulatorImpl::Partition*
+MultithreadedSimulatorImpl::GetCurrentPartition() const
+{
+    return static_cast<Partition*>(g_currentPartition);
+}
+
+void
+MultithreadedSimulatorImpl::Insert(Partition& partition, Scheduler::Event& ev)
+{
+    if (m_barrier)
+    {
+        ev.key.m_uid = partition.uid++;
+    }
+    else
+    {
+        ev.key.m_uid = m_uid++;
+    }
+    partition.events->Insert(ev);
+    partition.unscheduledEvents++;
+}
+
+void
+MultithreadedSimulatorImpl::Send(Partition& partition, const Scheduler::Event& ev)
+{
+    Partition* current = GetCurrentPartition();
+
+    auto msg = new Message;
+    msg->ev = ev;
+    if (current != nullptr)
+    {
+        msg->source = current->index;
+        msg->sequence = current->sent++;
+    }
+    else
+    {
+        msg->source = EXTERNAL_SOURCE;
+        msg->sequence = m_externalSent++;
+    }
+    msg->next = partition.inbox.load(std::memory_order_relaxed);
+    while (!partition.inbox.compare_exchange_weak(msg->next,
+                                                  msg,
+                                                  std::memory_order_release,
+                                                  std::memory_order_relaxed))
+    {
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Synchronizer::operator()() noexcept
+{
+    impl->Synchronize();
+}
+
+void
+MultithreadedSimulatorImpl::Synchronize()
+{
+    std::vector<Message*> messages;
+    uint64_t next = UINT64_MAX;
+    for (auto& partition : m_partitions)
+    {
+        messages.clear();
+        for (Message* msg = partition->inbox.exchange(nullptr, std::memory_order_acquire);
+             msg != nullptr;
+             msg = msg->next)
+        {
+            messages.push_back(msg);
+        }
+        // Receive the events in an order independent of the thread timing.
+        std::sort(messages.begin(), messages.end(), [](const Message* a, const Message* b) {
+            return std::tie(a->ev.key.m_ts, a->source, a->sequence) <
+                   std::tie(b->ev.key.m_ts, b->source, b->sequence);
+        });
+        for (Message* msg : messages)
+        {
+            Insert(*partition, msg->ev);
+            delete msg;
+        }
+        if (!partition->events->IsEmpty())
+        {
+            next = std::min(next, partition->events->PeekNext().key.m_ts);
+        }
+    }
+
+    if (next == UINT64_MAX || next > m_stopTs.load(std::memory_order_relaxed))
+    {
+        m_done = true;
+        return;
+    }
+    m_windowCount++;
+    if (m_partitions.size() == 1)
+    {
+        m_windowEnd = UINT64_MAX;
+    }
+    else
+    {
+        m_windowEnd = next + std::max<uint64_t>(m_lookAhead.GetTimeStep(), 1);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::RunPartition(uint32_t index)
+{
+    Partition& partition = *m_partitions[index];
+    g_currentPartition = &partition;
+
+    while (true)
+    {
+        m_barrier->arrive_and_wait();
+        if (m_done)
+        {
+            break;
+        }
+        while (!partition.events->IsEmpty())
+        {
+            uint64_t ts = partition.events->PeekNext().key.m_ts;
+            if (ts >= m_windowEnd || ts > m_stopTs.load(std::memory_order_relaxed))
+            {
+                break;
+            }
+            Scheduler::Event next = partition.events->RemoveNext();
+            partition.unscheduledEvents--;
+            partition.eventCount++;
+            NS_ASSERT(next.key.m_ts >= partition.currentTs);
+            partition.currentTs = next.key.m_ts;
+            partition.currentContext = next.key.m_context;
+            partition.currentUid = next.key.m_uid;
+            next.impl->Invoke();
+            next.impl->Unref();
+        }
+    }
+    g_currentPartition = nullptr;
+}
+
+void
+MultithreadedSimulatorImpl::Run()
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(!m_partitions.empty());
+
+    m_started = true;
+    m_done = false;
+    for (auto& partition : m_partitions)
+    {
+        partition->uid = std::max(partition->uid, m_uid);
+    }
+    m_barrier = std::make_unique<std::barrier<Synchronizer>>(m_partitions.size(),
+                                                             Synchronizer{this});
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 1; i < m_partitions.size(); ++i)
+    {
+        threads.emplace_back(&MultithreadedSimulatorImpl::RunPartition, this, i);
+    }
+    RunPartition(0);
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    m_barrier = nullptr;
+
+    uint64_t stopTs = m_stopTs.exchange(UINT64_MAX);
+    for (auto& partition : m_partitions)
+    {
+        m_currentTs = std::max(m_currentTs, partition->currentTs);
+        m_uid = std::max(m_uid, partition->uid);
+    }
+    // The partitions run separately, and only one of them executed the
+    // stop event: align them all on its time stamp.
+    if (stopTs != UINT64_MAX && !IsFinished())
+    {
+        m_currentTs = stopTs;
+    }
+    for (auto& partition : m_partitions)
+    {
+        if (partition->currentTs != m_currentTs)
+        {
+            partition->currentTs = m_currentTs;
+            partition->currentUid = EventId::UID::INVALID;
+        }
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished() const
+{
+    for (const auto& partition : m_partitions)
+    {
+        if (!partition->events->IsEmpty() ||
+            partition->inbox.load(std::memory_order_relaxed) != nullptr)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    uint64_t now = Now().GetTimeStep();
+    uint64_t stopTs = m_stopTs.load();
+    while (now < stopTs && !m_stopTs.compare_exchange_weak(stopTs, now))
+    {
+    }
+}
+
+EventId
+MultithreadedSimulatorImpl::Stop(const Time& delay)
+{
+    NS_LOG_FUNCTION(this << delay.GetTimeStep());
+    // Set the stop time right away, so that all the partitions stop at
+    // the same time stamp, whatever the progress of the one executing
+    // the stop event.
+    uint64_t ts = (Now() + delay).GetTimeStep();
+    uint64_t stopTs = m_stopTs.load();
+    while (ts < stopTs && !m_stopTs.compare_exchange_weak(stopTs, ts))
+    {
+    }
+    return Simulator::Schedule(delay, &Simulator::Stop);
+}
+
+EventId
+MultithreadedSimulatorImpl::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_ASSERT_MSG(delay.IsPositive(), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+
+    Partition* partition = GetCurrentPartition();
+    uint32_t context = GetContext();
+    if (partition == nullptr)
+    {
+        NS_ASSERT_MSG(!m_barrier, "Simulator::Schedule Thread-unsafe invocation!");
+        partition = m_partitions[GetContextPartition(context)].get();
+    }
+
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = (uint64_t)(delay + Now()).GetTimeStep();
+    ev.key.m_context = context;
+    Insert(*partition, ev);
+    return EventId(event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext(uint32_t context,
+                                                const Time& delay,
+                                                EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << context << delay.GetTimeStep() << event);
+    NS_ASSERT_MSG(delay.IsPositive(), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+
+    Partition& partition = *m_partitions[GetContextPartition(context)];
+    Partition* current = GetCurrentPartition();
+
+    Scheduler::Event ev;
+    ev.impl = event;
+    ev.key.m_ts = (uint64_t)(delay + Now()).GetTimeStep();
+    ev.key.m_context = context;
+
+    if (current == &partition || !m_barrier)
+    {
+        Insert(partition, ev);
+        return;
+    }
+    if (current != nullptr)
+    {
+        NS_ABORT_MSG_IF(delay < m_lookAhead || delay.IsZero(),
+                        "Event scheduled for context "
+                            << context << " in another partition with delay " << delay
+                            << ", shorter than the LookAhead " << m_lookAhead);
+    }
+    Send(partition, ev);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow(EventImpl* event)
+{
+    return Schedule(Time(0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy(EventImpl* event)
+{
+    EventId id(Ptr<EventImpl>(event, false), Now().GetTimeStep(), 0xffffffff, 2);
+    std::unique_lock lock{m_destroyMutex};
+    m_destroyEvents.push_back(id);
+    return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now() const
+{
+    // Do not add function logging here, to avoid stack overflow
+    Partition* partition = GetCurrentPartition();
+    return TimeStep(partition != nullptr ? partition->currentTs : m_currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft(const EventId& id) const
+{
+    if (IsExpired(id))
+    {
+        return TimeStep(0);
+    }
+    return TimeStep(id.GetTs()) - Now();
+}
+
+void
+MultithreadedSimulatorImpl::Remove(const EventId& id)
+{
+    if (id.GetUid() == EventId::UID::WHEEL)
+    {
+        // timer wheel events are not in the event list until they are due.
+        Cancel(id);
+        return;
+    }
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        // destroy events.
+        std::unique_lock lock{m_destroyMutex};
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                m_destroyEvents.erase(i);
+                break;
+            }
+        }
+        return;
+    }
+    if (IsExpired(id))
+    {
+        return;
+    }
+    Partition& partition = *m_partitions[GetContextPartition(id.GetContext())];
+    NS_ASSERT_MSG(!m_barrier || GetCurrentPartition() == &partition,
+                  "Cannot remove an event of another partition");
+    Scheduler::Event event;
+    event.impl = id.PeekEventImpl();
+    event.key.m_ts = id.GetTs();
+    event.key.m_context = id.GetContext();
+    event.key.m_uid = id.GetUid();
+    partition.events->Remove(event);
+    event.impl->Cancel();
+    // whenever we remove an event from the event list, we have to unref it.
+    event.impl->Unref();
+    partition.unscheduledEvents--;
+}
+
+void
+MultithreadedSimulatorImpl::Cancel(const EventId& id)
+{
+    if (!IsExpired(id))
+    {
+        id.PeekEventImpl()->Cancel();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired(const EventId& id) const
+{
+    if (id.GetUid() == EventId::UID::DESTROY)
+    {
+        if (id.PeekEventImpl() == nullptr || id.PeekEventImpl()->IsCancelled())
+        {
+            return true;
+        }
+        // destroy events.
+        std::unique_lock lock{m_destroyMutex};
+        for (auto i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++)
+        {
+            if (*i == id)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    const Partition& partition = *m_partitions[GetContextPartition(id.GetContext())];
+    return id.PeekEventImpl() == nullptr || id.GetTs() < partition.currentTs ||
+           (id.GetTs() == partition.currentTs && id.GetUid() <= partition.currentUid) ||
+           id.PeekEventImpl()->IsCancelled();
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime() const
+{
+    return TimeStep(0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext() const
+{
+    Partition* partition = GetCurrentPartition();
+    return partition != nullptr ? partition->currentContext : Simulator::NO_CONTEXT;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount() const
+{
+    uint64_t count = 0;
+    for (const auto& partition : m_partitions)
+    {
+        count += partition->eventCount;
+    }
+    return count;
+}
+
+} // namespace ns3
@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "event-id.h"
+#include "nstime.h"
+#include "scheduler.h"
+#include "simulator-impl.h"
+
+#include <atomic>
+#include <barrier>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup simulator
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3
+{
+
+/**
+ * @ingroup simulator
+ *
+ * @brief A conservative parallel simulator implementation, running
+ * in a single process on several threads.
+ *
+ * The simulation contexts, that is, the node ids, are split into
+ * `ThreadCount` partitions.  Each partition has its own event list,
+ * and is executed by its own thread.  By default context \c c belongs to
+ * partition `c % ThreadCount`; SetContextPartition() overrides this, for
+ * example to follow the system ids given to the nodes for a distributed
+ * simulation.  Events without context run in partition 0.
+ *
+ * The partitions are synchronized with barriers, as the YAWNS algorithm
+ * used by the DistributedSimulatorImpl: all partitions execute
+ * their events in a window of simulation time, starting at the
+ * earliest pending event and lasting `LookAhead`, then exchange the
+ * events they scheduled for each other, and start the next window.  This
+ * requires that an event scheduled with Simulator::ScheduleWithContext
+ * for a context in another partition is at least `LookAhead` in the
+ * future, which is typically the smallest delay of the channels
+ * connecting nodes of different partitions, e.g. the `Delay` attribute
+ * of the PointToPointChannel.
+ *
+ * Events sent to another partition are pushed to a lock-free queue of
+ * that partition, and sorted by time stamp, sending partition, and
+ * order of sending when the window ends.  The execution is thus
+ * deterministic, and independent of the number of threads for events
+ * with distinct time stamps in each context.
+ *
+ * The models must not share mutable state between nodes of different
+ * partitions, other than through events scheduled with
+ * Simulator::ScheduleWithContext.  In particular, a packet sent to a
+ * node of another partition must not be modified or copied by the
+ * sender afterwards, and the TimerWheel must not be used.
+ *
+ * Simulator::Stop with a delay stops all the partitions once they have
+ * executed the events of the stop time stamp.  Simulator::Stop without
+ * argument stops them at the end of the current window only.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+  public:
+    /**
+     *  Register this type.
+     *  @return The object TypeId.
+     */
+    static TypeId GetTypeId();
+
+    /** Constructor. */
+    MultithreadedSimulatorImpl();
+    /** Destructor. */
+    ~MultithreadedSimulatorImpl() override;
+
+    // Inherited
+    void Destroy() override;
+    bool IsFinished() const override;
+    void Stop() override;
+    EventId Stop(const Time& delay) override;
+    EventId Schedule(const Time& delay, EventImpl* event) override;
+    void ScheduleWithContext(uint32_t context, const Time& delay, EventImpl* event) override;
+    EventId ScheduleNow(EventImpl* event) override;
+    EventId ScheduleDestroy(EventImpl* event) override;
+    void Remove(const EventId& id) override;
+    void Cancel(const EventId& id) override;
+    bool IsExpired(const EventId& id) const override;
+    void Run() override;
+    Time Now() const override;
+    Time GetDelayLeft(const EventId& id) const override;
+    Time GetMaximumSimulationTime() const override;
+    void SetScheduler(ObjectFactory schedulerFactory) override;
+    uint32_t GetSystemId() const override;
+    uint32_t GetContext() const override;
+    uint64_t GetEventCount() const override;
+
+    /**
+     * Assign a context to a partition.
+     *
+     * This can only be called before the simulation starts.
+     *
+     * @param [in] context The context, usually a node id.
+     * @param [in] partition The partition, less than `ThreadCount`.
+     */
+    void SetContextPartition(uint32_t context, uint32_t partition);
+    /**
+     * Get the partition of a context.
+     * @param [in] context The context.
+     * @returns The partition executing the events of this context.
+     */
+    uint32_t GetContextPartition(uint32_t context) const;
+    /**
+     * Get the number of partitions, which is the number of threads.
+     * @returns The number of partitions.
+     */
+    uint32_t GetPartitionCount() const;
+    /**
+     * Get the number of synchronization windows executed so far.
+     * @returns The number of windows.
+     */
+    uint64_t GetWindowCount() const;
+
+  private:
+    void DoDispose() override;
+
+    /** An event sent to another partition. */
+    struct Message
+    {
+        Scheduler::Event ev; /**< The event; the uid is set on reception. */
+        uint32_t source;     /**< The sending partition. */
+        uint64_t sequence;   /**< The sending order in the sending partition. */
+        Message* next;       /**< The next message in the queue. */
+    };
+
+    /** A partition of the simulation. */
+    struct Partition
+    {
+        uint32_t index;              /**< Index of the partition. */
+        Ptr<Scheduler> events;       /**< The event list. */
+        std::atomic<Message*> inbox; /**< Lock-free queue of the incoming events. */
+        uint64_t currentTs;          /**< Time stamp of the current event. */
+        uint32_t currentUid;         /**< Uid of the current event. */
+        uint32_t currentContext;     /**< Context of the current event. */
+        uint32_t uid;                /**< Next uid. */
+        uint64_t sent;               /**< Number of events sent to other partitions. */
+        uint64_t eventCount;         /**< Number of events executed. */
+        int64_t unscheduledEvents;   /**< Number of events in the event list. */
+    };
+
+    /** Completion function of the synchronization barrier. */
+    struct Synchronizer
+    {
+        MultithreadedSimulatorImpl* impl; /**< The simulator. */
+
+        /** Run the synchronization step. */
+        void operator()() noexcept;
+    };
+
+    /**
+     * Insert an event in the event list of a partition.
+     * @param [in] partition The partition.
+     * @param [in] ev The event; its uid is set by this function.
+     */
+    void Insert(Partition& partition, Scheduler::Event& ev);
+    /**
+     * Send an event to the queue of another partition.
+     * @param [in] partition The destination partition.
+     * @param [in] ev The event.
+     */
+    void Send(Partition& partition, const Scheduler::Event& ev);
+    /**
+     * Move the incoming events of all partitions to their event lists,
+     * and compute the next window.
+     *
+     * Called by a single thread while all the partitions are blocked.
+     */
+    void Synchronize();
+    /**
+     * Thread function: execute the windows of a partition.
+     * @param [in] index The partition index.
+     */
+    void RunPartition(uint32_t index);
+    /**
+     * Get the partition of the calling thread, if any.
+     * @returns The partition, or nullptr outside of Run().
+     */
+    Partition* GetCurrentPartition() const;
+
+    /** The partitions. */
+    std::vector<std::unique_ptr<Partition>> m_partitions;
+    /** Explicit partition of the contexts. */
+    std::vector<uint32_t> m_contextPartition;
+    /** The synchronization barrier, during Run(). */
+    std::unique_ptr<std::barrier<Synchronizer>> m_barrier;
+    /** Number of partitions and threads, 0 for the hardware concurrency. */
+    uint32_t m_threadCount;
+    /** Minimum delay of the events scheduled to another partition. */
+    Time m_lookAhead;
+    /** End (exclusive) of the current window. */
+    uint64_t m_windowEnd;
+    /** Number of windows executed. */
+    uint64_t m_windowCount;
+    /** Time stamp after which no event is executed. */
+    std::atomic<uint64_t> m_stopTs;
+    /** Set by the synchronization step when the simulation is over. */
+    bool m_done;
+    /** Whether the simulation has been run once. */
+    bool m_started;
+    /** Current time stamp outside of Run(). */
+    uint64_t m_currentTs;
+    /** Next uid outside of Run(). */
+    uint32_t m_uid;
+    /** Sequence number of the events sent from foreign threads. */
+    std::atomic<uint64_t> m_externalSent;
+
+    /** The event list of destroy events. */
+    std::list<EventId> m_destroyEvents;
+    /** Mutex protecting m_destroyEvents. */
+    mutable std::mutex m_destroyMutex;
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
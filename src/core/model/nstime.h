@@ -20,6 +20,7 @@
 #include <ostream>
 #include <set>
 #include <stdint.h>
+#include <unordered_set>
 
 /**
  * @file
@@ -715,13 +716,15 @@ class Time
      *
      *  @internal
      *
-     *  We use a std::set so we can remove the record easily when
-     *  ~Time() is called.
+     *  We use a std::unordered_set so we can remove the record easily
+     *  when ~Time() is called: every Time created before the simulation
+     *  starts is recorded, and the topologies of many nodes hold many
+     *  of them in their attributes.
      *
      *  We don't use Ptr<Time>, because we would have to bloat every Time
      *  instance with SimpleRefCount<Time>.
      *
-     *  Seems like this should be std::set< Time * const >, but
+     *  Seems like this should be std::unordered_set< Time * const >, but
      *  [Stack
      * Overflow](http://stackoverflow.com/questions/5526019/compile-errors-stdset-with-const-members)
      *  says otherwise, quoting the standard:
@@ -729,7 +732,7 @@ class Time
      *  > & sect;23.1/3 states that std::set key types must be assignable
      *  > and copy constructable; clearly a const type will not be assignable.
      */
-    typedef std::set<Time*> MarkedTimes;
+    typedef std::unordered_set<Time*> MarkedTimes;
     /**
      *  Record of outstanding Time objects which will need conversion
      *  when the resolution is set.
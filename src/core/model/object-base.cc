@@ -83,6 +83,9 @@ ObjectBase::ConstructSelf(const AttributeConstructionList& attributes)
     // loop over the inheritance tree back to the Object base class.
     NS_LOG_FUNCTION(this << &attributes);
     TypeId tid = GetInstanceTypeId();
+    // Look for the attribute defaults in the environment only if it sets some.
+    auto envDefaults = EnvironmentVariable::GetDictionary("NS_ATTRIBUTE_DEFAULT");
+    bool hasEnvDefaults = envDefaults->Get().first;
     do // Do this tid and all parents
     {
         // loop over all attributes in object type
@@ -119,11 +122,10 @@ ObjectBase::ConstructSelf(const AttributeConstructionList& attributes)
                 }
             }
 
-            if (!value)
+            if (!value && hasEnvDefaults)
             {
                 NS_LOG_DEBUG("trying to set from environment variable NS_ATTRIBUTE_DEFAULT");
-                auto [found, val] =
-                    EnvironmentVariable::Get("NS_ATTRIBUTE_DEFAULT", tid.GetAttributeFullName(i));
+                auto [found, val] = envDefaults->Get(tid.GetAttributeFullName(i));
                 if (found)
                 {
                     NS_LOG_DEBUG("found in environment: " << val);
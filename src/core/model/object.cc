@@ -97,11 +97,10 @@ Object::Object()
     : m_tid(Object::GetTypeId()),
       m_disposed(false),
       m_initialized(false),
-      m_aggregates((Aggregates*)std::malloc(sizeof(Aggregates))),
+      m_aggregates(AllocateAggregates(1)),
       m_getObjectCount(0)
 {
     NS_LOG_FUNCTION(this);
-    m_aggregates->n = 1;
     m_aggregates->buffer[0] = this;
 }
 
@@ -121,11 +120,22 @@ Object::~Object()
             m_aggregates->n--;
         }
     }
+    // the remaining objects must not find this one in the cache
+    if (m_aggregates->cache != nullptr)
+    {
+        for (uint32_t i = 0; i < CACHE_SLOT_COUNT; i++)
+        {
+            if (m_aggregates->cache[i] == this)
+            {
+                m_aggregates->cache[i] = nullptr;
+            }
+        }
+    }
     // finally, if all objects have been removed from the list,
     // delete the aggregate list
     if (m_aggregates->n == 0)
     {
-        std::free(m_aggregates);
+        FreeAggregates(m_aggregates);
     }
     m_aggregates = nullptr;
     m_unidirectionalAggregates.clear();
@@ -135,10 +145,9 @@ Object::Object(const Object& o)
     : m_tid(o.m_tid),
       m_disposed(false),
       m_initialized(false),
-      m_aggregates((Aggregates*)std::malloc(sizeof(Aggregates))),
+      m_aggregates(AllocateAggregates(1)),
       m_getObjectCount(0)
 {
-    m_aggregates->n = 1;
     m_aggregates->buffer[0] = this;
 }
 
@@ -199,6 +208,45 @@ Object::DoGetObject(TypeId tid) const
     return nullptr;
 }
 
+Object*
+Object::DoGetCachedObject(TypeId tid, uint8_t slot) const
+{
+    NS_LOG_FUNCTION(this << tid << +slot);
+    NS_ASSERT(slot < CACHE_SLOT_COUNT);
+
+    Ptr<Object> found = DoGetObject(tid);
+    if (!found)
+    {
+        return nullptr;
+    }
+    // A unidirectional aggregate has its own aggregates buffer.
+    if (found->m_aggregates == m_aggregates)
+    {
+        if (m_aggregates->cache == nullptr)
+        {
+            m_aggregates->cache = (Object**)std::calloc(CACHE_SLOT_COUNT, sizeof(Object*));
+        }
+        m_aggregates->cache[slot] = PeekPointer(found);
+    }
+    return PeekPointer(found);
+}
+
+Object::Aggregates*
+Object::AllocateAggregates(uint32_t n)
+{
+    auto aggregates = (Aggregates*)std::malloc(sizeof(Aggregates) + (n - 1) * sizeof(Object*));
+    aggregates->n = n;
+    aggregates->cache = nullptr;
+    return aggregates;
+}
+
+void
+Object::FreeAggregates(Aggregates* aggregates)
+{
+    std::free(aggregates->cache);
+    std::free(aggregates);
+}
+
 void
 Object::Initialize()
 {
@@ -306,8 +354,8 @@ Object::AggregateObject(Ptr<Object> o)
     Object* other = PeekPointer(o);
     // first create the new aggregate buffer.
     uint32_t total = m_aggregates->n + other->m_aggregates->n;
-    auto aggregates = (Aggregates*)std::malloc(sizeof(Aggregates) + (total - 1) * sizeof(Object*));
-    aggregates->n = total;
+    // the new buffer starts with an empty cache.
+    Aggregates* aggregates = AllocateAggregates(total);
 
     // copy our buffer to the new buffer
     std::memcpy(&aggregates->buffer[0],
@@ -360,8 +408,8 @@ Object::AggregateObject(Ptr<Object> o)
     }
 
     // Now that we are done with them, we can free our old aggregate buffers
-    std::free(a);
-    std::free(b);
+    FreeAggregates(a);
+    FreeAggregates(b);
 }
 
 void
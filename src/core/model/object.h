@@ -137,10 +137,35 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
 
     TypeId GetInstanceTypeId() const final;
 
+    /**
+     * Slots of the aggregation cache.
+     *
+     * The interfaces most often looked up on the packet paths have a slot
+     * in a direct-mapped cache shared by the aggregated Objects; a type \c T
+     * is assigned a slot by a specialization of ObjectCacheSlot<T>.
+     */
+    enum CacheSlot : uint8_t
+    {
+        CACHE_SLOT_IPV4 = 0,        //!< ns3::Ipv4
+        CACHE_SLOT_IPV4_L3,         //!< ns3::Ipv4L3Protocol
+        CACHE_SLOT_IPV6,            //!< ns3::Ipv6
+        CACHE_SLOT_IPV6_L3,         //!< ns3::Ipv6L3Protocol
+        CACHE_SLOT_TCP,             //!< ns3::TcpL4Protocol
+        CACHE_SLOT_UDP,             //!< ns3::UdpL4Protocol
+        CACHE_SLOT_ARP,             //!< ns3::ArpL3Protocol
+        CACHE_SLOT_TRAFFIC_CONTROL, //!< ns3::TrafficControlLayer
+        CACHE_SLOT_COUNT            //!< Number of slots
+    };
+
     /**
      * Get a pointer to the requested aggregated Object.  If the type of object
      * requested is ns3::Object, a Ptr to the calling object is returned.
      *
+     * If \c T has a slot in the aggregation cache (see ObjectCacheSlot),
+     * the first lookup stores the Object found in that slot, and the
+     * following lookups only read the slot, until another Object is
+     * aggregated.
+     *
      * @tparam T \explicit The type of the aggregated Object to retrieve.
      * @returns A pointer to the requested Object, or zero
      *          if it could not be found.
@@ -376,6 +401,11 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
     {
         /** The number of entries in \c buffer. */
         uint32_t n;
+        /**
+         * The aggregation cache, indexed by CacheSlot, or nullptr until
+         * the first lookup of a type with a slot.
+         */
+        Object** cache;
         /** The array of Objects. */
         Object* buffer[1];
     };
@@ -387,6 +417,30 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
      * @return The matching Object, if it is found
      */
     Ptr<Object> DoGetObject(TypeId tid) const;
+    /**
+     * Find an Object of TypeId tid in the aggregates of this Object,
+     * and store it in a slot of the aggregation cache.
+     *
+     * Only the Objects of the aggregates buffer, which is shared by all
+     * the aggregated Objects, are cached: the unidirectional aggregates
+     * are specific to this Object.
+     *
+     * @param [in] tid The TypeId we're looking for
+     * @param [in] slot The cache slot of tid
+     * @return The matching Object, if it is found
+     */
+    Object* DoGetCachedObject(TypeId tid, uint8_t slot) const;
+    /**
+     * Allocate an empty aggregates buffer.
+     * @param [in] n The number of entries.
+     * @return The buffer, without cache.
+     */
+    static Aggregates* AllocateAggregates(uint32_t n);
+    /**
+     * Free an aggregates buffer and its cache.
+     * @param [in] aggregates The buffer.
+     */
+    static void FreeAggregates(Aggregates* aggregates);
     /**
      * Verify that this Object is still live, by checking it's reference count.
      * @return \c true if the reference count is non zero.
@@ -486,6 +540,29 @@ class Object : public SimpleRefCount<Object, ObjectBase, ObjectDeleter>
     uint32_t m_getObjectCount;
 };
 
+/**
+ * @ingroup object
+ * @brief Slot of a type in the aggregation cache of Object::GetObject().
+ *
+ * Types without a specialization of this trait are not cached.
+ * A specialization is declared after the class of the type:
+ *
+ * @code
+ * template <>
+ * struct ObjectCacheSlot<Ipv4>
+ * {
+ *     static constexpr uint8_t index = Object::CACHE_SLOT_IPV4;
+ * };
+ * @endcode
+ *
+ * @tparam T \explicit The aggregated type.
+ */
+template <typename T>
+struct ObjectCacheSlot
+{
+    static constexpr uint8_t index = Object::CACHE_SLOT_COUNT; //!< The slot
+};
+
 template <typename T>
 Ptr<T> CopyObject(Ptr<const T> object);
 template <typename T>
@@ -510,6 +587,17 @@ template <typename T>
 Ptr<T>
 Object::GetObject() const
 {
+    if constexpr (ObjectCacheSlot<T>::index < CACHE_SLOT_COUNT)
+    {
+        constexpr uint8_t slot = ObjectCacheSlot<T>::index;
+        Object** cache = m_aggregates->cache;
+        Object* result = (cache != nullptr) ? cache[slot] : nullptr;
+        if (result == nullptr)
+        {
+            result = DoGetCachedObject(T::GetTypeId(), slot);
+        }
+        return Ptr<T>(static_cast<T*>(result));
+    }
     // This is an optimization: if the cast works (which is likely),
     // things will be pretty fast.
     T* result = dynamic_cast<T*>(m_aggregates->buffer[0]);
@@ -11,6 +11,7 @@
 #include "object-factory.h"
 
 #include <sstream>
+#include <unordered_map>
 
 /**
  * @file
@@ -23,6 +24,9 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Pointer");
 
+/** Maximum number of factories kept by PointerValue::DeserializeFromString(). */
+static constexpr std::size_t FACTORY_CACHE_SIZE = 256;
+
 PointerValue::PointerValue()
     : m_value()
 {
@@ -72,6 +76,17 @@ PointerValue::DeserializeFromString(std::string value, Ptr<const AttributeChecke
     // a description for an ObjectFactory to create an object and then assign it to the
     // member variable.
     NS_LOG_FUNCTION(this << value << checker);
+    // The initial values of the pointer attributes are deserialized on the
+    // construction of every object which holds them, so remember the parsed
+    // factories.  A factory with nested objects is parsed again each time,
+    // since its parsing creates the nested objects.
+    static thread_local std::unordered_map<std::string, ObjectFactory> factories;
+    auto it = factories.find(value);
+    if (it != factories.end())
+    {
+        m_value = it->second.Create<Object>();
+        return true;
+    }
     ObjectFactory factory;
     std::istringstream iss;
     iss.str(value);
@@ -80,6 +95,14 @@ PointerValue::DeserializeFromString(std::string value, Ptr<const AttributeChecke
     {
         return false;
     }
+    if (value.find('[') == value.rfind('['))
+    {
+        if (factories.size() >= FACTORY_CACHE_SIZE)
+        {
+            factories.clear();
+        }
+        factories.emplace(value, factory);
+    }
     m_value = factory.Create<Object>();
     return true;
 }
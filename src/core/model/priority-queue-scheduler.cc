@@ -102,4 +102,31 @@ PriorityQueueScheduler::Remove(const Scheduler::Event& ev)
     m_queue.remove(ev);
 }
 
+void
+PriorityQueueScheduler::EventPriorityQueue::removeCancelled(
+    std::vector<Scheduler::Event>& cancelled)
+{
+    auto last = this->c.begin();
+    for (auto it = this->c.begin(); it != this->c.end(); ++it)
+    {
+        if (it->impl->IsCancelled())
+        {
+            cancelled.push_back(*it);
+        }
+        else
+        {
+            *last++ = *it;
+        }
+    }
+    this->c.erase(last, this->c.end());
+    std::make_heap(this->c.begin(), this->c.end(), this->comp);
+}
+
+void
+PriorityQueueScheduler::RemoveCancelled(std::vector<Scheduler::Event>& cancelled)
+{
+    NS_LOG_FUNCTION(this);
+    m_queue.removeCancelled(cancelled);
+}
+
 } // namespace ns3
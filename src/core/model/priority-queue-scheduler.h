@@ -71,6 +71,7 @@ class PriorityQueueScheduler : public Scheduler
     Scheduler::Event PeekNext() const override;
     Scheduler::Event RemoveNext() override;
     void Remove(const Scheduler::Event& ev) override;
+    void RemoveCancelled(std::vector<Scheduler::Event>& cancelled) override;
 
   private:
     /**
@@ -87,6 +88,10 @@ class PriorityQueueScheduler : public Scheduler
          * @returns \c true if the event was found, false otherwise.
          */
         bool remove(const Scheduler::Event& ev);
+        /**
+         * @copydoc PriorityQueueScheduler::RemoveCancelled()
+         */
+        void removeCancelled(std::vector<Scheduler::Event>& cancelled);
 
         // end of class EventPriorityQueue
     };
@@ -68,7 +68,10 @@ RandomVariableStream::GetTypeId()
 }
 
 RandomVariableStream::RandomVariableStream()
-    : m_rng(nullptr)
+    : m_rng(nullptr),
+      m_rngSeed(0),
+      m_rngStream(0),
+      m_rngRun(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -107,6 +110,9 @@ RandomVariableStream::SetStream(int64_t stream)
     // negative values are not legal.
     NS_ASSERT(stream >= -1);
     delete m_rng;
+    m_rng = nullptr;
+    m_rngSeed = RngSeedManager::GetSeed();
+    m_rngRun = RngSeedManager::GetRun();
     if (stream == -1)
     {
         // The first 2^63 streams are reserved for automatic stream
@@ -114,7 +120,7 @@ RandomVariableStream::SetStream(int64_t stream)
         uint64_t nextStream = RngSeedManager::GetNextStreamIndex();
         NS_ASSERT(nextStream <= ((1ULL) << 63));
         NS_LOG_INFO(GetInstanceTypeId().GetName() << " automatic stream: " << nextStream);
-        m_rng = new RngStream(RngSeedManager::GetSeed(), nextStream, RngSeedManager::GetRun());
+        m_rngStream = nextStream;
     }
     else
     {
@@ -123,7 +129,7 @@ RandomVariableStream::SetStream(int64_t stream)
         uint64_t base = ((1ULL) << 63);
         uint64_t target = base + stream;
         NS_LOG_INFO(GetInstanceTypeId().GetName() << " configured stream: " << stream);
-        m_rng = new RngStream(RngSeedManager::GetSeed(), target, RngSeedManager::GetRun());
+        m_rngStream = target;
     }
     m_stream = stream;
 }
@@ -137,6 +143,10 @@ RandomVariableStream::GetStream() const
 RngStream*
 RandomVariableStream::Peek() const
 {
+    if (m_rng == nullptr)
+    {
+        m_rng = new RngStream(m_rngSeed, m_rngStream, m_rngRun);
+    }
     return m_rng;
 }
 
@@ -146,13 +146,28 @@ class RandomVariableStream : public Object
   protected:
     /**
      * @brief Get the pointer to the underlying RngStream.
+     *
+     * The RngStream is created on the first call, from the seed, stream
+     * and run numbers recorded by SetStream(), so that the variables
+     * which never draw a value, or whose stream is reassigned before the
+     * first draw, do not pay for the computation of its state.
+     *
      * @return The underlying RngStream
      */
     RngStream* Peek() const;
 
   private:
-    /** Pointer to the underlying RngStream. */
-    RngStream* m_rng;
+    /** Pointer to the underlying RngStream, created on the first draw. */
+    mutable RngStream* m_rng;
+
+    /** The seed of the RngStream. */
+    uint32_t m_rngSeed;
+
+    /** The index of the RngStream. */
+    uint64_t m_rngStream;
+
+    /** The run number of the RngStream. */
+    uint64_t m_rngRun;
 
     /** Indicates if antithetic values should be generated by this RNG stream. */
     bool m_isAntithetic;
@@ -690,6 +690,12 @@ RealtimeSimulatorImpl::GetDelayLeft(const EventId& id) const
 void
 RealtimeSimulatorImpl::Remove(const EventId& id)
 {
+    if (id.GetUid() == EventId::UID::WHEEL)
+    {
+        // timer wheel events are not in the event list until they are due.
+        Cancel(id);
+        return;
+    }
     if (id.GetUid() == EventId::UID::DESTROY)
     {
         // destroy events.
@@ -9,6 +9,7 @@
 #include "scheduler.h"
 
 #include "assert.h"
+#include "event-impl.h"
 #include "log.h"
 
 /**
@@ -36,4 +37,27 @@ Scheduler::GetTypeId()
     return tid;
 }
 
+void
+Scheduler::RemoveCancelled(std::vector<Event>& cancelled)
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<Event> live;
+    while (!IsEmpty())
+    {
+        Event ev = RemoveNext();
+        if (ev.impl->IsCancelled())
+        {
+            cancelled.push_back(ev);
+        }
+        else
+        {
+            live.push_back(ev);
+        }
+    }
+    for (const auto& ev : live)
+    {
+        Insert(ev);
+    }
+}
+
 } // namespace ns3
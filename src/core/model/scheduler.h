@@ -12,6 +12,7 @@
 #include "object.h"
 
 #include <stdint.h>
+#include <vector>
 
 /**
  * @file
@@ -60,6 +61,8 @@ class EventImpl;
  * rely heavily on Scheduler::Cancel, however, and these might benefit
  * from using Scheduler::Remove instead, to reduce the size of the event
  * list, at the time cost of actually removing events from the list.
+ * Alternatively, the simulator can periodically purge the cancelled
+ * events in bulk with Scheduler::RemoveCancelled.
  *
  * A summary of the main characteristics
  * of each SchedulerImpl is provided below.  See the individual
@@ -100,6 +103,14 @@ class EventImpl;
  *      <td class="markdownTableBodyLeft"> 0 </td>
  * </tr>
  * <tr class="markdownTableBody">
+ *      <td class="markdownTableBodyLeft"> LadderScheduler </td>
+ *      <td class="markdownTableBodyLeft"> `std::vector<std::vector>` tiers </td>
+ *      <td class="markdownTableBodyLeft"> Constant </td>
+ *      <td class="markdownTableBodyLeft"> Constant </td>
+ *      <td class="markdownTableBodyLeft"> ~ 500 bytes </td>
+ *      <td class="markdownTableBodyLeft"> 24 bytes </td>
+ * </tr>
+ * <tr class="markdownTableBody">
  *      <td class="markdownTableBodyLeft"> ListScheduler </td>
  *      <td class="markdownTableBodyLeft"> `std::list` </td>
  *      <td class="markdownTableBodyLeft"> Linear </td>
@@ -215,6 +226,19 @@ class Scheduler : public Object
      * @param [in] ev The event to remove
      */
     virtual void Remove(const Event& ev) = 0;
+    /**
+     * Remove all the cancelled events from the event list.
+     *
+     * The default implementation drains the event list and inserts back
+     * the events which have not been cancelled.  Subclasses should
+     * override it with an in-place filter when they can.
+     *
+     * As with Remove(), the caller is responsible for releasing the
+     * removed events.
+     *
+     * @param [out] cancelled The removed events are appended to this vector.
+     */
+    virtual void RemoveCancelled(std::vector<Event>& cancelled);
 };
 
 /**
@@ -102,6 +102,7 @@ SimulationSingleton<T>::DeleteObject()
     T** ppobject = GetObject();
     delete (*ppobject);
     *ppobject = nullptr;
+    *ppobject = nullptr;
 }
 
 } // namespace ns3
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "startup-timer.h"
+
+#include <iomanip>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * @file
+ * @ingroup system
+ * ns3::StartupTimer implementation.
+ */
+
+namespace ns3
+{
+
+namespace
+{
+
+/** The phases timed so far. */
+struct StartupPhases
+{
+    std::mutex mutex;                                     //!< Protect the phases
+    std::vector<StartupTimer::Phase> phases;              //!< The phases, in order
+    std::unordered_map<std::string, std::size_t> indexes; //!< The phases, by name
+    uint64_t generation{0};                               //!< The number of resets
+};
+
+/**
+ * Get the phases timed so far.
+ * @returns The phases.
+ */
+StartupPhases&
+GetStartupPhases()
+{
+    static StartupPhases phases;
+    return phases;
+}
+
+} // unnamed namespace
+
+StartupTimer::StartupTimer(const std::string& phase)
+{
+    auto& phases = GetStartupPhases();
+    {
+        std::unique_lock lock{phases.mutex};
+        auto [it, inserted] = phases.indexes.emplace(phase, phases.phases.size());
+        if (inserted)
+        {
+            phases.phases.push_back({phase, 0, 0});
+        }
+        m_phase = it->second;
+        m_generation = phases.generation;
+    }
+    m_start = std::chrono::steady_clock::now();
+}
+
+StartupTimer::~StartupTimer()
+{
+    auto elapsed = std::chrono::steady_clock::now() - m_start;
+    auto& phases = GetStartupPhases();
+    std::unique_lock lock{phases.mutex};
+    if (m_generation == phases.generation)
+    {
+        auto& phase = phases.phases[m_phase];
+        phase.count++;
+        phase.nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    }
+}
+
+std::vector<StartupTimer::Phase>
+StartupTimer::GetPhases()
+{
+    auto& phases = GetStartupPhases();
+    std::unique_lock lock{phases.mutex};
+    return phases.phases;
+}
+
+void
+StartupTimer::Print(std::ostream& os)
+{
+    auto flags = os.flags();
+    for (const auto& phase : GetPhases())
+    {
+        os << std::left << std::setw(50) << phase.name << std::right << std::setw(8)
+           << phase.count << " calls " << std::fixed << std::setprecision(3) << std::setw(12)
+           << phase.nanoseconds / 1e6 << " ms" << std::endl;
+    }
+    os.flags(flags);
+}
+
+void
+StartupTimer::Reset()
+{
+    auto& phases = GetStartupPhases();
+    std::unique_lock lock{phases.mutex};
+    phases.phases.clear();
+    phases.indexes.clear();
+    phases.generation++;
+}
+
+} // namespace ns3
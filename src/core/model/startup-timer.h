@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef STARTUP_TIMER_H
+#define STARTUP_TIMER_H
+
+/**
+ * @file
+ * @ingroup system
+ * ns3::StartupTimer declaration.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup system
+ * @brief Account the wall-clock time spent in the phases of the set up
+ * of a simulation.
+ *
+ * A StartupTimer measures the time from its construction to its
+ * destruction, and adds it to the total of its phase.  The topology
+ * helpers time their bulk operations, such as
+ * InternetStackHelper::Install(NodeContainer) or
+ * Ipv4GlobalRoutingHelper::PopulateRoutingTables(), and a script can
+ * time its own phases the same way:
+ *
+ * @code
+ *   {
+ *       StartupTimer timer("Applications");
+ *       // install the applications
+ *   }
+ *   StartupTimer::Print(std::cout);
+ * @endcode
+ *
+ * The time of a phase includes the time of the phases nested in it.
+ */
+class StartupTimer
+{
+  public:
+    /**
+     * Start timing a phase.
+     * @param [in] phase The name of the phase.
+     */
+    StartupTimer(const std::string& phase);
+
+    /** Stop timing, and add the time to the total of the phase. */
+    ~StartupTimer();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    StartupTimer(const StartupTimer&) = delete;
+    StartupTimer& operator=(const StartupTimer&) = delete;
+
+    /** The time spent in a phase. */
+    struct Phase
+    {
+        std::string name;    //!< The name of the phase
+        uint32_t count;      //!< The number of times the phase was timed
+        int64_t nanoseconds; //!< The total time spent in the phase
+    };
+
+    /**
+     * Get the time spent in each phase.
+     * @returns The phases, in the order of their first timing.
+     */
+    static std::vector<Phase> GetPhases();
+
+    /**
+     * Print the time spent in each phase, one phase per line.
+     * @param [in,out] os The output stream.
+     */
+    static void Print(std::ostream& os);
+
+    /**
+     * Forget the time spent in all the phases.
+     *
+     * The timers running during the call are ignored.
+     */
+    static void Reset();
+
+  private:
+    std::size_t m_phase;                           //!< The index of the phase
+    uint64_t m_generation;                         //!< The number of resets at the start
+    std::chrono::steady_clock::time_point m_start; //!< The start time
+};
+
+} // namespace ns3
+
+#endif /* STARTUP_TIMER_H */
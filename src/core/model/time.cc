@@ -343,11 +343,9 @@ Time::Clear(Time* const time)
 
     if (g_markingTimes)
     {
-        NS_ASSERT_MSG(g_markingTimes->count(time) == 1,
-                      "Time object " << time << " registered " << g_markingTimes->count(time)
-                                     << " times (should be 1).");
-
         MarkedTimes::size_type num = g_markingTimes->erase(time);
+        NS_ASSERT_MSG(num == 1,
+                      "Time object " << time << " registered " << num << " times (should be 1).");
         if (num != 1)
         {
             NS_LOG_WARN("unexpected result erasing " << time << "!");
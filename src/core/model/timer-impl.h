@@ -11,6 +11,7 @@
 
 #include "fatal-error.h"
 #include "simulator.h"
+#include "timer-wheel.h"
 
 #include <type_traits>
 
@@ -55,6 +56,14 @@ class TimerImpl
      * @returns The scheduled EventId.
      */
     virtual EventId Schedule(const Time& delay) = 0;
+    /**
+     * Schedule the callback for a future time on a TimerWheel.
+     *
+     * @param [in] wheel The timer wheel.
+     * @param [in] delay The amount of time until the timer expires.
+     * @returns The scheduled EventId.
+     */
+    virtual EventId Schedule(TimerWheel& wheel, const Time& delay) = 0;
     /** Invoke the expire function. */
     virtual void Invoke() = 0;
 };
@@ -110,6 +119,13 @@ MakeTimerImpl(U(fn)(Ts...))
                 m_arguments);
         }
 
+        EventId Schedule(TimerWheel& wheel, const Time& delay) override
+        {
+            return std::apply(
+                [&, this](Ts... args) { return wheel.Schedule(delay, m_fn, args...); },
+                m_arguments);
+        }
+
         void Invoke() override
         {
             std::apply([this](Ts... args) { (m_fn)(args...); }, m_arguments);
@@ -159,6 +175,15 @@ MakeTimerImpl(U (V::*memPtr)(Ts...), OBJ_PTR objPtr)
                 m_arguments);
         }
 
+        EventId Schedule(TimerWheel& wheel, const Time& delay) override
+        {
+            return std::apply(
+                [&, this](Ts... args) {
+                    return wheel.Schedule(delay, std::bind(m_memPtr, args...));
+                },
+                m_arguments);
+        }
+
         void Invoke() override
         {
             std::apply(m_memPtr, m_arguments);
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "timer-wheel.h"
+
+#include "abort.h"
+#include "assert.h"
+#include "event-impl.h"
+#include "log.h"
+#include "simulation-singleton.h"
+#include "simulator.h"
+
+#include <algorithm>
+
+/**
+ * @file
+ * @ingroup timer
+ * ns3::TimerWheel implementation.
+ */
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("TimerWheel");
+
+namespace
+{
+
+/**
+ * @ingroup timer
+ * The event of a timer held by the TimerWheel.
+ *
+ * The EventId returned by TimerWheel::Schedule refers to this event,
+ * which is also the event eventually inserted in the simulator event
+ * list.  It marks itself as cancelled before invoking the timer, so
+ * that the EventId reports the timer as expired from the timer
+ * function on, as for events scheduled with Simulator::Schedule.
+ */
+class TimerWheelEvent : public EventImpl
+{
+  public:
+    /**
+     * Constructor.
+     * @param [in] event The timer event.
+     */
+    TimerWheelEvent(EventImpl* event)
+        : m_event(event, false)
+    {
+    }
+
+  private:
+    void Notify() override
+    {
+        Cancel();
+        m_event->Invoke();
+    }
+
+    Ptr<EventImpl> m_event; //!< The timer event.
+};
+
+} // unnamed namespace
+
+TimerWheel::TimerWheel()
+    : m_slots(LEVELS * SLOTS),
+      m_granularity(MilliSeconds(1).GetTimeStep()),
+      m_size(0),
+      m_stats()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+TimerWheel::~TimerWheel()
+{
+    NS_LOG_FUNCTION(this);
+    for (auto& slot : m_slots)
+    {
+        slot.event.Cancel();
+    }
+}
+
+TimerWheel*
+TimerWheel::Get()
+{
+    return SimulationSingleton<TimerWheel>::Get();
+}
+
+void
+TimerWheel::SetGranularity(const Time& granularity)
+{
+    NS_LOG_FUNCTION(this << granularity);
+    NS_ABORT_MSG_IF(m_size != 0, "Cannot change the granularity of a non-empty timer wheel");
+    NS_ABORT_MSG_IF(!granularity.IsStrictlyPositive(), "Invalid timer wheel granularity");
+    m_granularity = granularity.GetTimeStep();
+}
+
+Time
+TimerWheel::GetGranularity() const
+{
+    return TimeStep(m_granularity);
+}
+
+EventId
+TimerWheel::Schedule(const Time& delay, EventImpl* event)
+{
+    NS_LOG_FUNCTION(this << delay << event);
+    NS_ASSERT_MSG(!delay.IsStrictlyNegative(), "TimerWheel::Schedule(): negative delay");
+
+    Entry entry;
+    entry.ts = Simulator::Now().GetTimeStep() + delay.GetTimeStep();
+    entry.context = Simulator::GetContext();
+    entry.event = Create<TimerWheelEvent>(event);
+    m_stats.scheduled++;
+    Insert(entry);
+    return EventId(entry.event, entry.ts, entry.context, EventId::UID::WHEEL);
+}
+
+void
+TimerWheel::Insert(const Entry& entry)
+{
+    uint64_t now = Simulator::Now().GetTimeStep();
+    NS_ASSERT(entry.ts >= now);
+
+    uint64_t width = m_granularity;
+    for (uint32_t level = 0; level < LEVELS; ++level, width *= SLOTS)
+    {
+        uint64_t slot = entry.ts / width;
+        uint64_t current = now / width;
+        if (slot == current)
+        {
+            // Only possible on level 0, since the timer would have fit
+            // the previous level otherwise: the timer is due soon.
+            NS_ASSERT(level == 0);
+            m_stats.posted++;
+            Simulator::ScheduleWithContext(entry.context,
+                                           TimeStep(entry.ts - now),
+                                           GetPointer(entry.event));
+            return;
+        }
+        if (slot - current >= SLOTS && level != LEVELS - 1)
+        {
+            continue;
+        }
+        // Timers beyond the horizon of the wheel wait in its last slot,
+        // and are inserted again when it expires.
+        slot = std::min(slot, current + SLOTS - 1);
+        uint32_t index = level * SLOTS + slot % SLOTS;
+        Slot& s = m_slots[index];
+        s.entries.push_back(entry);
+        m_size++;
+        if (!s.event.IsPending())
+        {
+            NS_LOG_LOGIC("schedule slot " << index << " at " << slot * width);
+            m_stats.slotEvents++;
+            s.event = Simulator::Schedule(TimeStep(slot * width - now),
+                                          &TimerWheel::ExpireSlot,
+                                          this,
+                                          index);
+        }
+        return;
+    }
+}
+
+void
+TimerWheel::ExpireSlot(uint32_t index)
+{
+    NS_LOG_FUNCTION(this << index);
+
+    // Swap with the scratch vector, rather than move, so that the
+    // storage of both vectors is reused.
+    m_expiring.swap(m_slots[index].entries);
+    m_size -= m_expiring.size();
+    for (const auto& entry : m_expiring)
+    {
+        if (entry.event->IsCancelled())
+        {
+            m_stats.dropped++;
+            continue;
+        }
+        m_stats.cascaded++;
+        Insert(entry);
+    }
+    m_expiring.clear();
+}
+
+uint64_t
+TimerWheel::GetSize() const
+{
+    return m_size;
+}
+
+TimerWheel::Stats
+TimerWheel::GetStats() const
+{
+    return m_stats;
+}
+
+} // namespace ns3
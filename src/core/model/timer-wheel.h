@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include "event-id.h"
+#include "make-event.h"
+#include "nstime.h"
+#include "ptr.h"
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup timer
+ * ns3::TimerWheel declaration.
+ */
+
+namespace ns3
+{
+
+class EventImpl;
+
+/**
+ * @ingroup timer
+ * @brief A hierarchical timer wheel for frequently rescheduled timers.
+ *
+ * Protocol timers such as retransmission or delayed acknowledgment
+ * timeouts are cancelled and scheduled again far more often than they
+ * expire.  With Simulator::Schedule every such move costs an insertion
+ * in the event list, and leaves a cancelled event behind.
+ *
+ * A timer scheduled with TimerWheel::Schedule() is instead appended to
+ * a slot of a hierarchical timing wheel, in constant time.  The wheel
+ * has `LEVELS` levels of `SLOTS` slots; the slots of level 0 span
+ * the wheel granularity, and those of each higher level span `SLOTS`
+ * slots of the level below.  Only one representative event is
+ * scheduled in the simulator event list for each non-empty slot, at the
+ * start of the slot.  When it runs, the timers of the slot are moved to
+ * the finer level they now belong to, and the timers due within the
+ * current level 0 slot are handed to the simulator at their exact
+ * expiration time.  Timers cancelled in the meantime are just dropped.
+ * The expiration times are thus exact, whatever the granularity.
+ *
+ * The returned EventId can be used as any other EventId: cancelling it,
+ * or asking whether it is pending or expired, behaves as for an event
+ * scheduled with Simulator::Schedule.  Removing it is equivalent to
+ * cancelling it.  However, the execution order of timers expiring at the
+ * same time stamp as other events is not guaranteed to follow the order
+ * of the Schedule calls.
+ *
+ * There is a single wheel per simulation, returned by Get(), which
+ * is deleted by Simulator::Destroy.
+ *
+ * @see Timer::SetTimerWheel
+ */
+class TimerWheel
+{
+  public:
+    /** Number of slots per level. */
+    static constexpr uint32_t SLOTS = 256;
+    /** Number of levels. */
+    static constexpr uint32_t LEVELS = 4;
+
+    /** Timer wheel statistics. */
+    struct Stats
+    {
+        uint64_t scheduled;  /**< Timers scheduled on the wheel. */
+        uint64_t slotEvents; /**< Representative events scheduled in the simulator. */
+        uint64_t cascaded;   /**< Timers taken out of an expiring slot. */
+        uint64_t posted;     /**< Timers handed to the simulator at their expiration time. */
+        uint64_t dropped;    /**< Cancelled timers discarded by the wheel. */
+    };
+
+    /** Constructor. */
+    TimerWheel();
+    /** Destructor. */
+    ~TimerWheel();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /**
+     * Get the timer wheel of the current simulation.
+     * @returns The timer wheel.
+     */
+    static TimerWheel* Get();
+
+    /**
+     * Set the duration of the slots of level 0.
+     *
+     * The granularity does not affect the expiration times; it trades
+     * the number of representative events against the number of timers
+     * moved when a slot expires.  It can only be changed while no timer
+     * is pending on the wheel.
+     *
+     * @param [in] granularity The slot duration, 1 ms by default.
+     */
+    void SetGranularity(const Time& granularity);
+    /**
+     * Get the duration of the slots of level 0.
+     * @returns The slot duration.
+     */
+    Time GetGranularity() const;
+
+    /**
+     * Schedule a timer to expire after a delay.
+     *
+     * @tparam FUNC \deduced The type of the function or method to invoke.
+     * @tparam Ts \deduced Argument types.
+     * @param [in] delay The relative expiration time of the timer.
+     * @param [in] f The function or member function to invoke.
+     * @param [in] args Arguments to pass to MakeEvent.
+     * @returns The id of the timer.
+     */
+    template <typename FUNC, typename... Ts>
+    EventId Schedule(const Time& delay, FUNC f, Ts&&... args);
+
+    /**
+     * Schedule a timer to expire after a delay.
+     *
+     * @tparam Us \deduced Formal function argument types.
+     * @tparam Ts \deduced Actual function argument types.
+     * @param [in] delay The relative expiration time of the timer.
+     * @param [in] f The function to invoke.
+     * @param [in] args Arguments to pass to the invoked function.
+     * @returns The id of the timer.
+     */
+    template <typename... Us, typename... Ts>
+    EventId Schedule(const Time& delay, void (*f)(Us...), Ts&&... args);
+
+    /**
+     * Schedule a timer to expire after a delay.
+     *
+     * @param [in] delay The relative expiration time of the timer.
+     * @param [in] event The event to invoke; the wheel takes ownership.
+     * @returns The id of the timer.
+     */
+    EventId Schedule(const Time& delay, EventImpl* event);
+
+    /**
+     * Get the number of timers held by the wheel, including cancelled
+     * timers not discarded yet.
+     * @returns The number of timers.
+     */
+    uint64_t GetSize() const;
+    /**
+     * Get the timer wheel statistics.
+     * @returns The statistics.
+     */
+    Stats GetStats() const;
+
+  private:
+    /** A timer held in a slot. */
+    struct Entry
+    {
+        uint64_t ts;          /**< Expiration time, in time steps. */
+        uint32_t context;     /**< Context of the Schedule call. */
+        Ptr<EventImpl> event; /**< The timer event. */
+    };
+
+    /** A wheel slot. */
+    struct Slot
+    {
+        std::vector<Entry> entries; /**< The timers of the slot. */
+        EventId event;              /**< The representative event of the slot. */
+    };
+
+    /**
+     * Store a timer in the slot it belongs to, or hand it to the
+     * simulator if it expires in the current level 0 slot.
+     * @param [in] entry The timer.
+     */
+    void Insert(const Entry& entry);
+    /**
+     * Expire a slot: move its timers to the finer level they belong to.
+     * @param [in] index The index of the slot in m_slots.
+     */
+    void ExpireSlot(uint32_t index);
+
+    /** The slots, level by level. */
+    std::vector<Slot> m_slots;
+    /** Scratch storage for the timers of an expiring slot. */
+    std::vector<Entry> m_expiring;
+    /** The slot duration of level 0, in time steps. */
+    uint64_t m_granularity;
+    /** Number of timers in the slots. */
+    uint64_t m_size;
+    /** The statistics. */
+    Stats m_stats;
+};
+
+} // namespace ns3
+
+/********************************************************************
+ *  Implementation of the templates declared above.
+ ********************************************************************/
+
+namespace ns3
+{
+
+template <typename FUNC, typename... Ts>
+EventId
+TimerWheel::Schedule(const Time& delay, FUNC f, Ts&&... args)
+{
+    return Schedule(delay, MakeEvent(f, std::forward<Ts>(args)...));
+}
+
+template <typename... Us, typename... Ts>
+EventId
+TimerWheel::Schedule(const Time& delay, void (*f)(Us...), Ts&&... args)
+{
+    return Schedule(delay, MakeEvent(f, std::forward<Ts>(args)...));
+}
+
+} // namespace ns3
+
+#endif /* TIMER_WHEEL_H */
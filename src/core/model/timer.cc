@@ -10,6 +10,7 @@
 #include "log.h"
 #include "simulation-singleton.h"
 #include "simulator.h"
+#include "timer-wheel.h"
 
 /**
  * @file
@@ -75,6 +76,20 @@ Timer::GetDelay() const
     return m_delay;
 }
 
+void
+Timer::SetTimerWheel(bool useWheel)
+{
+    NS_LOG_FUNCTION(this << useWheel);
+    if (useWheel)
+    {
+        m_flags |= TIMER_WHEEL;
+    }
+    else
+    {
+        m_flags &= ~TIMER_WHEEL;
+    }
+}
+
 Time
 Timer::GetDelayLeft() const
 {
@@ -163,7 +178,20 @@ Timer::Schedule(Time delay)
     {
         NS_FATAL_ERROR("Event is still running while re-scheduling.");
     }
-    m_event = m_impl->Schedule(delay);
+    DoSchedule(delay);
+}
+
+void
+Timer::DoSchedule(const Time& delay)
+{
+    if (m_flags & TIMER_WHEEL)
+    {
+        m_event = m_impl->Schedule(*TimerWheel::Get(), delay);
+    }
+    else
+    {
+        m_event = m_impl->Schedule(delay);
+    }
 }
 
 void
@@ -188,7 +216,7 @@ Timer::Resume()
 {
     NS_LOG_FUNCTION(this);
     NS_ASSERT(m_flags & TIMER_SUSPENDED);
-    m_event = m_impl->Schedule(m_delayLeft);
+    DoSchedule(m_delayLeft);
     m_flags &= ~TIMER_SUSPENDED;
 }
 
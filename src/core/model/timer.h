@@ -157,6 +157,16 @@ class Timer
      * @returns The currently-configured delay for the next Schedule.
      */
     Time GetDelay() const;
+    /**
+     * @param [in] useWheel Whether to schedule the timer on the TimerWheel.
+     *
+     * When enabled, the next calls to Schedule and Resume store the timer
+     * in the TimerWheel instead of the simulator event list, which makes
+     * a Cancel followed by a Schedule a constant-time operation.  This
+     * suits timers rescheduled much more often than they expire.  The
+     * expiration time of the timer is unchanged.
+     */
+    void SetTimerWheel(bool useWheel);
     /**
      * @returns The amount of time left until this timer expires.
      *
@@ -228,9 +238,17 @@ class Timer
   private:
     /** Internal bit marking the suspended timer state */
     static constexpr auto TIMER_SUSPENDED{1 << 7};
+    /** Internal bit marking a timer scheduled on the TimerWheel */
+    static constexpr auto TIMER_WHEEL{1 << 8};
+
+    /**
+     * Schedule the timer event, on the TimerWheel if enabled.
+     * @param [in] delay The delay.
+     */
+    void DoSchedule(const Time& delay);
 
     /**
-     * Bitfield for Timer State, DestroyPolicy and InternalSuspended.
+     * Bitfield for Timer State, DestroyPolicy, InternalSuspended and TimerWheel.
      *
      * @internal
      * The DestroyPolicy, State and InternalSuspended state are stored
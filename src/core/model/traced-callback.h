@@ -12,6 +12,8 @@
 #include "callback.h"
 
 #include <list>
+#include <memory>
+#include <vector>
 
 /**
  * @file
@@ -36,6 +38,15 @@ namespace ns3
  * calling the \c operator() form with the appropriate
  * number of arguments.
  *
+ * The first Callback of the chain is stored in the TracedCallback
+ * itself, and the following ones in a vector allocated when a second
+ * Callback is connected.  Invoking a TracedCallback to which nothing is
+ * connected only tests whether the first Callback is null.
+ *
+ * If \c NS3_TRACING_DISABLE is defined, which the \c NS3_TRACING=OFF
+ * build option does in the non-debug builds, invoking a TracedCallback
+ * does nothing, and the Callbacks connected to it are never called.
+ *
  * @tparam Ts \explicit Types of the functor arguments.
  */
 template <typename... Ts>
@@ -44,6 +55,17 @@ class TracedCallback
   public:
     /** Constructor. */
     TracedCallback();
+    /**
+     * Copy constructor.
+     * @param [in] o The TracedCallback to copy.
+     */
+    TracedCallback(const TracedCallback& o);
+    /**
+     * Assignment operator.
+     * @param [in] o The TracedCallback to copy.
+     * @returns This TracedCallback.
+     */
+    TracedCallback& operator=(const TracedCallback& o);
     /**
      * Append a Callback to the chain (without a context).
      *
@@ -81,6 +103,11 @@ class TracedCallback
     void operator()(Ts... args) const;
     /**
      * @brief Checks if the Callbacks list is empty.
+     *
+     * If \c NS3_TRACING_DISABLE is defined, the list is always reported
+     * empty, so that the code preparing the arguments of a trace source
+     * can be skipped.
+     *
      * @return true if the Callbacks list is empty.
      */
     bool IsEmpty() const;
@@ -98,13 +125,22 @@ class TracedCallback
 
   private:
     /**
-     * Container type for holding the chain of Callbacks.
+     * Container type for holding the Callbacks after the first one.
      *
      * @tparam Ts \deduced Types of the functor arguments.
      */
-    typedef std::list<Callback<void, Ts...>> CallbackList;
-    /** The chain of Callbacks. */
-    CallbackList m_callbackList;
+    typedef std::vector<Callback<void, Ts...>> CallbackList;
+    /**
+     * Append a Callback to the chain.
+     *
+     * @param [in] callback Callback to add to chain.
+     */
+    void Append(const Callback<void, Ts...>& callback);
+
+    /** The first Callback of the chain, null if the chain is empty. */
+    Callback<void, Ts...> m_first;
+    /** The rest of the chain, or nullptr if it was never needed. */
+    std::unique_ptr<CallbackList> m_others;
 };
 
 } // namespace ns3
@@ -118,8 +154,44 @@ namespace ns3
 
 template <typename... Ts>
 TracedCallback<Ts...>::TracedCallback()
-    : m_callbackList()
+    : m_first(),
+      m_others()
+{
+}
+
+template <typename... Ts>
+TracedCallback<Ts...>::TracedCallback(const TracedCallback& o)
+    : m_first(o.m_first),
+      m_others(o.m_others ? std::make_unique<CallbackList>(*o.m_others) : nullptr)
+{
+}
+
+template <typename... Ts>
+TracedCallback<Ts...>&
+TracedCallback<Ts...>::operator=(const TracedCallback& o)
+{
+    if (this != &o)
+    {
+        m_first = o.m_first;
+        m_others = o.m_others ? std::make_unique<CallbackList>(*o.m_others) : nullptr;
+    }
+    return *this;
+}
+
+template <typename... Ts>
+void
+TracedCallback<Ts...>::Append(const Callback<void, Ts...>& callback)
 {
+    if (m_first.IsNull())
+    {
+        m_first = callback;
+        return;
+    }
+    if (!m_others)
+    {
+        m_others = std::make_unique<CallbackList>();
+    }
+    m_others->push_back(callback);
 }
 
 template <typename... Ts>
@@ -131,7 +203,7 @@ TracedCallback<Ts...>::ConnectWithoutContext(const CallbackBase& callback)
     {
         NS_FATAL_ERROR_NO_MSG();
     }
-    m_callbackList.push_back(cb);
+    Append(cb);
 }
 
 template <typename... Ts>
@@ -144,22 +216,38 @@ TracedCallback<Ts...>::Connect(const CallbackBase& callback, std::string path)
         NS_FATAL_ERROR("when connecting to " << path);
     }
     Callback<void, Ts...> realCb = cb.Bind(path);
-    m_callbackList.push_back(realCb);
+    Append(realCb);
 }
 
 template <typename... Ts>
 void
 TracedCallback<Ts...>::DisconnectWithoutContext(const CallbackBase& callback)
 {
-    for (auto i = m_callbackList.begin(); i != m_callbackList.end(); /* empty */)
+    if (m_others)
+    {
+        for (auto i = m_others->begin(); i != m_others->end(); /* empty */)
+        {
+            if ((*i).IsEqual(callback))
+            {
+                i = m_others->erase(i);
+            }
+            else
+            {
+                i++;
+            }
+        }
+    }
+    if (!m_first.IsNull() && m_first.IsEqual(callback))
     {
-        if ((*i).IsEqual(callback))
+        // the next Callback, which is not equal, becomes the first one
+        if (m_others && !m_others->empty())
         {
-            i = m_callbackList.erase(i);
+            m_first = m_others->front();
+            m_others->erase(m_others->begin());
         }
         else
         {
-            i++;
+            m_first.Nullify();
         }
     }
 }
@@ -181,17 +269,34 @@ template <typename... Ts>
 void
 TracedCallback<Ts...>::operator()(Ts... args) const
 {
-    for (auto i = m_callbackList.begin(); i != m_callbackList.end(); i++)
+#ifndef NS3_TRACING_DISABLE
+    if (m_first.IsNull())
+    {
+        return;
+    }
+    m_first(args...);
+    if (m_others)
     {
-        (*i)(args...);
+        // A Callback may connect another one, and reallocate the vector.
+        for (std::size_t i = 0; i < m_others->size(); i++)
+        {
+            (*m_others)[i](args...);
+        }
     }
+#else
+    ((void)args, ...);
+#endif
 }
 
 template <typename... Ts>
 bool
 TracedCallback<Ts...>::IsEmpty() const
 {
-    return m_callbackList.empty();
+#ifndef NS3_TRACING_DISABLE
+    return m_first.IsNull();
+#else
+    return true;
+#endif
 }
 
 } // namespace ns3
@@ -220,15 +220,18 @@ class TracedValue
      * Set the value of the underlying variable.
      *
      * If the new value differs from the old, the Callback will be invoked.
+     * The values are only compared if a Callback is connected.
      * @param [in] v The new value.
      */
     void Set(const T& v)
     {
-        if (m_v != v)
+#ifndef NS3_TRACING_DISABLE
+        if (!m_cb.IsEmpty() && m_v != v)
         {
             m_cb(m_v, v);
-            m_v = v;
         }
+#endif
+        m_v = v;
     }
 
     /**
@@ -19,6 +19,8 @@
 #include "ns3/traced-value.h"
 
 #include <sstream>
+#include <string>
+#include <vector>
 
 /**
  * @file
@@ -853,6 +855,129 @@ SearchAttributesOfParentObjectsTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(iv.Get(), 42, "Object Attribute \"X\" not settable in derived class");
 }
 
+/**
+ * @ingroup config-tests
+ * Test the matching of the indexes of a vector of objects, and the
+ * CompiledPath.
+ */
+class CompiledPathConfigTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    CompiledPathConfigTestCase();
+
+    /**
+     * Trace callback with context path.
+     * @param path The context path.
+     * @param old The old value.
+     * @param newValue The new value.
+     */
+    void TraceWithPath(std::string path, int16_t old [[maybe_unused]], int16_t newValue)
+    {
+        m_paths.push_back(path);
+    }
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the objects matching an index of the vector.
+     * @param index The index element of the path.
+     * @param expected The indexes of the objects expected, in order.
+     */
+    void CheckIndexes(std::string index, std::vector<uint32_t> expected);
+
+    std::vector<std::string> m_paths; //!< The context paths of the trace calls.
+};
+
+CompiledPathConfigTestCase::CompiledPathConfigTestCase()
+    : TestCase("Check the index matching and the compiled paths")
+{
+}
+
+void
+CompiledPathConfigTestCase::CheckIndexes(std::string index, std::vector<uint32_t> expected)
+{
+    Config::MatchContainer matches = Config::LookupMatches("/NodesA/" + index);
+    NS_TEST_ASSERT_MSG_EQ(matches.GetN(), expected.size(), "Wrong number of matches of " << index);
+    for (std::size_t i = 0; i < expected.size(); i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ(matches.GetMatchedPath(i),
+                              "/NodesA/" + std::to_string(expected[i]) + "/",
+                              "Wrong match " << i << " of " << index);
+    }
+}
+
+void
+CompiledPathConfigTestCase::DoRun()
+{
+    IntegerValue iv;
+
+    //
+    // Create a root namespace object, with twenty objects in its NodesA
+    // vector, which the other test cases leave empty.
+    //
+    Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject>();
+    Config::RegisterRootNamespaceObject(root);
+    std::vector<Ptr<ConfigTestObject>> nodes;
+    for (uint32_t i = 0; i < 20; i++)
+    {
+        nodes.push_back(CreateObject<ConfigTestObject>());
+        root->AddNodeA(nodes.back());
+    }
+
+    CheckIndexes("*", {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19});
+    CheckIndexes("7", {7});
+    CheckIndexes("[12-14]|3|13", {3, 12, 13, 14});
+    CheckIndexes("19|[0-1]|[1-2]", {0, 1, 2, 19});
+    CheckIndexes("[18-25]", {18, 19});
+    CheckIndexes("25", {});
+    CheckIndexes("[5-2]", {});
+    CheckIndexes("x", {});
+    CheckIndexes("*|4", {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19});
+
+    //
+    // Set an attribute through a compiled path, then through the cached
+    // path of Config::Set.
+    //
+    Config::CompiledPath path("/NodesA/[2-3]/A");
+    NS_TEST_ASSERT_MSG_EQ(path.GetPath(), "/NodesA/[2-3]/A", "Wrong path");
+    NS_TEST_ASSERT_MSG_EQ(path.LookupMatches().GetN(), 2, "Wrong number of matches");
+    path.Set(IntegerValue(-5));
+    for (uint32_t i = 1; i < 5; i++)
+    {
+        nodes[i]->GetAttribute("A", iv);
+        NS_TEST_EXPECT_MSG_EQ(iv.Get(), (i == 2 || i == 3) ? -5 : 10, "Wrong A of node " << i);
+    }
+    for (int8_t value = 1; value < 3; value++)
+    {
+        Config::Set("/NodesA/1/A", IntegerValue(value));
+        nodes[1]->GetAttribute("A", iv);
+        NS_TEST_EXPECT_MSG_EQ(iv.Get(), value, "Object Attribute \"A\" not set as expected");
+    }
+    NS_TEST_EXPECT_MSG_EQ(path.SetFailSafe(IntegerValue(-6)), true, "Attribute not set");
+    NS_TEST_EXPECT_MSG_EQ(Config::CompiledPath("/NodesA/*/C").SetFailSafe(IntegerValue(0)),
+                          false,
+                          "Unknown attribute set");
+
+    //
+    // Connect a trace sink to all the nodes through a compiled path, and
+    // check the context.
+    //
+    Config::CompiledPath source("/NodesA/*/Source");
+    source.Connect(MakeCallback(&CompiledPathConfigTestCase::TraceWithPath, this));
+    nodes[5]->SetAttribute("Source", IntegerValue(3));
+    nodes[17]->SetAttribute("Source", IntegerValue(4));
+    NS_TEST_ASSERT_MSG_EQ(m_paths.size(), 2, "Wrong number of trace calls");
+    NS_TEST_EXPECT_MSG_EQ(m_paths[0], "/NodesA/5/Source", "Wrong context");
+    NS_TEST_EXPECT_MSG_EQ(m_paths[1], "/NodesA/17/Source", "Wrong context");
+    source.Disconnect(MakeCallback(&CompiledPathConfigTestCase::TraceWithPath, this));
+    nodes[5]->SetAttribute("Source", IntegerValue(5));
+    NS_TEST_EXPECT_MSG_EQ(m_paths.size(), 2, "Trace fired after disconnection");
+
+    Config::UnregisterRootNamespaceObject(root);
+}
+
 /**
  * @ingroup config-tests
  * The Test Suite that glues all of the Test Cases together.
@@ -871,6 +996,7 @@ ConfigTestSuite::ConfigTestSuite()
     AddTestCase(new UnderRootNamespaceConfigTestCase);
     AddTestCase(new ObjectVectorConfigTestCase);
     AddTestCase(new SearchAttributesOfParentObjectsTestCase);
+    AddTestCase(new CompiledPathConfigTestCase);
 }
 
 /**
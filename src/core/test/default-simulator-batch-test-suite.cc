@@ -0,0 +1,283 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/config.h"
+#include "ns3/default-simulator-impl.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup core-tests
+ * @ingroup simulator
+ * DefaultSimulatorImpl batch execution test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * @ingroup simulator-tests
+ *
+ * Check that the events executed in batches by context, on one or
+ * several threads, are those of the sequential execution, in an order
+ * independent of the number of threads, and that a recorded execution
+ * order can be replayed.
+ *
+ * A fixed number of messages circulate between the contexts, in steps
+ * of 10 us, so that the contexts receive them at the same time stamps.
+ * Each message schedules local events, some of which are cancelled or
+ * removed.
+ */
+class DefaultSimulatorBatchTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    DefaultSimulatorBatchTestCase();
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /** The events of each context: time stamp and value. */
+    typedef std::vector<std::vector<std::pair<int64_t, uint64_t>>> Log;
+
+    /**
+     * Run the model.
+     * @param [in] threads The ParallelThreads attribute.
+     * @param [in] record The record file name, or empty.
+     * @param [in] replay The replay file name, or empty.
+     * @returns The events of each context.
+     */
+    Log RunModel(uint32_t threads, const std::string& record, const std::string& replay);
+    /**
+     * Receive a message.
+     * @param [in] context The expected context.
+     * @param [in] value The message value.
+     */
+    void Receive(uint32_t context, uint64_t value);
+    /**
+     * Cancel or remove a local event, depending on the message value.
+     * @param [in] context The context.
+     * @param [in] value The message value.
+     * @param [in] local The local event.
+     */
+    void Expire(uint32_t context, uint64_t value, EventId local);
+    /**
+     * Local event of a context.
+     * @param [in] context The expected context.
+     * @param [in] value The message value.
+     */
+    void Local(uint32_t context, uint64_t value);
+    /**
+     * Record an event.
+     * @param [in] context The expected context.
+     * @param [in] value The value to log.
+     */
+    void Record(uint32_t context, uint64_t value);
+
+    static constexpr uint32_t CONTEXTS = 16; //!< Number of contexts
+    Log m_log;                               //!< Events of the current run
+    std::vector<uint32_t> m_errors;          //!< Errors detected, by context
+};
+
+DefaultSimulatorBatchTestCase::DefaultSimulatorBatchTestCase()
+    : TestCase("Check the batch execution of the events with the same time stamp")
+{
+}
+
+void
+DefaultSimulatorBatchTestCase::Record(uint32_t context, uint64_t value)
+{
+    // The test macros are not thread-safe: just count the errors.
+    if (Simulator::GetContext() != context)
+    {
+        m_errors[context]++;
+    }
+    m_log[context].emplace_back(Simulator::Now().GetTimeStep(), value);
+}
+
+void
+DefaultSimulatorBatchTestCase::Receive(uint32_t context, uint64_t value)
+{
+    Record(context, value);
+
+    EventId local = Simulator::Schedule(MicroSeconds(15) + NanoSeconds(value % 3),
+                                        &DefaultSimulatorBatchTestCase::Local,
+                                        this,
+                                        context,
+                                        value);
+    Simulator::Schedule(MicroSeconds(5),
+                        &DefaultSimulatorBatchTestCase::Expire,
+                        this,
+                        context,
+                        value,
+                        local);
+    if (value % 4 == 0)
+    {
+        Simulator::ScheduleNow(&DefaultSimulatorBatchTestCase::Local, this, context, value + 1);
+    }
+
+    uint64_t next = value * 6364136223846793005ULL + 1442695040888963407ULL;
+    uint32_t dst = (next >> 33) % CONTEXTS;
+    Simulator::ScheduleWithContext(dst,
+                                   MicroSeconds(10),
+                                   &DefaultSimulatorBatchTestCase::Receive,
+                                   this,
+                                   dst,
+                                   next);
+}
+
+void
+DefaultSimulatorBatchTestCase::Expire(uint32_t context, uint64_t value, EventId local)
+{
+    if (!local.IsPending())
+    {
+        m_errors[context]++;
+    }
+    if (value % 3 == 0)
+    {
+        local.Cancel();
+    }
+    else if (value % 3 == 1)
+    {
+        Simulator::Remove(local);
+    }
+    if (value % 3 != 2 && !local.IsExpired())
+    {
+        m_errors[context]++;
+    }
+}
+
+void
+DefaultSimulatorBatchTestCase::Local(uint32_t context, uint64_t value)
+{
+    Record(context, ~value);
+}
+
+DefaultSimulatorBatchTestCase::Log
+DefaultSimulatorBatchTestCase::RunModel(uint32_t threads,
+                                        const std::string& record,
+                                        const std::string& replay)
+{
+    Config::SetDefault("ns3::DefaultSimulatorImpl::ParallelThreads", UintegerValue(threads));
+    Config::SetDefault("ns3::DefaultSimulatorImpl::ParallelRecordFile", StringValue(record));
+    Config::SetDefault("ns3::DefaultSimulatorImpl::ParallelReplayFile", StringValue(replay));
+    m_log.assign(CONTEXTS, {});
+    m_errors.assign(CONTEXTS, 0);
+
+    for (uint32_t context = 0; context < CONTEXTS; ++context)
+    {
+        Simulator::ScheduleWithContext(context,
+                                       Seconds(0),
+                                       &DefaultSimulatorBatchTestCase::Receive,
+                                       this,
+                                       context,
+                                       context + 1);
+    }
+    // Stop between two time stamps: a stop event of a batch executed by
+    // context only takes effect at the end of the batch.
+    Time stop = MilliSeconds(20) - NanoSeconds(1);
+    Simulator::Stop(stop);
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), stop, "Wrong stop time");
+
+    auto impl = DynamicCast<DefaultSimulatorImpl>(Simulator::GetImplementation());
+    NS_TEST_EXPECT_MSG_NE(impl, nullptr, "Not a DefaultSimulatorImpl");
+    DefaultSimulatorImpl::BatchStats stats = impl->GetBatchStats();
+    if (threads > 0)
+    {
+        NS_TEST_EXPECT_MSG_GT(stats.parallelBatches, 1000, "Too few batches executed by context");
+        NS_TEST_EXPECT_MSG_GT(stats.parallelGroups,
+                              2 * stats.parallelBatches,
+                              "Too few contexts per batch");
+    }
+    else
+    {
+        NS_TEST_EXPECT_MSG_EQ(stats.batches, 0, "Batches executed while disabled");
+    }
+    Simulator::Destroy();
+
+    for (uint32_t context = 0; context < CONTEXTS; ++context)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_errors[context],
+                              0,
+                              "Wrong context or expiration in context " << context << " with "
+                                                                        << threads << " threads");
+    }
+    return m_log;
+}
+
+void
+DefaultSimulatorBatchTestCase::DoRun()
+{
+    std::string file = CreateTempDirFilename("batch-order.txt");
+
+    Log reference = RunModel(0, "", "");
+    Log single = RunModel(1, file, "");
+    Log first = RunModel(4, "", file);
+    Log second = RunModel(4, "", "");
+
+    for (uint32_t context = 0; context < CONTEXTS; ++context)
+    {
+        NS_TEST_EXPECT_MSG_GT(reference[context].size(), 1000, "Too few events");
+        NS_TEST_EXPECT_MSG_EQ((first[context] == single[context]),
+                              true,
+                              "Execution of context " << context << " depends on the threads");
+        NS_TEST_EXPECT_MSG_EQ((first[context] == second[context]),
+                              true,
+                              "Non-deterministic execution of context " << context);
+        // Events scheduled by different contexts at the same time stamp
+        // may run in a different order than with the sequential execution.
+        std::sort(reference[context].begin(), reference[context].end());
+        std::sort(first[context].begin(), first[context].end());
+        NS_TEST_EXPECT_MSG_EQ((first[context] == reference[context]),
+                              true,
+                              "Different events in context " << context);
+    }
+}
+
+void
+DefaultSimulatorBatchTestCase::DoTeardown()
+{
+    Config::Reset();
+}
+
+/**
+ * @ingroup simulator-tests
+ * DefaultSimulatorImpl batch execution test suite.
+ */
+class DefaultSimulatorBatchTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    DefaultSimulatorBatchTestSuite()
+        : TestSuite("default-simulator-batch")
+    {
+        AddTestCase(new DefaultSimulatorBatchTestCase());
+    }
+};
+
+/**
+ * @ingroup simulator-tests
+ * DefaultSimulatorBatchTestSuite instance variable.
+ */
+static DefaultSimulatorBatchTestSuite g_defaultSimulatorBatchTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/config.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup core-tests
+ * @ingroup simulator
+ * MultithreadedSimulatorImpl test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * @ingroup simulator-tests
+ *
+ * Check that a model run by the MultithreadedSimulatorImpl produces
+ * the same events in each context as with the DefaultSimulatorImpl.
+ *
+ * Each context forwards a message to a pseudo-random context, with a
+ * delay at least the look-ahead, and schedules a local event.
+ */
+class MultithreadedSimulatorTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * @param [in] threads The number of threads.
+     * @param [in] partition Whether to assign the contexts to the
+     *             partitions explicitly.
+     */
+    MultithreadedSimulatorTestCase(uint32_t threads, bool partition);
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+
+    /** The events of each context: time stamp and value. */
+    typedef std::vector<std::vector<std::pair<int64_t, uint64_t>>> Log;
+
+    /**
+     * Run the model.
+     * @param [in] type The simulator implementation type.
+     * @returns The events of each context.
+     */
+    Log RunModel(const std::string& type);
+    /**
+     * Receive a message.
+     * @param [in] context The expected context.
+     * @param [in] value The message value.
+     */
+    void Receive(uint32_t context, uint64_t value);
+    /**
+     * Local event of a context.
+     * @param [in] context The expected context.
+     * @param [in] value The message value.
+     */
+    void Local(uint32_t context, uint64_t value);
+    /**
+     * Record an event.
+     * @param [in] context The expected context.
+     * @param [in] value The value to log.
+     */
+    void Record(uint32_t context, uint64_t value);
+
+    static constexpr uint32_t CONTEXTS = 12; //!< Number of contexts
+    uint32_t m_threads;                      //!< Number of threads
+    bool m_partition;                        //!< Assign the partitions explicitly
+    Log m_log;                               //!< Events of the current run
+    std::vector<uint32_t> m_errors;          //!< Errors detected, by context
+};
+
+MultithreadedSimulatorTestCase::MultithreadedSimulatorTestCase(uint32_t threads, bool partition)
+    : TestCase("Check the MultithreadedSimulatorImpl with " + std::to_string(threads) +
+               " threads" + (partition ? " and explicit partitions" : "")),
+      m_threads(threads),
+      m_partition(partition)
+{
+}
+
+void
+MultithreadedSimulatorTestCase::Record(uint32_t context, uint64_t value)
+{
+    // The test macros are not thread-safe: just count the errors.
+    if (Simulator::GetContext() != context ||
+        (!m_log[context].empty() && m_log[context].back().first > Simulator::Now().GetTimeStep()))
+    {
+        m_errors[context]++;
+    }
+    m_log[context].emplace_back(Simulator::Now().GetTimeStep(), value);
+}
+
+void
+MultithreadedSimulatorTestCase::Receive(uint32_t context, uint64_t value)
+{
+    Record(context, value);
+    Simulator::Schedule(NanoSeconds(1 + value % 5),
+                        &MultithreadedSimulatorTestCase::Local,
+                        this,
+                        context,
+                        value);
+
+    uint64_t next = value * 6364136223846793005ULL + 1442695040888963407ULL;
+    uint32_t dst = (next >> 33) % CONTEXTS;
+    Simulator::ScheduleWithContext(dst,
+                                   MicroSeconds(100) + NanoSeconds((next >> 20) % 1000),
+                                   &MultithreadedSimulatorTestCase::Receive,
+                                   this,
+                                   dst,
+                                   next);
+}
+
+void
+MultithreadedSimulatorTestCase::Local(uint32_t context, uint64_t value)
+{
+    Record(context, ~value);
+}
+
+MultithreadedSimulatorTestCase::Log
+MultithreadedSimulatorTestCase::RunModel(const std::string& type)
+{
+    Config::SetGlobal("SimulatorImplementationType", StringValue(type));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::ThreadCount", UintegerValue(m_threads));
+    Config::SetDefault("ns3::MultithreadedSimulatorImpl::LookAhead",
+                       TimeValue(MicroSeconds(100)));
+    m_log.assign(CONTEXTS, {});
+    m_errors.assign(CONTEXTS, 0);
+
+    for (uint32_t context = 0; context < CONTEXTS; ++context)
+    {
+        Simulator::ScheduleWithContext(context,
+                                       NanoSeconds(context),
+                                       &MultithreadedSimulatorTestCase::Receive,
+                                       this,
+                                       context,
+                                       context + 1);
+    }
+    auto impl = DynamicCast<MultithreadedSimulatorImpl>(Simulator::GetImplementation());
+    if (impl && m_partition)
+    {
+        for (uint32_t context = 0; context < CONTEXTS; ++context)
+        {
+            impl->SetContextPartition(context, (context / 4) % m_threads);
+        }
+    }
+
+    Simulator::Stop(MilliSeconds(200));
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(Simulator::Now(), MilliSeconds(200), "Wrong stop time with " << type);
+    if (impl)
+    {
+        NS_TEST_EXPECT_MSG_EQ(impl->GetPartitionCount(), m_threads, "Wrong number of partitions");
+        if (m_threads > 1)
+        {
+            NS_TEST_EXPECT_MSG_GT(impl->GetWindowCount(), 1, "Too few windows");
+        }
+    }
+    Simulator::Destroy();
+
+    for (uint32_t context = 0; context < CONTEXTS; ++context)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_errors[context],
+                              0,
+                              "Events of context " << context << " misordered with " << type);
+    }
+    return m_log;
+}
+
+void
+MultithreadedSimulatorTestCase::DoRun()
+{
+    Log reference = RunModel("ns3::DefaultSimulatorImpl");
+    Log first = RunModel("ns3::MultithreadedSimulatorImpl");
+    Log second = RunModel("ns3::MultithreadedSimulatorImpl");
+
+    for (uint32_t context = 0; context < CONTEXTS; ++context)
+    {
+        NS_TEST_EXPECT_MSG_GT(reference[context].size(), 100, "Too few events");
+        NS_TEST_EXPECT_MSG_EQ((first[context] == second[context]),
+                              true,
+                              "Non-deterministic execution of context " << context);
+        // Events received at the same time stamp may run in a different
+        // order than with the DefaultSimulatorImpl.
+        std::sort(reference[context].begin(), reference[context].end());
+        std::sort(first[context].begin(), first[context].end());
+        NS_TEST_EXPECT_MSG_EQ((first[context] == reference[context]),
+                              true,
+                              "Different events in context " << context);
+    }
+}
+
+void
+MultithreadedSimulatorTestCase::DoTeardown()
+{
+    Config::Reset();
+}
+
+/**
+ * @ingroup simulator-tests
+ * MultithreadedSimulatorImpl test suite.
+ */
+class MultithreadedSimulatorTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    MultithreadedSimulatorTestSuite()
+        : TestSuite("multithreaded-simulator")
+    {
+        AddTestCase(new MultithreadedSimulatorTestCase(1, false));
+        AddTestCase(new MultithreadedSimulatorTestCase(2, false));
+        AddTestCase(new MultithreadedSimulatorTestCase(4, false));
+        AddTestCase(new MultithreadedSimulatorTestCase(3, true));
+    }
+};
+
+/**
+ * @ingroup simulator-tests
+ * MultithreadedSimulatorTestSuite instance variable.
+ */
+static MultithreadedSimulatorTestSuite g_multithreadedSimulatorTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
@@ -157,6 +157,29 @@ NS_OBJECT_ENSURE_REGISTERED(DerivedB);
 namespace ns3
 {
 
+/**
+ * @ingroup object-tests
+ * BaseA is stored in a slot of the aggregation cache.
+ *
+ * The slots of the internet stack are reused: the test objects are
+ * never aggregated to a protocol.
+ */
+template <>
+struct ObjectCacheSlot<BaseA>
+{
+    static constexpr uint8_t index = Object::CACHE_SLOT_IPV4; //!< The slot
+};
+
+/**
+ * @ingroup object-tests
+ * BaseB is stored in a slot of the aggregation cache.
+ */
+template <>
+struct ObjectCacheSlot<BaseB>
+{
+    static constexpr uint8_t index = Object::CACHE_SLOT_TCP; //!< The slot
+};
+
 namespace tests
 {
 
@@ -521,6 +544,54 @@ UnidirectionalAggregateObjectTestCase::DoRun()
                           "Can GetObject (through baseB) for BaseA Object");
 }
 
+/**
+ * @ingroup object-tests
+ * Test the aggregation cache of GetObject.
+ */
+class ObjectCacheTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    ObjectCacheTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ObjectCacheTestCase::ObjectCacheTestCase()
+    : TestCase("Check the aggregation cache of GetObject")
+{
+}
+
+void
+ObjectCacheTestCase::DoRun()
+{
+    Ptr<DerivedA> derivedA = CreateObject<DerivedA>();
+    Ptr<BaseB> baseB = CreateObject<BaseB>();
+
+    // A lookup that fails is not cached.
+    NS_TEST_ASSERT_MSG_EQ(derivedA->GetObject<BaseB>(), nullptr, "Found a BaseB too early");
+    NS_TEST_ASSERT_MSG_EQ(derivedA->GetObject<BaseA>(), derivedA, "Cannot find self as BaseA");
+
+    derivedA->AggregateObject(baseB);
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        NS_TEST_ASSERT_MSG_EQ(derivedA->GetObject<BaseB>(), baseB, "Wrong BaseB");
+        NS_TEST_ASSERT_MSG_EQ(baseB->GetObject<BaseA>(), derivedA, "Wrong BaseA");
+        NS_TEST_ASSERT_MSG_EQ(baseB->GetObject<DerivedA>(), derivedA, "Wrong DerivedA");
+    }
+
+    // A unidirectional aggregate is found by its aggregator only.
+    Ptr<BaseA> baseA = CreateObject<BaseA>();
+    Ptr<DerivedB> derivedB = CreateObject<DerivedB>();
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseA>(), baseA, "Cannot find self as BaseA");
+    baseA->UnidirectionalAggregateObject(derivedB);
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseB>(), derivedB, "Wrong unidirectional BaseB");
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseB>(), derivedB, "Wrong unidirectional BaseB");
+    NS_TEST_ASSERT_MSG_EQ(derivedB->GetObject<BaseA>(), nullptr, "Found a unidirectional BaseA");
+    NS_TEST_ASSERT_MSG_EQ(derivedB->GetObject<BaseB>(), derivedB, "Cannot find self as BaseB");
+}
+
 /**
  * @ingroup object-tests
  * Test an Object factory can create Objects
@@ -623,6 +694,7 @@ ObjectTestSuite::ObjectTestSuite()
     AddTestCase(new CreateObjectTestCase);
     AddTestCase(new AggregateObjectTestCase);
     AddTestCase(new UnidirectionalAggregateObjectTestCase);
+    AddTestCase(new ObjectCacheTestCase);
     AddTestCase(new ObjectFactoryTestCase);
 }
 
@@ -6,12 +6,20 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "ns3/calendar-scheduler.h"
+#include "ns3/config.h"
+#include "ns3/default-simulator-impl.h"
 #include "ns3/heap-scheduler.h"
+#include "ns3/ladder-scheduler.h"
 #include "ns3/list-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/priority-queue-scheduler.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
 
 using namespace ns3;
 
@@ -651,6 +659,189 @@ SimulatorTemplateTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that a Scheduler returns a large, clustered event population in order,
+ * with removals interleaved.
+ */
+class SchedulerOrderTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * @param schedulerFactory Scheduler factory.
+     */
+    SchedulerOrderTestCase(ObjectFactory schedulerFactory);
+    void DoRun() override;
+
+  private:
+    ObjectFactory m_schedulerFactory; //!< Scheduler factory.
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase(ObjectFactory schedulerFactory)
+    : TestCase("Check event ordering with " + schedulerFactory.GetTypeId().GetName()),
+      m_schedulerFactory(schedulerFactory)
+{
+}
+
+void
+SchedulerOrderTestCase::DoRun()
+{
+    Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler>();
+    std::mt19937 rng(1);
+    uint32_t uid = 0;
+    uint64_t now = 0;
+    std::vector<Scheduler::Event> pending;
+
+    auto schedule = [&](uint64_t delay) {
+        Scheduler::Event ev;
+        ev.impl = nullptr;
+        ev.key.m_ts = now + delay;
+        ev.key.m_uid = uid++;
+        ev.key.m_context = 0;
+        scheduler->Insert(ev);
+        pending.push_back(ev);
+    };
+
+    // Mix of near-future timers, far-future timers and simultaneous events
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        schedule(rng() % 100);
+        schedule(1000000 + rng() % 1000000);
+        schedule(5000);
+    }
+
+    uint32_t executed = 0;
+    while (!pending.empty())
+    {
+        auto earliest = std::min_element(pending.begin(), pending.end());
+        if (executed % 7 == 3)
+        {
+            // Remove a random pending event instead of running the next one
+            auto victim = pending.begin() + rng() % pending.size();
+            scheduler->Remove(*victim);
+            *victim = pending.back();
+            pending.pop_back();
+        }
+        else
+        {
+            Scheduler::Event next = scheduler->RemoveNext();
+            NS_TEST_ASSERT_MSG_EQ(next.key.m_uid,
+                                  earliest->key.m_uid,
+                                  "Events returned out of order");
+            now = next.key.m_ts;
+            *earliest = pending.back();
+            pending.pop_back();
+            if (executed < 2000)
+            {
+                schedule(rng() % 50);
+            }
+        }
+        ++executed;
+        NS_TEST_ASSERT_MSG_EQ(scheduler->IsEmpty(), pending.empty(), "Inconsistent IsEmpty");
+    }
+}
+
+/**
+ * @ingroup simulator-tests
+ *
+ * @brief Check that cancelled events are purged from the event list,
+ * and that event storage is recycled.
+ */
+class SimulatorCompactionTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor.
+     * @param schedulerFactory Scheduler factory.
+     */
+    SimulatorCompactionTestCase(ObjectFactory schedulerFactory);
+    void DoRun() override;
+    void DoTeardown() override;
+
+  private:
+    /**
+     * Test Event.
+     * @param cancelled Whether the event was cancelled.
+     */
+    void Fire(bool cancelled);
+
+    ObjectFactory m_schedulerFactory; //!< Scheduler factory.
+    uint32_t m_fired;                 //!< Number of events executed.
+    uint32_t m_firedCancelled;        //!< Number of cancelled events executed.
+};
+
+SimulatorCompactionTestCase::SimulatorCompactionTestCase(ObjectFactory schedulerFactory)
+    : TestCase("Check cancelled event compaction with " +
+               schedulerFactory.GetTypeId().GetName()),
+      m_schedulerFactory(schedulerFactory),
+      m_fired(0),
+      m_firedCancelled(0)
+{
+}
+
+void
+SimulatorCompactionTestCase::Fire(bool cancelled)
+{
+    ++m_fired;
+    if (cancelled)
+    {
+        ++m_firedCancelled;
+    }
+}
+
+void
+SimulatorCompactionTestCase::DoRun()
+{
+    Config::SetDefault("ns3::DefaultSimulatorImpl::CompactionMinimum", UintegerValue(50));
+    Simulator::Destroy();
+    Simulator::SetScheduler(m_schedulerFactory);
+
+    // Warm up the event pool
+    Simulator::Schedule(Seconds(1), &SimulatorCompactionTestCase::Fire, this, false).Cancel();
+    Simulator::Run();
+    auto pool = EventImpl::GetPoolStats();
+
+    std::vector<EventId> cancelled;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        Simulator::Schedule(MicroSeconds(i), &SimulatorCompactionTestCase::Fire, this, false);
+        cancelled.push_back(
+            Simulator::Schedule(MicroSeconds(i), &SimulatorCompactionTestCase::Fire, this, true));
+    }
+    for (auto& id : cancelled)
+    {
+        id.Cancel();
+    }
+
+    auto impl = DynamicCast<DefaultSimulatorImpl>(Simulator::GetImplementation());
+    NS_TEST_ASSERT_MSG_NE(impl, nullptr, "Expected the default simulator implementation");
+    auto stats = impl->GetEventStats();
+    NS_TEST_EXPECT_MSG_EQ(stats.cancelled, 101, "Wrong number of cancelled events");
+    NS_TEST_EXPECT_MSG_EQ(stats.compactions, 1, "Cancelled events were not compacted");
+    NS_TEST_EXPECT_MSG_EQ(stats.compacted, 100, "Wrong number of purged events");
+    for (auto& id : cancelled)
+    {
+        NS_TEST_EXPECT_MSG_EQ(id.IsExpired(), true, "Purged event should be expired");
+    }
+
+    Simulator::Run();
+    NS_TEST_EXPECT_MSG_EQ(m_fired, 100, "Live events were lost");
+    NS_TEST_EXPECT_MSG_EQ(m_firedCancelled, 0, "Cancelled events were executed");
+    NS_TEST_EXPECT_MSG_EQ(impl->GetEventCount(), 101, "Purged events should not be processed");
+
+    auto poolEnd = EventImpl::GetPoolStats();
+    NS_TEST_EXPECT_MSG_GT(poolEnd.poolHits, pool.poolHits, "Event storage was not recycled");
+    Simulator::Destroy();
+}
+
+void
+SimulatorCompactionTestCase::DoTeardown()
+{
+    Config::Reset();
+}
+
 /**
  * @ingroup simulator-tests
  *
@@ -674,6 +865,20 @@ class SimulatorTestSuite : public TestSuite
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
         factory.SetTypeId(PriorityQueueScheduler::GetTypeId());
         AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+        factory.SetTypeId(LadderScheduler::GetTypeId());
+        AddTestCase(new SimulatorEventsTestCase(factory), TestCase::Duration::QUICK);
+
+        for (const auto& tid : {ListScheduler::GetTypeId(),
+                                MapScheduler::GetTypeId(),
+                                HeapScheduler::GetTypeId(),
+                                CalendarScheduler::GetTypeId(),
+                                PriorityQueueScheduler::GetTypeId(),
+                                LadderScheduler::GetTypeId()})
+        {
+            factory.SetTypeId(tid);
+            AddTestCase(new SchedulerOrderTestCase(factory), TestCase::Duration::QUICK);
+            AddTestCase(new SimulatorCompactionTestCase(factory), TestCase::Duration::QUICK);
+        }
     }
 };
 
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/startup-timer.h"
+#include "ns3/test.h"
+
+#include <sstream>
+
+/**
+ * @file
+ * @ingroup core-tests
+ * StartupTimer test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * @ingroup core-tests
+ *
+ * Check that the StartupTimer accounts the phases in order, with the
+ * number of times each was timed.
+ */
+class StartupTimerTestCase : public TestCase
+{
+  public:
+    /** Constructor */
+    StartupTimerTestCase();
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+};
+
+StartupTimerTestCase::StartupTimerTestCase()
+    : TestCase("Check the phases of the StartupTimer")
+{
+}
+
+void
+StartupTimerTestCase::DoRun()
+{
+    StartupTimer::Reset();
+    {
+        StartupTimer outer("Outer");
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            StartupTimer inner("Inner");
+        }
+    }
+    {
+        StartupTimer outer("Outer");
+        StartupTimer::Reset();
+    }
+
+    auto phases = StartupTimer::GetPhases();
+    NS_TEST_EXPECT_MSG_EQ(phases.size(), 0, "The timer running during the reset was accounted");
+
+    {
+        StartupTimer outer("Outer");
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            StartupTimer inner("Inner");
+        }
+    }
+    {
+        StartupTimer outer("Outer");
+    }
+    phases = StartupTimer::GetPhases();
+    NS_TEST_ASSERT_MSG_EQ(phases.size(), 2, "Wrong number of phases");
+    NS_TEST_EXPECT_MSG_EQ(phases[0].name, "Outer", "Wrong order of the phases");
+    NS_TEST_EXPECT_MSG_EQ(phases[0].count, 2, "Wrong count of the outer phase");
+    NS_TEST_EXPECT_MSG_EQ(phases[1].name, "Inner", "Wrong order of the phases");
+    NS_TEST_EXPECT_MSG_EQ(phases[1].count, 3, "Wrong count of the inner phase");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(phases[0].nanoseconds,
+                                phases[1].nanoseconds,
+                                "The outer phase did not include the inner phase");
+
+    std::ostringstream oss;
+    StartupTimer::Print(oss);
+    NS_TEST_EXPECT_MSG_NE(oss.str().find("Inner"), std::string::npos, "Phase not printed");
+}
+
+void
+StartupTimerTestCase::DoTeardown()
+{
+    StartupTimer::Reset();
+}
+
+/**
+ * @ingroup core-tests
+ *
+ * StartupTimer test suite.
+ */
+class StartupTimerTestSuite : public TestSuite
+{
+  public:
+    /** Constructor */
+    StartupTimerTestSuite();
+};
+
+StartupTimerTestSuite::StartupTimerTestSuite()
+    : TestSuite("startup-timer", Type::UNIT)
+{
+    AddTestCase(new StartupTimerTestCase, TestCase::Duration::QUICK);
+}
+
+/**
+ * @ingroup core-tests
+ * Static variable for test initialization.
+ */
+static StartupTimerTestSuite g_startupTimerTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
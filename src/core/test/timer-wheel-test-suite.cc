@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/timer-wheel.h"
+#include "ns3/timer.h"
+
+#include <map>
+#include <vector>
+
+/**
+ * @file
+ * @ingroup core-tests
+ * @ingroup timer
+ * @ingroup timer-tests
+ * TimerWheel test suite.
+ */
+
+namespace ns3
+{
+
+namespace tests
+{
+
+/**
+ * @ingroup timer-tests
+ * Check that timers expire at their exact time on every level of the
+ * wheel, and that cancelled or removed timers do not expire.
+ */
+class TimerWheelExpireTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    TimerWheelExpireTestCase();
+    void DoRun() override;
+
+  private:
+    /**
+     * Timer function.
+     * @param [in] id The timer identifier.
+     */
+    void Expire(uint32_t id);
+
+    std::map<uint32_t, Time> m_expected; //!< Expected expiration times, by timer
+    std::map<uint32_t, Time> m_expired;  //!< Actual expiration times, by timer
+    std::map<uint32_t, EventId> m_ids;   //!< Timer EventIds, by timer
+};
+
+TimerWheelExpireTestCase::TimerWheelExpireTestCase()
+    : TestCase("Check timer wheel expiration times")
+{
+}
+
+void
+TimerWheelExpireTestCase::Expire(uint32_t id)
+{
+    m_expired[id] = Simulator::Now();
+    NS_TEST_EXPECT_MSG_EQ(m_ids[id].IsExpired(),
+                          true,
+                          "Timer " << id << " not expired in its own function");
+}
+
+void
+TimerWheelExpireTestCase::DoRun()
+{
+    TimerWheel* wheel = TimerWheel::Get();
+    // Start away from the origin, so that the slots are not aligned on
+    // the current time.
+    Simulator::Stop(NanoSeconds(123456789));
+    Simulator::Run();
+
+    const std::vector<Time> delays = {Seconds(0),
+                                      NanoSeconds(1),
+                                      MicroSeconds(300),
+                                      MilliSeconds(1),
+                                      MilliSeconds(5) + NanoSeconds(7),
+                                      MilliSeconds(255),
+                                      MilliSeconds(700),
+                                      Seconds(100) + MicroSeconds(3),
+                                      Hours(30),
+                                      Days(100) + NanoSeconds(11)};
+    uint32_t id = 0;
+    for (const auto& delay : delays)
+    {
+        // Two timers per delay, the second of which is cancelled or removed.
+        for (uint32_t i = 0; i < 2; ++i, ++id)
+        {
+            m_expected[id] = Simulator::Now() + delay;
+            m_ids[id] = wheel->Schedule(delay, &TimerWheelExpireTestCase::Expire, this, id);
+            NS_TEST_EXPECT_MSG_EQ(m_ids[id].IsPending(), true, "Timer " << id << " not pending");
+            NS_TEST_EXPECT_MSG_EQ(Simulator::GetDelayLeft(m_ids[id]),
+                                  delay,
+                                  "Wrong delay left for timer " << id);
+        }
+        if (id % 4 == 0)
+        {
+            m_ids[id - 1].Cancel();
+        }
+        else
+        {
+            m_ids[id - 1].Remove();
+        }
+        NS_TEST_EXPECT_MSG_EQ(m_ids[id - 1].IsExpired(), true, "Timer " << id - 1 << " pending");
+    }
+    Simulator::Run();
+
+    for (id = 0; id < 2 * delays.size(); id += 2)
+    {
+        NS_TEST_EXPECT_MSG_EQ(m_expired.count(id), 1, "Timer " << id << " did not expire");
+        NS_TEST_EXPECT_MSG_EQ(m_expired[id],
+                              m_expected[id],
+                              "Timer " << id << " did not expire at the right time");
+        NS_TEST_EXPECT_MSG_EQ(m_expired.count(id + 1), 0, "Timer " << id + 1 << " expired");
+    }
+    NS_TEST_EXPECT_MSG_EQ(wheel->GetSize(), 0, "Timers left in the wheel");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup timer-tests
+ * Check that a timer constantly rescheduled, as a retransmission timer
+ * is, costs few simulator events and expires at its last deadline.
+ */
+class TimerWheelRescheduleTestCase : public TestCase
+{
+  public:
+    /** Constructor. */
+    TimerWheelRescheduleTestCase();
+    void DoRun() override;
+
+  private:
+    /** Move the deadline of the timers, as on the reception of an ACK. */
+    void Ack();
+    /** Function of the wheel timer. */
+    void Expire();
+    /** Function of the Timer. */
+    void ExpireTimer();
+
+    EventId m_event;        //!< The wheel timer
+    Timer m_timer;          //!< A Timer using the wheel
+    Time m_expired;         //!< Expiration time of the wheel timer
+    Time m_timerExpired;    //!< Expiration time of the Timer
+    uint32_t m_expirations; //!< Number of wheel timer expirations
+};
+
+TimerWheelRescheduleTestCase::TimerWheelRescheduleTestCase()
+    : TestCase("Check timer wheel rescheduling"),
+      m_timer(Timer::CANCEL_ON_DESTROY),
+      m_expirations(0)
+{
+}
+
+void
+TimerWheelRescheduleTestCase::Ack()
+{
+    m_event.Cancel();
+    m_event = TimerWheel::Get()->Schedule(MilliSeconds(200),
+                                          &TimerWheelRescheduleTestCase::Expire,
+                                          this);
+    m_timer.Cancel();
+    m_timer.Schedule();
+}
+
+void
+TimerWheelRescheduleTestCase::Expire()
+{
+    m_expired = Simulator::Now();
+    m_expirations++;
+}
+
+void
+TimerWheelRescheduleTestCase::ExpireTimer()
+{
+    m_timerExpired = Simulator::Now();
+    NS_TEST_EXPECT_MSG_EQ(m_timer.IsExpired(), true, "Timer not expired in its own function");
+}
+
+void
+TimerWheelRescheduleTestCase::DoRun()
+{
+    m_timer.SetFunction(&TimerWheelRescheduleTestCase::ExpireTimer, this);
+    m_timer.SetDelay(MilliSeconds(300));
+    m_timer.SetTimerWheel(true);
+
+    const uint32_t acks = 10000;
+    for (uint32_t i = 0; i < acks; ++i)
+    {
+        Simulator::Schedule(MicroSeconds(10 * i), &TimerWheelRescheduleTestCase::Ack, this);
+    }
+    Simulator::Run();
+
+    Time last = MicroSeconds(10 * (acks - 1));
+    NS_TEST_EXPECT_MSG_EQ(m_expirations, 1, "Wrong number of expirations");
+    NS_TEST_EXPECT_MSG_EQ(m_expired, last + MilliSeconds(200), "Wrong expiration time");
+    NS_TEST_EXPECT_MSG_EQ(m_timerExpired, last + MilliSeconds(300), "Wrong Timer expiration time");
+
+    TimerWheel::Stats stats = TimerWheel::Get()->GetStats();
+    NS_TEST_EXPECT_MSG_EQ(stats.scheduled, 2 * acks, "Wrong number of scheduled timers");
+    NS_TEST_EXPECT_MSG_EQ(stats.posted, 2, "Only the last timers should reach the event list");
+    NS_TEST_EXPECT_MSG_LT(stats.slotEvents, acks / 10, "Too many slot events");
+    NS_TEST_EXPECT_MSG_EQ(stats.dropped + stats.posted, 2 * acks, "Timers lost by the wheel");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup timer-tests
+ * TimerWheel test suite
+ */
+class TimerWheelTestSuite : public TestSuite
+{
+  public:
+    /** Constructor. */
+    TimerWheelTestSuite()
+        : TestSuite("timer-wheel")
+    {
+        AddTestCase(new TimerWheelExpireTestCase());
+        AddTestCase(new TimerWheelRescheduleTestCase());
+    }
+};
+
+/**
+ * @ingroup timer-tests
+ * TimerWheelTestSuite instance variable.
+ */
+static TimerWheelTestSuite g_timerWheelTestSuite;
+
+} // namespace tests
+
+} // namespace ns3
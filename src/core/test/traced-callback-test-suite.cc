@@ -7,6 +7,8 @@
 #include "ns3/test.h"
 #include "ns3/traced-callback.h"
 
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -122,6 +124,89 @@ BasicTracedCallbackTestCase::DoRun()
     NS_TEST_ASSERT_MSG_EQ(m_two, true, "Callback CbTwo not called");
 }
 
+/**
+ * @ingroup tracedcallback-tests
+ *
+ * TracedCallback Test case, check the order of a chain of Callbacks
+ * when Callbacks are disconnected, and the copy of a chain.
+ */
+class TracedCallbackChainTestCase : public TestCase
+{
+  public:
+    TracedCallbackChainTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Record a call.
+     * @param id Identifier of the callback.
+     * @param value Value passed to the trace.
+     */
+    void Record(uint32_t id, uint32_t value);
+
+    std::vector<uint32_t> m_calls; //!< Identifiers of the callbacks called
+};
+
+TracedCallbackChainTestCase::TracedCallbackChainTestCase()
+    : TestCase("Check the order and the copy of a chain of Callbacks")
+{
+}
+
+void
+TracedCallbackChainTestCase::Record(uint32_t id, uint32_t value)
+{
+    m_calls.push_back(id * 100 + value);
+}
+
+void
+TracedCallbackChainTestCase::DoRun()
+{
+    TracedCallback<uint32_t> trace;
+    NS_TEST_ASSERT_MSG_EQ(trace.IsEmpty(), true, "New TracedCallback not empty");
+    trace(1);
+
+    std::vector<Callback<void, uint32_t>> cbs;
+    for (uint32_t id = 1; id <= 4; id++)
+    {
+        cbs.push_back(MakeCallback(&TracedCallbackChainTestCase::Record, this).Bind(id));
+        trace.ConnectWithoutContext(cbs.back());
+    }
+    NS_TEST_ASSERT_MSG_EQ(trace.IsEmpty(), false, "TracedCallback empty");
+    m_calls.clear();
+    trace(7);
+    NS_TEST_ASSERT_MSG_EQ((m_calls == std::vector<uint32_t>{107, 207, 307, 407}),
+                          true,
+                          "Wrong calls of the chain");
+
+    // The Callbacks following the first one keep their order.
+    TracedCallback<uint32_t> copy = trace;
+    trace.DisconnectWithoutContext(cbs[0]);
+    trace.DisconnectWithoutContext(cbs[2]);
+    m_calls.clear();
+    trace(5);
+    NS_TEST_ASSERT_MSG_EQ((m_calls == std::vector<uint32_t>{205, 405}),
+                          true,
+                          "Wrong calls after disconnection");
+
+    // The copy is not affected by the disconnections.
+    m_calls.clear();
+    copy(3);
+    NS_TEST_ASSERT_MSG_EQ((m_calls == std::vector<uint32_t>{103, 203, 303, 403}),
+                          true,
+                          "Wrong calls of the copy");
+
+    trace.DisconnectWithoutContext(cbs[1]);
+    trace.DisconnectWithoutContext(cbs[3]);
+    NS_TEST_ASSERT_MSG_EQ(trace.IsEmpty(), true, "TracedCallback not empty");
+    m_calls.clear();
+    trace(1);
+    NS_TEST_ASSERT_MSG_EQ(m_calls.empty(), true, "Callback unexpectedly called");
+
+    copy = trace;
+    NS_TEST_ASSERT_MSG_EQ(copy.IsEmpty(), true, "Assigned TracedCallback not empty");
+}
+
 /**
  * @ingroup tracedcallback-tests
  *
@@ -137,6 +222,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite()
     : TestSuite("traced-callback", Type::UNIT)
 {
     AddTestCase(new BasicTracedCallbackTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new TracedCallbackChainTestCase, TestCase::Duration::QUICK);
 }
 
 static TracedCallbackTestSuite
@@ -0,0 +1,189 @@
+import ipaddress
+import struct
+import sys
+
+## Record types, see FlowMonitor::BinaryRecordType
+BINARY_FLOW = 1
+BINARY_SNAPSHOT = 2
+
+## The times of a flow record, in ns
+TIME_FIELDS = [
+    "timeFirstTxPacket",
+    "timeFirstRxPacket",
+    "timeLastTxPacket",
+    "timeLastRxPacket",
+    "delaySum",
+    "jitterSum",
+    "lastDelay",
+    "maxDelay",
+    "minDelay",
+]
+
+## The counters of a flow record
+COUNTER_FIELDS = ["txBytes", "rxBytes", "txPackets", "rxPackets", "lostPackets", "timesForwarded"]
+
+
+## FiveTuple
+class FiveTuple(object):
+    ## class variables
+    ## @var sourceAddress
+    #  source address
+    ## @var destinationAddress
+    #  destination address
+    ## @var protocol
+    #  network protocol
+    ## @var sourcePort
+    #  source port
+    ## @var destinationPort
+    #  destination port
+    ## @var __slots_
+    #  class variable list
+    __slots_ = ["sourceAddress", "destinationAddress", "protocol", "sourcePort", "destinationPort"]
+
+    def __init__(self, payload):
+        """! The initializer.
+        @param self The object pointer.
+        @param payload The payload of a BINARY_FLOW record, after the flowId.
+        """
+        version = payload[0]
+        size = 4 if version == 4 else 16
+        self.sourceAddress = ipaddress.ip_address(payload[1 : 1 + size])
+        self.destinationAddress = ipaddress.ip_address(payload[1 + size : 1 + 2 * size])
+        (self.protocol, self.sourcePort, self.destinationPort) = struct.unpack_from(
+            "<BHH", payload, 1 + 2 * size
+        )
+
+
+## Flow
+class Flow(object):
+    ## class variables
+    ## @var flowId
+    #  flow ID
+    ## @var fiveTuple
+    #  five-tuple of the flow
+    ## @var stats
+    #  the statistics of the last snapshot, by field name
+    ## @var packetsDropped
+    #  the number of dropped packets, by reason code
+    ## @var bytesDropped
+    #  the number of dropped bytes, by reason code
+    ## @var __slots_
+    #  class variable list
+    __slots_ = ["flowId", "fiveTuple", "stats", "packetsDropped", "bytesDropped"]
+
+    def __init__(self, flowId):
+        """! The initializer.
+        @param self The object pointer.
+        @param flowId The flow ID.
+        """
+        self.flowId = flowId
+        self.fiveTuple = None
+        self.stats = {}
+        self.packetsDropped = []
+        self.bytesDropped = []
+
+
+def parse_snapshot(payload, flows):
+    """! Update the flows with a snapshot.
+    @param payload The payload of a BINARY_SNAPSHOT record.
+    @param flows The flows, by flow ID.
+    @return The time of the snapshot, in ns, and the number of flows updated.
+    """
+    time, count = struct.unpack_from("<qI", payload, 0)
+    offset = 12
+    for _ in range(count):
+        (flowId,) = struct.unpack_from("<I", payload, offset)
+        offset += 4
+        flow = flows.setdefault(flowId, Flow(flowId))
+        times = struct.unpack_from("<9q", payload, offset)
+        offset += 9 * 8
+        counters = struct.unpack_from("<QQIIII", payload, offset)
+        offset += 2 * 8 + 4 * 4
+        flow.stats = dict(zip(TIME_FIELDS + COUNTER_FIELDS, times + counters))
+        (reasons,) = struct.unpack_from("<H", payload, offset)
+        offset += 2
+        flow.packetsDropped = []
+        flow.bytesDropped = []
+        for _ in range(reasons):
+            packets, nbytes = struct.unpack_from("<IQ", payload, offset)
+            offset += 12
+            flow.packetsDropped.append(packets)
+            flow.bytesDropped.append(nbytes)
+    return time, count
+
+
+def read_flows(file_obj):
+    """! Read a binary export file; a truncated last record is ignored.
+    @param file_obj The file.
+    @return The flows, by flow ID, and the number of snapshots.
+    """
+    data = file_obj.read()
+    if data[:8] != b"NS3FMBIN":
+        raise ValueError("not a FlowMonitor binary export file")
+    (version,) = struct.unpack_from("<I", data, 8)
+    if version != 1:
+        raise ValueError("unsupported version %i" % version)
+    offset = 12
+    flows = {}
+    snapshots = 0
+    while offset + 5 <= len(data):
+        record_type, length = struct.unpack_from("<BI", data, offset)
+        offset += 5
+        if offset + length > len(data):
+            break
+        payload = data[offset : offset + length]
+        offset += length
+        if record_type == BINARY_FLOW:
+            (flowId,) = struct.unpack_from("<I", payload, 0)
+            flows.setdefault(flowId, Flow(flowId)).fiveTuple = FiveTuple(payload[4:])
+        elif record_type == BINARY_SNAPSHOT:
+            time, count = parse_snapshot(payload, flows)
+            snapshots += 1
+            print("Snapshot at %.3f s: %i flows updated" % (time * 1e-9, count))
+    return flows, snapshots
+
+
+def main(argv):
+    with open(argv[1], "rb") as file_obj:
+        flows, snapshots = read_flows(file_obj)
+    print("%i snapshots, %i flows" % (snapshots, len(flows)))
+
+    for flowId in sorted(flows):
+        flow = flows[flowId]
+        t = flow.fiveTuple
+        s = flow.stats
+        if t is None or not s:
+            continue
+        proto = {6: "TCP", 17: "UDP"}.get(t.protocol, str(t.protocol))
+        print(
+            "FlowID: %i (%s %s/%s --> %s/%i)"
+            % (
+                flow.flowId,
+                proto,
+                t.sourceAddress,
+                t.sourcePort,
+                t.destinationAddress,
+                t.destinationPort,
+            )
+        )
+        tx_duration = (s["timeLastTxPacket"] - s["timeFirstTxPacket"]) * 1e-9
+        rx_duration = (s["timeLastRxPacket"] - s["timeFirstRxPacket"]) * 1e-9
+        if tx_duration > 0:
+            print("\tTX bitrate: %.2f kbit/s" % (s["txBytes"] * 8 / tx_duration * 1e-3,))
+        else:
+            print("\tTX bitrate: None")
+        if rx_duration > 0:
+            print("\tRX bitrate: %.2f kbit/s" % (s["rxBytes"] * 8 / rx_duration * 1e-3,))
+        else:
+            print("\tRX bitrate: None")
+        if s["rxPackets"]:
+            print("\tMean Delay: %.2f ms" % (s["delaySum"] / s["rxPackets"] * 1e-6,))
+            lost = s["lostPackets"]
+            print("\tPacket Loss Ratio: %.2f %%" % (lost / (s["rxPackets"] + lost) * 100))
+        else:
+            print("\tMean Delay: None")
+            print("\tPacket Loss Ratio: None")
+
+
+if __name__ == "__main__":
+    main(sys.argv)
@@ -161,4 +161,10 @@ FlowMonitorHelper::SerializeToXmlFile(std::string fileName,
     }
 }
 
+void
+FlowMonitorHelper::EnableBinaryExport(std::string fileName, Time interval)
+{
+    GetMonitor()->EnableBinaryExport(fileName, interval);
+}
+
 } // namespace ns3
@@ -108,6 +108,14 @@ class FlowMonitorHelper
      */
     void SerializeToXmlFile(std::string fileName, bool enableHistograms, bool enableProbes);
 
+    /**
+     * Export the flow statistics to a file in a binary format, periodically
+     * @param fileName name or path of the output file that will be created
+     * @param interval the interval between the snapshots, or zero for no periodic snapshot
+     * @see FlowMonitor::EnableBinaryExport
+     */
+    void EnableBinaryExport(std::string fileName, Time interval);
+
   private:
     ObjectFactory m_monitorFactory;        //!< Object factory
     Ptr<FlowMonitor> m_flowMonitor;        //!< the FlowMonitor object
@@ -20,6 +20,11 @@ FlowClassifier::~FlowClassifier()
 {
 }
 
+void
+FlowClassifier::SerializeNewFlowsToBinaryStream(std::ostream& os)
+{
+}
+
 FlowId
 FlowClassifier::GetNewFlowId()
 {
@@ -57,6 +57,12 @@ class FlowClassifier : public SimpleRefCount<FlowClassifier>
     /// @param indent number of spaces to use as base indentation level
     virtual void SerializeToXmlStream(std::ostream& os, uint16_t indent) const = 0;
 
+    /// Serializes the flows classified since the previous call to an
+    /// std::ostream, as FlowMonitor::BINARY_FLOW records.  The default
+    /// implementation serializes nothing.
+    /// @param os the output stream
+    virtual void SerializeNewFlowsToBinaryStream(std::ostream& os);
+
   protected:
     /// Returns a new, unique Flow Identifier
     /// @returns a new FlowId
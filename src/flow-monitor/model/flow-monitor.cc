@@ -8,10 +8,13 @@
 
 #include "flow-monitor.h"
 
+#include "ns3/abort.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <fstream>
 #include <limits>
 #include <sstream>
@@ -40,6 +43,20 @@ FlowMonitor::GetTypeId()
                 TimeValue(Seconds(10)),
                 MakeTimeAccessor(&FlowMonitor::m_maxPerHopDelay),
                 MakeTimeChecker())
+            .AddAttribute("MaxTrackedPackets",
+                          ("The maximum number of packets in flight to track, or 0 for no "
+                           "limit.  Beyond it, the packets seen the longest time ago are "
+                           "considered lost."),
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&FlowMonitor::m_maxTrackedPackets),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("SamplingFactor",
+                          ("Track one packet in N, selected by a hash of its flow and packet "
+                           "identifiers, and count each tracked packet N times in the "
+                           "statistics.  1 tracks all the packets."),
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&FlowMonitor::m_samplingFactor),
+                          MakeUintegerChecker<uint32_t>(1))
             .AddAttribute("StartTime",
                           ("The time when the monitoring starts."),
                           TimeValue(Seconds(0)),
@@ -65,6 +82,13 @@ FlowMonitor::GetTypeId()
                           DoubleValue(0.250),
                           MakeDoubleAccessor(&FlowMonitor::m_flowInterruptionsBinWidth),
                           MakeDoubleChecker<double>())
+            .AddAttribute("HopDelayBinWidth",
+                          ("The width used in the per-probe hop delay histograms, of the "
+                           "delays since the packets were seen by the previous probe.  "
+                           "0 disables these histograms."),
+                          DoubleValue(0),
+                          MakeDoubleAccessor(&FlowMonitor::m_hopDelayBinWidth),
+                          MakeDoubleChecker<double>(0))
             .AddAttribute(
                 "FlowInterruptionsMinTime",
                 ("The minimum inter-arrival time that is considered a flow interruption."),
@@ -75,7 +99,9 @@ FlowMonitor::GetTypeId()
 }
 
 FlowMonitor::FlowMonitor()
-    : m_enabled(false)
+    : m_maxTrackedPackets(0),
+      m_samplingFactor(1),
+      m_enabled(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -86,6 +112,11 @@ FlowMonitor::DoDispose()
     NS_LOG_FUNCTION(this);
     Simulator::Cancel(m_startEvent);
     Simulator::Cancel(m_stopEvent);
+    Simulator::Cancel(m_binaryEvent);
+    Simulator::Cancel(m_binaryDestroyEvent);
+    m_binaryStream.close();
+    m_trackedPackets.clear();
+    m_trackedPacketList.clear();
     for (auto iter = m_classifiers.begin(); iter != m_classifiers.end(); iter++)
     {
         *iter = nullptr;
@@ -102,10 +133,23 @@ inline FlowMonitor::FlowStats&
 FlowMonitor::GetStatsForFlow(FlowId flowId)
 {
     NS_LOG_FUNCTION(this);
+    if (m_binaryStream.is_open())
+    {
+        NotifyFlowUpdated(flowId);
+    }
+    if (flowId < m_flowStatsIndex.size() && m_flowStatsIndex[flowId])
+    {
+        return *m_flowStatsIndex[flowId];
+    }
     auto iter = m_flowStats.find(flowId);
     if (iter == m_flowStats.end())
     {
         FlowMonitor::FlowStats& ref = m_flowStats[flowId];
+        if (flowId >= m_flowStatsIndex.size())
+        {
+            m_flowStatsIndex.resize(flowId + 1, nullptr);
+        }
+        m_flowStatsIndex[flowId] = &ref;
         ref.delaySum = Seconds(0);
         ref.jitterSum = Seconds(0);
         ref.lastDelay = Seconds(0);
@@ -141,24 +185,38 @@ FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
+    if (!IsSampled(flowId, packetId))
+    {
+        return;
+    }
     Time now = Simulator::Now();
-    TrackedPacket& tracked = m_trackedPackets[std::make_pair(flowId, packetId)];
-    tracked.firstSeenTime = now;
-    tracked.lastSeenTime = tracked.firstSeenTime;
-    tracked.timesForwarded = 0;
+    auto [key, inserted] =
+        m_trackedPackets.emplace(GetTrackedPacketKey(flowId, packetId), m_trackedPacketList.end());
+    if (!inserted)
+    {
+        m_trackedPacketList.erase(key->second);
+    }
+    key->second = m_trackedPacketList.insert(m_trackedPacketList.end(),
+                                             {now, now, 0, flowId, packetId});
     NS_LOG_DEBUG("ReportFirstTx: adding tracked packet (flowId=" << flowId << ", packetId="
                                                                  << packetId << ").");
 
-    probe->AddPacketStats(flowId, packetSize, Seconds(0));
+    probe->AddPacketStats(flowId, packetSize, Seconds(0), m_samplingFactor);
 
     FlowStats& stats = GetStatsForFlow(flowId);
-    stats.txBytes += packetSize;
-    stats.txPackets++;
-    if (stats.txPackets == 1)
+    stats.txBytes += static_cast<uint64_t>(packetSize) * m_samplingFactor;
+    stats.txPackets += m_samplingFactor;
+    if (stats.txPackets == m_samplingFactor)
     {
         stats.timeFirstTxPacket = now;
     }
     stats.timeLastTxPacket = now;
+
+    if (m_maxTrackedPackets > 0 && m_trackedPackets.size() > m_maxTrackedPackets)
+    {
+        NS_LOG_DEBUG("ReportFirstTx: too many tracked packets, the oldest one is lost");
+        RemoveLostPacket(m_trackedPacketList.begin());
+    }
 }
 
 void
@@ -173,20 +231,31 @@ FlowMonitor::ReportForwarding(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    std::pair<FlowId, FlowPacketId> key(flowId, packetId);
-    auto tracked = m_trackedPackets.find(key);
-    if (tracked == m_trackedPackets.end())
+    if (!IsSampled(flowId, packetId))
+    {
+        return;
+    }
+    auto key = m_trackedPackets.find(GetTrackedPacketKey(flowId, packetId));
+    if (key == m_trackedPackets.end())
     {
         NS_LOG_WARN("Received packet forward report (flowId="
                     << flowId << ", packetId=" << packetId << ") but not known to be transmitted.");
         return;
     }
 
-    tracked->second.timesForwarded++;
-    tracked->second.lastSeenTime = Simulator::Now();
+    // the packet is the last one seen: move it to the end of the list
+    auto tracked = key->second;
+    m_trackedPacketList.splice(m_trackedPacketList.end(), m_trackedPacketList, tracked);
+    tracked->timesForwarded++;
+    Time now = Simulator::Now();
+    if (m_hopDelayBinWidth > 0)
+    {
+        probe->AddHopDelayStats(flowId, now - tracked->lastSeenTime, m_hopDelayBinWidth);
+    }
+    tracked->lastSeenTime = now;
 
-    Time delay = (Simulator::Now() - tracked->second.firstSeenTime);
-    probe->AddPacketStats(flowId, packetSize, delay);
+    Time delay = (now - tracked->firstSeenTime);
+    probe->AddPacketStats(flowId, packetSize, delay, m_samplingFactor);
 }
 
 void
@@ -201,32 +270,41 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    auto tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
-    if (tracked == m_trackedPackets.end())
+    if (!IsSampled(flowId, packetId))
+    {
+        return;
+    }
+    auto key = m_trackedPackets.find(GetTrackedPacketKey(flowId, packetId));
+    if (key == m_trackedPackets.end())
     {
         NS_LOG_WARN("Received packet last-tx report (flowId="
                     << flowId << ", packetId=" << packetId << ") but not known to be transmitted.");
         return;
     }
+    auto tracked = key->second;
 
     Time now = Simulator::Now();
-    Time delay = (now - tracked->second.firstSeenTime);
-    probe->AddPacketStats(flowId, packetSize, delay);
+    Time delay = (now - tracked->firstSeenTime);
+    probe->AddPacketStats(flowId, packetSize, delay, m_samplingFactor);
+    if (m_hopDelayBinWidth > 0)
+    {
+        probe->AddHopDelayStats(flowId, now - tracked->lastSeenTime, m_hopDelayBinWidth);
+    }
 
     FlowStats& stats = GetStatsForFlow(flowId);
-    stats.delaySum += delay;
+    stats.delaySum += delay * m_samplingFactor;
     stats.delayHistogram.AddValue(delay.GetSeconds());
     if (stats.rxPackets > 0)
     {
         Time jitter = stats.lastDelay - delay;
         if (jitter.IsStrictlyPositive())
         {
-            stats.jitterSum += jitter;
+            stats.jitterSum += jitter * m_samplingFactor;
             stats.jitterHistogram.AddValue(jitter.GetSeconds());
         }
         else
         {
-            stats.jitterSum -= jitter;
+            stats.jitterSum -= jitter * m_samplingFactor;
             stats.jitterHistogram.AddValue(-jitter.GetSeconds());
         }
     }
@@ -240,10 +318,10 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         stats.minDelay = delay;
     }
 
-    stats.rxBytes += packetSize;
+    stats.rxBytes += static_cast<uint64_t>(packetSize) * m_samplingFactor;
     stats.packetSizeHistogram.AddValue((double)packetSize);
-    stats.rxPackets++;
-    if (stats.rxPackets == 1)
+    stats.rxPackets += m_samplingFactor;
+    if (stats.rxPackets == m_samplingFactor)
     {
         stats.timeFirstRxPacket = now;
     }
@@ -257,12 +335,14 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         }
     }
     stats.timeLastRxPacket = now;
-    stats.timesForwarded += tracked->second.timesForwarded;
+    stats.timesForwarded += tracked->timesForwarded * m_samplingFactor;
 
     NS_LOG_DEBUG("ReportLastTx: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                   << packetId << ").");
 
-    m_trackedPackets.erase(tracked); // we don't need to track this packet anymore
+    // we don't need to track this packet anymore
+    m_trackedPacketList.erase(tracked);
+    m_trackedPackets.erase(key);
 }
 
 void
@@ -278,32 +358,48 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
+    if (!IsSampled(flowId, packetId))
+    {
+        return;
+    }
 
-    probe->AddPacketDropStats(flowId, packetSize, reasonCode);
+    probe->AddPacketDropStats(flowId, packetSize, reasonCode, m_samplingFactor);
 
     FlowStats& stats = GetStatsForFlow(flowId);
-    stats.lostPackets++;
+    stats.lostPackets += m_samplingFactor;
     if (stats.packetsDropped.size() < reasonCode + 1)
     {
         stats.packetsDropped.resize(reasonCode + 1, 0);
         stats.bytesDropped.resize(reasonCode + 1, 0);
     }
-    ++stats.packetsDropped[reasonCode];
-    stats.bytesDropped[reasonCode] += packetSize;
+    stats.packetsDropped[reasonCode] += m_samplingFactor;
+    stats.bytesDropped[reasonCode] += static_cast<uint64_t>(packetSize) * m_samplingFactor;
     NS_LOG_DEBUG("++stats.packetsDropped["
                  << reasonCode << "]; // becomes: " << stats.packetsDropped[reasonCode]);
 
-    auto tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
-    if (tracked != m_trackedPackets.end())
+    auto key = m_trackedPackets.find(GetTrackedPacketKey(flowId, packetId));
+    if (key != m_trackedPackets.end())
     {
         // we don't need to track this packet anymore
         // FIXME: this will not necessarily be true with broadcast/multicast
         NS_LOG_DEBUG("ReportDrop: removing tracked packet (flowId=" << flowId << ", packetId="
                                                                     << packetId << ").");
-        m_trackedPackets.erase(tracked);
+        m_trackedPacketList.erase(key->second);
+        m_trackedPackets.erase(key);
     }
 }
 
+void
+FlowMonitor::ReportEcn(Ptr<FlowProbe> probe, FlowId flowId, FlowPacketId packetId, uint8_t ecn)
+{
+    NS_LOG_FUNCTION(this << probe << flowId << packetId << +ecn);
+    if (!m_enabled || !IsSampled(flowId, packetId))
+    {
+        return;
+    }
+    probe->AddPacketEcnStats(flowId, ecn, m_samplingFactor);
+}
+
 const FlowMonitor::FlowStatsContainer&
 FlowMonitor::GetFlowStats() const
 {
@@ -316,23 +412,50 @@ FlowMonitor::CheckForLostPackets(Time maxDelay)
     NS_LOG_FUNCTION(this << maxDelay.As(Time::S));
     Time now = Simulator::Now();
 
-    for (auto iter = m_trackedPackets.begin(); iter != m_trackedPackets.end();)
+    // the packets are sorted by the time they were last seen: only the lost
+    // ones, at the front, are visited
+    while (!m_trackedPacketList.empty() &&
+           now - m_trackedPacketList.front().lastSeenTime >= maxDelay)
     {
-        if (now - iter->second.lastSeenTime >= maxDelay)
-        {
-            // packet is considered lost, add it to the loss statistics
-            auto flow = m_flowStats.find(iter->first.first);
-            NS_ASSERT(flow != m_flowStats.end());
-            flow->second.lostPackets++;
+        RemoveLostPacket(m_trackedPacketList.begin());
+    }
+}
 
-            // we won't track it anymore
-            m_trackedPackets.erase(iter++);
-        }
-        else
-        {
-            iter++;
-        }
+void
+FlowMonitor::RemoveLostPacket(TrackedPacketList::iterator tracked)
+{
+    NS_LOG_FUNCTION(this << tracked->flowId << tracked->packetId);
+    // packet is considered lost, add it to the loss statistics
+    NS_ASSERT(m_flowStats.find(tracked->flowId) != m_flowStats.end());
+    GetStatsForFlow(tracked->flowId).lostPackets += m_samplingFactor;
+
+    // we won't track it anymore
+    m_trackedPackets.erase(GetTrackedPacketKey(tracked->flowId, tracked->packetId));
+    m_trackedPacketList.erase(tracked);
+}
+
+uint64_t
+FlowMonitor::GetTrackedPacketKey(FlowId flowId, FlowPacketId packetId)
+{
+    return (static_cast<uint64_t>(flowId) << 32) | packetId;
+}
+
+bool
+FlowMonitor::IsSampled(FlowId flowId, FlowPacketId packetId) const
+{
+    if (m_samplingFactor == 1)
+    {
+        return true;
     }
+    // mix the bits of the key (the finalizer of MurmurHash3), so that the
+    // successive packets of a flow are sampled independently
+    uint64_t hash = GetTrackedPacketKey(flowId, packetId);
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+    return hash % m_samplingFactor == 0;
 }
 
 void
@@ -413,6 +536,7 @@ FlowMonitor::StopRightNow()
     }
     m_enabled = false;
     CheckForLostPackets();
+    ExportBinarySnapshot();
 }
 
 void
@@ -529,6 +653,130 @@ FlowMonitor::SerializeToXmlFile(std::string fileName, bool enableHistograms, boo
     os.close();
 }
 
+void
+FlowMonitor::EnableBinaryExport(std::string fileName, Time interval)
+{
+    NS_LOG_FUNCTION(this << fileName << interval.As(Time::S));
+    NS_ABORT_MSG_IF(m_binaryStream.is_open(), "The binary export is already enabled");
+    m_binaryStream.open(fileName, std::ios::out | std::ios::binary);
+    NS_ABORT_MSG_UNLESS(m_binaryStream.is_open(), "Cannot open " << fileName);
+    m_binaryStream.write("NS3FMBIN", 8);
+    std::string version;
+    AppendBinaryValue(version, 1, 4);
+    m_binaryStream << version;
+    // the flows seen before the export are in the first snapshot
+    for (const auto& [flowId, flowStats] : m_flowStats)
+    {
+        NotifyFlowUpdated(flowId);
+    }
+    m_binaryDestroyEvent = Simulator::ScheduleDestroy(&FlowMonitor::ExportBinarySnapshot, this);
+    m_binaryInterval = interval;
+    if (m_binaryInterval.IsStrictlyPositive())
+    {
+        m_binaryEvent = Simulator::Schedule(m_binaryInterval,
+                                            &FlowMonitor::PeriodicExportBinarySnapshot,
+                                            this);
+    }
+}
+
+void
+FlowMonitor::PeriodicExportBinarySnapshot()
+{
+    ExportBinarySnapshot();
+    m_binaryEvent =
+        Simulator::Schedule(m_binaryInterval, &FlowMonitor::PeriodicExportBinarySnapshot, this);
+}
+
+void
+FlowMonitor::NotifyFlowUpdated(FlowId flowId)
+{
+    if (flowId >= m_flowUpdated.size())
+    {
+        m_flowUpdated.resize(flowId + 1, false);
+    }
+    if (!m_flowUpdated[flowId])
+    {
+        m_flowUpdated[flowId] = true;
+        m_updatedFlows.push_back(flowId);
+    }
+}
+
+void
+FlowMonitor::ExportBinarySnapshot()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_binaryStream.is_open())
+    {
+        return;
+    }
+    CheckForLostPackets();
+
+    // the flows first, so that the snapshot only refers to known flows
+    for (const auto& classifier : m_classifiers)
+    {
+        classifier->SerializeNewFlowsToBinaryStream(m_binaryStream);
+    }
+
+    std::sort(m_updatedFlows.begin(), m_updatedFlows.end());
+    std::string payload;
+    AppendBinaryValue(payload, Simulator::Now().GetNanoSeconds(), 8);
+    AppendBinaryValue(payload, m_updatedFlows.size(), 4);
+    for (FlowId flowId : m_updatedFlows)
+    {
+        m_flowUpdated[flowId] = false;
+        const FlowStats& flowStats = *m_flowStatsIndex[flowId];
+        AppendBinaryValue(payload, flowId, 4);
+        for (const Time* time : {&flowStats.timeFirstTxPacket,
+                                 &flowStats.timeFirstRxPacket,
+                                 &flowStats.timeLastTxPacket,
+                                 &flowStats.timeLastRxPacket,
+                                 &flowStats.delaySum,
+                                 &flowStats.jitterSum,
+                                 &flowStats.lastDelay,
+                                 &flowStats.maxDelay,
+                                 &flowStats.minDelay})
+        {
+            AppendBinaryValue(payload, time->GetNanoSeconds(), 8);
+        }
+        AppendBinaryValue(payload, flowStats.txBytes, 8);
+        AppendBinaryValue(payload, flowStats.rxBytes, 8);
+        AppendBinaryValue(payload, flowStats.txPackets, 4);
+        AppendBinaryValue(payload, flowStats.rxPackets, 4);
+        AppendBinaryValue(payload, flowStats.lostPackets, 4);
+        AppendBinaryValue(payload, flowStats.timesForwarded, 4);
+        AppendBinaryValue(payload, flowStats.packetsDropped.size(), 2);
+        for (std::size_t reasonCode = 0; reasonCode < flowStats.packetsDropped.size();
+             reasonCode++)
+        {
+            AppendBinaryValue(payload, flowStats.packetsDropped[reasonCode], 4);
+            AppendBinaryValue(payload, flowStats.bytesDropped[reasonCode], 8);
+        }
+    }
+    m_updatedFlows.clear();
+    WriteBinaryRecord(m_binaryStream, BINARY_SNAPSHOT, payload);
+    m_binaryStream.flush();
+}
+
+void
+FlowMonitor::AppendBinaryValue(std::string& payload, uint64_t value, uint8_t size)
+{
+    for (uint8_t i = 0; i < size; i++)
+    {
+        payload.push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+    }
+}
+
+void
+FlowMonitor::WriteBinaryRecord(std::ostream& os,
+                               BinaryRecordType type,
+                               const std::string& payload)
+{
+    std::string header;
+    AppendBinaryValue(header, type, 1);
+    AppendBinaryValue(header, payload.size(), 4);
+    os << header << payload;
+}
+
 void
 FlowMonitor::ResetAllStats()
 {
@@ -537,6 +785,10 @@ FlowMonitor::ResetAllStats()
     for (auto& iter : m_flowStats)
     {
         auto& flowStat = iter.second;
+        if (m_binaryStream.is_open())
+        {
+            NotifyFlowUpdated(iter.first);
+        }
         flowStat.delaySum = Seconds(0);
         flowStat.jitterSum = Seconds(0);
         flowStat.lastDelay = Seconds(0);
@@ -18,7 +18,10 @@
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 
+#include <fstream>
+#include <list>
 #include <map>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -36,6 +39,19 @@ namespace ns3
  * The FlowMonitor class is responsible for coordinating efforts
  * regarding probes, and collects end-to-end flow statistics.
  *
+ * The packets in flight are tracked in a hash table, and in a list sorted
+ * by the time they were last seen, so that the lost packets are found
+ * without a scan of all the tracked packets.  The MaxTrackedPackets
+ * attribute bounds the number of tracked packets: beyond it, the packets
+ * seen the longest time ago are considered lost.
+ *
+ * With a SamplingFactor N larger than one, only one packet in N is
+ * tracked, selected by a hash of its flow and packet identifiers, so that
+ * all the probes select the same packets, and each sampled packet counts
+ * for N packets in the statistics: the packet and byte counts, and the
+ * sums of delays, are unbiased estimates.  The histograms, the jitter
+ * (between successive sampled packets), and the times of the first and
+ * last packets are those of the sampled packets.
  */
 class FlowMonitor : public Object
 {
@@ -207,6 +223,14 @@ class FlowMonitor : public Object
                     FlowPacketId packetId,
                     uint32_t packetSize,
                     uint32_t reasonCode);
+    /// FlowProbe implementations are supposed to call this method to
+    /// report the ECN codepoint of a packet seen by the probe, after
+    /// reporting the packet itself.
+    /// @param probe the reporting probe
+    /// @param flowId flow identification
+    /// @param packetId Packet ID
+    /// @param ecn the ECN codepoint, the two low bits of the IP TOS or traffic class
+    void ReportEcn(Ptr<FlowProbe> probe, FlowId flowId, FlowPacketId packetId, uint8_t ecn);
 
     /// Check right now for packets that appear to be lost
     void CheckForLostPackets();
@@ -266,6 +290,60 @@ class FlowMonitor : public Object
     /// @param enableProbes if true, include also the per-probe/flow pair statistics in the output
     void SerializeToXmlFile(std::string fileName, bool enableHistograms, bool enableProbes);
 
+    /// The types of the records of the binary export
+    enum BinaryRecordType : uint8_t
+    {
+        /// The five-tuple of a flow, written by the FlowClassifier: flowId (u32),
+        /// IP version (u8, 4 or 6), source and destination addresses (4 or 16 bytes
+        /// each), protocol (u8), source and destination ports (u16 each)
+        BINARY_FLOW = 1,
+        /// The statistics of the flows updated since the previous snapshot: time
+        /// (i64, ns), number of flows (u32), and for each flow: flowId (u32), the
+        /// times timeFirstTxPacket, timeFirstRxPacket, timeLastTxPacket,
+        /// timeLastRxPacket, delaySum, jitterSum, lastDelay, maxDelay and minDelay
+        /// (i64 each, ns), txBytes and rxBytes (u64 each), txPackets, rxPackets,
+        /// lostPackets and timesForwarded (u32 each), the number of drop reason
+        /// codes (u16), and for each reason code, packetsDropped (u32) and
+        /// bytesDropped (u64)
+        BINARY_SNAPSHOT = 2,
+    };
+
+    /// Export the flow statistics to a file in a binary format, periodically,
+    /// when the monitoring stops, and when the simulator is destroyed.
+    ///
+    /// The file starts with the magic string "NS3FMBIN" and the version of the
+    /// format (u32, 1), followed by records: a type (u8, BinaryRecordType), the
+    /// length of the payload (u32), and the payload.  All the values are little
+    /// endian.  Each snapshot holds only the flows updated since the previous one,
+    /// so that its cost does not depend on the number of idle flows, and the file
+    /// is flushed after each snapshot, so that it can be read if the simulation
+    /// does not complete.  The statistics of a flow are those of its last
+    /// snapshot.  The histograms and the per-probe statistics are not exported.
+    ///
+    /// src/flow-monitor/examples/flowmon-parse-binary.py reads these files.
+    ///
+    /// @param fileName name or path of the output file that will be created
+    /// @param interval the interval between the snapshots, or zero for no periodic snapshot
+    void EnableBinaryExport(std::string fileName, Time interval);
+
+    /// Write a snapshot of the flows updated since the previous snapshot to the
+    /// file of the binary export, if enabled
+    void ExportBinarySnapshot();
+
+    /// Append a value to the payload of a binary export record, in little endian
+    /// @param payload the payload
+    /// @param value the value
+    /// @param size the number of bytes of the value
+    static void AppendBinaryValue(std::string& payload, uint64_t value, uint8_t size);
+
+    /// Write a record to a binary export file
+    /// @param os the output stream
+    /// @param type the type of the record
+    /// @param payload the payload of the record
+    static void WriteBinaryRecord(std::ostream& os,
+                                  BinaryRecordType type,
+                                  const std::string& payload);
+
     /// Reset all the statistics
     void ResetAllStats();
 
@@ -280,18 +358,34 @@ class FlowMonitor : public Object
         Time firstSeenTime;      //!< absolute time when the packet was first seen by a probe
         Time lastSeenTime;       //!< absolute time when the packet was last seen by a probe
         uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
+        FlowId flowId;           //!< flow identification
+        FlowPacketId packetId;   //!< Packet ID
     };
 
     /// FlowId --> FlowStats
     FlowStatsContainer m_flowStats;
-
+    /// The FlowStats of m_flowStats, indexed by FlowId
+    std::vector<FlowStats*> m_flowStatsIndex;
+    /// The flows updated since the previous binary snapshot, by FlowId
+    std::vector<bool> m_flowUpdated;
+    /// The flows updated since the previous binary snapshot
+    std::vector<FlowId> m_updatedFlows;
+    std::ofstream m_binaryStream; //!< The file of the binary export
+    Time m_binaryInterval;        //!< The interval between the binary snapshots
+    EventId m_binaryEvent;        //!< The next binary snapshot
+    EventId m_binaryDestroyEvent; //!< The binary snapshot at the end of the simulation
+
+    /// Tracked packets, sorted by the time they were last seen
+    typedef std::list<TrackedPacket> TrackedPacketList;
     /// (FlowId,PacketId) --> TrackedPacket
-    typedef std::map<std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
-    TrackedPacketMap m_trackedPackets; //!< Tracked packets
-    Time m_maxPerHopDelay;             //!< Minimum per-hop delay
-    FlowProbeContainer m_flowProbes;   //!< all the FlowProbes
+    typedef std::unordered_map<uint64_t, TrackedPacketList::iterator> TrackedPacketMap;
+    TrackedPacketList m_trackedPacketList; //!< Tracked packets, by last seen time
+    TrackedPacketMap m_trackedPackets;     //!< Tracked packets, by (FlowId,PacketId)
+    Time m_maxPerHopDelay;                 //!< Minimum per-hop delay
+    uint32_t m_maxTrackedPackets;          //!< Maximum number of tracked packets, or 0
+    uint32_t m_samplingFactor;             //!< One packet in m_samplingFactor is tracked
+    FlowProbeContainer m_flowProbes;       //!< all the FlowProbes
 
-    // note: this is needed only for serialization
     std::list<Ptr<FlowClassifier>> m_classifiers; //!< the FlowClassifiers
 
     EventId m_startEvent;               //!< Start event
@@ -301,6 +395,7 @@ class FlowMonitor : public Object
     double m_jitterBinWidth;            //!< Jitter bin width (for histograms)
     double m_packetSizeBinWidth;        //!< packet size bin width (for histograms)
     double m_flowInterruptionsBinWidth; //!< Flow interruptions bin width (for histograms)
+    double m_hopDelayBinWidth;          //!< Per-probe hop delay bin width (0 to disable)
     Time m_flowInterruptionsMinTime;    //!< Flow interruptions minimum time
 
     /// Get the stats for a given flow
@@ -310,6 +405,29 @@ class FlowMonitor : public Object
 
     /// Periodic function to check for lost packets and prune statistics
     void PeriodicCheckForLostPackets();
+
+    /// Periodic function to write the binary snapshots
+    void PeriodicExportBinarySnapshot();
+
+    /// Note that the stats of a flow are updated, for the binary export
+    /// @param flowId the Flow identification
+    void NotifyFlowUpdated(FlowId flowId);
+
+    /// Get the key of a packet in m_trackedPackets
+    /// @param flowId the Flow identification
+    /// @param packetId the Packet ID
+    /// @returns the key
+    static uint64_t GetTrackedPacketKey(FlowId flowId, FlowPacketId packetId);
+
+    /// Check if a packet is sampled, i.e., tracked
+    /// @param flowId the Flow identification
+    /// @param packetId the Packet ID
+    /// @returns true if the packet is sampled
+    bool IsSampled(FlowId flowId, FlowPacketId packetId) const;
+
+    /// Stop tracking a packet considered lost, and add it to the loss statistics
+    /// @param tracked the tracked packet
+    void RemoveLostPacket(TrackedPacketList::iterator tracked);
 };
 
 } // namespace ns3
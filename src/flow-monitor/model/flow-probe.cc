@@ -42,16 +42,22 @@ FlowProbe::DoDispose()
 }
 
 void
-FlowProbe::AddPacketStats(FlowId flowId, uint32_t packetSize, Time delayFromFirstProbe)
+FlowProbe::AddPacketStats(FlowId flowId,
+                          uint32_t packetSize,
+                          Time delayFromFirstProbe,
+                          uint32_t weight)
 {
     FlowStats& flow = m_stats[flowId];
-    flow.delayFromFirstProbeSum += delayFromFirstProbe;
-    flow.bytes += packetSize;
-    ++flow.packets;
+    flow.delayFromFirstProbeSum += delayFromFirstProbe * weight;
+    flow.bytes += static_cast<uint64_t>(packetSize) * weight;
+    flow.packets += weight;
 }
 
 void
-FlowProbe::AddPacketDropStats(FlowId flowId, uint32_t packetSize, uint32_t reasonCode)
+FlowProbe::AddPacketDropStats(FlowId flowId,
+                              uint32_t packetSize,
+                              uint32_t reasonCode,
+                              uint32_t weight)
 {
     FlowStats& flow = m_stats[flowId];
 
@@ -60,8 +66,25 @@ FlowProbe::AddPacketDropStats(FlowId flowId, uint32_t packetSize, uint32_t reaso
         flow.packetsDropped.resize(reasonCode + 1, 0);
         flow.bytesDropped.resize(reasonCode + 1, 0);
     }
-    ++flow.packetsDropped[reasonCode];
-    flow.bytesDropped[reasonCode] += packetSize;
+    flow.packetsDropped[reasonCode] += weight;
+    flow.bytesDropped[reasonCode] += static_cast<uint64_t>(packetSize) * weight;
+}
+
+void
+FlowProbe::AddPacketEcnStats(FlowId flowId, uint8_t ecn, uint32_t weight)
+{
+    m_stats[flowId].ecnPackets[ecn & 0x03] += weight;
+}
+
+void
+FlowProbe::AddHopDelayStats(FlowId flowId, Time hopDelay, double binWidth)
+{
+    FlowStats& flow = m_stats[flowId];
+    if (flow.hopDelayHistogram.GetNBins() == 0)
+    {
+        flow.hopDelayHistogram.SetDefaultBinWidth(binWidth);
+    }
+    flow.hopDelayHistogram.AddValue(hopDelay.GetSeconds());
 }
 
 FlowProbe::Stats
@@ -99,6 +122,19 @@ FlowProbe::SerializeToXmlStream(std::ostream& os, uint16_t indent, uint32_t inde
             os << "<bytesDropped reasonCode=\"" << reasonCode << "\""
                << " bytes=\"" << iter->second.bytesDropped[reasonCode] << "\" />\n";
         }
+        const auto& ecn = iter->second.ecnPackets;
+        if (ecn[0] + ecn[1] + ecn[2] + ecn[3] > 0)
+        {
+            os << std::string(indent, ' ');
+            os << "<ecnPackets notEct=\"" << ecn[0] << "\""
+               << " ect1=\"" << ecn[1] << "\""
+               << " ect0=\"" << ecn[2] << "\""
+               << " ce=\"" << ecn[3] << "\" />\n";
+        }
+        if (iter->second.hopDelayHistogram.GetNBins() > 0)
+        {
+            iter->second.hopDelayHistogram.SerializeToXmlStream(os, indent, "hopDelayHistogram");
+        }
         indent -= 2;
         os << std::string(indent, ' ') << "</FlowStats>\n";
     }
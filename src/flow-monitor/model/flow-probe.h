@@ -11,9 +11,12 @@
 
 #include "flow-classifier.h"
 
+#include "ns3/histogram.h"
 #include "ns3/nstime.h"
 #include "ns3/object.h"
 
+#include <array>
+#include <cstdint>
 #include <map>
 #include <vector>
 
@@ -51,7 +54,8 @@ class FlowProbe : public Object
         FlowStats()
             : delayFromFirstProbeSum(),
               bytes(0),
-              packets(0)
+              packets(0),
+              ecnPackets()
         {
         }
 
@@ -66,6 +70,12 @@ class FlowProbe : public Object
         uint64_t bytes;
         /// Number of packets seen of this flow
         uint32_t packets;
+        /// ecnPackets[codepoint] => number of packets seen with the ECN
+        /// codepoint (0: Not-ECT, 1: ECT(1), 2: ECT(0), 3: CE)
+        std::array<uint32_t, 4> ecnPackets;
+        /// Histogram of the delays of the hop ending at this probe, from the
+        /// previous probe that saw the packets
+        Histogram hopDelayHistogram;
     };
 
     /// Container to map FlowId -> FlowStats
@@ -75,12 +85,30 @@ class FlowProbe : public Object
     /// @param flowId the flow Identifier
     /// @param packetSize the packet size
     /// @param delayFromFirstProbe packet delay
-    void AddPacketStats(FlowId flowId, uint32_t packetSize, Time delayFromFirstProbe);
+    /// @param weight the number of packets the packet stands for, when sampled
+    void AddPacketStats(FlowId flowId,
+                        uint32_t packetSize,
+                        Time delayFromFirstProbe,
+                        uint32_t weight = 1);
     /// Add a packet drop data to the flow stats
     /// @param flowId the flow Identifier
     /// @param packetSize the packet size
     /// @param reasonCode reason code for the drop
-    void AddPacketDropStats(FlowId flowId, uint32_t packetSize, uint32_t reasonCode);
+    /// @param weight the number of packets the packet stands for, when sampled
+    void AddPacketDropStats(FlowId flowId,
+                            uint32_t packetSize,
+                            uint32_t reasonCode,
+                            uint32_t weight = 1);
+    /// Add the ECN codepoint of a packet to the flow stats
+    /// @param flowId the flow Identifier
+    /// @param ecn the ECN codepoint, the two low bits of the IP TOS or traffic class
+    /// @param weight the number of packets the packet stands for, when sampled
+    void AddPacketEcnStats(FlowId flowId, uint8_t ecn, uint32_t weight = 1);
+    /// Add the delay of the hop ending at this probe to the flow stats
+    /// @param flowId the flow Identifier
+    /// @param hopDelay the time since the packet was seen by the previous probe
+    /// @param binWidth the bin width of the histogram, used when it is created
+    void AddHopDelayStats(FlowId flowId, Time hopDelay, double binWidth);
 
     /// Get the partial flow statistics stored in this probe.  With this
     /// information you can, for example, find out what is the delay
@@ -8,6 +8,8 @@
 
 #include "ipv4-flow-classifier.h"
 
+#include "flow-monitor.h"
+
 #include "ns3/packet.h"
 #include "ns3/tcp-header.h"
 #include "ns3/udp-header.h"
@@ -80,7 +82,21 @@ operator==(const Ipv4FlowClassifier::FiveTuple& t1, const Ipv4FlowClassifier::Fi
             t1.sourcePort == t2.sourcePort && t1.destinationPort == t2.destinationPort);
 }
 
+std::size_t
+Ipv4FlowClassifier::FiveTupleHash::operator()(const FiveTuple& tuple) const
+{
+    std::size_t hash = Ipv4AddressHash()(tuple.sourceAddress);
+    auto combine = [&hash](std::size_t value) {
+        hash ^= value + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    };
+    combine(Ipv4AddressHash()(tuple.destinationAddress));
+    combine((static_cast<std::size_t>(tuple.protocol) << 32) |
+            (static_cast<std::size_t>(tuple.sourcePort) << 16) | tuple.destinationPort);
+    return hash;
+}
+
 Ipv4FlowClassifier::Ipv4FlowClassifier()
+    : m_serializedFlows(0)
 {
 }
 
@@ -141,44 +157,53 @@ Ipv4FlowClassifier::Classify(const Ipv4Header& ipHeader,
     {
         FlowId newFlowId = GetNewFlowId();
         insert.first->second = newFlowId;
-        m_flowPktIdMap[newFlowId] = 0;
-        m_flowDscpMap[newFlowId];
+        NS_ASSERT(newFlowId == m_flows.size() + 1);
+        m_flows.push_back({tuple, 0, {}});
     }
     else
     {
-        m_flowPktIdMap[insert.first->second]++;
+        m_flows[insert.first->second - 1].lastPacketId++;
     }
+    FlowInfo& flow = m_flows[insert.first->second - 1];
 
-    // increment the counter of packets with the same DSCP value
+    // increment the counter of packets with the same DSCP value; a flow has
+    // very few DSCP values, usually one
     Ipv4Header::DscpType dscp = ipHeader.GetDscp();
-    auto dscpInserter = m_flowDscpMap[insert.first->second].insert(
-        std::pair<Ipv4Header::DscpType, uint32_t>(dscp, 1));
-
-    // if the insertion did not succeed, we need to increment the counter
-    if (!dscpInserter.second)
+    auto dscpCount = std::lower_bound(flow.dscpCounts.begin(),
+                                      flow.dscpCounts.end(),
+                                      dscp,
+                                      [](const auto& count, Ipv4Header::DscpType value) {
+                                          return count.first < value;
+                                      });
+    if (dscpCount != flow.dscpCounts.end() && dscpCount->first == dscp)
+    {
+        dscpCount->second++;
+    }
+    else
     {
-        m_flowDscpMap[insert.first->second][dscp]++;
+        flow.dscpCounts.insert(dscpCount, {dscp, 1});
     }
 
     *out_flowId = insert.first->second;
-    *out_packetId = m_flowPktIdMap[*out_flowId];
+    *out_packetId = flow.lastPacketId;
 
     return true;
 }
 
-Ipv4FlowClassifier::FiveTuple
-Ipv4FlowClassifier::FindFlow(FlowId flowId) const
+const Ipv4FlowClassifier::FlowInfo&
+Ipv4FlowClassifier::GetFlowInfo(FlowId flowId) const
 {
-    for (auto iter = m_flowMap.begin(); iter != m_flowMap.end(); iter++)
+    if (flowId == 0 || flowId > m_flows.size())
     {
-        if (iter->second == flowId)
-        {
-            return iter->first;
-        }
+        NS_FATAL_ERROR("Could not find the flow with ID " << flowId);
     }
-    NS_FATAL_ERROR("Could not find the flow with ID " << flowId);
-    FiveTuple retval = {Ipv4Address::GetZero(), Ipv4Address::GetZero(), 0, 0, 0};
-    return retval;
+    return m_flows[flowId - 1];
+}
+
+Ipv4FlowClassifier::FiveTuple
+Ipv4FlowClassifier::FindFlow(FlowId flowId) const
+{
+    return GetFlowInfo(flowId).tuple;
 }
 
 bool
@@ -191,15 +216,7 @@ Ipv4FlowClassifier::SortByCount::operator()(std::pair<Ipv4Header::DscpType, uint
 std::vector<std::pair<Ipv4Header::DscpType, uint32_t>>
 Ipv4FlowClassifier::GetDscpCounts(FlowId flowId) const
 {
-    auto flow = m_flowDscpMap.find(flowId);
-
-    if (flow == m_flowDscpMap.end())
-    {
-        NS_FATAL_ERROR("Could not find the flow with ID " << flowId);
-    }
-
-    std::vector<std::pair<Ipv4Header::DscpType, uint32_t>> v(flow->second.begin(),
-                                                             flow->second.end());
+    std::vector<std::pair<Ipv4Header::DscpType, uint32_t>> v = GetFlowInfo(flowId).dscpCounts;
     std::sort(v.begin(), v.end(), SortByCount());
     return v;
 }
@@ -210,28 +227,29 @@ Ipv4FlowClassifier::SerializeToXmlStream(std::ostream& os, uint16_t indent) cons
     Indent(os, indent);
     os << "<Ipv4FlowClassifier>\n";
 
+    // the flows, in the order of their five-tuples
+    std::vector<std::pair<FiveTuple, FlowId>> flows(m_flowMap.begin(), m_flowMap.end());
+    std::sort(flows.begin(), flows.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+
     indent += 2;
-    for (auto iter = m_flowMap.begin(); iter != m_flowMap.end(); iter++)
+    for (const auto& [tuple, flowId] : flows)
     {
         Indent(os, indent);
-        os << "<Flow flowId=\"" << iter->second << "\""
-           << " sourceAddress=\"" << iter->first.sourceAddress << "\""
-           << " destinationAddress=\"" << iter->first.destinationAddress << "\""
-           << " protocol=\"" << int(iter->first.protocol) << "\""
-           << " sourcePort=\"" << iter->first.sourcePort << "\""
-           << " destinationPort=\"" << iter->first.destinationPort << "\">\n";
+        os << "<Flow flowId=\"" << flowId << "\""
+           << " sourceAddress=\"" << tuple.sourceAddress << "\""
+           << " destinationAddress=\"" << tuple.destinationAddress << "\""
+           << " protocol=\"" << int(tuple.protocol) << "\""
+           << " sourcePort=\"" << tuple.sourcePort << "\""
+           << " destinationPort=\"" << tuple.destinationPort << "\">\n";
 
         indent += 2;
-        auto flow = m_flowDscpMap.find(iter->second);
-
-        if (flow != m_flowDscpMap.end())
+        for (const auto& [dscp, packets] : GetFlowInfo(flowId).dscpCounts)
         {
-            for (auto i = flow->second.begin(); i != flow->second.end(); i++)
-            {
-                Indent(os, indent);
-                os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t>(i->first) << "\""
-                   << " packets=\"" << std::dec << i->second << "\" />\n";
-            }
+            Indent(os, indent);
+            os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t>(dscp) << "\""
+               << " packets=\"" << std::dec << packets << "\" />\n";
         }
 
         indent -= 2;
@@ -244,4 +262,25 @@ Ipv4FlowClassifier::SerializeToXmlStream(std::ostream& os, uint16_t indent) cons
     os << "</Ipv4FlowClassifier>\n";
 }
 
+void
+Ipv4FlowClassifier::SerializeNewFlowsToBinaryStream(std::ostream& os)
+{
+    for (; m_serializedFlows < m_flows.size(); m_serializedFlows++)
+    {
+        const FiveTuple& tuple = m_flows[m_serializedFlows].tuple;
+        std::string payload;
+        FlowMonitor::AppendBinaryValue(payload, m_serializedFlows + 1, 4);
+        FlowMonitor::AppendBinaryValue(payload, 4, 1);
+        uint8_t address[4];
+        tuple.sourceAddress.Serialize(address);
+        payload.append(reinterpret_cast<const char*>(address), 4);
+        tuple.destinationAddress.Serialize(address);
+        payload.append(reinterpret_cast<const char*>(address), 4);
+        FlowMonitor::AppendBinaryValue(payload, tuple.protocol, 1);
+        FlowMonitor::AppendBinaryValue(payload, tuple.sourcePort, 2);
+        FlowMonitor::AppendBinaryValue(payload, tuple.destinationPort, 2);
+        FlowMonitor::WriteBinaryRecord(os, FlowMonitor::BINARY_FLOW, payload);
+    }
+}
+
 } // namespace ns3
@@ -337,6 +337,7 @@ Ipv4FlowProbe::SendOutgoingLogger(const Ipv4Header& ipHeader,
         NS_LOG_DEBUG("ReportFirstTx (" << this << ", " << flowId << ", " << packetId << ", " << size
                                        << "); " << ipHeader << *ipPayload);
         m_flowMonitor->ReportFirstTx(this, flowId, packetId, size);
+        m_flowMonitor->ReportEcn(this, flowId, packetId, ipHeader.GetEcn());
 
         // tag the packet with the flow id and packet id, so that the packet can be identified even
         // when Ipv4Header is not accessible at some non-IPv4 protocol layer
@@ -377,6 +378,7 @@ Ipv4FlowProbe::ForwardLogger(const Ipv4Header& ipHeader,
         NS_LOG_DEBUG("ReportForwarding (" << this << ", " << flowId << ", " << packetId << ", "
                                           << size << ");");
         m_flowMonitor->ReportForwarding(this, flowId, packetId, size);
+        m_flowMonitor->ReportEcn(this, flowId, packetId, ipHeader.GetEcn());
     }
 }
 
@@ -403,6 +405,7 @@ Ipv4FlowProbe::ForwardUpLogger(const Ipv4Header& ipHeader,
         NS_LOG_DEBUG("ReportLastRx (" << this << ", " << flowId << ", " << packetId << ", " << size
                                       << "); " << ipHeader << *ipPayload);
         m_flowMonitor->ReportLastRx(this, flowId, packetId, size);
+        m_flowMonitor->ReportEcn(this, flowId, packetId, ipHeader.GetEcn());
     }
 }
 
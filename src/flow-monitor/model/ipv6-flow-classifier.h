@@ -14,8 +14,10 @@
 
 #include "ns3/ipv6-header.h"
 
-#include <map>
 #include <stdint.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -39,6 +41,15 @@ class Ipv6FlowClassifier : public FlowClassifier
         uint16_t destinationPort;       //!< Destination port
     };
 
+    /// Hash function of a FiveTuple
+    struct FiveTupleHash
+    {
+        /// Hash a FiveTuple
+        /// @param tuple the FiveTuple
+        /// @returns the hash
+        std::size_t operator()(const FiveTuple& tuple) const;
+    };
+
     Ipv6FlowClassifier();
 
     /// @brief try to classify the packet into flow-id and packet-id
@@ -82,13 +93,31 @@ class Ipv6FlowClassifier : public FlowClassifier
 
     void SerializeToXmlStream(std::ostream& os, uint16_t indent) const override;
 
+    void SerializeNewFlowsToBinaryStream(std::ostream& os) override;
+
   private:
+    /// The state of a flow
+    struct FlowInfo
+    {
+        FiveTuple tuple;           //!< The five-tuple of the flow
+        FlowPacketId lastPacketId; //!< The identifier of the last packet of the flow
+        /// (DSCP value, packet count) pairs, sorted by DSCP value
+        std::vector<std::pair<Ipv6Header::DscpType, uint32_t>> dscpCounts;
+    };
+
+    /**
+     * Get the state of a flow.
+     * @param flowId the FlowId of the flow
+     * @returns the state of the flow
+     */
+    const FlowInfo& GetFlowInfo(FlowId flowId) const;
+
     /// Map to Flows Identifiers to FlowIds
-    std::map<FiveTuple, FlowId> m_flowMap;
-    /// Map to FlowIds to FlowPacketId
-    std::map<FlowId, FlowPacketId> m_flowPktIdMap;
-    /// Map FlowIds to (DSCP value, packet count) pairs
-    std::map<FlowId, std::map<Ipv6Header::DscpType, uint32_t>> m_flowDscpMap;
+    std::unordered_map<FiveTuple, FlowId, FiveTupleHash> m_flowMap;
+    /// The state of the flows, indexed by FlowId - 1
+    std::vector<FlowInfo> m_flows;
+    /// The number of flows serialized to the binary export
+    std::size_t m_serializedFlows;
 };
 
 /**
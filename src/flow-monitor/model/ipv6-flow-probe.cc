@@ -280,6 +280,7 @@ Ipv6FlowProbe::SendOutgoingLogger(const Ipv6Header& ipHeader,
         NS_LOG_DEBUG("ReportFirstTx (" << this << ", " << flowId << ", " << packetId << ", " << size
                                        << "); " << ipHeader << *ipPayload);
         m_flowMonitor->ReportFirstTx(this, flowId, packetId, size);
+        m_flowMonitor->ReportEcn(this, flowId, packetId, ipHeader.GetEcn());
 
         // tag the packet with the flow id and packet id, so that the packet can be identified even
         // when Ipv6Header is not accessible at some non-IPv6 protocol layer
@@ -305,6 +306,7 @@ Ipv6FlowProbe::ForwardLogger(const Ipv6Header& ipHeader,
         NS_LOG_DEBUG("ReportForwarding (" << this << ", " << flowId << ", " << packetId << ", "
                                           << size << ");");
         m_flowMonitor->ReportForwarding(this, flowId, packetId, size);
+        m_flowMonitor->ReportEcn(this, flowId, packetId, ipHeader.GetEcn());
     }
 }
 
@@ -325,6 +327,7 @@ Ipv6FlowProbe::ForwardUpLogger(const Ipv6Header& ipHeader,
         NS_LOG_DEBUG("ReportLastRx (" << this << ", " << flowId << ", " << packetId << ", " << size
                                       << ");");
         m_flowMonitor->ReportLastRx(this, flowId, packetId, size);
+        m_flowMonitor->ReportEcn(this, flowId, packetId, ipHeader.GetEcn());
     }
 }
 
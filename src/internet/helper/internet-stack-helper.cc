@@ -34,6 +34,7 @@
 #include "ns3/object.h"
 #include "ns3/packet-socket-factory.h"
 #include "ns3/simulator.h"
+#include "ns3/startup-timer.h"
 #include "ns3/string.h"
 #include "ns3/traffic-control-layer.h"
 
@@ -256,6 +257,7 @@ InternetStackHelper::AssignStreams(NodeContainer c, int64_t stream)
 void
 InternetStackHelper::Install(NodeContainer c) const
 {
+    StartupTimer timer("InternetStackHelper::Install");
     for (auto i = c.Begin(); i != c.End(); ++i)
     {
         Install(*i);
@@ -154,6 +154,9 @@ class InternetStackHelper : public PcapHelperForIpv4,
      * ns3::Ipv4, ns3::Ipv6, ns3::Udp, and, ns3::Tcp classes.  This method will do nothing if the
      * stacks are already installed, and will not overwrite existing stacks parameters.
      *
+     * The time spent is accounted to the "InternetStackHelper::Install" phase
+     * of StartupTimer.
+     *
      * @param c NodeContainer that holds the set of nodes on which to install the
      * new stacks.
      */
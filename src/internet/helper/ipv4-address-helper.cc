@@ -16,6 +16,7 @@
 #include "ns3/node.h"
 #include "ns3/ptr.h"
 #include "ns3/simulator.h"
+#include "ns3/startup-timer.h"
 #include "ns3/traffic-control-helper.h"
 #include "ns3/traffic-control-layer.h"
 
@@ -121,6 +122,7 @@ Ipv4InterfaceContainer
 Ipv4AddressHelper::Assign(const NetDeviceContainer& c)
 {
     NS_LOG_FUNCTION_NOARGS();
+    StartupTimer timer("Ipv4AddressHelper::Assign");
     Ipv4InterfaceContainer retval;
     for (uint32_t i = 0; i < c.GetN(); ++i)
     {
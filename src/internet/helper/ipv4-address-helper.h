@@ -158,6 +158,9 @@ class Ipv4AddressHelper
      * the addresses overflow the number of bits allocated for them by the network
      * mask in the SetBase method, the system will NS_ASSERT and halt.
      *
+     * The time spent is accounted to the "Ipv4AddressHelper::Assign" phase of
+     * StartupTimer.
+     *
      * @param c The NetDeviceContainer holding the collection of net devices we
      * are asked to assign Ipv4 addresses to.
      *
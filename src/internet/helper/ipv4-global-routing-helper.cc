@@ -11,6 +11,7 @@
 #include "ns3/ipv4-global-routing.h"
 #include "ns3/ipv4-list-routing.h"
 #include "ns3/log.h"
+#include "ns3/startup-timer.h"
 
 namespace ns3
 {
@@ -49,15 +50,25 @@ Ipv4GlobalRoutingHelper::Create(Ptr<Node> node) const
 void
 Ipv4GlobalRoutingHelper::PopulateRoutingTables()
 {
-    GlobalRouteManager::BuildGlobalRoutingDatabase();
-    GlobalRouteManager::InitializeRoutes();
+    StartupTimer timer("Ipv4GlobalRoutingHelper::PopulateRoutingTables");
+    BuildAndInitializeRoutes();
 }
 
 void
 Ipv4GlobalRoutingHelper::RecomputeRoutingTables()
 {
-    GlobalRouteManager::DeleteGlobalRoutes();
-    GlobalRouteManager::BuildGlobalRoutingDatabase();
+    StartupTimer timer("Ipv4GlobalRoutingHelper::RecomputeRoutingTables");
+    GlobalRouteManager::RecomputeRoutes();
+}
+
+void
+Ipv4GlobalRoutingHelper::BuildAndInitializeRoutes()
+{
+    {
+        StartupTimer timer("GlobalRouteManager::BuildGlobalRoutingDatabase");
+        GlobalRouteManager::BuildGlobalRoutingDatabase();
+    }
+    StartupTimer timer("GlobalRouteManager::InitializeRoutes");
     GlobalRouteManager::InitializeRoutes();
 }
 
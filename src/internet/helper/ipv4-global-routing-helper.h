@@ -61,7 +61,8 @@ class Ipv4GlobalRoutingHelper : public Ipv4RoutingHelper
      * routers.
      *
      * All this function does is call the functions
-     * BuildGlobalRoutingDatabase () and  InitializeRoutes ().
+     * BuildGlobalRoutingDatabase () and  InitializeRoutes ().  The time
+     * spent in each is accounted to a phase of StartupTimer.
      *
      */
     static void PopulateRoutingTables();
@@ -76,8 +77,18 @@ class Ipv4GlobalRoutingHelper : public Ipv4RoutingHelper
      * Users must first call PopulateRoutingTables() and then may subsequently
      * call RecomputeRoutingTables() at any later time in the simulation.
      *
+     * When links were only removed since the previous computation, the
+     * routers whose shortest paths did not use them keep their routes, minus
+     * the routes to the removed addresses; see GlobalRouteManager::RecomputeRoutes().
      */
     static void RecomputeRoutingTables();
+
+  private:
+    /**
+     * @brief Build the routing database and initialize the routing tables,
+     * timing both.
+     */
+    static void BuildAndInitializeRoutes();
 };
 
 } // namespace ns3
@@ -161,6 +161,15 @@ class ArpL3Protocol : public Object
     Ptr<TrafficControlLayer> m_tc;                 //!< The associated TrafficControlLayer
 };
 
+/**
+ * @brief ArpL3Protocol is stored in a slot of the aggregation cache of Object::GetObject().
+ */
+template <>
+struct ObjectCacheSlot<ArpL3Protocol>
+{
+    static constexpr uint8_t index = Object::CACHE_SLOT_ARP; //!< The slot
+};
+
 } // namespace ns3
 
 #endif /* ARP_L3_PROTOCOL_H */
@@ -47,20 +47,21 @@ operator<<(std::ostream& os, const SPFVertex::VertexType& t)
 std::ostream&
 operator<<(std::ostream& os, const CandidateQueue& q)
 {
-    const CandidateQueue::CandidateList_t& list = q.m_candidates;
-
     os << "*** CandidateQueue Begin (<id, distance, LSA-type>) ***" << std::endl;
-    for (auto iter = list.begin(); iter != list.end(); iter++)
+    for (const auto& c : q.GetSorted())
     {
-        os << "<" << (*iter)->GetVertexId() << ", " << (*iter)->GetDistanceFromRoot() << ", "
-           << (*iter)->GetVertexType() << ">" << std::endl;
+        os << "<" << c.vertex->GetVertexId() << ", " << c.vertex->GetDistanceFromRoot() << ", "
+           << c.vertex->GetVertexType() << ">" << std::endl;
     }
     os << "*** CandidateQueue End ***";
     return os;
 }
 
 CandidateQueue::CandidateQueue()
-    : m_candidates()
+    : m_heap(),
+      m_positions(),
+      m_ids(),
+      m_order(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -75,7 +76,7 @@ void
 CandidateQueue::Clear()
 {
     NS_LOG_FUNCTION(this);
-    while (!m_candidates.empty())
+    while (!m_heap.empty())
     {
         SPFVertex* p = Pop();
         delete p;
@@ -88,24 +89,43 @@ CandidateQueue::Push(SPFVertex* vNew)
 {
     NS_LOG_FUNCTION(this << vNew);
 
-    auto i = std::upper_bound(m_candidates.begin(),
-                              m_candidates.end(),
-                              vNew,
-                              &CandidateQueue::CompareSPFVertex);
-    m_candidates.insert(i, vNew);
+    NS_ASSERT_MSG(m_positions.find(vNew) == m_positions.end(), "Vertex already in the queue");
+    Candidate c;
+    c.vertex = vNew;
+    SetPriority(c);
+    m_heap.push_back(c);
+    m_positions[vNew] = m_heap.size() - 1;
+    m_ids.emplace(vNew->GetVertexId(), vNew);
+    SiftUp(m_heap.size() - 1);
 }
 
 SPFVertex*
 CandidateQueue::Pop()
 {
     NS_LOG_FUNCTION(this);
-    if (m_candidates.empty())
+    if (m_heap.empty())
     {
         return nullptr;
     }
 
-    SPFVertex* v = m_candidates.front();
-    m_candidates.pop_front();
+    SPFVertex* v = m_heap.front().vertex;
+    m_positions.erase(v);
+    auto range = m_ids.equal_range(v->GetVertexId());
+    for (auto i = range.first; i != range.second; ++i)
+    {
+        if (i->second == v)
+        {
+            m_ids.erase(i);
+            break;
+        }
+    }
+    Candidate last = m_heap.back();
+    m_heap.pop_back();
+    if (!m_heap.empty())
+    {
+        Place(last, 0);
+        SiftDown(0);
+    }
     return v;
 }
 
@@ -113,44 +133,61 @@ SPFVertex*
 CandidateQueue::Top() const
 {
     NS_LOG_FUNCTION(this);
-    if (m_candidates.empty())
+    if (m_heap.empty())
     {
         return nullptr;
     }
 
-    return m_candidates.front();
+    return m_heap.front().vertex;
 }
 
 bool
 CandidateQueue::Empty() const
 {
     NS_LOG_FUNCTION(this);
-    return m_candidates.empty();
+    return m_heap.empty();
 }
 
 uint32_t
 CandidateQueue::Size() const
 {
     NS_LOG_FUNCTION(this);
-    return m_candidates.size();
+    return m_heap.size();
 }
 
 SPFVertex*
 CandidateQueue::Find(const Ipv4Address addr) const
 {
     NS_LOG_FUNCTION(this);
-    auto i = m_candidates.begin();
-
-    for (; i != m_candidates.end(); i++)
+    auto range = m_ids.equal_range(addr);
+    if (range.first == range.second)
+    {
+        return nullptr;
+    }
+    // A router and a network may share an ID: return the one popped first.
+    const Candidate* found = nullptr;
+    for (auto i = range.first; i != range.second; ++i)
     {
-        SPFVertex* v = *i;
-        if (v->GetVertexId() == addr)
+        const Candidate& c = m_heap[m_positions.at(i->second)];
+        if (!found || CompareCandidate(c, *found))
         {
-            return v;
+            found = &c;
         }
     }
+    return found->vertex;
+}
+
+void
+CandidateQueue::Update(SPFVertex* v)
+{
+    NS_LOG_FUNCTION(this << v);
 
-    return nullptr;
+    auto it = m_positions.find(v);
+    NS_ASSERT_MSG(it != m_positions.end(), "Vertex not in the queue");
+    std::size_t i = it->second;
+    SetPriority(m_heap[i]);
+    SiftUp(i);
+    SiftDown(m_positions[v]);
 }
 
 void
@@ -158,11 +195,106 @@ CandidateQueue::Reorder()
 {
     NS_LOG_FUNCTION(this);
 
-    m_candidates.sort(&CandidateQueue::CompareSPFVertex);
+    // Sort the vertices as they were queued, then by their current distance.
+    // Since the sort is stable, the vertices of equal priority keep their order.
+    std::vector<Candidate> sorted = GetSorted();
+    std::stable_sort(sorted.begin(),
+                     sorted.end(),
+                     [](const Candidate& c1, const Candidate& c2) {
+                         return CompareSPFVertex(c1.vertex, c2.vertex);
+                     });
+    // A sorted vector is a heap.
+    m_heap.clear();
+    for (auto& c : sorted)
+    {
+        SetPriority(c);
+        m_heap.push_back(c);
+        m_positions[c.vertex] = m_heap.size() - 1;
+    }
     NS_LOG_LOGIC("After reordering the CandidateQueue");
     NS_LOG_LOGIC(*this);
 }
 
+void
+CandidateQueue::SetPriority(Candidate& c)
+{
+    c.distance = c.vertex->GetDistanceFromRoot();
+    c.network = (c.vertex->GetVertexType() == SPFVertex::VertexNetwork);
+    c.order = m_order++;
+}
+
+void
+CandidateQueue::Place(const Candidate& c, std::size_t i)
+{
+    m_heap[i] = c;
+    m_positions[c.vertex] = i;
+}
+
+void
+CandidateQueue::SiftUp(std::size_t i)
+{
+    Candidate c = m_heap[i];
+    while (i > 0)
+    {
+        std::size_t parent = (i - 1) / 2;
+        if (!CompareCandidate(c, m_heap[parent]))
+        {
+            break;
+        }
+        Place(m_heap[parent], i);
+        i = parent;
+    }
+    Place(c, i);
+}
+
+void
+CandidateQueue::SiftDown(std::size_t i)
+{
+    Candidate c = m_heap[i];
+    std::size_t n = m_heap.size();
+    for (;;)
+    {
+        std::size_t child = 2 * i + 1;
+        if (child >= n)
+        {
+            break;
+        }
+        if (child + 1 < n && CompareCandidate(m_heap[child + 1], m_heap[child]))
+        {
+            child++;
+        }
+        if (!CompareCandidate(m_heap[child], c))
+        {
+            break;
+        }
+        Place(m_heap[child], i);
+        i = child;
+    }
+    Place(c, i);
+}
+
+std::vector<CandidateQueue::Candidate>
+CandidateQueue::GetSorted() const
+{
+    std::vector<Candidate> sorted = m_heap;
+    std::sort(sorted.begin(), sorted.end(), &CandidateQueue::CompareCandidate);
+    return sorted;
+}
+
+bool
+CandidateQueue::CompareCandidate(const Candidate& c1, const Candidate& c2)
+{
+    if (c1.distance != c2.distance)
+    {
+        return c1.distance < c2.distance;
+    }
+    if (c1.network != c2.network)
+    {
+        return c1.network;
+    }
+    return c1.order < c2.order;
+}
+
 /*
  * In this implementation, SPFVertex follows the ordering where
  * a vertex is ranked first if its GetDistanceFromRoot () is smaller;
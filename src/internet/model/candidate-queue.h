@@ -11,8 +11,9 @@
 
 #include "ns3/ipv4-address.h"
 
-#include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
@@ -37,6 +38,11 @@ class SPFVertex;
  * for a Find () operation, the dynamic nature of the data and the derived
  * requirement for a Reorder () operation led us to implement this simple
  * enhanced priority queue.
+ *
+ * The queue is a binary heap, indexed by vertex and by vertex ID, so that
+ * Push (), Pop () and Update () take a logarithmic time and Find () a
+ * constant time.  The vertices of equal priority are popped in the order
+ * in which they were pushed, or last updated.
  */
 class CandidateQueue
 {
@@ -133,6 +139,19 @@ class CandidateQueue
      */
     SPFVertex* Find(const Ipv4Address addr) const;
 
+    /**
+     * @brief Move a Shortest Path First Vertex pointer to its position in the
+     * queue after its m_distanceFromRoot decreased.
+     *
+     * The vertex is then popped after the other vertices of equal priority,
+     * as if it had been removed and pushed again.  This is cheaper than
+     * Reorder (), which sorts the whole queue.
+     *
+     * @see SPFVertex
+     * @param v The Shortest Path First Vertex, already in the queue.
+     */
+    void Update(SPFVertex* v);
+
     /**
      * @brief Reorders the Candidate Queue according to the priority scheme.
      *
@@ -162,8 +181,69 @@ class CandidateQueue
      */
     static bool CompareSPFVertex(const SPFVertex* v1, const SPFVertex* v2);
 
-    typedef std::list<SPFVertex*> CandidateList_t; //!< container of SPFVertex pointers
-    CandidateList_t m_candidates;                  //!< SPFVertex candidates
+    /**
+     * @brief A vertex in the heap, with its priority when it was last
+     * pushed or updated.
+     */
+    struct Candidate
+    {
+        SPFVertex* vertex; //!< The vertex
+        uint32_t distance; //!< The distance from the root
+        bool network;      //!< Whether the vertex is a network vertex
+        uint64_t order;    //!< The order among the vertices of equal priority
+    };
+
+    /**
+     * @brief return true if c1 should be popped before c2
+     *
+     * @param c1 first operand
+     * @param c2 second operand
+     * @return True if c1 should be popped before c2; false otherwise
+     */
+    static bool CompareCandidate(const Candidate& c1, const Candidate& c2);
+
+    /**
+     * @brief Set the priority of a candidate from its vertex.
+     *
+     * @param c The candidate.
+     */
+    void SetPriority(Candidate& c);
+
+    /**
+     * @brief Store a candidate at a position of the heap.
+     *
+     * @param c The candidate.
+     * @param i The position.
+     */
+    void Place(const Candidate& c, std::size_t i);
+
+    /**
+     * @brief Move a candidate towards the top of the heap.
+     *
+     * @param i The position of the candidate.
+     */
+    void SiftUp(std::size_t i);
+
+    /**
+     * @brief Move a candidate towards the bottom of the heap.
+     *
+     * @param i The position of the candidate.
+     */
+    void SiftDown(std::size_t i);
+
+    /**
+     * @brief Return the candidates in the order in which they will be popped.
+     *
+     * @returns The sorted candidates.
+     */
+    std::vector<Candidate> GetSorted() const;
+
+    std::vector<Candidate> m_heap; //!< SPFVertex candidates, as a binary heap
+    std::unordered_map<const SPFVertex*, std::size_t>
+        m_positions; //!< position in the heap of each vertex
+    std::unordered_multimap<Ipv4Address, SPFVertex*, Ipv4AddressHash>
+        m_ids;        //!< vertices by vertex ID
+    uint64_t m_order; //!< the order given to the next vertex pushed or updated
 
     /**
      * @brief Stream insertion operator.
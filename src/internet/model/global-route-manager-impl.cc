@@ -19,13 +19,22 @@
 
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
+#include "ns3/global-value.h"
 #include "ns3/log.h"
 #include "ns3/node-list.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <iostream>
+#include <map>
+#include <memory>
 #include <queue>
+#include <set>
+#include <thread>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -34,6 +43,126 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("GlobalRouteManagerImpl");
 
+namespace
+{
+
+/**
+ * @ingroup globalrouting
+ * @brief Compare two Global Routing Link Records.
+ * @param a the first link record
+ * @param b the second link record
+ * @returns true if the link records are the same
+ */
+bool
+SameLinkRecord(const GlobalRoutingLinkRecord* a, const GlobalRoutingLinkRecord* b)
+{
+    return a->GetLinkType() == b->GetLinkType() && a->GetLinkId() == b->GetLinkId() &&
+           a->GetLinkData() == b->GetLinkData() && a->GetMetric() == b->GetMetric();
+}
+
+/**
+ * @ingroup globalrouting
+ * @brief Compare two Link State Advertisements, except for their link records.
+ * @param a the first LSA
+ * @param b the second LSA
+ * @returns true if the LSAs are the same, except maybe for their link records
+ */
+bool
+SameLSAHeader(const GlobalRoutingLSA* a, const GlobalRoutingLSA* b)
+{
+    if (a->GetLSType() != b->GetLSType() || a->GetLinkStateId() != b->GetLinkStateId() ||
+        a->GetAdvertisingRouter() != b->GetAdvertisingRouter() ||
+        a->GetNetworkLSANetworkMask() != b->GetNetworkLSANetworkMask() ||
+        a->GetNAttachedRouters() != b->GetNAttachedRouters())
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < a->GetNAttachedRouters(); i++)
+    {
+        if (a->GetAttachedRouter(i) != b->GetAttachedRouter(i))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @ingroup globalrouting
+ * @brief Compare two Link State Advertisements.
+ * @param a the first LSA
+ * @param b the second LSA
+ * @returns true if the LSAs are the same
+ */
+bool
+SameLSA(const GlobalRoutingLSA* a, const GlobalRoutingLSA* b)
+{
+    if (!SameLSAHeader(a, b) || a->GetNLinkRecords() != b->GetNLinkRecords())
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < a->GetNLinkRecords(); i++)
+    {
+        if (!SameLinkRecord(a->GetLinkRecord(i), b->GetLinkRecord(i)))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// The edges entering each vertex of a graph: source vertex and cost
+using IncomingEdges = std::vector<std::vector<std::pair<uint32_t, uint32_t>>>;
+
+/**
+ * @ingroup globalrouting
+ * @brief Compute the distances of all the vertices of a graph to a vertex.
+ * @param edges the edges entering each vertex
+ * @param target the vertex
+ * @returns the distance to the target of each vertex, or SPF_INFINITY
+ */
+std::vector<uint32_t>
+GetDistancesTo(const IncomingEdges& edges, uint32_t target)
+{
+    std::vector<uint32_t> distances(edges.size(), SPF_INFINITY);
+    using Item = std::pair<uint32_t, uint32_t>; // distance, vertex
+    std::priority_queue<Item, std::vector<Item>, std::greater<>> queue;
+    distances[target] = 0;
+    queue.emplace(0, target);
+    while (!queue.empty())
+    {
+        auto [distance, v] = queue.top();
+        queue.pop();
+        if (distance > distances[v])
+        {
+            continue;
+        }
+        for (const auto& [u, cost] : edges[v])
+        {
+            if (distance + cost < distances[u])
+            {
+                distances[u] = distance + cost;
+                queue.emplace(distances[u], u);
+            }
+        }
+    }
+    return distances;
+}
+
+} // namespace
+
+/**
+ * @relates GlobalRouteManager
+ * @anchor GlobalValueGlobalRoutingThreadCount
+ * @brief The number of threads that compute the routes of the routers.
+ */
+static GlobalValue g_threadCount =
+    GlobalValue("GlobalRoutingThreadCount",
+                "The number of threads that compute the global routes; "
+                "0 uses the number of hardware threads",
+                UintegerValue(1),
+                MakeUintegerChecker<uint32_t>());
+
 /**
  * @brief Stream insertion operator.
  *
@@ -413,7 +542,8 @@ SPFVertex::ClearVertexProcessed()
 
 GlobalRouteManagerLSDB::GlobalRouteManagerLSDB()
     : m_database(),
-      m_extdatabase()
+      m_extdatabase(),
+      m_linkData()
 {
     NS_LOG_FUNCTION(this);
 }
@@ -458,7 +588,29 @@ GlobalRouteManagerLSDB::Insert(Ipv4Address addr, GlobalRoutingLSA* lsa)
     }
     else
     {
-        m_database.insert(LSDBPair_t(addr, lsa));
+        auto inserted = m_database.insert(LSDBPair_t(addr, lsa));
+        if (!inserted.second)
+        {
+            return;
+        }
+        //
+        // Index the TransitNetwork link records.  If several LSAs have the
+        // same link data, keep the one with the lowest address, as a walk of
+        // the database would find.
+        //
+        for (uint32_t j = 0; j < lsa->GetNLinkRecords(); j++)
+        {
+            GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
+            if (lr->GetLinkType() != GlobalRoutingLinkRecord::TransitNetwork)
+            {
+                continue;
+            }
+            auto indexed = m_linkData.emplace(lr->GetLinkData(), inserted.first);
+            if (!indexed.second && addr < indexed.first->second->first)
+            {
+                indexed.first->second = inserted.first;
+            }
+        }
     }
 }
 
@@ -483,12 +635,10 @@ GlobalRouteManagerLSDB::GetLSA(Ipv4Address addr) const
     //
     // Look up an LSA by its address.
     //
-    for (auto i = m_database.begin(); i != m_database.end(); i++)
+    auto i = m_database.find(addr);
+    if (i != m_database.end())
     {
-        if (i->first == addr)
-        {
-            return i->second;
-        }
+        return i->second;
     }
     return nullptr;
 }
@@ -498,25 +648,46 @@ GlobalRouteManagerLSDB::GetLSAByLinkData(Ipv4Address addr) const
 {
     NS_LOG_FUNCTION(this << addr);
     //
-    // Look up an LSA by its address.
+    // Look up an LSA by the link data of its TransitNetwork link records.
     //
-    for (auto i = m_database.begin(); i != m_database.end(); i++)
+    auto i = m_linkData.find(addr);
+    if (i != m_linkData.end())
     {
-        GlobalRoutingLSA* temp = i->second;
-        // Iterate among temp's Link Records
-        for (uint32_t j = 0; j < temp->GetNLinkRecords(); j++)
-        {
-            GlobalRoutingLinkRecord* lr = temp->GetLinkRecord(j);
-            if (lr->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork &&
-                lr->GetLinkData() == addr)
-            {
-                return temp;
-            }
-        }
+        return i->second->second;
     }
     return nullptr;
 }
 
+std::vector<GlobalRoutingLSA*>
+GlobalRouteManagerLSDB::GetLSAs() const
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<GlobalRoutingLSA*> lsas;
+    lsas.reserve(m_database.size());
+    for (auto i = m_database.begin(); i != m_database.end(); i++)
+    {
+        lsas.push_back(i->second);
+    }
+    return lsas;
+}
+
+GlobalRouteManagerLSDB*
+GlobalRouteManagerLSDB::Copy() const
+{
+    NS_LOG_FUNCTION(this);
+    auto lsdb = new GlobalRouteManagerLSDB();
+    for (auto i = m_database.begin(); i != m_database.end(); i++)
+    {
+        lsdb->Insert(i->first, new GlobalRoutingLSA(*i->second));
+    }
+    for (uint32_t j = 0; j < m_extdatabase.size(); j++)
+    {
+        GlobalRoutingLSA* lsa = m_extdatabase.at(j);
+        lsdb->Insert(lsa->GetLinkStateId(), new GlobalRoutingLSA(*lsa));
+    }
+    return lsdb;
+}
+
 // ---------------------------------------------------------------------------
 //
 // GlobalRouteManagerImpl Implementation
@@ -524,7 +695,8 @@ GlobalRouteManagerLSDB::GetLSAByLinkData(Ipv4Address addr) const
 // ---------------------------------------------------------------------------
 
 GlobalRouteManagerImpl::GlobalRouteManagerImpl()
-    : m_spfroot(nullptr)
+    : m_spfroot(nullptr),
+      m_lsdbRouted(false)
 {
     NS_LOG_FUNCTION(this);
     m_lsdb = new GlobalRouteManagerLSDB();
@@ -548,6 +720,7 @@ GlobalRouteManagerImpl::DebugUseLsdb(GlobalRouteManagerLSDB* lsdb)
         delete m_lsdb;
     }
     m_lsdb = lsdb;
+    m_lsdbRouted = false;
 }
 
 void
@@ -556,25 +729,7 @@ GlobalRouteManagerImpl::DeleteGlobalRoutes()
     NS_LOG_FUNCTION(this);
     for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
     {
-        Ptr<Node> node = *i;
-        Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-        if (!router)
-        {
-            continue;
-        }
-        Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-        uint32_t j = 0;
-        uint32_t nRoutes = gr->GetNRoutes();
-        NS_LOG_LOGIC("Deleting " << gr->GetNRoutes() << " routes from node " << node->GetId());
-        // Each time we delete route 0, the route index shifts downward
-        // We can delete all routes if we delete the route numbered 0
-        // nRoutes times
-        for (j = 0; j < nRoutes; j++)
-        {
-            NS_LOG_LOGIC("Deleting global route " << j << " from node " << node->GetId());
-            gr->RemoveRoute(0);
-        }
-        NS_LOG_LOGIC("Deleted " << j << " global routes from node " << node->GetId());
+        DeleteGlobalRoutes(*i);
     }
     if (m_lsdb)
     {
@@ -582,6 +737,60 @@ GlobalRouteManagerImpl::DeleteGlobalRoutes()
         delete m_lsdb;
         m_lsdb = new GlobalRouteManagerLSDB();
     }
+    m_lsdbRouted = false;
+}
+
+void
+GlobalRouteManagerImpl::DeleteGlobalRoutes(Ptr<Node> node)
+{
+    NS_LOG_FUNCTION(this << node);
+    Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
+    if (!router)
+    {
+        return;
+    }
+    Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
+    uint32_t j = 0;
+    uint32_t nRoutes = gr->GetNRoutes();
+    NS_LOG_LOGIC("Deleting " << gr->GetNRoutes() << " routes from node " << node->GetId());
+    // Each time we delete route 0, the route index shifts downward
+    // We can delete all routes if we delete the route numbered 0
+    // nRoutes times
+    for (j = 0; j < nRoutes; j++)
+    {
+        NS_LOG_LOGIC("Deleting global route " << j << " from node " << node->GetId());
+        gr->RemoveRoute(0);
+    }
+    NS_LOG_LOGIC("Deleted " << j << " global routes from node " << node->GetId());
+}
+
+Ptr<Node>
+GlobalRouteManagerImpl::GetRouterNode(Ipv4Address routerId)
+{
+    NS_LOG_FUNCTION(this << routerId);
+    auto i = m_routerNodes.find(routerId);
+    if (i == m_routerNodes.end())
+    {
+        //
+        // Index the routers again, in case some were added since.  The router
+        // IDs are unique, but keep the first node of a walk of the node list.
+        //
+        m_routerNodes.clear();
+        for (auto j = NodeList::Begin(); j != NodeList::End(); j++)
+        {
+            Ptr<GlobalRouter> rtr = (*j)->GetObject<GlobalRouter>();
+            if (rtr)
+            {
+                m_routerNodes.emplace(rtr->GetRouterId(), *j);
+            }
+        }
+        i = m_routerNodes.find(routerId);
+        if (i == m_routerNodes.end())
+        {
+            return nullptr;
+        }
+    }
+    return i->second;
 }
 
 //
@@ -597,6 +806,7 @@ void
 GlobalRouteManagerImpl::BuildGlobalRoutingDatabase()
 {
     NS_LOG_FUNCTION(this);
+    m_lsdbRouted = false;
     //
     // Walk the list of nodes looking for the GlobalRouter Interface.  Nodes with
     // global router interfaces are, not too surprisingly, our routers.
@@ -683,6 +893,7 @@ GlobalRouteManagerImpl::InitializeRoutes()
     // Walk the list of nodes in the system.
     //
     NS_LOG_INFO("About to start SPF calculation");
+    std::vector<Ipv4Address> roots;
     for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
     {
         Ptr<Node> node = *i;
@@ -705,12 +916,289 @@ GlobalRouteManagerImpl::InitializeRoutes()
         //
         if (rtr && rtr->GetNumLSAs())
         {
-            SPFCalculate(rtr->GetRouterId());
+            roots.push_back(rtr->GetRouterId());
         }
     }
+    SPFCalculate(roots);
+    m_lsdbRouted = true;
     NS_LOG_INFO("Finished SPF calculation");
 }
 
+void
+GlobalRouteManagerImpl::RecomputeRoutes()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_lsdbRouted)
+    {
+        DeleteGlobalRoutes();
+        BuildGlobalRoutingDatabase();
+        InitializeRoutes();
+        return;
+    }
+    GlobalRouteManagerLSDB* previous = m_lsdb;
+    m_lsdb = new GlobalRouteManagerLSDB();
+    BuildGlobalRoutingDatabase();
+    if (!RemoveLinks(*previous))
+    {
+        NS_LOG_LOGIC("Recomputing all the routes");
+        for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+        {
+            DeleteGlobalRoutes(*i);
+        }
+        InitializeRoutes();
+    }
+    delete previous;
+    m_lsdbRouted = true;
+}
+
+//
+// The forwarding table of a router is the output of its SPF calculation.
+// When links are only removed, the calculation of a router whose shortest
+// path tree did not use them runs as before, except that the host routes to
+// the addresses of the removed point-to-point link records and the network
+// routes to the removed stub networks are not added.  Removing these routes
+// gives the same forwarding table, provided no other link record advertises
+// the same destinations.
+//
+// A removed link from vertex <u> to vertex <w> with cost <c> is not in the
+// tree of root <r> if d(r, u) + c > d(r, w): it is then examined in the
+// calculation, but never kept as the parent of <w>.  The distances to <u>
+// and <w> of all the roots are computed on the reversed graph of the
+// previous LSDB.  The routers whose own LSA changed, and the neighbors of
+// the removed point-to-point links, are calculated again in any case.
+//
+bool
+GlobalRouteManagerImpl::RemoveLinks(const GlobalRouteManagerLSDB& previous)
+{
+    NS_LOG_FUNCTION(this << &previous);
+
+    std::vector<GlobalRoutingLSA*> before = previous.GetLSAs();
+    std::vector<GlobalRoutingLSA*> after = m_lsdb->GetLSAs();
+    if (before.size() != after.size() || previous.GetNumExtLSAs() != m_lsdb->GetNumExtLSAs())
+    {
+        return false;
+    }
+    for (uint32_t i = 0; i < previous.GetNumExtLSAs(); i++)
+    {
+        if (!SameLSA(previous.GetExtLSA(i), m_lsdb->GetExtLSA(i)))
+        {
+            return false;
+        }
+    }
+    //
+    // Find the removed link records: the link records of each new LSA must be
+    // those of the previous LSA, in the same order, minus some point-to-point
+    // and stub network link records.
+    //
+    std::vector<std::pair<uint32_t, GlobalRoutingLinkRecord*>> removed;
+    for (uint32_t i = 0; i < before.size(); i++)
+    {
+        if (!SameLSAHeader(before[i], after[i]))
+        {
+            return false;
+        }
+        uint32_t k = 0;
+        for (uint32_t j = 0; j < before[i]->GetNLinkRecords(); j++)
+        {
+            GlobalRoutingLinkRecord* lr = before[i]->GetLinkRecord(j);
+            if (k < after[i]->GetNLinkRecords() && SameLinkRecord(lr, after[i]->GetLinkRecord(k)))
+            {
+                k++;
+                continue;
+            }
+            if (lr->GetLinkType() != GlobalRoutingLinkRecord::PointToPoint &&
+                lr->GetLinkType() != GlobalRoutingLinkRecord::StubNetwork)
+            {
+                return false;
+            }
+            removed.emplace_back(i, lr);
+        }
+        if (k != after[i]->GetNLinkRecords())
+        {
+            return false;
+        }
+    }
+    if (removed.empty())
+    {
+        NS_LOG_LOGIC("The LSDB did not change");
+        return true;
+    }
+
+    std::unordered_map<const GlobalRoutingLSA*, uint32_t> index;
+    for (uint32_t i = 0; i < before.size(); i++)
+    {
+        index[before[i]] = i;
+    }
+    //
+    // The destinations of the removed routes, and the routers to calculate again.
+    //
+    std::set<uint32_t> hosts;
+    std::set<std::pair<uint32_t, uint32_t>> networks;
+    std::set<uint32_t> changed;
+    for (const auto& [i, lr] : removed)
+    {
+        changed.insert(i);
+        if (lr->GetLinkType() == GlobalRoutingLinkRecord::PointToPoint)
+        {
+            hosts.insert(lr->GetLinkData().Get());
+            GlobalRoutingLSA* w_lsa = previous.GetLSA(lr->GetLinkId());
+            if (!w_lsa)
+            {
+                return false;
+            }
+            changed.insert(index[w_lsa]);
+        }
+        else
+        {
+            Ipv4Mask mask(lr->GetLinkData().Get());
+            networks.emplace(lr->GetLinkId().CombineMask(mask).Get(), mask.Get());
+        }
+    }
+    for (const auto lsa : after)
+    {
+        if (lsa->GetLSType() == GlobalRoutingLSA::NetworkLSA)
+        {
+            Ipv4Mask mask = lsa->GetNetworkLSANetworkMask();
+            if (networks.count({lsa->GetLinkStateId().CombineMask(mask).Get(), mask.Get()}))
+            {
+                return false;
+            }
+        }
+        for (uint32_t j = 0; j < lsa->GetNLinkRecords(); j++)
+        {
+            GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
+            if (lr->GetLinkType() == GlobalRoutingLinkRecord::PointToPoint &&
+                hosts.count(lr->GetLinkData().Get()))
+            {
+                return false;
+            }
+            if (lr->GetLinkType() == GlobalRoutingLinkRecord::StubNetwork)
+            {
+                Ipv4Mask mask(lr->GetLinkData().Get());
+                if (networks.count({lr->GetLinkId().CombineMask(mask).Get(), mask.Get()}))
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    //
+    // The graph of the previous LSDB, as SPFNext () walks it.
+    //
+    IncomingEdges edges(before.size());
+    for (uint32_t i = 0; i < before.size(); i++)
+    {
+        GlobalRoutingLSA* lsa = before[i];
+        if (lsa->GetLSType() == GlobalRoutingLSA::RouterLSA)
+        {
+            for (uint32_t j = 0; j < lsa->GetNLinkRecords(); j++)
+            {
+                GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
+                if (lr->GetLinkType() == GlobalRoutingLinkRecord::PointToPoint ||
+                    lr->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork)
+                {
+                    GlobalRoutingLSA* w_lsa = previous.GetLSA(lr->GetLinkId());
+                    if (w_lsa)
+                    {
+                        edges[index[w_lsa]].emplace_back(i, lr->GetMetric());
+                    }
+                }
+            }
+        }
+        else if (lsa->GetLSType() == GlobalRoutingLSA::NetworkLSA)
+        {
+            for (uint32_t j = 0; j < lsa->GetNAttachedRouters(); j++)
+            {
+                GlobalRoutingLSA* w_lsa = previous.GetLSAByLinkData(lsa->GetAttachedRouter(j));
+                if (w_lsa)
+                {
+                    edges[index[w_lsa]].emplace_back(i, 0);
+                }
+            }
+        }
+    }
+    // The removed point-to-point links: source, destination and cost
+    std::vector<std::tuple<uint32_t, uint32_t, uint32_t>> links;
+    std::map<uint32_t, std::vector<uint32_t>> distances;
+    for (const auto& [i, lr] : removed)
+    {
+        if (lr->GetLinkType() == GlobalRoutingLinkRecord::PointToPoint)
+        {
+            uint32_t w = index[previous.GetLSA(lr->GetLinkId())];
+            links.emplace_back(i, w, lr->GetMetric());
+            for (uint32_t target : {i, w})
+            {
+                if (distances.find(target) == distances.end())
+                {
+                    distances[target] = GetDistancesTo(edges, target);
+                }
+            }
+        }
+    }
+
+    //
+    // Sort the routers between those calculated again and those whose lost
+    // routes are removed.
+    //
+    std::vector<Ipv4Address> roots;
+    std::vector<Ptr<Ipv4GlobalRouting>> kept;
+    uint32_t systemId = Simulator::GetSystemId();
+    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    {
+        Ptr<Node> node = *i;
+        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+        if (!rtr)
+        {
+            continue;
+        }
+        bool calculate = false;
+        if (node->GetSystemId() == systemId && rtr->GetNumLSAs())
+        {
+            GlobalRoutingLSA* rlsa = previous.GetLSA(rtr->GetRouterId());
+            if (!rlsa)
+            {
+                return false;
+            }
+            uint32_t r = index[rlsa];
+            calculate = changed.count(r);
+            for (const auto& [u, w, cost] : links)
+            {
+                uint32_t toU = distances[u][r];
+                calculate = calculate || (toU != SPF_INFINITY && toU + cost <= distances[w][r]);
+            }
+        }
+        if (calculate)
+        {
+            roots.push_back(rtr->GetRouterId());
+        }
+        else
+        {
+            kept.push_back(rtr->GetRoutingProtocol());
+        }
+    }
+    NS_LOG_LOGIC("Removed " << removed.size() << " link records; calculating " << roots.size()
+                            << " routers again");
+
+    for (const auto& gr : kept)
+    {
+        for (uint32_t host : hosts)
+        {
+            gr->RemoveHostRoutesTo(Ipv4Address(host));
+        }
+        for (const auto& [network, mask] : networks)
+        {
+            gr->RemoveNetworkRoutesTo(Ipv4Address(network), Ipv4Mask(mask));
+        }
+    }
+    for (const auto& root : roots)
+    {
+        DeleteGlobalRoutes(GetRouterNode(root));
+    }
+    SPFCalculate(roots);
+    return true;
+}
+
 //
 // This method is derived from quagga ospf_spf_next ().  See RFC2328 Section
 // 16.1 (2) for further details.
@@ -936,9 +1424,9 @@ GlobalRouteManagerImpl::SPFNext(SPFVertex* v, CandidateQueue& candidate)
                 {
                     //
                     // If we've changed the cost to get to the vertex represented by <w>, we
-                    // must reorder the priority queue keyed to that cost.
+                    // must move it in the priority queue keyed to that cost.
                     //
-                    candidate.Reorder();
+                    candidate.Update(cw);
                 }
             }
         }
@@ -1289,11 +1777,7 @@ GlobalRouteManagerImpl::CheckForStubNode(Ipv4Address root)
                 if (lr->GetLinkId() == myRouterId)
                 {
                     // Next hop is stored in the LinkID field of lr
-                    Ptr<GlobalRouter> router = rlsa->GetNode()->GetObject<GlobalRouter>();
-                    NS_ASSERT(router);
-                    Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-                    NS_ASSERT(gr);
-                    gr->AddNetworkRouteTo(Ipv4Address("0.0.0.0"),
+                    m_spfrootRouting->AddNetworkRouteTo(Ipv4Address("0.0.0.0"),
                                           Ipv4Mask("0.0.0.0"),
                                           lr->GetLinkData(),
                                           FindOutgoingInterfaceId(transitLink->GetLinkData()));
@@ -1309,11 +1793,93 @@ GlobalRouteManagerImpl::CheckForStubNode(Ipv4Address root)
     return false;
 }
 
-// quagga ospf_spf_calculate
+void
+GlobalRouteManagerImpl::SPFCalculate(const std::vector<Ipv4Address>& roots)
+{
+    NS_LOG_FUNCTION(this << roots.size());
+
+    std::vector<Ptr<Node>> nodes;
+    nodes.reserve(roots.size());
+    for (const auto& root : roots)
+    {
+        nodes.push_back(GetRouterNode(root));
+    }
+
+    UintegerValue threadCount;
+    g_threadCount.GetValue(threadCount);
+    std::size_t count = threadCount.Get();
+    if (count == 0)
+    {
+        count = std::max(1U, std::thread::hardware_concurrency());
+    }
+    count = std::min(count, roots.size());
+    if (count <= 1)
+    {
+        for (std::size_t i = 0; i < roots.size(); i++)
+        {
+            SPFCalculate(roots[i], nodes[i]);
+        }
+        return;
+    }
+
+    //
+    // Each thread computes the trees of whole routers, with its own copy of
+    // the LSDB for the SPF status of the LSAs.  The calculation of a router
+    // only accesses the node of that router, and fills its forwarding table
+    // in the same order as a single thread would.
+    //
+    NS_LOG_LOGIC("Calculating " << roots.size() << " trees with " << count << " threads");
+    std::vector<std::unique_ptr<GlobalRouteManagerImpl>> workers;
+    for (std::size_t t = 0; t < count; t++)
+    {
+        workers.push_back(std::make_unique<GlobalRouteManagerImpl>());
+        workers.back()->DebugUseLsdb(m_lsdb->Copy());
+    }
+    std::atomic<std::size_t> next{0};
+    std::vector<std::thread> threads;
+    for (auto& worker : workers)
+    {
+        threads.emplace_back([&roots, &nodes, &next, impl = worker.get()]() {
+            for (std::size_t i = next++; i < roots.size(); i = next++)
+            {
+                impl->SPFCalculate(roots[i], nodes[i]);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
 void
 GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
 {
     NS_LOG_FUNCTION(this << root);
+    SPFCalculate(root, GetRouterNode(root));
+}
+
+// quagga ospf_spf_calculate
+void
+GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root, Ptr<Node> node)
+{
+    NS_LOG_FUNCTION(this << root << node);
+
+    //
+    // The routes are written to the node of the root router, through its
+    // Ipv4GlobalRouting.  If there is no such node, the routes are only
+    // calculated.
+    //
+    m_spfrootNode = node;
+    if (node)
+    {
+        m_spfrootIpv4 = node->GetObject<Ipv4>();
+        NS_ASSERT_MSG(m_spfrootIpv4,
+                      "GlobalRouteManagerImpl::SPFCalculate (): "
+                      "GetObject for <Ipv4> interface failed");
+        m_spfrootRouting = node->GetObject<GlobalRouter>()->GetRoutingProtocol();
+        NS_ASSERT(m_spfrootRouting);
+    }
 
     SPFVertex* v;
     //
@@ -1349,10 +1915,14 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
     // reached.  Instead, short-circuit this computation and just install
     // a default route in the CheckForStubNode() method.
     //
-    if (NodeList::GetNNodes() > 0 && CheckForStubNode(root))
+    if (m_spfrootNode && CheckForStubNode(root))
     {
         NS_LOG_LOGIC("SPFCalculate truncated for stub node " << root);
         delete m_spfroot;
+        m_spfroot = nullptr;
+        m_spfrootNode = nullptr;
+        m_spfrootIpv4 = nullptr;
+        m_spfrootRouting = nullptr;
         return;
     }
 
@@ -1416,12 +1986,11 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
         //
         // RFC2328 16.1. (4).
         //
-        // This is the method that actually adds the routes.  It'll walk the list
-        // of nodes in the system, looking for the node corresponding to the router
-        // ID of the root of the tree -- that is the router we're building the routes
-        // for.  It looks for the Ipv4 interface of that node and remembers it.  So
-        // we are only actually adding routes to that one node at the root of the SPF
-        // tree.
+        // This is the method that actually adds the routes.  It uses the node
+        // corresponding to the router ID of the root of the tree -- that is the
+        // router we're building the routes for -- that was found at the start of
+        // the calculation, with its Ipv4 interface.  So we are only actually adding
+        // routes to that one node at the root of the SPF tree.
         //
         // We're going to pop of a pointer to every vertex in the tree except the
         // root in order of distance from the root.  For each of the vertices, we call
@@ -1473,6 +2042,9 @@ GlobalRouteManagerImpl::SPFCalculate(Ipv4Address root)
     //
     delete m_spfroot;
     m_spfroot = nullptr;
+    m_spfrootNode = nullptr;
+    m_spfrootIpv4 = nullptr;
+    m_spfrootRouting = nullptr;
 }
 
 void
@@ -1529,104 +2101,65 @@ GlobalRouteManagerImpl::SPFAddASExternal(GlobalRoutingLSA* extlsa, SPFVertex* v)
 
     NS_LOG_LOGIC("Vertex ID = " << routerId);
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
-    // the routing information to.
+    // The node of the root router is the one we're going to write the
+    // routing information to.
     //
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    if (!m_spfrootNode)
     {
-        Ptr<Node> node = *i;
-        //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to QI for that interface.  If there's no GlobalRouter interface, the node
-        // in question cannot be the router we want, so we continue.
-        //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
-
-        if (!rtr)
-        {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
-            continue;
-        }
-        //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
-        //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() != routerId)
-        {
-            continue;
-        }
-
-        NS_LOG_LOGIC("Setting routes for node " << node->GetId());
-        //
-        // Routing information is updated using the Ipv4 interface.  We need to QI
-        // for that interface.  If the node is acting as an IP version 4 router, it
-        // should absolutely have an Ipv4 interface.
-        //
-        Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-        NS_ASSERT_MSG(ipv4,
-                      "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                      "QI for <Ipv4> interface failed");
-        //
-        // Get the Global Router Link State Advertisement from the vertex we're
-        // adding the routes to.  The LSA will have a number of attached Global Router
-        // Link Records corresponding to links off of that vertex / node.  We're going
-        // to be interested in the records corresponding to point-to-point links.
-        //
-        NS_ASSERT_MSG(v->GetLSA(),
-                      "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                      "Expected valid LSA in SPFVertex* v");
-        Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask();
-        Ipv4Address tempip = extlsa->GetLinkStateId();
-        tempip = tempip.CombineMask(tempmask);
+        NS_LOG_LOGIC("No node with router ID " << routerId);
+        return;
+    }
+    Ptr<Node> node = m_spfrootNode;
+    NS_LOG_LOGIC("Setting routes for node " << node->GetId());
+    //
+    // Get the Global Router Link State Advertisement from the vertex we're
+    // adding the routes to.  The LSA will have a number of attached Global Router
+    // Link Records corresponding to links off of that vertex / node.  We're going
+    // to be interested in the records corresponding to point-to-point links.
+    //
+    NS_ASSERT_MSG(v->GetLSA(),
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "Expected valid LSA in SPFVertex* v");
+    Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask();
+    Ipv4Address tempip = extlsa->GetLinkStateId();
+    tempip = tempip.CombineMask(tempmask);
 
-        //
-        // Here's why we did all of that work.  We're going to add a host route to the
-        // host address found in the m_linkData field of the point-to-point link
-        // record.  In the case of a point-to-point link, this is the local IP address
-        // of the node connected to the link.  Each of these point-to-point links
-        // will correspond to a local interface that has an IP address to which
-        // the node at the root of the SPF tree can send packets.  The vertex <v>
-        // (corresponding to the node that has these links and interfaces) has
-        // an m_nextHop address precalculated for us that is the address to which the
-        // root node should send packets to be forwarded to these IP addresses.
-        // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-        // which the packets should be send for forwarding.
-        //
-        Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-        if (!router)
+    //
+    // Here's why we did all of that work.  We're going to add a host route to the
+    // host address found in the m_linkData field of the point-to-point link
+    // record.  In the case of a point-to-point link, this is the local IP address
+    // of the node connected to the link.  Each of these point-to-point links
+    // will correspond to a local interface that has an IP address to which
+    // the node at the root of the SPF tree can send packets.  The vertex <v>
+    // (corresponding to the node that has these links and interfaces) has
+    // an m_nextHop address precalculated for us that is the address to which the
+    // root node should send packets to be forwarded to these IP addresses.
+    // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
+    // which the packets should be send for forwarding.
+    //
+    Ptr<Ipv4GlobalRouting> gr = m_spfrootRouting;
+    // walk through all next-hop-IPs and out-going-interfaces for reaching
+    // the stub network gateway 'v' from the root node
+    for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
+    {
+        SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+        Ipv4Address nextHop = exit.first;
+        int32_t outIf = exit.second;
+        if (outIf >= 0)
         {
-            continue;
+            gr->AddASExternalRouteTo(tempip, tempmask, nextHop, outIf);
+            NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
+                                   << " add external network route to " << tempip
+                                   << " using next hop " << nextHop << " via interface "
+                                   << outIf);
         }
-        Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-        NS_ASSERT(gr);
-        // walk through all next-hop-IPs and out-going-interfaces for reaching
-        // the stub network gateway 'v' from the root node
-        for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
+        else
         {
-            SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-            Ipv4Address nextHop = exit.first;
-            int32_t outIf = exit.second;
-            if (outIf >= 0)
-            {
-                gr->AddASExternalRouteTo(tempip, tempmask, nextHop, outIf);
-                NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                       << " add external network route to " << tempip
-                                       << " using next hop " << nextHop << " via interface "
-                                       << outIf);
-            }
-            else
-            {
-                NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                       << " NOT able to add network route to " << tempip
-                                       << " using next hop " << nextHop
-                                       << " since outgoing interface id is negative");
-            }
+            NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
+                                   << " NOT able to add network route to " << tempip
+                                   << " using next hop " << nextHop
+                                   << " since outgoing interface id is negative");
         }
-        return;
     }
 }
 
@@ -1695,101 +2228,63 @@ GlobalRouteManagerImpl::SPFIntraAddStub(GlobalRoutingLinkRecord* l, SPFVertex* v
 
     NS_LOG_LOGIC("Vertex ID = " << routerId);
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
-    // the routing information to.
+    // The node of the root router is the one we're going to write the
+    // routing information to.
     //
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    if (!m_spfrootNode)
     {
-        Ptr<Node> node = *i;
-        //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to QI for that interface.  If there's no GlobalRouter interface, the node
-        // in question cannot be the router we want, so we continue.
-        //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
-
-        if (!rtr)
+        NS_LOG_LOGIC("No node with router ID " << routerId);
+        return;
+    }
+    Ptr<Node> node = m_spfrootNode;
+    NS_LOG_LOGIC("Setting routes for node " << node->GetId());
+    //
+    // Get the Global Router Link State Advertisement from the vertex we're
+    // adding the routes to.  The LSA will have a number of attached Global Router
+    // Link Records corresponding to links off of that vertex / node.  We're going
+    // to be interested in the records corresponding to point-to-point links.
+    //
+    NS_ASSERT_MSG(v->GetLSA(),
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "Expected valid LSA in SPFVertex* v");
+    Ipv4Mask tempmask(l->GetLinkData().Get());
+    Ipv4Address tempip = l->GetLinkId();
+    tempip = tempip.CombineMask(tempmask);
+    //
+    // Here's why we did all of that work.  We're going to add a host route to the
+    // host address found in the m_linkData field of the point-to-point link
+    // record.  In the case of a point-to-point link, this is the local IP address
+    // of the node connected to the link.  Each of these point-to-point links
+    // will correspond to a local interface that has an IP address to which
+    // the node at the root of the SPF tree can send packets.  The vertex <v>
+    // (corresponding to the node that has these links and interfaces) has
+    // an m_nextHop address precalculated for us that is the address to which the
+    // root node should send packets to be forwarded to these IP addresses.
+    // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
+    // which the packets should be send for forwarding.
+    //
+    Ptr<Ipv4GlobalRouting> gr = m_spfrootRouting;
+    // walk through all next-hop-IPs and out-going-interfaces for reaching
+    // the stub network gateway 'v' from the root node
+    for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
+    {
+        SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+        Ipv4Address nextHop = exit.first;
+        int32_t outIf = exit.second;
+        if (outIf >= 0)
         {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
-            continue;
+            gr->AddNetworkRouteTo(tempip, tempmask, nextHop, outIf);
+            NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
+                                   << " add network route to " << tempip
+                                   << " using next hop " << nextHop << " via interface "
+                                   << outIf);
         }
-        //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
-        //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() == routerId)
+        else
         {
-            NS_LOG_LOGIC("Setting routes for node " << node->GetId());
-            //
-            // Routing information is updated using the Ipv4 interface.  We need to QI
-            // for that interface.  If the node is acting as an IP version 4 router, it
-            // should absolutely have an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "QI for <Ipv4> interface failed");
-            //
-            // Get the Global Router Link State Advertisement from the vertex we're
-            // adding the routes to.  The LSA will have a number of attached Global Router
-            // Link Records corresponding to links off of that vertex / node.  We're going
-            // to be interested in the records corresponding to point-to-point links.
-            //
-            NS_ASSERT_MSG(v->GetLSA(),
-                          "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                          "Expected valid LSA in SPFVertex* v");
-            Ipv4Mask tempmask(l->GetLinkData().Get());
-            Ipv4Address tempip = l->GetLinkId();
-            tempip = tempip.CombineMask(tempmask);
-            //
-            // Here's why we did all of that work.  We're going to add a host route to the
-            // host address found in the m_linkData field of the point-to-point link
-            // record.  In the case of a point-to-point link, this is the local IP address
-            // of the node connected to the link.  Each of these point-to-point links
-            // will correspond to a local interface that has an IP address to which
-            // the node at the root of the SPF tree can send packets.  The vertex <v>
-            // (corresponding to the node that has these links and interfaces) has
-            // an m_nextHop address precalculated for us that is the address to which the
-            // root node should send packets to be forwarded to these IP addresses.
-            // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-            // which the packets should be send for forwarding.
-            //
-
-            Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-            if (!router)
-            {
-                continue;
-            }
-            Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-            NS_ASSERT(gr);
-            // walk through all next-hop-IPs and out-going-interfaces for reaching
-            // the stub network gateway 'v' from the root node
-            for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
-            {
-                SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-                Ipv4Address nextHop = exit.first;
-                int32_t outIf = exit.second;
-                if (outIf >= 0)
-                {
-                    gr->AddNetworkRouteTo(tempip, tempmask, nextHop, outIf);
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " add network route to " << tempip
-                                           << " using next hop " << nextHop << " via interface "
-                                           << outIf);
-                }
-                else
-                {
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " NOT able to add network route to " << tempip
-                                           << " using next hop " << nextHop
-                                           << " since outgoing interface id is negative");
-                }
-            }
-            return;
+            NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
+                                   << " NOT able to add network route to " << tempip
+                                   << " using next hop " << nextHop
+                                   << " since outgoing interface id is negative");
         }
     }
 }
@@ -1815,58 +2310,32 @@ GlobalRouteManagerImpl::FindOutgoingInterfaceId(Ipv4Address a, Ipv4Mask amask)
     //
     Ipv4Address routerId = m_spfroot->GetVertexId();
     //
-    // Walk the list of nodes in the system looking for the one corresponding to
-    // the node at the root of the SPF tree.  This is the node for which we are
+    // The node at the root of the SPF tree is the node for which we are
     // building the routing table.
     //
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    if (!m_spfrootNode)
     {
-        Ptr<Node> node = *i;
-
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
         //
-        // If the node doesn't have a GlobalRouter interface it can't be the one
-        // we're interested in.
+        // Couldn't find it.
         //
-        if (!rtr)
-        {
-            continue;
-        }
-
-        if (rtr->GetRouterId() == routerId)
-        {
-            //
-            // This is the node we're building the routing table for.  We're going to need
-            // the Ipv4 interface to look for the ipv4 interface index.  Since this node
-            // is participating in routing IP version 4 packets, it certainly must have
-            // an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::FindOutgoingInterfaceId (): "
-                          "GetObject for <Ipv4> interface failed");
-            //
-            // Look through the interfaces on this node for one that has the IP address
-            // we're looking for.  If we find one, return the corresponding interface
-            // index, or -1 if not found.
-            //
-            int32_t interface = ipv4->GetInterfaceForPrefix(a, amask);
-
-#if 0
-          if (interface < 0)
-            {
-              NS_FATAL_ERROR ("GlobalRouteManagerImpl::FindOutgoingInterfaceId(): "
-                              "Expected an interface associated with address a:" << a);
-            }
-#endif
-            return interface;
-        }
+        NS_LOG_LOGIC("FindOutgoingInterfaceId():Can't find root node " << routerId);
+        return -1;
     }
     //
-    // Couldn't find it.
+    // Look through the interfaces on this node for one that has the IP address
+    // we're looking for.  If we find one, return the corresponding interface
+    // index, or -1 if not found.
     //
-    NS_LOG_LOGIC("FindOutgoingInterfaceId():Can't find root node " << routerId);
-    return -1;
+    int32_t interface = m_spfrootIpv4->GetInterfaceForPrefix(a, amask);
+
+#if 0
+  if (interface < 0)
+    {
+      NS_FATAL_ERROR ("GlobalRouteManagerImpl::FindOutgoingInterfaceId(): "
+                      "Expected an interface associated with address a:" << a);
+    }
+#endif
+    return interface;
 }
 
 //
@@ -1902,129 +2371,87 @@ GlobalRouteManagerImpl::SPFIntraAddRouter(SPFVertex* v)
 
     NS_LOG_LOGIC("Vertex ID = " << routerId);
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
-    // the routing information to.
+    // The node of the root router is the one we're going to write the
+    // routing information to.
     //
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    if (!m_spfrootNode)
     {
-        Ptr<Node> node = *i;
-        //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to GetObject for that interface.  If there's no GlobalRouter interface,
-        // the node in question cannot be the router we want, so we continue.
-        //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+        NS_LOG_LOGIC("No node with router ID " << routerId);
+        return;
+    }
+    Ptr<Node> node = m_spfrootNode;
+    NS_LOG_LOGIC("Setting routes for node " << node->GetId());
+    //
+    // Get the Global Router Link State Advertisement from the vertex we're
+    // adding the routes to.  The LSA will have a number of attached Global Router
+    // Link Records corresponding to links off of that vertex / node.  We're going
+    // to be interested in the records corresponding to point-to-point links.
+    //
+    GlobalRoutingLSA* lsa = v->GetLSA();
+    NS_ASSERT_MSG(lsa,
+                  "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
+                  "Expected valid LSA in SPFVertex* v");
 
-        if (!rtr)
-        {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
-            continue;
-        }
+    uint32_t nLinkRecords = lsa->GetNLinkRecords();
+    //
+    // Iterate through the link records on the vertex to which we're going to add
+    // routes.  To make sure we're being clear, we're going to add routing table
+    // entries to the tables on the node corresponding to the root of the SPF tree.
+    // These entries will have routes to the IP addresses we find from looking at
+    // the local side of the point-to-point links found on the node described by
+    // the vertex <v>.
+    //
+    NS_LOG_LOGIC(" Node " << node->GetId() << " found " << nLinkRecords
+                          << " link records in LSA " << lsa << "with LinkStateId "
+                          << lsa->GetLinkStateId());
+    Ptr<Ipv4GlobalRouting> gr = m_spfrootRouting;
+    for (uint32_t j = 0; j < nLinkRecords; ++j)
+    {
         //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
+        // We are only concerned about point-to-point links
         //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() != routerId)
+        GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
+        if (lr->GetLinkType() != GlobalRoutingLinkRecord::PointToPoint)
         {
             continue;
         }
-
-        NS_LOG_LOGIC("Setting routes for node " << node->GetId());
-        //
-        // Routing information is updated using the Ipv4 interface.  We need to
-        // GetObject for that interface.  If the node is acting as an IP version 4
-        // router, it should absolutely have an Ipv4 interface.
-        //
-        Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-        NS_ASSERT_MSG(ipv4,
-                      "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                      "GetObject for <Ipv4> interface failed");
         //
-        // Get the Global Router Link State Advertisement from the vertex we're
-        // adding the routes to.  The LSA will have a number of attached Global Router
-        // Link Records corresponding to links off of that vertex / node.  We're going
-        // to be interested in the records corresponding to point-to-point links.
-        //
-        GlobalRoutingLSA* lsa = v->GetLSA();
-        NS_ASSERT_MSG(lsa,
-                      "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                      "Expected valid LSA in SPFVertex* v");
-
-        uint32_t nLinkRecords = lsa->GetNLinkRecords();
-        //
-        // Iterate through the link records on the vertex to which we're going to add
-        // routes.  To make sure we're being clear, we're going to add routing table
-        // entries to the tables on the node corresponding to the root of the SPF tree.
-        // These entries will have routes to the IP addresses we find from looking at
-        // the local side of the point-to-point links found on the node described by
-        // the vertex <v>.
+        // Here's why we did all of that work.  We're going to add a host route to the
+        // host address found in the m_linkData field of the point-to-point link
+        // record.  In the case of a point-to-point link, this is the local IP address
+        // of the node connected to the link.  Each of these point-to-point links
+        // will correspond to a local interface that has an IP address to which
+        // the node at the root of the SPF tree can send packets.  The vertex <v>
+        // (corresponding to the node that has these links and interfaces) has
+        // an m_nextHop address precalculated for us that is the address to which the
+        // root node should send packets to be forwarded to these IP addresses.
+        // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
+        // which the packets should be send for forwarding.
         //
-        NS_LOG_LOGIC(" Node " << node->GetId() << " found " << nLinkRecords
-                              << " link records in LSA " << lsa << "with LinkStateId "
-                              << lsa->GetLinkStateId());
-        for (uint32_t j = 0; j < nLinkRecords; ++j)
+        // walk through all available exit directions due to ECMP,
+        // and add host route for each of the exit direction toward
+        // the vertex 'v'
+        for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
         {
-            //
-            // We are only concerned about point-to-point links
-            //
-            GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
-            if (lr->GetLinkType() != GlobalRoutingLinkRecord::PointToPoint)
-            {
-                continue;
-            }
-            //
-            // Here's why we did all of that work.  We're going to add a host route to the
-            // host address found in the m_linkData field of the point-to-point link
-            // record.  In the case of a point-to-point link, this is the local IP address
-            // of the node connected to the link.  Each of these point-to-point links
-            // will correspond to a local interface that has an IP address to which
-            // the node at the root of the SPF tree can send packets.  The vertex <v>
-            // (corresponding to the node that has these links and interfaces) has
-            // an m_nextHop address precalculated for us that is the address to which the
-            // root node should send packets to be forwarded to these IP addresses.
-            // Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-            // which the packets should be send for forwarding.
-            //
-            Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-            if (!router)
+            SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+            Ipv4Address nextHop = exit.first;
+            int32_t outIf = exit.second;
+            if (outIf >= 0)
             {
-                continue;
+                gr->AddHostRouteTo(lr->GetLinkData(), nextHop, outIf);
+                NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
+                                       << " adding host route to " << lr->GetLinkData()
+                                       << " using next hop " << nextHop
+                                       << " and outgoing interface " << outIf);
             }
-            Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-            NS_ASSERT(gr);
-            // walk through all available exit directions due to ECMP,
-            // and add host route for each of the exit direction toward
-            // the vertex 'v'
-            for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
+            else
             {
-                SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-                Ipv4Address nextHop = exit.first;
-                int32_t outIf = exit.second;
-                if (outIf >= 0)
-                {
-                    gr->AddHostRouteTo(lr->GetLinkData(), nextHop, outIf);
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " adding host route to " << lr->GetLinkData()
-                                           << " using next hop " << nextHop
-                                           << " and outgoing interface " << outIf);
-                }
-                else
-                {
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " NOT able to add host route to " << lr->GetLinkData()
-                                           << " using next hop " << nextHop
-                                           << " since outgoing interface id is negative " << outIf);
-                }
+                NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
+                                       << " NOT able to add host route to " << lr->GetLinkData()
+                                       << " using next hop " << nextHop
+                                       << " since outgoing interface id is negative " << outIf);
             }
         }
-        //
-        // Done adding the routes for the selected node.
-        //
-        return;
     }
 }
 
@@ -2045,89 +2472,53 @@ GlobalRouteManagerImpl::SPFIntraAddTransit(SPFVertex* v)
 
     NS_LOG_LOGIC("Vertex ID = " << routerId);
     //
-    // We need to walk the list of nodes looking for the one that has the router
-    // ID corresponding to the root vertex.  This is the one we're going to write
-    // the routing information to.
+    // The node of the root router is the one we're going to write the
+    // routing information to.
     //
-    for (auto i = NodeList::Begin(); i != NodeList::End(); i++)
+    if (!m_spfrootNode)
     {
-        Ptr<Node> node = *i;
-        //
-        // The router ID is accessible through the GlobalRouter interface, so we need
-        // to GetObject for that interface.  If there's no GlobalRouter interface,
-        // the node in question cannot be the router we want, so we continue.
-        //
-        Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter>();
+        NS_LOG_LOGIC("No node with router ID " << routerId);
+        return;
+    }
+    Ptr<Node> node = m_spfrootNode;
+    NS_LOG_LOGIC("setting routes for node " << node->GetId());
+    //
+    // Get the Global Router Link State Advertisement from the vertex we're
+    // adding the routes to.  The LSA will have a number of attached Global Router
+    // Link Records corresponding to links off of that vertex / node.  We're going
+    // to be interested in the records corresponding to point-to-point links.
+    //
+    GlobalRoutingLSA* lsa = v->GetLSA();
+    NS_ASSERT_MSG(lsa,
+                  "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
+                  "Expected valid LSA in SPFVertex* v");
+    Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask();
+    Ipv4Address tempip = lsa->GetLinkStateId();
+    tempip = tempip.CombineMask(tempmask);
+    Ptr<Ipv4GlobalRouting> gr = m_spfrootRouting;
+    // walk through all available exit directions due to ECMP,
+    // and add host route for each of the exit direction toward
+    // the vertex 'v'
+    for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
+    {
+        SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
+        Ipv4Address nextHop = exit.first;
+        int32_t outIf = exit.second;
 
-        if (!rtr)
+        if (outIf >= 0)
         {
-            NS_LOG_LOGIC("No GlobalRouter interface on node " << node->GetId());
-            continue;
+            gr->AddNetworkRouteTo(tempip, tempmask, nextHop, outIf);
+            NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
+                                   << " add network route to " << tempip
+                                   << " using next hop " << nextHop << " via interface "
+                                   << outIf);
         }
-        //
-        // If the router ID of the current node is equal to the router ID of the
-        // root of the SPF tree, then this node is the one for which we need to
-        // write the routing tables.
-        //
-        NS_LOG_LOGIC("Considering router " << rtr->GetRouterId());
-
-        if (rtr->GetRouterId() == routerId)
+        else
         {
-            NS_LOG_LOGIC("setting routes for node " << node->GetId());
-            //
-            // Routing information is updated using the Ipv4 interface.  We need to
-            // GetObject for that interface.  If the node is acting as an IP version 4
-            // router, it should absolutely have an Ipv4 interface.
-            //
-            Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
-            NS_ASSERT_MSG(ipv4,
-                          "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
-                          "GetObject for <Ipv4> interface failed");
-            //
-            // Get the Global Router Link State Advertisement from the vertex we're
-            // adding the routes to.  The LSA will have a number of attached Global Router
-            // Link Records corresponding to links off of that vertex / node.  We're going
-            // to be interested in the records corresponding to point-to-point links.
-            //
-            GlobalRoutingLSA* lsa = v->GetLSA();
-            NS_ASSERT_MSG(lsa,
-                          "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
-                          "Expected valid LSA in SPFVertex* v");
-            Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask();
-            Ipv4Address tempip = lsa->GetLinkStateId();
-            tempip = tempip.CombineMask(tempmask);
-            Ptr<GlobalRouter> router = node->GetObject<GlobalRouter>();
-            if (!router)
-            {
-                continue;
-            }
-            Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol();
-            NS_ASSERT(gr);
-            // walk through all available exit directions due to ECMP,
-            // and add host route for each of the exit direction toward
-            // the vertex 'v'
-            for (uint32_t i = 0; i < v->GetNRootExitDirections(); i++)
-            {
-                SPFVertex::NodeExit_t exit = v->GetRootExitDirection(i);
-                Ipv4Address nextHop = exit.first;
-                int32_t outIf = exit.second;
-
-                if (outIf >= 0)
-                {
-                    gr->AddNetworkRouteTo(tempip, tempmask, nextHop, outIf);
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " add network route to " << tempip
-                                           << " using next hop " << nextHop << " via interface "
-                                           << outIf);
-                }
-                else
-                {
-                    NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
-                                           << " NOT able to add network route to " << tempip
-                                           << " using next hop " << nextHop
-                                           << " since outgoing interface id is negative " << outIf);
-                }
-            }
+            NS_LOG_LOGIC("(Route " << i << ") Node " << node->GetId()
+                                   << " NOT able to add network route to " << tempip
+                                   << " using next hop " << nextHop
+                                   << " since outgoing interface id is negative " << outIf);
         }
     }
 }
@@ -20,6 +20,7 @@
 #include <map>
 #include <queue>
 #include <stdint.h>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -28,7 +29,9 @@ namespace ns3
 const uint32_t SPF_INFINITY = 0xffffffff; //!< "infinite" distance between nodes
 
 class CandidateQueue;
+class Ipv4;
 class Ipv4GlobalRouting;
+class Node;
 
 /**
  * @ingroup globalrouting
@@ -628,6 +631,24 @@ class GlobalRouteManagerLSDB
      */
     GlobalRoutingLSA* GetLSAByLinkData(Ipv4Address addr) const;
 
+    /**
+     * @brief Get the Link State Advertisements, except the external ones.
+     *
+     * @returns The Link State Advertisements, in the order of their link
+     * state ID.
+     */
+    std::vector<GlobalRoutingLSA*> GetLSAs() const;
+
+    /**
+     * @brief Copy the database.
+     *
+     * The Link State Advertisements are copied, so that the SPF status of
+     * the copy can be changed independently from the original.
+     *
+     * @returns A new database, that the caller must delete.
+     */
+    GlobalRouteManagerLSDB* Copy() const;
+
     /**
      * @brief Set all LSA flags to an initialized state, for SPF computation
      *
@@ -670,6 +691,8 @@ class GlobalRouteManagerLSDB
     LSDBMap_t m_database; //!< database of IPv4 addresses / Link State Advertisements
     std::vector<GlobalRoutingLSA*>
         m_extdatabase; //!< database of External Link State Advertisements
+    std::unordered_map<Ipv4Address, LSDBMap_t::iterator, Ipv4AddressHash>
+        m_linkData; //!< LSAs by LinkData field of their TransitNetwork link records
 };
 
 /**
@@ -714,6 +737,20 @@ class GlobalRouteManagerImpl
      */
     virtual void InitializeRoutes();
 
+    /**
+     * @brief Rebuild the routing database and update the per-node forwarding
+     * tables accordingly.
+     *
+     * This is equivalent to DeleteGlobalRoutes (), BuildGlobalRoutingDatabase ()
+     * and InitializeRoutes (), but recomputes only the routes that may
+     * have changed.  When the new database only lacks some point-to-point and
+     * stub network link records of the database in use, as it does when links
+     * go down, the routers whose shortest path trees did not use these links
+     * only have the routes to the lost addresses removed.  The other changes
+     * recompute all the routes.
+     */
+    virtual void RecomputeRoutes();
+
     /**
      * @brief Debugging routine; allow client code to supply a pre-built LSDB
      * @param lsdb the pre-built LSDB
@@ -729,6 +766,58 @@ class GlobalRouteManagerImpl
   private:
     SPFVertex* m_spfroot;           //!< the root node
     GlobalRouteManagerLSDB* m_lsdb; //!< the Link State DataBase (LSDB) of the Global Route Manager
+    bool m_lsdbRouted; //!< whether the routes of the LSDB are in the forwarding tables
+    Ptr<Node> m_spfrootNode;                 //!< the node of the root router
+    Ptr<Ipv4> m_spfrootIpv4;                 //!< the Ipv4 of the root router
+    Ptr<Ipv4GlobalRouting> m_spfrootRouting; //!< the routing protocol of the root router
+    std::unordered_map<Ipv4Address, Ptr<Node>, Ipv4AddressHash>
+        m_routerNodes; //!< the nodes of the routers, by router ID
+
+    /**
+     * @brief Find the node of a router.
+     *
+     * @param routerId the router ID
+     * @returns the node, or null if no node has that router ID
+     */
+    Ptr<Node> GetRouterNode(Ipv4Address routerId);
+
+    /**
+     * @brief Delete the routes of a node that has a GlobalRouterInterface
+     *
+     * @param node the node
+     */
+    void DeleteGlobalRoutes(Ptr<Node> node);
+
+    /**
+     * @brief Calculate the shortest path first (SPF) trees of routers and
+     * populate their forwarding tables.
+     *
+     * The calculations are spread over the number of threads given by the
+     * GlobalRoutingThreadCount global value.
+     *
+     * @param roots the root routers
+     */
+    void SPFCalculate(const std::vector<Ipv4Address>& roots);
+
+    /**
+     * @brief Calculate the shortest path first (SPF) tree of a router whose
+     * node is known.
+     *
+     * @param root the root router
+     * @param node the node of the root router
+     */
+    void SPFCalculate(Ipv4Address root, Ptr<Node> node);
+
+    /**
+     * @brief Update the forwarding tables after links were removed from the
+     * LSDB in use.
+     *
+     * @param previous the LSDB that computed the forwarding tables
+     * @returns false if the changes of the LSDB are not all removals of
+     * point-to-point and stub network link records; the forwarding tables
+     * are then left unchanged.
+     */
+    bool RemoveLinks(const GlobalRouteManagerLSDB& previous);
 
     /**
      * @brief Test if a node is a stub, from an OSPF sense.
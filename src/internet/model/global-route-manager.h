@@ -59,6 +59,17 @@ class GlobalRouteManager
      * per-node forwarding tables
      */
     static void InitializeRoutes();
+
+    /**
+     * @brief Rebuild the routing database and update the per-node forwarding
+     * tables accordingly.
+     *
+     * This is equivalent to DeleteGlobalRoutes (), BuildGlobalRoutingDatabase ()
+     * and InitializeRoutes (), except that the routes of the routers that are
+     * not affected by the changes are kept, as well as the routes that were
+     * added to them by other means.
+     */
+    static void RecomputeRoutes();
 };
 
 } // namespace ns3
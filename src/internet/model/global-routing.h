@@ -43,8 +43,11 @@
  * ns3::GlobalRouteManager::PopulateRoutingTables (), prior to the
  * ns3::Simulator::Run() call.
  *
- * There are two attributes of Ipv4GlobalRouting that govern behavior.
+ * These attributes of Ipv4GlobalRouting govern behavior.
  * - Ipv4GlobalRouting::RandomEcmpRouting
+ * - Ipv4GlobalRouting::FlowEcmpRouting
+ * - Ipv4GlobalRouting::EcmpHashSeed
+ * - Ipv4GlobalRouting::FlowletTimeout
  * - Ipv4GlobalRouting::RespondToInterfaceEvents
  *
  * @section impl Implementation
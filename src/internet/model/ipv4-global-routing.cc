@@ -9,6 +9,8 @@
 #include "global-route-manager.h"
 #include "ipv4-route.h"
 #include "ipv4-routing-table-entry.h"
+#include "tcp-l4-protocol.h"
+#include "udp-l4-protocol.h"
 
 #include "ns3/boolean.h"
 #include "ns3/log.h"
@@ -18,8 +20,11 @@
 #include "ns3/object.h"
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <iterator>
 #include <vector>
 
 namespace ns3
@@ -29,6 +34,28 @@ NS_LOG_COMPONENT_DEFINE("Ipv4GlobalRouting");
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv4GlobalRouting);
 
+namespace
+{
+
+/**
+ * @ingroup ipv4
+ * @brief Mix the bits of a flow hash (the finalizer of MurmurHash3).
+ * @param x the value to mix
+ * @returns the mixed value
+ */
+uint64_t
+MixFlowHash(uint64_t x)
+{
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+} // namespace
+
 TypeId
 Ipv4GlobalRouting::GetTypeId()
 {
@@ -42,6 +69,25 @@ Ipv4GlobalRouting::GetTypeId()
                           BooleanValue(false),
                           MakeBooleanAccessor(&Ipv4GlobalRouting::m_randomEcmpRouting),
                           MakeBooleanChecker())
+            .AddAttribute("FlowEcmpRouting",
+                          "Set to true if packets are routed among ECMP by a hash of their flow "
+                          "(addresses, protocol and ports), so that the packets of a flow take "
+                          "the same route; ignored if RandomEcmpRouting is true",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&Ipv4GlobalRouting::m_flowEcmpRouting),
+                          MakeBooleanChecker())
+            .AddAttribute("EcmpHashSeed",
+                          "The seed of the hash of the flows used by FlowEcmpRouting, which is "
+                          "also salted with the node ID",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&Ipv4GlobalRouting::m_ecmpHashSeed),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("FlowletTimeout",
+                          "With FlowEcmpRouting, the gap between the packets of a flow after "
+                          "which the flow may take another route; zero disables the flowlets",
+                          TimeValue(Time(0)),
+                          MakeTimeAccessor(&Ipv4GlobalRouting::m_flowletTimeout),
+                          MakeTimeChecker(Time(0)))
             .AddAttribute("RespondToInterfaceEvents",
                           "Set to true if you want to dynamically recompute the global routes upon "
                           "Interface notification events (up/down, or add/remove address)",
@@ -53,7 +99,11 @@ Ipv4GlobalRouting::GetTypeId()
 
 Ipv4GlobalRouting::Ipv4GlobalRouting()
     : m_randomEcmpRouting(false),
-      m_respondToInterfaceEvents(false)
+      m_respondToInterfaceEvents(false),
+      m_flowEcmpRouting(false),
+      m_ecmpHashSeed(0),
+      m_nodeId(0),
+      m_networkRouteRank(0)
 {
     NS_LOG_FUNCTION(this);
 
@@ -71,7 +121,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, Ipv4Address nextHop, uint32_
     NS_LOG_FUNCTION(this << dest << nextHop << interface);
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, nextHop, interface);
-    m_hostRoutes.push_back(route);
+    AddHostRoute(route);
 }
 
 void
@@ -80,7 +130,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, uint32_t interface)
     NS_LOG_FUNCTION(this << dest << interface);
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, interface);
-    m_hostRoutes.push_back(route);
+    AddHostRoute(route);
 }
 
 void
@@ -92,7 +142,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network,
     NS_LOG_FUNCTION(this << network << networkMask << nextHop << interface);
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
-    m_networkRoutes.push_back(route);
+    AddNetworkRoute(route);
 }
 
 void
@@ -101,7 +151,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network, Ipv4Mask networkMask,
     NS_LOG_FUNCTION(this << network << networkMask << interface);
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
-    m_networkRoutes.push_back(route);
+    AddNetworkRoute(route);
 }
 
 void
@@ -116,8 +166,52 @@ Ipv4GlobalRouting::AddASExternalRouteTo(Ipv4Address network,
     m_ASexternalRoutes.push_back(route);
 }
 
+void
+Ipv4GlobalRouting::AddHostRoute(Ipv4RoutingTableEntry* route)
+{
+    NS_LOG_FUNCTION(this << route);
+    m_hostRoutes.push_back(route);
+    m_hostRouteIndex[route->GetDest()].push_back(std::prev(m_hostRoutes.end()));
+}
+
+void
+Ipv4GlobalRouting::AddNetworkRoute(Ipv4RoutingTableEntry* route)
+{
+    NS_LOG_FUNCTION(this << route);
+    m_networkRoutes.push_back(route);
+    m_networkRouteIndex.Insert(GetPrefixTrieKey(route->GetDestNetwork()),
+                               GetPrefixTrieLength(route->GetDestNetworkMask()),
+                               {m_networkRouteRank++, std::prev(m_networkRoutes.end())});
+}
+
+void
+Ipv4GlobalRouting::UnindexHostRoute(HostRoutesI i)
+{
+    NS_LOG_FUNCTION(this << *i);
+    auto routes = m_hostRouteIndex.find((*i)->GetDest());
+    NS_ASSERT(routes != m_hostRouteIndex.end());
+    std::erase(routes->second, i);
+    if (routes->second.empty())
+    {
+        m_hostRouteIndex.erase(routes);
+    }
+}
+
+void
+Ipv4GlobalRouting::UnindexNetworkRoute(NetworkRoutesI j)
+{
+    NS_LOG_FUNCTION(this << *j);
+    bool removed = m_networkRouteIndex.Remove(GetPrefixTrieKey((*j)->GetDestNetwork()),
+                                              GetPrefixTrieLength((*j)->GetDestNetworkMask()),
+                                              [j](const auto& route) { return route.second == j; });
+    NS_ASSERT(removed);
+}
+
 Ptr<Ipv4Route>
-Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
+Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest,
+                                Ptr<NetDevice> oif,
+                                const Ipv4Header* header,
+                                Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << dest << oif);
     NS_LOG_LOGIC("Looking for route for destination " << dest);
@@ -127,11 +221,12 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
     RouteVec_t allRoutes;
 
     NS_LOG_LOGIC("Number of m_hostRoutes = " << m_hostRoutes.size());
-    for (auto i = m_hostRoutes.begin(); i != m_hostRoutes.end(); i++)
+    auto hostRoutes = m_hostRouteIndex.find(dest);
+    if (hostRoutes != m_hostRouteIndex.end())
     {
-        NS_ASSERT((*i)->IsHost());
-        if ((*i)->GetDest() == dest)
+        for (auto i : hostRoutes->second)
         {
+            NS_ASSERT((*i)->IsHost());
             if (oif)
             {
                 if (oif != m_ipv4->GetNetDevice((*i)->GetInterface()))
@@ -147,7 +242,16 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
     if (allRoutes.empty()) // if no host route is found
     {
         NS_LOG_LOGIC("Number of m_networkRoutes" << m_networkRoutes.size());
-        for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+        // the routes to the networks matching the destination, in the order of m_networkRoutes
+        std::vector<std::pair<uint64_t, NetworkRoutesI>> networkRoutes;
+        m_networkRouteIndex.ForEachMatch(GetPrefixTrieKey(dest),
+                                         [&networkRoutes](const auto& route) {
+                                             networkRoutes.push_back(route);
+                                         });
+        std::sort(networkRoutes.begin(), networkRoutes.end(), [](const auto& a, const auto& b) {
+            return a.first < b.first;
+        });
+        for (const auto& [rank, j] : networkRoutes)
         {
             Ipv4Mask mask = (*j)->GetDestNetworkMask();
             Ipv4Address entry = (*j)->GetDestNetwork();
@@ -191,13 +295,18 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
     if (!allRoutes.empty()) // if route(s) is found
     {
         // pick up one of the routes uniformly at random if random
-        // ECMP routing is enabled, or always select the first route
-        // consistently if random ECMP routing is disabled
+        // ECMP routing is enabled, by the hash of the flow if flow ECMP
+        // routing is enabled, or always select the first route
+        // consistently otherwise
         uint32_t selectIndex;
         if (m_randomEcmpRouting)
         {
             selectIndex = m_rand->GetInteger(0, allRoutes.size() - 1);
         }
+        else if (m_flowEcmpRouting && header && allRoutes.size() > 1)
+        {
+            selectIndex = SelectFlowRoute(*header, p, allRoutes.size());
+        }
         else
         {
             selectIndex = 0;
@@ -286,6 +395,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
             if (tmp == index)
             {
                 NS_LOG_LOGIC("Removing route " << index << "; size = " << m_hostRoutes.size());
+                UnindexHostRoute(i);
                 delete *i;
                 m_hostRoutes.erase(i);
                 NS_LOG_LOGIC("Done removing host route "
@@ -302,6 +412,7 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
         if (tmp == index)
         {
             NS_LOG_LOGIC("Removing route " << index << "; size = " << m_networkRoutes.size());
+            UnindexNetworkRoute(j);
             delete *j;
             m_networkRoutes.erase(j);
             NS_LOG_LOGIC("Done removing network route "
@@ -328,6 +439,95 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
     NS_ASSERT(false);
 }
 
+uint32_t
+Ipv4GlobalRouting::RemoveHostRoutesTo(Ipv4Address dest)
+{
+    NS_LOG_FUNCTION(this << dest);
+    auto routes = m_hostRouteIndex.find(dest);
+    if (routes == m_hostRouteIndex.end())
+    {
+        return 0;
+    }
+    uint32_t removed = routes->second.size();
+    for (auto i : routes->second)
+    {
+        delete *i;
+        m_hostRoutes.erase(i);
+    }
+    m_hostRouteIndex.erase(routes);
+    return removed;
+}
+
+uint32_t
+Ipv4GlobalRouting::RemoveNetworkRoutesTo(Ipv4Address network, Ipv4Mask networkMask)
+{
+    NS_LOG_FUNCTION(this << network << networkMask);
+    const auto* routes = m_networkRouteIndex.Find(GetPrefixTrieKey(network),
+                                                  GetPrefixTrieLength(networkMask));
+    if (!routes)
+    {
+        return 0;
+    }
+    std::vector<NetworkRoutesI> matches;
+    for (const auto& [rank, j] : *routes)
+    {
+        if ((*j)->GetDestNetwork() == network && (*j)->GetDestNetworkMask() == networkMask)
+        {
+            matches.push_back(j);
+        }
+    }
+    for (auto j : matches)
+    {
+        UnindexNetworkRoute(j);
+        delete *j;
+        m_networkRoutes.erase(j);
+    }
+    return matches.size();
+}
+
+uint32_t
+Ipv4GlobalRouting::SelectFlowRoute(const Ipv4Header& header,
+                                   Ptr<const Packet> p,
+                                   uint32_t nRoutes)
+{
+    NS_LOG_FUNCTION(this << header << p << nRoutes);
+    uint32_t ports = 0;
+    uint8_t protocol = header.GetProtocol();
+    // The fragments but the first have no transport header: all the fragments
+    // are hashed without the ports, to take the same route
+    if (p && (protocol == TcpL4Protocol::PROT_NUMBER || protocol == UdpL4Protocol::PROT_NUMBER) &&
+        header.IsLastFragment() && header.GetFragmentOffset() == 0 && p->GetSize() >= 4)
+    {
+        uint8_t buffer[4];
+        p->CopyData(buffer, 4);
+        ports = (buffer[0] << 24) | (buffer[1] << 16) | (buffer[2] << 8) | buffer[3];
+    }
+    uint64_t addresses =
+        (static_cast<uint64_t>(header.GetSource().Get()) << 32) | header.GetDestination().Get();
+    uint64_t salt = (static_cast<uint64_t>(m_ecmpHashSeed) << 32) | m_nodeId;
+    uint64_t hash =
+        MixFlowHash(addresses ^ MixFlowHash(((static_cast<uint64_t>(ports) << 8) | protocol) ^
+                                            MixFlowHash(salt)));
+    if (m_flowletTimeout.IsStrictlyPositive())
+    {
+        if (m_flowlets.empty())
+        {
+            m_flowlets.resize(FLOWLET_TABLE_SIZE, {Time(0), 0});
+        }
+        Flowlet& flowlet = m_flowlets[hash % FLOWLET_TABLE_SIZE];
+        Time now = Simulator::Now();
+        if (now - flowlet.lastSeen > m_flowletTimeout)
+        {
+            flowlet.id++;
+            NS_LOG_LOGIC("New flowlet " << flowlet.id);
+        }
+        flowlet.lastSeen = now;
+        hash = MixFlowHash(hash ^ flowlet.id);
+    }
+    // Map the high bits of the hash to the routes, without a division
+    return static_cast<uint32_t>(((hash >> 32) * nRoutes) >> 32);
+}
+
 int64_t
 Ipv4GlobalRouting::AssignStreams(int64_t stream)
 {
@@ -340,6 +540,8 @@ void
 Ipv4GlobalRouting::DoDispose()
 {
     NS_LOG_FUNCTION(this);
+    m_hostRouteIndex.clear();
+    m_networkRouteIndex.Clear();
     for (auto i = m_hostRoutes.begin(); i != m_hostRoutes.end(); i = m_hostRoutes.erase(i))
     {
         delete (*i);
@@ -445,7 +647,13 @@ Ipv4GlobalRouting::RouteOutput(Ptr<Packet> p,
     // See if this is a unicast packet we have a route for.
     //
     NS_LOG_LOGIC("Unicast destination- looking up");
-    Ptr<Ipv4Route> rtentry = LookupGlobal(header.GetDestination(), oif);
+    // The transport header of the TCP packets is added before the route
+    // lookup, but not that of the UDP packets: only the former give their ports
+    Ptr<Ipv4Route> rtentry =
+        LookupGlobal(header.GetDestination(),
+                     oif,
+                     &header,
+                     header.GetProtocol() == TcpL4Protocol::PROT_NUMBER ? p : nullptr);
     if (rtentry)
     {
         sockerr = Socket::ERROR_NOTERROR;
@@ -500,7 +708,7 @@ Ipv4GlobalRouting::RouteInput(Ptr<const Packet> p,
     }
     // Next, try to find a route
     NS_LOG_LOGIC("Unicast destination- looking up global route");
-    Ptr<Ipv4Route> rtentry = LookupGlobal(header.GetDestination());
+    Ptr<Ipv4Route> rtentry = LookupGlobal(header.GetDestination(), nullptr, &header, p);
     if (rtentry)
     {
         NS_LOG_LOGIC("Found unicast destination- calling unicast callback");
@@ -521,9 +729,7 @@ Ipv4GlobalRouting::NotifyInterfaceUp(uint32_t i)
     NS_LOG_FUNCTION(this << i);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        GlobalRouteManager::RecomputeRoutes();
     }
 }
 
@@ -533,9 +739,7 @@ Ipv4GlobalRouting::NotifyInterfaceDown(uint32_t i)
     NS_LOG_FUNCTION(this << i);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        GlobalRouteManager::RecomputeRoutes();
     }
 }
 
@@ -545,9 +749,7 @@ Ipv4GlobalRouting::NotifyAddAddress(uint32_t interface, Ipv4InterfaceAddress add
     NS_LOG_FUNCTION(this << interface << address);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        GlobalRouteManager::RecomputeRoutes();
     }
 }
 
@@ -557,9 +759,7 @@ Ipv4GlobalRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress
     NS_LOG_FUNCTION(this << interface << address);
     if (m_respondToInterfaceEvents && Simulator::Now().GetSeconds() > 0) // avoid startup events
     {
-        GlobalRouteManager::DeleteGlobalRoutes();
-        GlobalRouteManager::BuildGlobalRoutingDatabase();
-        GlobalRouteManager::InitializeRoutes();
+        GlobalRouteManager::RecomputeRoutes();
     }
 }
 
@@ -569,6 +769,11 @@ Ipv4GlobalRouting::SetIpv4(Ptr<Ipv4> ipv4)
     NS_LOG_FUNCTION(this << ipv4);
     NS_ASSERT(!m_ipv4 && ipv4);
     m_ipv4 = ipv4;
+    Ptr<Node> node = m_ipv4->GetObject<Node>();
+    if (node)
+    {
+        m_nodeId = node->GetId();
+    }
 }
 
 } // namespace ns3
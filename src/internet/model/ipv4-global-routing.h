@@ -10,13 +10,18 @@
 #include "ipv4-header.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
+#include "prefix-trie.h"
 
 #include "ns3/ipv4-address.h"
+#include "ns3/nstime.h"
 #include "ns3/ptr.h"
 #include "ns3/random-variable-stream.h"
 
 #include <list>
 #include <stdint.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -54,6 +59,18 @@ class Node;
  *
  * This class deals with Ipv4 unicast routes only.
  *
+ * When several routes of equal cost lead to a destination, the route used is
+ * the first one by default.  With the RandomEcmpRouting attribute, each packet
+ * takes a route drawn at random, which reorders the packets of the flows.
+ * With the FlowEcmpRouting attribute, the route is selected by a hash of the
+ * addresses, the protocol and the ports of the packet, so that all the packets
+ * of a flow take the same route.  The hash is salted with the node ID and the
+ * EcmpHashSeed attribute, so that the choices of successive routers are not
+ * correlated.  With a non-zero FlowletTimeout, a flow is moved to another
+ * route, also selected by hash, when it resumes after a gap longer than the
+ * timeout (flowlet switching): the packets of a flowlet are not reordered if
+ * the timeout exceeds the difference between the delays of the routes.
+ *
  * @see Ipv4RoutingProtocol
  * @see GlobalRouteManager
  */
@@ -210,6 +227,25 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
      */
     void RemoveRoute(uint32_t i);
 
+    /**
+     * @brief Remove the host routes to a destination from the global unicast
+     * routing table.
+     *
+     * @param dest The Ipv4Address destination of the routes.
+     * @return The number of routes removed.
+     */
+    uint32_t RemoveHostRoutesTo(Ipv4Address dest);
+
+    /**
+     * @brief Remove the network routes to a network from the global unicast
+     * routing table.
+     *
+     * @param network The Ipv4Address network of the routes.
+     * @param networkMask The Ipv4Mask of the network.
+     * @return The number of routes removed.
+     */
+    uint32_t RemoveNetworkRoutesTo(Ipv4Address network, Ipv4Mask networkMask);
+
     /**
      * Assign a fixed random variable stream number to the random variables
      * used by this model.  Return the number of streams (possibly zero) that
@@ -232,6 +268,26 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
     bool m_respondToInterfaceEvents;
     /// A uniform random number generator for randomly routing packets among ECMP
     Ptr<UniformRandomVariable> m_rand;
+    /// Set to true if the packets are routed among ECMP by a hash of their flow
+    bool m_flowEcmpRouting;
+    /// The seed of the hash of the flows, salted with the node ID
+    uint32_t m_ecmpHashSeed;
+    /// The gap after which a flow may take another route, or zero to disable flowlets
+    Time m_flowletTimeout;
+    /// The ID of the node, which salts the hash of the flows
+    uint32_t m_nodeId;
+
+    /// The state of the flowlets of the flows hashed to an entry of the flowlet table
+    struct Flowlet
+    {
+        Time lastSeen; //!< The time of the last packet
+        uint32_t id;   //!< The number of the current flowlet, which salts the route selection
+    };
+
+    /// The number of entries of the flowlet table
+    static constexpr uint32_t FLOWLET_TABLE_SIZE = 4096;
+    /// The flowlet table, indexed by the hash of the flows, allocated on first use
+    std::vector<Flowlet> m_flowlets;
 
     /// container of Ipv4RoutingTableEntry (routes to hosts)
     typedef std::list<Ipv4RoutingTableEntry*> HostRoutes;
@@ -258,14 +314,62 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
      * @brief Lookup in the forwarding table for destination.
      * @param dest destination address
      * @param oif output interface if any (put 0 otherwise)
+     * @param header the IP header of the packet, to select a route among ECMP by flow, if any
+     * @param p the packet, starting with its transport header, if any
      * @return Ipv4Route to route the packet to reach dest address
      */
-    Ptr<Ipv4Route> LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif = nullptr);
+    Ptr<Ipv4Route> LookupGlobal(Ipv4Address dest,
+                                Ptr<NetDevice> oif = nullptr,
+                                const Ipv4Header* header = nullptr,
+                                Ptr<const Packet> p = nullptr);
+
+    /**
+     * @brief Select a route among ECMP by a hash of the flow of a packet.
+     *
+     * The flow is identified by the addresses and the protocol of the packet,
+     * and by its ports for the TCP and UDP packets which are not fragments.
+     *
+     * @param header the IP header of the packet
+     * @param p the packet, starting with its transport header, or nullptr to ignore the ports
+     * @param nRoutes the number of routes
+     * @return the index of the route
+     */
+    uint32_t SelectFlowRoute(const Ipv4Header& header, Ptr<const Packet> p, uint32_t nRoutes);
+
+    /**
+     * @brief Append a route to the routes to hosts, and index it.
+     * @param route the route
+     */
+    void AddHostRoute(Ipv4RoutingTableEntry* route);
+
+    /**
+     * @brief Append a route to the routes to networks, and index it.
+     * @param route the route
+     */
+    void AddNetworkRoute(Ipv4RoutingTableEntry* route);
+
+    /**
+     * @brief Remove a route to a host from the index.
+     * @param i the route, still in m_hostRoutes
+     */
+    void UnindexHostRoute(HostRoutesI i);
+
+    /**
+     * @brief Remove a route to a network from the index.
+     * @param j the route, still in m_networkRoutes
+     */
+    void UnindexNetworkRoute(NetworkRoutesI j);
 
     HostRoutes m_hostRoutes;             //!< Routes to hosts
     NetworkRoutes m_networkRoutes;       //!< Routes to networks
     ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
 
+    /// The routes to hosts, by destination, in the order of m_hostRoutes
+    std::unordered_map<Ipv4Address, std::vector<HostRoutesI>, Ipv4AddressHash> m_hostRouteIndex;
+    /// The routes to networks, by prefix, with their rank in m_networkRoutes
+    PrefixTrie<std::pair<uint64_t, NetworkRoutesI>, 4> m_networkRouteIndex;
+    uint64_t m_networkRouteRank; //!< The rank of the next route to a network
+
     Ptr<Ipv4> m_ipv4; //!< associated IPv4 instance
 };
 
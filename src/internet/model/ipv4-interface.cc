@@ -60,7 +60,8 @@ Ipv4Interface::Ipv4Interface()
       m_node(nullptr),
       m_device(nullptr),
       m_tc(nullptr),
-      m_cache(nullptr)
+      m_cache(nullptr),
+      m_arp(nullptr)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -78,6 +79,7 @@ Ipv4Interface::DoDispose()
     m_device = nullptr;
     m_tc = nullptr;
     m_cache = nullptr;
+    m_arp = nullptr;
     Object::DoDispose();
 }
 
@@ -116,8 +118,8 @@ Ipv4Interface::DoSetup()
     {
         return;
     }
-    Ptr<ArpL3Protocol> arp = m_node->GetObject<ArpL3Protocol>();
-    m_cache = arp->CreateCache(m_device, this);
+    m_arp = m_node->GetObject<ArpL3Protocol>();
+    m_cache = m_arp->CreateCache(m_device, this);
 }
 
 Ptr<NetDevice>
@@ -254,7 +256,6 @@ Ipv4Interface::Send(Ptr<Packet> p, const Ipv4Header& hdr, Ipv4Address dest)
     if (m_device->NeedsArp())
     {
         NS_LOG_LOGIC("Needs ARP " << dest);
-        Ptr<ArpL3Protocol> arp = m_node->GetObject<ArpL3Protocol>();
         Address hardwareDestination;
         bool found = false;
         if (dest.IsBroadcast())
@@ -288,7 +289,7 @@ Ipv4Interface::Send(Ptr<Packet> p, const Ipv4Header& hdr, Ipv4Address dest)
             if (!found)
             {
                 NS_LOG_LOGIC("ARP Lookup");
-                found = arp->Lookup(p, hdr, dest, m_device, m_cache, &hardwareDestination);
+                found = m_arp->Lookup(p, hdr, dest, m_device, m_cache, &hardwareDestination);
             }
         }
 
@@ -23,6 +23,7 @@ class NetDevice;
 class Packet;
 class Node;
 class ArpCache;
+class ArpL3Protocol;
 class Ipv4InterfaceAddress;
 class Ipv4Address;
 class Ipv4Header;
@@ -235,6 +236,7 @@ class Ipv4Interface : public Object
     Ptr<NetDevice> m_device;            //!< The associated NetDevice
     Ptr<TrafficControlLayer> m_tc;      //!< The associated TrafficControlLayer
     Ptr<ArpCache> m_cache;              //!< ARP cache
+    Ptr<ArpL3Protocol> m_arp;           //!< ARP protocol of the node
     Callback<void, Ptr<Ipv4Interface>, Ipv4InterfaceAddress>
         m_removeAddressCallback; //!< remove address callback
     Callback<void, Ptr<Ipv4Interface>, Ipv4InterfaceAddress>
@@ -635,6 +635,15 @@ class Ipv4L3Protocol : public Ipv4
     Ipv4RoutingProtocol::ErrorCallback m_ecb;            ///< Error callback
 };
 
+/**
+ * @brief Ipv4L3Protocol is stored in a slot of the aggregation cache of Object::GetObject().
+ */
+template <>
+struct ObjectCacheSlot<Ipv4L3Protocol>
+{
+    static constexpr uint8_t index = Object::CACHE_SLOT_IPV4_L3; //!< The slot
+};
+
 } // Namespace ns3
 
 #endif /* IPV4_L3_PROTOCOL_H */
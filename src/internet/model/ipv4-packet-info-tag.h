@@ -10,6 +10,7 @@
 #define IPV4_PACKET_INFO_TAG_H
 
 #include "ns3/ipv4-address.h"
+#include "ns3/packet-tag-list.h"
 #include "ns3/tag.h"
 
 namespace ns3
@@ -106,6 +107,16 @@ class Ipv4PacketInfoTag : public Tag
     // Used for IP_RECVTTL, though not implemented yet.
     uint8_t m_ttl; //!< Time to Live
 };
+
+/**
+ * @brief Ipv4PacketInfoTag is stored in a slot of the PacketTagList hot tag store.
+ */
+template <>
+struct PacketTagSlot<Ipv4PacketInfoTag>
+{
+    static constexpr uint8_t index = PacketTagList::SLOT_IPV4_PACKET_INFO; //!< The slot
+};
+
 } // namespace ns3
 
 #endif /* IPV4_PACKET_INFO_TAG_H */
@@ -25,7 +25,10 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <iterator>
+#include <vector>
 
 using std::make_pair;
 
@@ -47,7 +50,8 @@ Ipv4StaticRouting::GetTypeId()
 }
 
 Ipv4StaticRouting::Ipv4StaticRouting()
-    : m_ipv4(nullptr)
+    : m_networkRouteRank(0),
+      m_ipv4(nullptr)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -68,7 +72,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
     if (!LookupRoute(route, metric))
     {
         auto routePtr = new Ipv4RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AddNetworkRoute(routePtr, metric);
     }
 }
 
@@ -86,7 +90,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
     {
         auto routePtr = new Ipv4RoutingTableEntry(route);
 
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AddNetworkRoute(routePtr, metric);
     }
 }
 
@@ -141,7 +145,29 @@ Ipv4StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     Ipv4Address network("224.0.0.0");
     Ipv4Mask networkMask("240.0.0.0");
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
-    m_networkRoutes.emplace_back(route, 0);
+    AddNetworkRoute(route, 0);
+}
+
+void
+Ipv4StaticRouting::AddNetworkRoute(Ipv4RoutingTableEntry* route, uint32_t metric)
+{
+    NS_LOG_FUNCTION(this << route << metric);
+    m_networkRoutes.emplace_back(route, metric);
+    m_networkRouteIndex.Insert(GetPrefixTrieKey(route->GetDestNetwork()),
+                               GetPrefixTrieLength(route->GetDestNetworkMask()),
+                               {m_networkRouteRank++, std::prev(m_networkRoutes.end())});
+}
+
+void
+Ipv4StaticRouting::UnindexNetworkRoute(NetworkRoutesI route)
+{
+    NS_LOG_FUNCTION(this << route->first);
+    Ipv4RoutingTableEntry* entry = route->first;
+    auto isRoute = [route](const auto& indexed) { return indexed.second == route; };
+    bool removed = m_networkRouteIndex.Remove(GetPrefixTrieKey(entry->GetDestNetwork()),
+                                              GetPrefixTrieLength(entry->GetDestNetworkMask()),
+                                              isRoute);
+    NS_ASSERT(removed);
 }
 
 uint32_t
@@ -213,7 +239,13 @@ Ipv4StaticRouting::RemoveMulticastRoute(uint32_t index)
 bool
 Ipv4StaticRouting::LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metric)
 {
-    for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    const auto* routes = m_networkRouteIndex.Find(GetPrefixTrieKey(route.GetDest()),
+                                                  GetPrefixTrieLength(route.GetDestNetworkMask()));
+    if (!routes)
+    {
+        return false;
+    }
+    for (const auto& [rank, j] : *routes)
     {
         Ipv4RoutingTableEntry* rtentry = j->first;
 
@@ -250,7 +282,14 @@ Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
         return rtentry;
     }
 
-    for (auto i = m_networkRoutes.begin(); i != m_networkRoutes.end(); i++)
+    // The routes to the networks matching the destination, in the order of m_networkRoutes
+    std::vector<std::pair<uint64_t, NetworkRoutesI>> routes;
+    m_networkRouteIndex.ForEachMatch(GetPrefixTrieKey(dest),
+                                     [&routes](const auto& route) { routes.push_back(route); });
+    std::sort(routes.begin(), routes.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    for (const auto& [rank, i] : routes)
     {
         Ipv4RoutingTableEntry* j = i->first;
         uint32_t metric = i->second;
@@ -374,7 +413,14 @@ Ipv4StaticRouting::GetDefaultRoute()
     Ipv4Address dest("0.0.0.0");
     uint32_t shortest_metric = 0xffffffff;
     Ipv4RoutingTableEntry* result = nullptr;
-    for (auto i = m_networkRoutes.begin(); i != m_networkRoutes.end(); i++)
+    // The routes to the networks matching the destination, in the order of m_networkRoutes
+    std::vector<std::pair<uint64_t, NetworkRoutesI>> routes;
+    m_networkRouteIndex.ForEachMatch(GetPrefixTrieKey(dest),
+                                     [&routes](const auto& route) { routes.push_back(route); });
+    std::sort(routes.begin(), routes.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    for (const auto& [rank, i] : routes)
     {
         Ipv4RoutingTableEntry* j = i->first;
         uint32_t metric = i->second;
@@ -446,6 +492,7 @@ Ipv4StaticRouting::RemoveRoute(uint32_t index)
     {
         if (tmp == index)
         {
+            UnindexNetworkRoute(j);
             delete j->first;
             m_networkRoutes.erase(j);
             return;
@@ -577,6 +624,7 @@ void
 Ipv4StaticRouting::DoDispose()
 {
     NS_LOG_FUNCTION(this);
+    m_networkRouteIndex.Clear();
     for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j = m_networkRoutes.erase(j))
     {
         delete (j->first);
@@ -620,6 +668,7 @@ Ipv4StaticRouting::NotifyInterfaceDown(uint32_t i)
     {
         if (it->first->GetInterface() == i)
         {
+            UnindexNetworkRoute(it);
             delete it->first;
             it = m_networkRoutes.erase(it);
         }
@@ -665,6 +714,7 @@ Ipv4StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress
             it->first->GetDestNetwork() == networkAddress &&
             it->first->GetDestNetworkMask() == networkMask)
         {
+            UnindexNetworkRoute(it);
             delete it->first;
             it = m_networkRoutes.erase(it);
         }
@@ -13,6 +13,7 @@
 #include "ipv4-header.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
+#include "prefix-trie.h"
 
 #include "ns3/ipv4-address.h"
 #include "ns3/ptr.h"
@@ -21,6 +22,7 @@
 #include <list>
 #include <stdint.h>
 #include <utility>
+#include <vector>
 
 namespace ns3
 {
@@ -395,11 +397,35 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      */
     Ptr<Ipv4MulticastRoute> LookupStatic(Ipv4Address origin, Ipv4Address group, uint32_t interface);
 
+    /**
+     * @brief Append a route to the forwarding table for network, and index it.
+     * @param route route
+     * @param metric metric of route
+     */
+    void AddNetworkRoute(Ipv4RoutingTableEntry* route, uint32_t metric);
+
+    /**
+     * @brief Remove a route from the index of the forwarding table for network.
+     * @param route route, still in m_networkRoutes
+     */
+    void UnindexNetworkRoute(NetworkRoutesI route);
+
     /**
      * @brief the forwarding table for network.
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * @brief the routes of the forwarding table for network, by prefix, with
+     * their rank in m_networkRoutes.
+     */
+    PrefixTrie<std::pair<uint64_t, NetworkRoutesI>, 4> m_networkRouteIndex;
+
+    /**
+     * @brief the rank of the next route of the forwarding table for network.
+     */
+    uint64_t m_networkRouteRank;
+
     /**
      * @brief the forwarding table for multicast.
      */
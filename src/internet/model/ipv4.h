@@ -460,6 +460,15 @@ class Ipv4 : public Object
     virtual bool GetStrongEndSystemModel() const = 0;
 };
 
+/**
+ * @brief Ipv4 is stored in a slot of the aggregation cache of Object::GetObject().
+ */
+template <>
+struct ObjectCacheSlot<Ipv4>
+{
+    static constexpr uint8_t index = Object::CACHE_SLOT_IPV4; //!< The slot
+};
+
 } // namespace ns3
 
 #endif /* IPV4_H */
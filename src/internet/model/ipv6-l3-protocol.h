@@ -835,6 +835,15 @@ class Ipv6L3Protocol : public Ipv6
     Ipv6RoutingProtocol::ErrorCallback m_ecb;            ///< Error callback
 };
 
+/**
+ * @brief Ipv6L3Protocol is stored in a slot of the aggregation cache of Object::GetObject().
+ */
+template <>
+struct ObjectCacheSlot<Ipv6L3Protocol>
+{
+    static constexpr uint8_t index = Object::CACHE_SLOT_IPV6_L3; //!< The slot
+};
+
 } /* namespace ns3 */
 
 #endif /* IPV6_L3_PROTOCOL_H */
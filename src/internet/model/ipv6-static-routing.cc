@@ -18,7 +18,10 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <iterator>
+#include <vector>
 
 namespace ns3
 {
@@ -38,7 +41,8 @@ Ipv6StaticRouting::GetTypeId()
 }
 
 Ipv6StaticRouting::Ipv6StaticRouting()
-    : m_ipv6(nullptr)
+    : m_networkRouteRank(0),
+      m_ipv6(nullptr)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -171,7 +175,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
     if (!LookupRoute(route, metric))
     {
         auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AddNetworkRoute(routePtr, metric);
     }
 }
 
@@ -198,7 +202,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
     if (!LookupRoute(route, metric))
     {
         auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AddNetworkRoute(routePtr, metric);
     }
 }
 
@@ -215,7 +219,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
     if (!LookupRoute(route, metric))
     {
         auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AddNetworkRoute(routePtr, metric);
     }
 }
 
@@ -257,7 +261,29 @@ Ipv6StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     Ipv6Address network = Ipv6Address("ff00::"); /* RFC 3513 */
     Ipv6Prefix networkMask = Ipv6Prefix(8);
     *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
-    m_networkRoutes.emplace_back(route, 0);
+    AddNetworkRoute(route, 0);
+}
+
+void
+Ipv6StaticRouting::AddNetworkRoute(Ipv6RoutingTableEntry* route, uint32_t metric)
+{
+    NS_LOG_FUNCTION(this << route << metric);
+    m_networkRoutes.emplace_back(route, metric);
+    m_networkRouteIndex.Insert(GetPrefixTrieKey(route->GetDestNetwork()),
+                               GetPrefixTrieLength(route->GetDestNetworkPrefix()),
+                               {m_networkRouteRank++, std::prev(m_networkRoutes.end())});
+}
+
+void
+Ipv6StaticRouting::UnindexNetworkRoute(NetworkRoutesI route)
+{
+    NS_LOG_FUNCTION(this << route->first);
+    Ipv6RoutingTableEntry* entry = route->first;
+    auto isRoute = [route](const auto& indexed) { return indexed.second == route; };
+    bool removed = m_networkRouteIndex.Remove(GetPrefixTrieKey(entry->GetDestNetwork()),
+                                              GetPrefixTrieLength(entry->GetDestNetworkPrefix()),
+                                              isRoute);
+    NS_ASSERT(removed);
 }
 
 uint32_t
@@ -333,26 +359,33 @@ Ipv6StaticRouting::HasNetworkDest(Ipv6Address network, uint32_t interfaceIndex)
     NS_LOG_FUNCTION(this << network << interfaceIndex);
 
     /* in the network table */
-    for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
-    {
-        Ipv6RoutingTableEntry* rtentry = j->first;
+    bool found = false;
+    m_networkRouteIndex.ForEachMatch(GetPrefixTrieKey(network), [&](const auto& route) {
+        Ipv6RoutingTableEntry* rtentry = route.second->first;
         Ipv6Prefix prefix = rtentry->GetDestNetworkPrefix();
         Ipv6Address entry = rtentry->GetDestNetwork();
 
         if (prefix.IsMatch(network, entry) && rtentry->GetInterface() == interfaceIndex)
         {
-            return true;
+            found = true;
         }
-    }
+    });
 
-    /* beuh!!! not route at all */
-    return false;
+    /* beuh!!! not route at all if not found */
+    return found;
 }
 
 bool
 Ipv6StaticRouting::LookupRoute(const Ipv6RoutingTableEntry& route, uint32_t metric)
 {
-    for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    const auto* routes =
+        m_networkRouteIndex.Find(GetPrefixTrieKey(route.GetDest()),
+                                 GetPrefixTrieLength(route.GetDestNetworkPrefix()));
+    if (!routes)
+    {
+        return false;
+    }
+    for (const auto& [rank, j] : *routes)
     {
         Ipv6RoutingTableEntry* rtentry = j->first;
 
@@ -391,7 +424,14 @@ Ipv6StaticRouting::LookupStatic(Ipv6Address dst, Ptr<NetDevice> interface)
         return rtentry;
     }
 
-    for (auto it = m_networkRoutes.begin(); it != m_networkRoutes.end(); it++)
+    // The routes to the networks matching the destination, in the order of m_networkRoutes
+    std::vector<std::pair<uint64_t, NetworkRoutesI>> routes;
+    m_networkRouteIndex.ForEachMatch(GetPrefixTrieKey(dst),
+                                     [&routes](const auto& route) { routes.push_back(route); });
+    std::sort(routes.begin(), routes.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    for (const auto& [rank, it] : routes)
     {
         Ipv6RoutingTableEntry* j = it->first;
         uint32_t metric = it->second;
@@ -470,6 +510,7 @@ Ipv6StaticRouting::DoDispose()
 {
     NS_LOG_FUNCTION(this);
 
+    m_networkRouteIndex.Clear();
     for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j = m_networkRoutes.erase(j))
     {
         delete j->first;
@@ -553,7 +594,14 @@ Ipv6StaticRouting::GetDefaultRoute()
     uint32_t shortestMetric = 0xffffffff;
     Ipv6RoutingTableEntry* result = nullptr;
 
-    for (auto it = m_networkRoutes.begin(); it != m_networkRoutes.end(); it++)
+    // The routes to the networks matching the destination, in the order of m_networkRoutes
+    std::vector<std::pair<uint64_t, NetworkRoutesI>> routes;
+    m_networkRouteIndex.ForEachMatch(GetPrefixTrieKey(dst),
+                                     [&routes](const auto& route) { routes.push_back(route); });
+    std::sort(routes.begin(), routes.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    for (const auto& [rank, it] : routes)
     {
         Ipv6RoutingTableEntry* j = it->first;
         uint32_t metric = it->second;
@@ -632,6 +680,7 @@ Ipv6StaticRouting::RemoveRoute(uint32_t index)
     {
         if (tmp == index)
         {
+            UnindexNetworkRoute(it);
             delete it->first;
             m_networkRoutes.erase(it);
             return;
@@ -655,6 +704,7 @@ Ipv6StaticRouting::RemoveRoute(Ipv6Address network,
         if (network == rtentry->GetDest() && rtentry->GetInterface() == ifIndex &&
             rtentry->GetPrefixToUse() == prefixToUse)
         {
+            UnindexNetworkRoute(it);
             delete it->first;
             m_networkRoutes.erase(it);
             return;
@@ -797,6 +847,7 @@ Ipv6StaticRouting::NotifyInterfaceDown(uint32_t i)
     {
         if (it->first->GetInterface() == i)
         {
+            UnindexNetworkRoute(it);
             delete it->first;
             it = m_networkRoutes.erase(it);
         }
@@ -835,6 +886,7 @@ Ipv6StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv6InterfaceAddress
             it->first->GetDestNetwork() == networkAddress &&
             it->first->GetDestNetworkPrefix() == networkMask)
         {
+            UnindexNetworkRoute(it);
             delete it->first;
             it = m_networkRoutes.erase(it);
         }
@@ -893,6 +945,7 @@ Ipv6StaticRouting::NotifyRemoveRoute(Ipv6Address dst,
 
             if (dst == entry && prefix == mask && rtentry->GetInterface() == interface)
             {
+                UnindexNetworkRoute(j);
                 delete j->first;
                 j = m_networkRoutes.erase(j);
             }
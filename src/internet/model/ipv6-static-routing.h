@@ -12,12 +12,14 @@
 #include "ipv6-header.h"
 #include "ipv6-routing-protocol.h"
 #include "ipv6.h"
+#include "prefix-trie.h"
 
 #include "ns3/ipv6-address.h"
 #include "ns3/ptr.h"
 
 #include <list>
 #include <stdint.h>
+#include <utility>
 
 namespace ns3
 {
@@ -320,11 +322,35 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
      */
     Ptr<Ipv6MulticastRoute> LookupStatic(Ipv6Address origin, Ipv6Address group, uint32_t ifIndex);
 
+    /**
+     * @brief Append a route to the forwarding table for network, and index it.
+     * @param route route
+     * @param metric metric of route
+     */
+    void AddNetworkRoute(Ipv6RoutingTableEntry* route, uint32_t metric);
+
+    /**
+     * @brief Remove a route from the index of the forwarding table for network.
+     * @param route route, still in m_networkRoutes
+     */
+    void UnindexNetworkRoute(NetworkRoutesI route);
+
     /**
      * @brief the forwarding table for network.
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * @brief the routes of the forwarding table for network, by prefix, with
+     * their rank in m_networkRoutes.
+     */
+    PrefixTrie<std::pair<uint64_t, NetworkRoutesI>, 16> m_networkRouteIndex;
+
+    /**
+     * @brief the rank of the next route of the forwarding table for network.
+     */
+    uint64_t m_networkRouteRank;
+
     /**
      * @brief the forwarding table for multicast.
      */
@@ -430,6 +430,15 @@ class Ipv6 : public Object
     virtual bool GetStrongEndSystemModel() const = 0;
 };
 
+/**
+ * @brief Ipv6 is stored in a slot of the aggregation cache of Object::GetObject().
+ */
+template <>
+struct ObjectCacheSlot<Ipv6>
+{
+    static constexpr uint8_t index = Object::CACHE_SLOT_IPV6; //!< The slot
+};
+
 } // namespace ns3
 
 #endif /* IPV6_H */
@@ -0,0 +1,381 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PREFIX_TRIE_H
+#define PREFIX_TRIE_H
+
+#include "ns3/ipv4-address.h"
+#include "ns3/ipv6-address.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup internet
+ *
+ * @brief A path-compressed binary trie of address prefixes, to find the
+ * values stored for all the prefixes matching an address.
+ *
+ * Each node holds the values inserted for one prefix, and has at most two
+ * children, one for each value of the next bit: the nodes with a single
+ * child are compressed away.  The prefixes matching an address are found in
+ * a walk from the root, in a time proportional to the number of nodes on
+ * the path, which is at most the number of distinct prefix lengths, plus
+ * one, instead of the number of prefixes.
+ *
+ * The values of a prefix are kept in the order in which they were inserted.
+ *
+ * @tparam T \explicit The type of the values.
+ * @tparam N \explicit The number of bytes of the addresses.
+ */
+template <typename T, std::size_t N>
+class PrefixTrie
+{
+  public:
+    /// The bytes of an address, in network order
+    using Key = std::array<uint8_t, N>;
+
+    /// The length of the longest prefixes, in bits
+    static constexpr uint32_t MAX_LENGTH = N * 8;
+
+    /**
+     * Insert a value for a prefix.
+     * @param key The address of the prefix; the bits after its length are ignored.
+     * @param length The prefix length.
+     * @param value The value.
+     */
+    void Insert(const Key& key, uint32_t length, const T& value);
+
+    /**
+     * Remove the first value of a prefix satisfying a predicate.
+     * @tparam P \deduced The type of the predicate.
+     * @param key The address of the prefix; the bits after its length are ignored.
+     * @param length The prefix length.
+     * @param predicate The predicate, called with a value.
+     * @returns true if a value was removed.
+     */
+    template <typename P>
+    bool Remove(const Key& key, uint32_t length, P predicate);
+
+    /**
+     * Get the values of a prefix.
+     * @param key The address of the prefix; the bits after its length are ignored.
+     * @param length The prefix length.
+     * @returns The values of the prefix, or nullptr if none was inserted.
+     */
+    const std::vector<T>* Find(const Key& key, uint32_t length) const;
+
+    /**
+     * Call a function with the values of all the prefixes matching an
+     * address, from the shortest prefix to the longest.
+     * @tparam F \deduced The type of the function.
+     * @param key The address.
+     * @param f The function, called with a value.
+     */
+    template <typename F>
+    void ForEachMatch(const Key& key, F f) const;
+
+    /// Remove all the values.
+    void Clear();
+
+  private:
+    /// A node of the trie
+    struct Node
+    {
+        Key prefix;                                    //!< The address of the prefix, masked
+        uint32_t length;                               //!< The prefix length
+        std::vector<T> values;                         //!< The values of the prefix
+        std::array<std::unique_ptr<Node>, 2> children; //!< The children, by next bit
+    };
+
+    /**
+     * Get a bit of an address.
+     * @param key The address.
+     * @param i The index of the bit, from the most significant bit.
+     * @returns The bit.
+     */
+    static uint32_t GetBit(const Key& key, uint32_t i);
+
+    /**
+     * Mask an address.
+     * @param key The address.
+     * @param length The number of bits to keep.
+     * @returns The address with the bits after length cleared.
+     */
+    static Key Mask(const Key& key, uint32_t length);
+
+    /**
+     * Get the length of the common prefix of two addresses.
+     * @param a The first address.
+     * @param b The second address.
+     * @param max The maximum length.
+     * @returns The number of leading bits on which a and b agree, up to max.
+     */
+    static uint32_t GetCommonLength(const Key& a, const Key& b, uint32_t max);
+
+    /**
+     * Create a node.
+     * @param key The address of the prefix, masked.
+     * @param length The prefix length.
+     * @returns The node.
+     */
+    static std::unique_ptr<Node> MakeNode(const Key& key, uint32_t length);
+
+    /**
+     * Find the node of a prefix.
+     * @param key The address of the prefix, masked.
+     * @param length The prefix length.
+     * @returns The node, or nullptr.
+     */
+    Node* FindNode(const Key& key, uint32_t length) const;
+
+    std::unique_ptr<Node> m_root; //!< The root of the trie
+};
+
+/**
+ * @ingroup internet
+ * Get the key of an IPv4 address in a PrefixTrie.
+ * @param address The address.
+ * @returns The key.
+ */
+inline std::array<uint8_t, 4>
+GetPrefixTrieKey(Ipv4Address address)
+{
+    std::array<uint8_t, 4> key;
+    address.Serialize(key.data());
+    return key;
+}
+
+/**
+ * @ingroup internet
+ * Get the key of an IPv6 address in a PrefixTrie.
+ * @param address The address.
+ * @returns The key.
+ */
+inline std::array<uint8_t, 16>
+GetPrefixTrieKey(Ipv6Address address)
+{
+    std::array<uint8_t, 16> key;
+    address.GetBytes(key.data());
+    return key;
+}
+
+/**
+ * @ingroup internet
+ * Get the length of the prefix of an IPv4 mask in a PrefixTrie: its
+ * leading one bits, which match for all the addresses matching the mask.
+ * @param mask The mask.
+ * @returns The prefix length.
+ */
+inline uint32_t
+GetPrefixTrieLength(Ipv4Mask mask)
+{
+    return std::countl_one(mask.Get());
+}
+
+/**
+ * @ingroup internet
+ * Get the length of the prefix of an IPv6 prefix in a PrefixTrie: its
+ * leading one bits, which match for all the addresses matching the prefix.
+ * @param prefix The prefix.
+ * @returns The prefix length.
+ */
+inline uint32_t
+GetPrefixTrieLength(Ipv6Prefix prefix)
+{
+    uint8_t bytes[16];
+    prefix.GetBytes(bytes);
+    uint32_t length = 0;
+    for (uint8_t byte : bytes)
+    {
+        uint32_t ones = std::countl_one(byte);
+        length += ones;
+        if (ones < 8)
+        {
+            break;
+        }
+    }
+    return length;
+}
+
+/*************************************************
+ *  Implementation of the templates declared above
+ *************************************************/
+
+template <typename T, std::size_t N>
+uint32_t
+PrefixTrie<T, N>::GetBit(const Key& key, uint32_t i)
+{
+    return (key[i / 8] >> (7 - i % 8)) & 1;
+}
+
+template <typename T, std::size_t N>
+typename PrefixTrie<T, N>::Key
+PrefixTrie<T, N>::Mask(const Key& key, uint32_t length)
+{
+    Key masked{};
+    for (uint32_t i = 0; i < N && length > 0; i++)
+    {
+        uint32_t bits = std::min<uint32_t>(length, 8);
+        masked[i] = key[i] & static_cast<uint8_t>(0xff << (8 - bits));
+        length -= bits;
+    }
+    return masked;
+}
+
+template <typename T, std::size_t N>
+uint32_t
+PrefixTrie<T, N>::GetCommonLength(const Key& a, const Key& b, uint32_t max)
+{
+    uint32_t length = 0;
+    for (uint32_t i = 0; i < N && length < max; i++)
+    {
+        uint8_t diff = a[i] ^ b[i];
+        if (diff != 0)
+        {
+            length += std::countl_zero(diff);
+            break;
+        }
+        length += 8;
+    }
+    return std::min(length, max);
+}
+
+template <typename T, std::size_t N>
+std::unique_ptr<typename PrefixTrie<T, N>::Node>
+PrefixTrie<T, N>::MakeNode(const Key& key, uint32_t length)
+{
+    auto node = std::make_unique<Node>();
+    node->prefix = key;
+    node->length = length;
+    return node;
+}
+
+template <typename T, std::size_t N>
+void
+PrefixTrie<T, N>::Insert(const Key& key, uint32_t length, const T& value)
+{
+    Key prefix = Mask(key, length);
+    std::unique_ptr<Node>* link = &m_root;
+    while (*link)
+    {
+        Node* node = link->get();
+        uint32_t common = GetCommonLength(prefix, node->prefix, std::min(length, node->length));
+        if (common == node->length)
+        {
+            if (node->length == length)
+            {
+                node->values.push_back(value);
+                return;
+            }
+            // The node is a prefix of the new prefix
+            link = &node->children[GetBit(prefix, node->length)];
+            continue;
+        }
+        std::unique_ptr<Node> parent;
+        if (common == length)
+        {
+            // The new prefix is a prefix of the node
+            parent = MakeNode(prefix, length);
+            parent->values.push_back(value);
+        }
+        else
+        {
+            // The new prefix and the node branch after their common prefix
+            parent = MakeNode(Mask(prefix, common), common);
+            parent->children[GetBit(prefix, common)] = MakeNode(prefix, length);
+            parent->children[GetBit(prefix, common)]->values.push_back(value);
+        }
+        parent->children[GetBit(node->prefix, common)] = std::move(*link);
+        *link = std::move(parent);
+        return;
+    }
+    *link = MakeNode(prefix, length);
+    (*link)->values.push_back(value);
+}
+
+template <typename T, std::size_t N>
+typename PrefixTrie<T, N>::Node*
+PrefixTrie<T, N>::FindNode(const Key& key, uint32_t length) const
+{
+    Node* node = m_root.get();
+    while (node && node->length <= length &&
+           GetCommonLength(key, node->prefix, node->length) == node->length)
+    {
+        if (node->length == length)
+        {
+            return node;
+        }
+        node = node->children[GetBit(key, node->length)].get();
+    }
+    return nullptr;
+}
+
+template <typename T, std::size_t N>
+template <typename P>
+bool
+PrefixTrie<T, N>::Remove(const Key& key, uint32_t length, P predicate)
+{
+    Node* node = FindNode(Mask(key, length), length);
+    if (!node)
+    {
+        return false;
+    }
+    auto it = std::find_if(node->values.begin(), node->values.end(), predicate);
+    if (it == node->values.end())
+    {
+        return false;
+    }
+    // The empty nodes are kept: they are reused if the prefix is inserted again
+    node->values.erase(it);
+    return true;
+}
+
+template <typename T, std::size_t N>
+const std::vector<T>*
+PrefixTrie<T, N>::Find(const Key& key, uint32_t length) const
+{
+    Node* node = FindNode(Mask(key, length), length);
+    return (node && !node->values.empty()) ? &node->values : nullptr;
+}
+
+template <typename T, std::size_t N>
+template <typename F>
+void
+PrefixTrie<T, N>::ForEachMatch(const Key& key, F f) const
+{
+    const Node* node = m_root.get();
+    while (node && GetCommonLength(key, node->prefix, node->length) == node->length)
+    {
+        for (const auto& value : node->values)
+        {
+            f(value);
+        }
+        if (node->length == MAX_LENGTH)
+        {
+            break;
+        }
+        node = node->children[GetBit(key, node->length)].get();
+    }
+}
+
+template <typename T, std::size_t N>
+void
+PrefixTrie<T, N>::Clear()
+{
+    m_root.reset();
+}
+
+} // namespace ns3
+
+#endif /* PREFIX_TRIE_H */
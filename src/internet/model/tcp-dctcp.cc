@@ -152,6 +152,12 @@ TcpDctcp::PktsAcked(Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Time&
     }
 }
 
+double
+TcpDctcp::GetAlpha() const
+{
+    return m_alpha;
+}
+
 void
 TcpDctcp::InitializeDctcpAlpha(double alpha)
 {
@@ -83,6 +83,13 @@ class TcpDctcp : public TcpLinuxReno
     void PktsAcked(Ptr<TcpSocketState> tcb, uint32_t segmentsAcked, const Time& rtt) override;
     void CwndEvent(Ptr<TcpSocketState> tcb, const TcpSocketState::TcpCAEvent_t event) override;
 
+    /**
+     * @brief Get the estimate of the amount of network congestion
+     *
+     * @returns the DCTCP alpha
+     */
+    double GetAlpha() const;
+
   private:
     /**
      * @brief Changes state of m_ceState to true
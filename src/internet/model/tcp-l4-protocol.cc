@@ -132,6 +132,11 @@ TcpL4Protocol::NotifyNewAggregate()
     // need to keep track of whether we are connected to an IPv4 or
     // IPv6 lower layer and call the appropriate one.
 
+    // The packets are sent to the stacks found here, without a lookup
+    // of the aggregates for each packet.
+    m_ipv4 = ipv4;
+    m_ipv6 = this->GetObject<Ipv6L3Protocol>();
+
     if (ipv4 && m_downTarget.IsNull())
     {
         ipv4->Insert(this);
@@ -170,6 +175,8 @@ TcpL4Protocol::DoDispose()
     }
 
     m_node = nullptr;
+    m_ipv4 = nullptr;
+    m_ipv6 = nullptr;
     m_downTarget.Nullify();
     m_downTarget6.Nullify();
     IpL4Protocol::DoDispose();
@@ -594,7 +601,7 @@ TcpL4Protocol::SendPacketV4(Ptr<Packet> packet,
 
     packet->AddHeader(outgoingHeader);
 
-    Ptr<Ipv4> ipv4 = m_node->GetObject<Ipv4>();
+    Ptr<Ipv4> ipv4 = m_ipv4;
     if (ipv4)
     {
         Ipv4Header header;
@@ -653,7 +660,7 @@ TcpL4Protocol::SendPacketV6(Ptr<Packet> packet,
 
     packet->AddHeader(outgoingHeader);
 
-    Ptr<Ipv6L3Protocol> ipv6 = m_node->GetObject<Ipv6L3Protocol>();
+    Ptr<Ipv6L3Protocol> ipv6 = m_ipv6;
     if (ipv6)
     {
         Ipv6Header header;
@@ -26,7 +26,9 @@ class Socket;
 class TcpHeader;
 class Ipv4EndPointDemux;
 class Ipv6EndPointDemux;
+class Ipv4;
 class Ipv4Interface;
+class Ipv6L3Protocol;
 class TcpSocketBase;
 class Ipv4EndPoint;
 class Ipv6EndPoint;
@@ -327,6 +329,8 @@ class TcpL4Protocol : public IpL4Protocol
 
   private:
     Ptr<Node> m_node;                //!< the node this stack is associated with
+    Ptr<Ipv4> m_ipv4;                //!< the IPv4 stack aggregated to the node
+    Ptr<Ipv6L3Protocol> m_ipv6;      //!< the IPv6 stack aggregated to the node
     Ipv4EndPointDemux* m_endPoints;  //!< A list of IPv4 end points.
     Ipv6EndPointDemux* m_endPoints6; //!< A list of IPv6 end points.
     TypeId m_rttTypeId;              //!< The RTT Estimator TypeId
@@ -369,6 +373,15 @@ class TcpL4Protocol : public IpL4Protocol
                       Ptr<NetDevice> oif = nullptr) const;
 };
 
+/**
+ * @brief TcpL4Protocol is stored in a slot of the aggregation cache of Object::GetObject().
+ */
+template <>
+struct ObjectCacheSlot<TcpL4Protocol>
+{
+    static constexpr uint8_t index = Object::CACHE_SLOT_TCP; //!< The slot
+};
+
 } // namespace ns3
 
 #endif /* TCP_L4_PROTOCOL_H */
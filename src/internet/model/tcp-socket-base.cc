@@ -25,6 +25,7 @@
 #include "ipv6-routing-protocol.h"
 #include "rtt-estimator.h"
 #include "tcp-congestion-ops.h"
+#include "tcp-dctcp.h"
 #include "tcp-header.h"
 #include "tcp-l4-protocol.h"
 #include "tcp-option-sack-permitted.h"
@@ -44,10 +45,12 @@
 #include "ns3/log.h"
 #include "ns3/node.h"
 #include "ns3/object.h"
+#include "ns3/packet-annotation-tag.h"
 #include "ns3/packet.h"
 #include "ns3/pointer.h"
 #include "ns3/simulation-singleton.h"
 #include "ns3/simulator.h"
+#include "ns3/timer-wheel.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/uinteger.h"
 
@@ -184,6 +187,18 @@ TcpSocketBase::GetTypeId()
                           BooleanValue(true),
                           MakeBooleanAccessor(&TcpSocketBase::m_limitedTx),
                           MakeBooleanChecker())
+            .AddAttribute("UseTimerWheel",
+                          "Schedule the retransmission, delayed ACK and persist timers "
+                          "on the TimerWheel rather than in the simulator event list",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&TcpSocketBase::m_useTimerWheel),
+                          MakeBooleanChecker())
+            .AddAttribute("AnnotatePackets",
+                          "Whether the congestion window (and the DCTCP alpha) is recorded "
+                          "in the PacketAnnotationTag of the data packets sent",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&TcpSocketBase::m_annotatePackets),
+                          MakeBooleanChecker())
             .AddAttribute("UseEcn",
                           "Parameter to set ECN functionality",
                           EnumValue(TcpSocketState::Off),
@@ -397,6 +412,8 @@ TcpSocketBase::TcpSocketBase(const TcpSocketBase& sock)
       m_recoverActive(sock.m_recoverActive),
       m_retxThresh(sock.m_retxThresh),
       m_limitedTx(sock.m_limitedTx),
+      m_useTimerWheel(sock.m_useTimerWheel),
+      m_annotatePackets(sock.m_annotatePackets),
       m_isFirstPartialAck(sock.m_isFirstPartialAck),
       m_txTrace(sock.m_txTrace),
       m_rxTrace(sock.m_rxTrace),
@@ -1452,8 +1469,7 @@ TcpSocketBase::DoForwardUp(Ptr<Packet> packet, const Address& fromAddress, const
         NS_LOG_LOGIC("Schedule persist timeout at time "
                      << Simulator::Now().GetSeconds() << " to expire at time "
                      << (Simulator::Now() + m_persistTimeout).GetSeconds());
-        m_persistEvent =
-            Simulator::Schedule(m_persistTimeout, &TcpSocketBase::PersistTimeout, this);
+        m_persistEvent = ScheduleTimer(m_persistTimeout, &TcpSocketBase::PersistTimeout);
         NS_ASSERT(m_persistTimeout == Simulator::GetDelayLeft(m_persistEvent));
     }
 
@@ -3239,6 +3255,17 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
     bool isEct = IsEct(isRetransmission ? TcpPacketType_t::RE_XMT : TcpPacketType_t::DATA);
     AddSocketTags(p, isEct);
 
+    if (m_annotatePackets)
+    {
+        PacketAnnotationTag annotationTag;
+        annotationTag.SetCongestionWindow(m_tcb->m_cWnd);
+        if (Ptr<TcpDctcp> dctcp = DynamicCast<TcpDctcp>(m_congestionControl))
+        {
+            annotationTag.SetAlpha(dctcp->GetAlpha());
+        }
+        p->ReplacePacketTag(annotationTag);
+    }
+
     if (m_closeOnEmpty && (remainingData == 0))
     {
         flags |= TcpHeader::FIN;
@@ -3277,7 +3304,7 @@ TcpSocketBase::SendDataPacket(SequenceNumber32 seq, uint32_t maxSize, bool withA
         NS_LOG_LOGIC(this << " SendDataPacket Schedule ReTxTimeout at time "
                           << Simulator::Now().GetSeconds() << " to expire at time "
                           << (Simulator::Now() + m_rto.Get()).GetSeconds());
-        m_retxEvent = Simulator::Schedule(m_rto, &TcpSocketBase::ReTxTimeout, this);
+        m_retxEvent = ScheduleTimer(m_rto, &TcpSocketBase::ReTxTimeout);
     }
 
     m_txTrace(p, header, this);
@@ -3700,8 +3727,7 @@ TcpSocketBase::ReceivedData(Ptr<Packet> p, const TcpHeader& tcpHeader)
         else if (m_delAckEvent.IsExpired())
         {
             m_congestionControl->CwndEvent(m_tcb, TcpSocketState::CA_EVENT_DELAYED_ACK);
-            m_delAckEvent =
-                Simulator::Schedule(m_delAckTimeout, &TcpSocketBase::DelAckTimeout, this);
+            m_delAckEvent = ScheduleTimer(m_delAckTimeout, &TcpSocketBase::DelAckTimeout);
             NS_LOG_LOGIC(
                 this << " scheduled delayed ACK at "
                      << (Simulator::Now() + Simulator::GetDelayLeft(m_delAckEvent)).GetSeconds());
@@ -3827,7 +3853,7 @@ TcpSocketBase::NewAck(const SequenceNumber32& ack, bool resetRTO)
         NS_LOG_LOGIC(this << " Schedule ReTxTimeout at time " << Simulator::Now().GetSeconds()
                           << " to expire at time "
                           << (Simulator::Now() + m_rto.Get()).GetSeconds());
-        m_retxEvent = Simulator::Schedule(m_rto, &TcpSocketBase::ReTxTimeout, this);
+        m_retxEvent = ScheduleTimer(m_rto, &TcpSocketBase::ReTxTimeout);
     }
 
     // Note the highest ACK and tell app to send more
@@ -4023,6 +4049,16 @@ TcpSocketBase::LastAckTimeout()
 }
 
 // Send 1-byte data to probe for the window size at the receiver when
+EventId
+TcpSocketBase::ScheduleTimer(const Time& delay, void (TcpSocketBase::*timeout)())
+{
+    if (m_useTimerWheel)
+    {
+        return TimerWheel::Get()->Schedule(delay, timeout, this);
+    }
+    return Simulator::Schedule(delay, timeout, this);
+}
+
 // the local knowledge tells that the receiver has zero window size
 // C.f.: RFC793 p.42, RFC1112 sec.4.2.2.17
 void
@@ -4075,7 +4111,7 @@ TcpSocketBase::PersistTimeout()
     NS_LOG_LOGIC("Schedule persist timeout at time "
                  << Simulator::Now().GetSeconds() << " to expire at time "
                  << (Simulator::Now() + m_persistTimeout).GetSeconds());
-    m_persistEvent = Simulator::Schedule(m_persistTimeout, &TcpSocketBase::PersistTimeout, this);
+    m_persistEvent = ScheduleTimer(m_persistTimeout, &TcpSocketBase::PersistTimeout);
 }
 
 void
@@ -1172,6 +1172,18 @@ class TcpSocketBase : public TcpSocket
      */
     virtual void PersistTimeout();
 
+    /**
+     * @brief Schedule a retransmission, delayed ACK or persist timer
+     *
+     * The timer is scheduled on the TimerWheel if the UseTimerWheel
+     * attribute is set, and in the simulator event list otherwise.
+     *
+     * @param delay The timer delay
+     * @param timeout The timeout method
+     * @returns The timer EventId
+     */
+    EventId ScheduleTimer(const Time& delay, void (TcpSocketBase::*timeout)());
+
     /**
      * @brief Retransmit the first segment marked as lost, without considering
      * available window nor pacing.
@@ -1418,11 +1430,13 @@ class TcpSocketBase : public TcpSocket
     // Fast Retransmit and Recovery
     SequenceNumber32 m_recover{
         0}; //!< Previous highest Tx seqnum for fast recovery (set it to initial seq number)
-    bool m_recoverActive{false}; //!< Whether "m_recover" has been set/activated
-                                 //!< It is used to avoid comparing with the old m_recover value
-                                 //!< which was set for handling previous congestion event.
-    uint32_t m_retxThresh{3};    //!< Fast Retransmit threshold
-    bool m_limitedTx{true};      //!< perform limited transmit
+    bool m_recoverActive{false};   //!< Whether "m_recover" has been set/activated
+                                   //!< It is used to avoid comparing with the old m_recover value
+                                   //!< which was set for handling previous congestion event.
+    uint32_t m_retxThresh{3};      //!< Fast Retransmit threshold
+    bool m_limitedTx{true};        //!< perform limited transmit
+    bool m_useTimerWheel{false};   //!< schedule the protocol timers on the TimerWheel
+    bool m_annotatePackets{false}; //!< record the cwnd in the PacketAnnotationTag
 
     // Transmission Control Block
     Ptr<TcpSocketState> m_tcb;                 //!< Congestion control information
@@ -294,6 +294,15 @@ class UdpL4Protocol : public IpL4Protocol
     IpL4Protocol::DownTargetCallback6 m_downTarget6; //!< Callback to send packets over IPv6
 };
 
+/**
+ * @brief UdpL4Protocol is stored in a slot of the aggregation cache of Object::GetObject().
+ */
+template <>
+struct ObjectCacheSlot<UdpL4Protocol>
+{
+    static constexpr uint8_t index = Object::CACHE_SLOT_UDP; //!< The slot
+};
+
 } // namespace ns3
 
 #endif /* UDP_L4_PROTOCOL_H */
@@ -16,6 +16,7 @@
 #include "ns3/test.h"
 
 #include <cstdlib> // for rand()
+#include <vector>
 
 using namespace ns3;
 
@@ -204,6 +205,88 @@ GlobalRouteManagerImplTestCase::DoRun()
     // does not crash
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief Candidate Queue ordering Test
+ */
+class CandidateQueueTestCase : public TestCase
+{
+  public:
+    CandidateQueueTestCase();
+    void DoRun() override;
+};
+
+CandidateQueueTestCase::CandidateQueueTestCase()
+    : TestCase("Check the order in which the CandidateQueue pops the vertices")
+{
+}
+
+void
+CandidateQueueTestCase::DoRun()
+{
+    CandidateQueue candidate;
+    std::vector<SPFVertex*> vertices;
+    // Vertex i has the ID 0.0.0.i
+    auto addVertex = [&](uint32_t distance, SPFVertex::VertexType type) {
+        auto v = new SPFVertex;
+        v->SetVertexId(Ipv4Address(static_cast<uint32_t>(vertices.size())));
+        v->SetVertexType(type);
+        v->SetDistanceFromRoot(distance);
+        vertices.push_back(v);
+        candidate.Push(v);
+    };
+    addVertex(5, SPFVertex::VertexRouter);
+    addVertex(3, SPFVertex::VertexRouter);
+    addVertex(5, SPFVertex::VertexRouter);
+    addVertex(5, SPFVertex::VertexNetwork);
+    addVertex(3, SPFVertex::VertexRouter);
+    addVertex(9, SPFVertex::VertexRouter);
+    addVertex(7, SPFVertex::VertexRouter);
+    NS_TEST_ASSERT_MSG_EQ(candidate.Size(), 7, "All the vertices are queued");
+    NS_TEST_ASSERT_MSG_EQ(candidate.Find(Ipv4Address(6u)), vertices[6], "Vertex 6 is found");
+    NS_TEST_ASSERT_MSG_EQ(candidate.Find(Ipv4Address(7u)), nullptr, "Vertex 7 is not queued");
+
+    // Vertex 5 now has the distance of vertices 0 and 2, and is popped after them
+    vertices[5]->SetDistanceFromRoot(5);
+    candidate.Update(vertices[5]);
+    // Vertex 6 is popped first
+    vertices[6]->SetDistanceFromRoot(1);
+    candidate.Update(vertices[6]);
+
+    // Networks are popped before the routers at the same distance, and the
+    // vertices at the same distance in the order in which they were queued
+    std::vector<uint32_t> expected = {6, 1, 4, 3, 0, 2, 5};
+    NS_TEST_ASSERT_MSG_EQ(candidate.Top(), vertices[6], "Vertex 6 is at the top");
+    for (uint32_t i : expected)
+    {
+        SPFVertex* v = candidate.Pop();
+        NS_TEST_ASSERT_MSG_EQ(v, vertices[i], "Vertex " << i << " is popped");
+        NS_TEST_ASSERT_MSG_EQ(candidate.Find(Ipv4Address(i)), nullptr, "Vertex is not found");
+    }
+    NS_TEST_ASSERT_MSG_EQ(candidate.Empty(), true, "The queue is empty");
+
+    // Reorder () sorts the vertices whose distance changed, without
+    // changing the order of the vertices at the same distance
+    for (uint32_t i = 0; i < vertices.size(); i++)
+    {
+        candidate.Push(vertices[i]);
+    }
+    vertices[0]->SetDistanceFromRoot(3);
+    vertices[2]->SetDistanceFromRoot(9);
+    candidate.Reorder();
+    expected = {6, 1, 4, 0, 3, 5, 2};
+    for (uint32_t i : expected)
+    {
+        NS_TEST_ASSERT_MSG_EQ(candidate.Pop(), vertices[i], "Vertex " << i << " is popped");
+    }
+
+    for (auto v : vertices)
+    {
+        delete v;
+    }
+}
+
 /**
  * @ingroup internet-test
  *
@@ -221,6 +304,7 @@ GlobalRouteManagerImplTestSuite::GlobalRouteManagerImplTestSuite()
     : TestSuite("global-route-manager-impl", Type::UNIT)
 {
     AddTestCase(new GlobalRouteManagerImplTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new CandidateQueueTestCase(), TestCase::Duration::QUICK);
 }
 
 static GlobalRouteManagerImplTestSuite
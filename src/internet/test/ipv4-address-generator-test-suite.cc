@@ -338,6 +338,68 @@ AddressCollisionTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(added, false, "404");
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief IPv4 network collision Test
+ */
+class NetworkCollisionTestCase : public TestCase
+{
+  public:
+    NetworkCollisionTestCase();
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+};
+
+NetworkCollisionTestCase::NetworkCollisionTestCase()
+    : TestCase("Make sure that the network collision logic works.")
+{
+}
+
+void
+NetworkCollisionTestCase::DoTeardown()
+{
+    Ipv4AddressGenerator::Reset();
+    Simulator::Destroy();
+}
+
+void
+NetworkCollisionTestCase::DoRun()
+{
+    Ipv4AddressGenerator::AddAllocated("10.1.1.2");
+    Ipv4AddressGenerator::AddAllocated("10.1.1.1");
+    for (uint32_t i = 0; i < 12; i++)
+    {
+        Ipv4AddressGenerator::AddAllocated(Ipv4Address(Ipv4Address("10.1.2.250").Get() + i));
+    }
+    Ipv4AddressGenerator::AddAllocated("10.3.0.1");
+
+    Ipv4Mask mask("255.255.255.0");
+    bool available = Ipv4AddressGenerator::IsNetworkAllocated("10.1.1.0", mask);
+    NS_TEST_EXPECT_MSG_EQ(available, false, "10.1.1.0/24 should be already allocated");
+    available = Ipv4AddressGenerator::IsNetworkAllocated("10.1.2.0", mask);
+    NS_TEST_EXPECT_MSG_EQ(available, false, "10.1.2.0/24 should be already allocated");
+    available = Ipv4AddressGenerator::IsNetworkAllocated("10.1.3.0", mask);
+    NS_TEST_EXPECT_MSG_EQ(available, false, "10.1.3.0/24 should be already allocated");
+    available = Ipv4AddressGenerator::IsNetworkAllocated("10.1.4.0", mask);
+    NS_TEST_EXPECT_MSG_EQ(available, true, "10.1.4.0/24 should not be already allocated");
+    available = Ipv4AddressGenerator::IsNetworkAllocated("10.1.0.0", "255.255.0.0");
+    NS_TEST_EXPECT_MSG_EQ(available, false, "10.1.0.0/16 should be already allocated");
+    available = Ipv4AddressGenerator::IsNetworkAllocated("10.2.0.0", "255.255.0.0");
+    NS_TEST_EXPECT_MSG_EQ(available, true, "10.2.0.0/16 should not be already allocated");
+    available = Ipv4AddressGenerator::IsNetworkAllocated("10.0.0.0", "255.0.0.0");
+    NS_TEST_EXPECT_MSG_EQ(available, false, "10.0.0.0/8 should be already allocated");
+
+    bool allocated = Ipv4AddressGenerator::IsAddressAllocated("10.1.3.5");
+    NS_TEST_EXPECT_MSG_EQ(allocated, true, "10.1.3.5 should be already allocated");
+    allocated = Ipv4AddressGenerator::IsAddressAllocated("10.1.3.6");
+    NS_TEST_EXPECT_MSG_EQ(allocated, false, "10.1.3.6 should not be already allocated");
+    allocated = Ipv4AddressGenerator::IsAddressAllocated("10.1.1.3");
+    NS_TEST_EXPECT_MSG_EQ(allocated, false, "10.1.1.3 should not be already allocated");
+}
+
 /**
  * @ingroup internet-test
  *
@@ -359,6 +421,7 @@ Ipv4AddressGeneratorTestSuite::Ipv4AddressGeneratorTestSuite()
     AddTestCase(new NetworkAndAddressTestCase(), TestCase::Duration::QUICK);
     AddTestCase(new ExampleAddressGeneratorTestCase(), TestCase::Duration::QUICK);
     AddTestCase(new AddressCollisionTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new NetworkCollisionTestCase(), TestCase::Duration::QUICK);
 }
 
 static Ipv4AddressGeneratorTestSuite
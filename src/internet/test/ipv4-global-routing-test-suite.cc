@@ -5,6 +5,7 @@
 #include "ns3/boolean.h"
 #include "ns3/bridge-helper.h"
 #include "ns3/config.h"
+#include "ns3/global-route-manager.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
@@ -18,6 +19,7 @@
 #include "ns3/log.h"
 #include "ns3/node-container.h"
 #include "ns3/node.h"
+#include "ns3/output-stream-wrapper.h"
 #include "ns3/packet.h"
 #include "ns3/pointer.h"
 #include "ns3/simple-channel.h"
@@ -26,10 +28,14 @@
 #include "ns3/simulator.h"
 #include "ns3/socket-factory.h"
 #include "ns3/string.h"
+#include "ns3/tcp-header.h"
+#include "ns3/tcp-l4-protocol.h"
 #include "ns3/test.h"
 #include "ns3/udp-socket-factory.h"
 #include "ns3/uinteger.h"
 
+#include <set>
+#include <sstream>
 #include <vector>
 
 using namespace ns3;
@@ -1396,6 +1402,298 @@ EcmpRouteCalculationTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @ingroup internet-test
+ *
+ * @brief This TestCase checks that the routes recomputed after the removal of
+ * links, which are kept by some routers, are those of a full computation.
+ */
+class RecomputeRoutesTestCase : public TestCase
+{
+  public:
+    RecomputeRoutesTestCase();
+    void DoSetup() override;
+    void DoRun() override;
+
+  private:
+    /**
+     * Print the routing tables of all the nodes.
+     * @returns The routing tables.
+     */
+    std::string GetRoutingTables() const;
+
+    /**
+     * Compute the routes with GlobalRouteManager::RecomputeRoutes (), and
+     * check that they are those of a full computation.
+     * @param threads The number of threads of the full computation.
+     */
+    void CheckRecomputedRoutes(uint32_t threads);
+
+    NodeContainer m_nodes; //!< Nodes used in the test.
+};
+
+RecomputeRoutesTestCase::RecomputeRoutesTestCase()
+    : TestCase("Recompute the routes after the removal of links")
+{
+}
+
+void
+RecomputeRoutesTestCase::DoSetup()
+{
+    /*
+        //         Network Topology
+        //
+        //   n0 ---- n1 ---- n2 ---- n3
+        //   |       |       |       |
+        //   n4 ---- n5 ---- n6 ---- n7
+        //   |       |       |       |
+        //   n8 ---- n9 ---- n10 --- n11
+        //
+        //    All the links are point-to-point links in 10.i.j.0/30, where
+        //    i < j are the two nodes.  The link n5-n6 costs 2.
+    */
+    const uint32_t width = 4;
+    const uint32_t height = 3;
+    m_nodes.Create(width * height);
+
+    InternetStackHelper stack;
+    stack.Install(m_nodes);
+    SimpleNetDeviceHelper devHelper;
+    devHelper.SetNetDevicePointToPointMode(true);
+    Ipv4AddressHelper address;
+
+    auto link = [&](uint32_t i, uint32_t j) {
+        Ptr<SimpleChannel> channel = CreateObject<SimpleChannel>();
+        NetDeviceContainer d = devHelper.Install(m_nodes.Get(i), channel);
+        d.Add(devHelper.Install(m_nodes.Get(j), channel));
+        std::ostringstream network;
+        network << "10." << i << "." << j << ".0";
+        address.SetBase(network.str().c_str(), "255.255.255.252");
+        Ipv4InterfaceContainer interfaces = address.Assign(d);
+        if (i == 5 && j == 6)
+        {
+            interfaces.Get(0).first->SetMetric(interfaces.Get(0).second, 2);
+            interfaces.Get(1).first->SetMetric(interfaces.Get(1).second, 2);
+        }
+    };
+    for (uint32_t y = 0; y < height; y++)
+    {
+        for (uint32_t x = 0; x < width; x++)
+        {
+            uint32_t i = y * width + x;
+            if (x + 1 < width)
+            {
+                link(i, i + 1);
+            }
+            if (y + 1 < height)
+            {
+                link(i, i + width);
+            }
+        }
+    }
+}
+
+std::string
+RecomputeRoutesTestCase::GetRoutingTables() const
+{
+    std::ostringstream tables;
+    Ptr<OutputStreamWrapper> stream = Create<OutputStreamWrapper>(&tables);
+    for (uint32_t i = 0; i < m_nodes.GetN(); i++)
+    {
+        Ptr<Ipv4> ipv4 = m_nodes.Get(i)->GetObject<Ipv4>();
+        ipv4->GetRoutingProtocol()->PrintRoutingTable(stream);
+    }
+    return tables.str();
+}
+
+void
+RecomputeRoutesTestCase::CheckRecomputedRoutes(uint32_t threads)
+{
+    Ipv4GlobalRoutingHelper::RecomputeRoutingTables();
+    std::string recomputed = GetRoutingTables();
+
+    Config::SetGlobal("GlobalRoutingThreadCount", UintegerValue(threads));
+    GlobalRouteManager::DeleteGlobalRoutes();
+    GlobalRouteManager::BuildGlobalRoutingDatabase();
+    GlobalRouteManager::InitializeRoutes();
+    Config::SetGlobal("GlobalRoutingThreadCount", UintegerValue(1));
+    NS_TEST_ASSERT_MSG_EQ(recomputed, GetRoutingTables(), "The routes are not recomputed");
+}
+
+void
+RecomputeRoutesTestCase::DoRun()
+{
+    Ipv4GlobalRoutingHelper::PopulateRoutingTables();
+    std::string tables = GetRoutingTables();
+    CheckRecomputedRoutes(1);
+    NS_TEST_ASSERT_MSG_EQ(tables, GetRoutingTables(), "The routes changed");
+
+    // Bring down the links, one at a time.  The first one is not on the
+    // shortest paths of most routers; then the link n5-n6 has equal cost paths.
+    std::vector<std::pair<uint32_t, uint32_t>> links = {{5, 6}, {2, 6}, {1, 5}, {9, 10}};
+    // The interfaces of the last link
+    std::vector<std::pair<Ptr<Ipv4>, uint32_t>> interfaces;
+    for (const auto& [i, j] : links)
+    {
+        Ptr<Ipv4> ipv4i = m_nodes.Get(i)->GetObject<Ipv4>();
+        Ptr<Ipv4> ipv4j = m_nodes.Get(j)->GetObject<Ipv4>();
+        interfaces.clear();
+        for (uint32_t k = 1; k < ipv4i->GetNInterfaces(); k++)
+        {
+            Ipv4Address local = ipv4i->GetAddress(k, 0).GetLocal();
+            Ipv4Mask mask = ipv4i->GetAddress(k, 0).GetMask();
+            int32_t remote = ipv4j->GetInterfaceForPrefix(local, mask);
+            if (remote >= 0)
+            {
+                interfaces.emplace_back(ipv4i, k);
+                interfaces.emplace_back(ipv4j, remote);
+            }
+        }
+        NS_TEST_ASSERT_MSG_EQ(interfaces.size(), 2, "The nodes are not linked");
+        for (const auto& [ipv4, k] : interfaces)
+        {
+            ipv4->SetDown(k);
+        }
+        CheckRecomputedRoutes(j == 10 ? 4 : 1);
+        NS_TEST_ASSERT_MSG_NE(tables, GetRoutingTables(), "The routes did not change");
+        tables = GetRoutingTables();
+    }
+
+    // Bring the last link up again
+    for (const auto& [ipv4, k] : interfaces)
+    {
+        ipv4->SetUp(k);
+    }
+    CheckRecomputedRoutes(1);
+    NS_TEST_ASSERT_MSG_NE(tables, GetRoutingTables(), "The routes did not change");
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief This TestCase checks that the routes selected among ECMP by the hash
+ * of the flows are the same for all the packets of a flow, spread the flows on
+ * the routes, and change with the flowlets.
+ */
+class FlowEcmpRoutingTestCase : public TestCase
+{
+  public:
+    FlowEcmpRoutingTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Get the interfaces of the routes of flows.
+     * @param routing The routing protocol.
+     * @param flows The number of flows, of source ports from 1000.
+     * @returns The interfaces of the routes, by flow.
+     */
+    std::vector<uint32_t> GetInterfaces(Ptr<Ipv4GlobalRouting> routing, uint16_t flows) const;
+
+    Ptr<Ipv4> m_ipv4; //!< The IPv4 stack of the router.
+};
+
+FlowEcmpRoutingTestCase::FlowEcmpRoutingTestCase()
+    : TestCase("Select the ECMP routes by the hash of the flows")
+{
+}
+
+std::vector<uint32_t>
+FlowEcmpRoutingTestCase::GetInterfaces(Ptr<Ipv4GlobalRouting> routing, uint16_t flows) const
+{
+    std::vector<uint32_t> interfaces;
+    for (uint16_t port = 1000; port < 1000 + flows; port++)
+    {
+        Ptr<Packet> packet = Create<Packet>(100);
+        TcpHeader tcpHeader;
+        tcpHeader.SetSourcePort(port);
+        tcpHeader.SetDestinationPort(80);
+        packet->AddHeader(tcpHeader);
+        Ipv4Header header;
+        header.SetSource(Ipv4Address("192.168.0.1"));
+        header.SetDestination(Ipv4Address("10.2.0.5"));
+        header.SetProtocol(TcpL4Protocol::PROT_NUMBER);
+        Socket::SocketErrno error;
+        Ptr<Ipv4Route> route = routing->RouteOutput(packet, header, nullptr, error);
+        interfaces.push_back(route ? m_ipv4->GetInterfaceForDevice(route->GetOutputDevice()) : 0);
+    }
+    return interfaces;
+}
+
+void
+FlowEcmpRoutingTestCase::DoRun()
+{
+    // A router with four routes of equal cost to 10.2.0.0/16
+    Ptr<Node> node = CreateObject<Node>();
+    Ipv4GlobalRoutingHelper globalhelper;
+    InternetStackHelper stack;
+    stack.SetRoutingHelper(globalhelper);
+    stack.Install(node);
+    SimpleNetDeviceHelper devHelper;
+    NetDeviceContainer devices = devHelper.Install(NodeContainer(node, node, node, node));
+    Ipv4AddressHelper address("192.168.0.0", "255.255.255.0");
+    address.Assign(devices);
+    m_ipv4 = node->GetObject<Ipv4>();
+    Ptr<Ipv4GlobalRouting> routing =
+        Ipv4RoutingHelper::GetRouting<Ipv4GlobalRouting>(m_ipv4->GetRoutingProtocol());
+    NS_TEST_ASSERT_MSG_NE(routing, nullptr, "No global routing");
+    for (uint32_t i = 1; i <= 4; i++)
+    {
+        routing->AddNetworkRouteTo(Ipv4Address("10.2.0.0"),
+                                   Ipv4Mask("255.255.0.0"),
+                                   Ipv4Address(0xc0a8000a + i),
+                                   i);
+    }
+
+    std::vector<uint32_t> interfaces = GetInterfaces(routing, 64);
+    NS_TEST_EXPECT_MSG_EQ(std::set<uint32_t>(interfaces.begin(), interfaces.end()).size(),
+                          1,
+                          "The first route is not always used without ECMP");
+
+    routing->SetAttribute("FlowEcmpRouting", BooleanValue(true));
+    interfaces = GetInterfaces(routing, 64);
+    NS_TEST_EXPECT_MSG_EQ(std::set<uint32_t>(interfaces.begin(), interfaces.end()).size(),
+                          4,
+                          "The flows are not spread on all the routes");
+    for (uint32_t i = 0; i < 10; i++)
+    {
+        NS_TEST_EXPECT_MSG_EQ((GetInterfaces(routing, 64) == interfaces),
+                              true,
+                              "The packets of a flow take different routes");
+    }
+
+    routing->SetAttribute("EcmpHashSeed", UintegerValue(1));
+    NS_TEST_EXPECT_MSG_EQ((GetInterfaces(routing, 64) != interfaces),
+                          true,
+                          "The seed does not change the routes");
+
+    // The routes change only after a gap longer than the flowlet timeout
+    routing->SetAttribute("FlowletTimeout", TimeValue(MilliSeconds(1)));
+    std::vector<std::vector<uint32_t>> flowlets;
+    for (auto time : {MilliSeconds(0), MicroSeconds(500), MilliSeconds(10), MicroSeconds(10500)})
+    {
+        Simulator::Schedule(time, [&flowlets, routing, this]() {
+            flowlets.push_back(GetInterfaces(routing, 64));
+        });
+    }
+    Simulator::Run();
+    NS_TEST_ASSERT_MSG_EQ(flowlets.size(), 4, "Missing flowlets");
+    NS_TEST_EXPECT_MSG_EQ((flowlets[0] == flowlets[1]),
+                          true,
+                          "The routes change within a flowlet");
+    NS_TEST_EXPECT_MSG_EQ((flowlets[1] != flowlets[2]),
+                          true,
+                          "The routes do not change with the flowlets");
+    NS_TEST_EXPECT_MSG_EQ((flowlets[2] == flowlets[3]),
+                          true,
+                          "The routes change within a flowlet");
+
+    Simulator::Destroy();
+}
+
 /**
  * @ingroup internet-test
  *
@@ -1419,6 +1717,8 @@ Ipv4GlobalRoutingTestSuite::Ipv4GlobalRoutingTestSuite()
     AddTestCase(new Ipv4DynamicGlobalRoutingTestCase, TestCase::Duration::QUICK);
     AddTestCase(new Ipv4GlobalRoutingSlash32TestCase, TestCase::Duration::QUICK);
     AddTestCase(new EcmpRouteCalculationTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new RecomputeRoutesTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new FlowEcmpRoutingTestCase, TestCase::Duration::QUICK);
 }
 
 static Ipv4GlobalRoutingTestSuite
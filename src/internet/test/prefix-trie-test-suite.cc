@@ -0,0 +1,304 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-route.h"
+#include "ns3/ipv4-routing-table-entry.h"
+#include "ns3/ipv4-static-routing-helper.h"
+#include "ns3/ipv4-static-routing.h"
+#include "ns3/node.h"
+#include "ns3/prefix-trie.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief PrefixTrie Test: the values found are those of the prefixes
+ * matching the addresses, as found by a scan of all the prefixes.
+ */
+class PrefixTrieTestCase : public TestCase
+{
+  public:
+    PrefixTrieTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// A prefix and its value
+    struct Prefix
+    {
+        Ipv4Address address; //!< The address
+        Ipv4Mask mask;       //!< The mask
+        uint32_t value;      //!< The value
+    };
+
+    /**
+     * Check the values of the prefixes matching an address.
+     * @param trie The trie.
+     * @param prefixes The prefixes inserted in the trie.
+     * @param address The address.
+     */
+    void CheckMatches(const PrefixTrie<uint32_t, 4>& trie,
+                      const std::vector<Prefix>& prefixes,
+                      Ipv4Address address);
+};
+
+PrefixTrieTestCase::PrefixTrieTestCase()
+    : TestCase("Find the prefixes matching an address in a PrefixTrie")
+{
+}
+
+void
+PrefixTrieTestCase::CheckMatches(const PrefixTrie<uint32_t, 4>& trie,
+                                 const std::vector<Prefix>& prefixes,
+                                 Ipv4Address address)
+{
+    std::vector<uint32_t> expected;
+    for (const auto& prefix : prefixes)
+    {
+        if (prefix.mask.IsMatch(address, prefix.address))
+        {
+            expected.push_back(prefix.value);
+        }
+    }
+    std::vector<uint32_t> found;
+    uint32_t length = 0;
+    trie.ForEachMatch(GetPrefixTrieKey(address), [&](uint32_t value) {
+        uint32_t valueLength = GetPrefixTrieLength(prefixes[value].mask);
+        NS_TEST_EXPECT_MSG_GT_OR_EQ(valueLength, length, "The prefixes are not sorted");
+        length = valueLength;
+        found.push_back(value);
+    });
+    std::sort(found.begin(), found.end());
+    NS_TEST_EXPECT_MSG_EQ((found == expected), true, "Wrong prefixes matching " << address);
+}
+
+void
+PrefixTrieTestCase::DoRun()
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+    rand->SetStream(1);
+
+    // Prefixes in 10.0.0.0/12, so that they overlap, with the value of
+    // their index
+    PrefixTrie<uint32_t, 4> trie;
+    std::vector<Prefix> prefixes;
+    for (uint32_t i = 0; i < 400; i++)
+    {
+        Ipv4Mask mask(~0U << (32 - rand->GetInteger(8, 32)));
+        if (i % 40 == 0)
+        {
+            mask = Ipv4Mask::GetZero();
+        }
+        Ipv4Address address(0x0a000000 | rand->GetInteger(0, 0xfffff));
+        prefixes.push_back({address, mask, i});
+        trie.Insert(GetPrefixTrieKey(address), GetPrefixTrieLength(mask), i);
+    }
+
+    const std::vector<uint32_t>* values =
+        trie.Find(GetPrefixTrieKey(prefixes[7].address), GetPrefixTrieLength(prefixes[7].mask));
+    NS_TEST_ASSERT_MSG_NE(values, nullptr, "The prefix is not found");
+    NS_TEST_EXPECT_MSG_EQ((std::find(values->begin(), values->end(), 7u) != values->end()),
+                          true,
+                          "The value is not found");
+    NS_TEST_EXPECT_MSG_EQ(trie.Find(GetPrefixTrieKey(Ipv4Address("192.168.0.0")), 16),
+                          nullptr,
+                          "An unknown prefix is found");
+
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        CheckMatches(trie, prefixes, Ipv4Address(0x0a000000 | rand->GetInteger(0, 0xfffff)));
+    }
+    for (const auto& prefix : prefixes)
+    {
+        CheckMatches(trie, prefixes, prefix.address);
+    }
+
+    // Remove the odd prefixes, which then match no address
+    std::vector<Prefix> kept = prefixes;
+    for (auto& prefix : kept)
+    {
+        if (prefix.value % 2)
+        {
+            bool removed = trie.Remove(GetPrefixTrieKey(prefix.address),
+                                       GetPrefixTrieLength(prefix.mask),
+                                       [&prefix](uint32_t value) { return value == prefix.value; });
+            NS_TEST_EXPECT_MSG_EQ(removed, true, "The prefix is not removed");
+            prefix.address = Ipv4Address("255.255.255.255");
+            prefix.mask = Ipv4Mask::GetOnes();
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(trie.Remove(GetPrefixTrieKey(prefixes[1].address),
+                                      GetPrefixTrieLength(prefixes[1].mask),
+                                      [](uint32_t value) { return value == 1; }),
+                          false,
+                          "A removed prefix is removed again");
+    for (uint32_t i = 0; i < 1000; i++)
+    {
+        CheckMatches(trie, kept, Ipv4Address(0x0a000000 | rand->GetInteger(0, 0xfffff)));
+    }
+
+    // IPv6 prefixes
+    PrefixTrie<uint32_t, 16> trie6;
+    trie6.Insert(GetPrefixTrieKey(Ipv6Address("2001:db8::")), 32, 1);
+    trie6.Insert(GetPrefixTrieKey(Ipv6Address("2001:db8:1::")), 48, 2);
+    trie6.Insert(GetPrefixTrieKey(Ipv6Address("2001:db8:1::1")), 128, 3);
+    trie6.Insert(GetPrefixTrieKey(Ipv6Address("::")), 0, 0);
+    std::vector<uint32_t> found;
+    trie6.ForEachMatch(GetPrefixTrieKey(Ipv6Address("2001:db8:1::1")),
+                       [&found](uint32_t value) { found.push_back(value); });
+    NS_TEST_EXPECT_MSG_EQ((found == std::vector<uint32_t>{0, 1, 2, 3}), true, "Wrong matches");
+    found.clear();
+    trie6.ForEachMatch(GetPrefixTrieKey(Ipv6Address("2001:db8:2::1")),
+                       [&found](uint32_t value) { found.push_back(value); });
+    NS_TEST_EXPECT_MSG_EQ((found == std::vector<uint32_t>{0, 1}), true, "Wrong matches");
+    NS_TEST_EXPECT_MSG_EQ(GetPrefixTrieLength(Ipv6Prefix(64)), 64, "Wrong prefix length");
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief Ipv4StaticRouting lookup Test: the routes selected are those of the
+ * longest prefix, lowest metric, as found by a scan of the routing table.
+ */
+class Ipv4StaticRoutingLookupTestCase : public TestCase
+{
+  public:
+    Ipv4StaticRoutingLookupTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+Ipv4StaticRoutingLookupTestCase::Ipv4StaticRoutingLookupTestCase()
+    : TestCase("Select the static routes by longest prefix and metric")
+{
+}
+
+void
+Ipv4StaticRoutingLookupTestCase::DoRun()
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+    Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+    rand->SetStream(2);
+
+    Ptr<Node> node = CreateObject<Node>();
+    InternetStackHelper stack;
+    stack.Install(node);
+    SimpleNetDeviceHelper devHelper;
+    NetDeviceContainer devices = devHelper.Install(NodeContainer(node, node, node, node));
+    Ipv4AddressHelper address("192.168.0.0", "255.255.255.0");
+    address.Assign(devices);
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    Ptr<Ipv4StaticRouting> routing = Ipv4StaticRoutingHelper().GetStaticRouting(ipv4);
+
+    for (uint32_t i = 0; i < 300; i++)
+    {
+        Ipv4Mask mask(~0U << (32 - rand->GetInteger(12, 32)));
+        Ipv4Address network(0x0a000000 | rand->GetInteger(0, 0xffff) << 4);
+        Ipv4Address gateway(0xc0a80000 | rand->GetInteger(1, 254));
+        routing->AddNetworkRouteTo(network.CombineMask(mask),
+                                   mask,
+                                   gateway,
+                                   rand->GetInteger(1, 4),
+                                   rand->GetInteger(0, 3));
+        if (i % 7 == 0)
+        {
+            routing->RemoveRoute(rand->GetInteger(0, routing->GetNRoutes() - 1));
+        }
+    }
+
+    // The routing table, with the metrics
+    std::vector<std::pair<Ipv4RoutingTableEntry, uint32_t>> routes;
+    for (uint32_t j = 0; j < routing->GetNRoutes(); j++)
+    {
+        routes.emplace_back(routing->GetRoute(j), routing->GetMetric(j));
+    }
+
+    for (uint32_t i = 0; i < 2000; i++)
+    {
+        Ipv4Address dest(0x0a000000 | rand->GetInteger(0, 0xfffff));
+        // Scan the routing table, as LookupStatic () did
+        const Ipv4RoutingTableEntry* expected = nullptr;
+        uint32_t longestMask = 0;
+        uint32_t shortestMetric = 0xffffffff;
+        for (const auto& [route, metric] : routes)
+        {
+            uint32_t maskLength = route.GetDestNetworkMask().GetPrefixLength();
+            if (!route.GetDestNetworkMask().IsMatch(dest, route.GetDestNetwork()) ||
+                maskLength < longestMask)
+            {
+                continue;
+            }
+            if (maskLength > longestMask)
+            {
+                shortestMetric = 0xffffffff;
+            }
+            longestMask = maskLength;
+            if (metric > shortestMetric)
+            {
+                continue;
+            }
+            shortestMetric = metric;
+            expected = &route;
+            if (maskLength == 32)
+            {
+                break;
+            }
+        }
+
+        Ipv4Header header;
+        header.SetDestination(dest);
+        Socket::SocketErrno error;
+        Ptr<Ipv4Route> found = routing->RouteOutput(nullptr, header, nullptr, error);
+        if (!expected)
+        {
+            NS_TEST_EXPECT_MSG_EQ(found, nullptr, "A route to " << dest << " is found");
+            continue;
+        }
+        NS_TEST_ASSERT_MSG_NE(found, nullptr, "No route to " << dest << " is found");
+        NS_TEST_EXPECT_MSG_EQ(found->GetGateway(), expected->GetGateway(), "Wrong gateway");
+        NS_TEST_EXPECT_MSG_EQ(found->GetOutputDevice(),
+                              ipv4->GetNetDevice(expected->GetInterface()),
+                              "Wrong interface");
+    }
+
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup internet-test
+ *
+ * @brief PrefixTrie TestSuite
+ */
+class PrefixTrieTestSuite : public TestSuite
+{
+  public:
+    PrefixTrieTestSuite();
+};
+
+PrefixTrieTestSuite::PrefixTrieTestSuite()
+    : TestSuite("prefix-trie", Type::UNIT)
+{
+    AddTestCase(new PrefixTrieTestCase(), TestCase::Duration::QUICK);
+    AddTestCase(new Ipv4StaticRoutingLookupTestCase(), TestCase::Duration::QUICK);
+}
+
+static PrefixTrieTestSuite g_prefixTrieTestSuite; //!< Static variable for test initialization
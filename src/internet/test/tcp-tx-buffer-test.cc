@@ -9,7 +9,9 @@
 #include "ns3/tcp-tx-buffer.h"
 #include "ns3/test.h"
 
+#include <algorithm>
 #include <limits>
+#include <vector>
 
 using namespace ns3;
 
@@ -42,6 +44,8 @@ class TcpTxBufferTestCase : public TestCase
     /** @brief Test the logic of merging items in GetTransmittedSegment()
      * which is triggered by CopyFromSequence()*/
     void TestMergeItemsWhenGetTransmittedSegment();
+    /** @brief Test that the segments built from dataless packets stay dataless */
+    void TestVirtualPayload();
     /**
      * @brief Callback to provide a value of receiver window
      * @returns the receiver window size
@@ -89,6 +93,13 @@ TcpTxBufferTestCase::DoRun()
                         &TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment,
                         this);
 
+    /*
+     * Case for dataless packets:
+     *  -> segments made of several application packets, sent or
+     *     retransmitted, do not hold the payload bytes in memory.
+     */
+    Simulator::Schedule(Seconds(0), &TcpTxBufferTestCase::TestVirtualPayload, this);
+
     Simulator::Run();
     Simulator::Destroy();
 }
@@ -409,6 +420,40 @@ TcpTxBufferTestCase::TestMergeItemsWhenGetTransmittedSegment()
     txBuf.CopyFromSequence(2000, SequenceNumber32(1));
 }
 
+void
+TcpTxBufferTestCase::TestVirtualPayload()
+{
+    TcpTxBuffer txBuf;
+    SequenceNumber32 head(1);
+    txBuf.SetHeadSequence(head);
+    txBuf.SetSegmentSize(1400);
+
+    for (uint32_t i = 0; i < 20; ++i)
+    {
+        txBuf.Add(Create<Packet>(300));
+    }
+    // The serialized size of a packet holds its real bytes, but not its
+    // zero-filled bytes.
+    Ptr<Packet> segment = txBuf.CopyFromSequence(1400, SequenceNumber32(1))->GetPacketCopy();
+    NS_TEST_ASSERT_MSG_EQ(segment->GetSize(), 1400, "Wrong segment size");
+    NS_TEST_ASSERT_MSG_LT(segment->GetSerializedSize(), 1000, "Payload of a new segment in memory");
+
+    segment = txBuf.CopyFromSequence(1400, SequenceNumber32(1401))->GetPacketCopy();
+    txBuf.MarkHeadAsLost();
+    // Retransmission: the items of the first segment are merged again.
+    segment = txBuf.CopyFromSequence(2100, SequenceNumber32(1))->GetPacketCopy();
+    NS_TEST_ASSERT_MSG_EQ(segment->GetSize(), 1400, "Wrong retransmitted segment size");
+    NS_TEST_ASSERT_MSG_LT(segment->GetSerializedSize(),
+                          1000,
+                          "Payload of a retransmitted segment in memory");
+
+    std::vector<uint8_t> bytes(segment->GetSize(), 1);
+    segment->CopyData(bytes.data(), bytes.size());
+    NS_TEST_ASSERT_MSG_EQ(std::count(bytes.begin(), bytes.end(), 0),
+                          segment->GetSize(),
+                          "Payload not zero-filled");
+}
+
 void
 TcpTxBufferTestCase::TestTransmittedBlock()
 {
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+/**
+ * @file
+ * @ingroup mpi
+ *
+ * This example partitions a network of campuses over the ranks with the
+ * GraphPartitionHelper, instead of assigning the nodes to the ranks by hand.
+ *
+ * Each campus is a router with leaf nodes on 1 ms links, and the routers
+ * are joined in a ring by 10 ms links.  Each leaf node sends UDP traffic
+ * to the matching leaf of the next campus.  The graph of the nodes and
+ * links, weighted by the expected packet rate of each node and link, is
+ * partitioned over the ranks, and the predicted lookahead, cut and loads
+ * are printed before the run.  Each rank then prints the number of packets
+ * received by its nodes.
+ *
+ *     mpiexec -n 4 ./ns3-dev-partitioned-distributed-debug --campuses=8
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/graph-partition-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/mpi-interface.h"
+#include "ns3/network-module.h"
+#include "ns3/nix-vector-helper.h"
+#include "ns3/on-off-helper.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/packet-sink.h"
+#include "ns3/point-to-point-helper.h"
+
+#include <iostream>
+#include <mpi.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("PartitionedDistributed");
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t campuses = 8;
+    uint32_t leaves = 10;
+    double imbalance = 0.05;
+    bool nullmsg = false;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("campuses", "Number of campuses", campuses);
+    cmd.AddValue("leaves", "Number of leaf nodes per campus", leaves);
+    cmd.AddValue("imbalance", "Imbalance tolerance of the partition", imbalance);
+    cmd.AddValue("nullmsg", "Enable the use of null-message synchronization", nullmsg);
+    cmd.Parse(argc, argv);
+
+    if (nullmsg)
+    {
+        GlobalValue::Bind("SimulatorImplementationType",
+                          StringValue("ns3::NullMessageSimulatorImpl"));
+    }
+    else
+    {
+        GlobalValue::Bind("SimulatorImplementationType",
+                          StringValue("ns3::DistributedSimulatorImpl"));
+    }
+    MpiInterface::Enable(&argc, &argv);
+    uint32_t systemId = MpiInterface::GetSystemId();
+
+    DataRate rate("1Mbps");
+    uint32_t packetSize = 512;
+    double packetRate = rate.GetBitRate() / (8.0 * packetSize);
+
+    // Describe the graph: the router of campus c is node c * (leaves + 1),
+    // followed by its leaves.  A router handles the packets of its leaves,
+    // in both directions.
+    GraphPartitionHelper partition;
+    partition.SetImbalance(imbalance);
+    for (uint32_t c = 0; c < campuses; ++c)
+    {
+        partition.AddNode(2 * leaves * packetRate);
+        for (uint32_t l = 0; l < leaves; ++l)
+        {
+            partition.AddNode(2 * packetRate);
+        }
+    }
+    for (uint32_t c = 0; c < campuses; ++c)
+    {
+        uint32_t router = c * (leaves + 1);
+        for (uint32_t l = 1; l <= leaves; ++l)
+        {
+            partition.AddLink(router, router + l, MilliSeconds(1), 2 * packetRate);
+        }
+        uint32_t nextRouter = ((c + 1) % campuses) * (leaves + 1);
+        partition.AddLink(router, nextRouter, MilliSeconds(10), leaves * packetRate);
+    }
+    partition.Partition(MpiInterface::GetSize());
+    if (systemId == 0)
+    {
+        partition.Print(std::cout);
+    }
+
+    // Create the nodes and links in the order of the graph
+    NodeContainer nodes = partition.CreateNodes();
+
+    PointToPointHelper leafLink;
+    leafLink.SetDeviceAttribute("DataRate", StringValue("10Mbps"));
+    leafLink.SetChannelAttribute("Delay", StringValue("1ms"));
+    PointToPointHelper ringLink;
+    ringLink.SetDeviceAttribute("DataRate", StringValue("100Mbps"));
+    ringLink.SetChannelAttribute("Delay", StringValue("10ms"));
+
+    InternetStackHelper stack;
+    Ipv4NixVectorHelper nixRouting;
+    stack.SetRoutingHelper(nixRouting);
+    stack.Install(nodes);
+
+    Ipv4AddressHelper address;
+    address.SetBase("10.0.0.0", "255.255.255.252");
+    std::vector<Ipv4Address> leafAddresses(nodes.GetN());
+    for (uint32_t c = 0; c < campuses; ++c)
+    {
+        uint32_t router = c * (leaves + 1);
+        for (uint32_t l = 1; l <= leaves; ++l)
+        {
+            NetDeviceContainer devices = leafLink.Install(nodes.Get(router), nodes.Get(router + l));
+            leafAddresses[router + l] = address.Assign(devices).GetAddress(1);
+            address.NewNetwork();
+        }
+        uint32_t nextRouter = ((c + 1) % campuses) * (leaves + 1);
+        address.Assign(ringLink.Install(nodes.Get(router), nodes.Get(nextRouter)));
+        address.NewNetwork();
+    }
+
+    // Install the applications of the nodes of this rank
+    uint16_t port = 50000;
+    PacketSinkHelper sinkHelper("ns3::UdpSocketFactory",
+                                InetSocketAddress(Ipv4Address::GetAny(), port));
+    OnOffHelper clientHelper("ns3::UdpSocketFactory", Address());
+    clientHelper.SetConstantRate(rate, packetSize);
+    ApplicationContainer sinks;
+    ApplicationContainer clients;
+    for (uint32_t c = 0; c < campuses; ++c)
+    {
+        for (uint32_t l = 1; l <= leaves; ++l)
+        {
+            uint32_t leaf = c * (leaves + 1) + l;
+            if (nodes.Get(leaf)->GetSystemId() != systemId)
+            {
+                continue;
+            }
+            sinks.Add(sinkHelper.Install(nodes.Get(leaf)));
+            uint32_t peer = ((c + 1) % campuses) * (leaves + 1) + l;
+            clientHelper.SetAttribute("Remote",
+                                      AddressValue(InetSocketAddress(leafAddresses[peer], port)));
+            clients.Add(clientHelper.Install(nodes.Get(leaf)));
+        }
+    }
+    sinks.Start(Seconds(0));
+    clients.Start(Seconds(1));
+    clients.Stop(Seconds(2));
+    Simulator::Stop(Seconds(3));
+
+    Simulator::Run();
+
+    uint64_t received = 0;
+    for (uint32_t i = 0; i < sinks.GetN(); ++i)
+    {
+        received += DynamicCast<PacketSink>(sinks.Get(i))->GetTotalRx();
+    }
+    std::cout << "Rank " << systemId << ": " << sinks.GetN() << " sinks received "
+              << received / packetSize << " packets" << std::endl;
+
+    Simulator::Destroy();
+    MpiInterface::Disable();
+    return 0;
+}
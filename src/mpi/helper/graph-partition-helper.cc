@@ -0,0 +1,1032 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+/**
+ * @file
+ * @ingroup mpi
+ * Implementation of class ns3::GraphPartitionHelper.
+ */
+
+#include "graph-partition-helper.h"
+
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <tuple>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("GraphPartitionHelper");
+
+namespace
+{
+
+/**
+ * @ingroup mpi
+ * An edge of a weighted graph.
+ */
+struct Edge
+{
+    uint32_t to;   //!< Vertex at the end of the edge
+    double weight; //!< Weight of the edge
+};
+
+/**
+ * @ingroup mpi
+ * A weighted undirected graph, in adjacency lists.
+ */
+struct Graph
+{
+    std::vector<double> weights;            //!< Weights of the vertices
+    std::vector<std::vector<Edge>> adjList; //!< Edges of the vertices
+
+    /** @return The number of vertices. */
+    uint32_t GetN() const
+    {
+        return weights.size();
+    }
+
+    /** @return The total weight of the vertices. */
+    double GetTotalWeight() const
+    {
+        return std::accumulate(weights.begin(), weights.end(), 0.0);
+    }
+
+    /** @return The weight of the heaviest vertex. */
+    double GetMaxWeight() const
+    {
+        return weights.empty() ? 0 : *std::max_element(weights.begin(), weights.end());
+    }
+};
+
+/// The number of vertices below which a graph is not coarsened further
+const uint32_t COARSEN_TO = 40;
+
+/// The number of moves without improvement after which a refinement pass stops
+const uint32_t MAX_NON_IMPROVING_MOVES = 50;
+
+/// The maximum number of refinement passes per level
+const uint32_t MAX_PASSES = 8;
+
+/// The number of initial bisections tried on the coarsest graph
+const uint32_t INITIAL_TRIALS = 8;
+
+/**
+ * Coarsen a graph by heavy-edge matching: each vertex is merged with the
+ * unmatched neighbor to which its edge is the heaviest.
+ *
+ * @param [in] graph The graph.
+ * @param [in] maxWeight The maximum weight of a coarse vertex.
+ * @param [out] map The coarse vertex of each vertex.
+ * @return The coarse graph.
+ */
+Graph
+Coarsen(const Graph& graph, double maxWeight, std::vector<uint32_t>& map)
+{
+    const uint32_t unmatched = std::numeric_limits<uint32_t>::max();
+    uint32_t n = graph.GetN();
+    std::vector<uint32_t> match(n, unmatched);
+
+    // Visit the vertices with few neighbors first, so that they find a match
+    std::vector<uint32_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&graph](uint32_t u, uint32_t v) {
+        return graph.adjList[u].size() < graph.adjList[v].size();
+    });
+
+    map.assign(n, 0);
+    uint32_t nCoarse = 0;
+    for (uint32_t v : order)
+    {
+        if (match[v] != unmatched)
+        {
+            continue;
+        }
+        uint32_t best = v;
+        double bestWeight = -1;
+        for (const Edge& e : graph.adjList[v])
+        {
+            if (match[e.to] == unmatched && e.to != v &&
+                graph.weights[v] + graph.weights[e.to] <= maxWeight && e.weight > bestWeight)
+            {
+                best = e.to;
+                bestWeight = e.weight;
+            }
+        }
+        match[v] = best;
+        match[best] = v;
+        map[v] = nCoarse;
+        map[best] = nCoarse;
+        nCoarse++;
+    }
+
+    Graph coarse;
+    coarse.weights.assign(nCoarse, 0);
+    coarse.adjList.resize(nCoarse);
+    // Position of the edge to each coarse vertex in the list being built
+    std::vector<int64_t> position(nCoarse, -1);
+    for (uint32_t v = 0; v < n; ++v)
+    {
+        coarse.weights[map[v]] += graph.weights[v];
+        if (match[v] < v)
+        {
+            continue; // merged with the edges of its match
+        }
+        uint32_t c = map[v];
+        std::vector<Edge>& edges = coarse.adjList[c];
+        for (uint32_t u : {v, match[v]})
+        {
+            for (const Edge& e : graph.adjList[u])
+            {
+                uint32_t to = map[e.to];
+                if (to == c)
+                {
+                    continue;
+                }
+                if (position[to] < 0)
+                {
+                    position[to] = edges.size();
+                    edges.push_back({to, e.weight});
+                }
+                else
+                {
+                    edges[position[to]].weight += e.weight;
+                }
+            }
+            if (match[v] == v)
+            {
+                break;
+            }
+        }
+        for (const Edge& e : edges)
+        {
+            position[e.to] = -1;
+        }
+    }
+    return coarse;
+}
+
+/**
+ * A bisection of a graph, with the gains of the moves of its vertices.
+ */
+class Bisection
+{
+  public:
+    /**
+     * @param [in] graph The graph.
+     * @param [in] maxWeights The maximum weight of each side.
+     * @param [in] sides The side of each vertex.
+     */
+    Bisection(const Graph& graph, const double maxWeights[2], std::vector<uint8_t> sides)
+        : m_graph(graph),
+          m_sides(std::move(sides))
+    {
+        m_maxWeights[0] = maxWeights[0];
+        m_maxWeights[1] = maxWeights[1];
+        Update();
+    }
+
+    /** Compute the weights of the sides, the cut and the gains. */
+    void Update()
+    {
+        m_weights[0] = 0;
+        m_weights[1] = 0;
+        m_cut = 0;
+        m_gains.assign(m_graph.GetN(), 0);
+        for (uint32_t v = 0; v < m_graph.GetN(); ++v)
+        {
+            m_weights[m_sides[v]] += m_graph.weights[v];
+            for (const Edge& e : m_graph.adjList[v])
+            {
+                bool external = m_sides[e.to] != m_sides[v];
+                m_gains[v] += external ? e.weight : -e.weight;
+                m_cut += external ? e.weight / 2 : 0;
+            }
+        }
+    }
+
+    /**
+     * Move a vertex to the other side, and update the gains of its neighbors.
+     *
+     * @param [in] v The vertex.
+     * @param [in] onUpdate Called with each neighbor whose gain changes.
+     */
+    void Move(uint32_t v, const std::function<void(uint32_t)>& onUpdate)
+    {
+        uint8_t from = m_sides[v];
+        m_sides[v] = 1 - from;
+        m_weights[from] -= m_graph.weights[v];
+        m_weights[1 - from] += m_graph.weights[v];
+        m_cut -= m_gains[v];
+        m_gains[v] = -m_gains[v];
+        for (const Edge& e : m_graph.adjList[v])
+        {
+            // The edge was internal to u if u is on the side v left
+            m_gains[e.to] += m_sides[e.to] == from ? 2 * e.weight : -2 * e.weight;
+            onUpdate(e.to);
+        }
+    }
+
+    /** @return The weight in excess of the maximum weights of the sides. */
+    double GetExcess() const
+    {
+        return std::max(0.0, m_weights[0] - m_maxWeights[0]) +
+               std::max(0.0, m_weights[1] - m_maxWeights[1]);
+    }
+
+    /**
+     * @param [in] v A vertex.
+     * @return The weight in excess after the move of the vertex.
+     */
+    double GetExcessAfterMove(uint32_t v) const
+    {
+        uint8_t from = m_sides[v];
+        double w = m_graph.weights[v];
+        return std::max(0.0, m_weights[from] - w - m_maxWeights[from]) +
+               std::max(0.0, m_weights[1 - from] + w - m_maxWeights[1 - from]);
+    }
+
+    /**
+     * Refine the bisection with Fiduccia-Mattheyses passes: the vertex of
+     * highest gain whose move does not increase the weight in excess is
+     * moved and locked, and the best bisection of the pass is kept.
+     */
+    void Refine()
+    {
+        uint32_t n = m_graph.GetN();
+        for (uint32_t pass = 0; pass < MAX_PASSES; ++pass)
+        {
+            // Candidate moves of each side: gain, vertex (reversed, so that
+            // the lowest vertex comes first among equal gains) and version
+            using Entry = std::tuple<double, int64_t, uint32_t>;
+            std::priority_queue<Entry> heaps[2];
+            std::vector<uint32_t> versions(n, 0);
+            std::vector<bool> locked(n, false);
+            for (uint32_t v = 0; v < n; ++v)
+            {
+                heaps[m_sides[v]].emplace(m_gains[v], -int64_t(v), 0);
+            }
+            auto onUpdate = [&](uint32_t u) {
+                if (!locked[u])
+                {
+                    heaps[m_sides[u]].emplace(m_gains[u], -int64_t(u), ++versions[u]);
+                }
+            };
+
+            std::vector<uint32_t> moves;
+            m_bestExcess = GetExcess();
+            m_bestCut = m_cut;
+            uint32_t bestMoves = 0;
+            while (moves.size() < bestMoves + MAX_NON_IMPROVING_MOVES)
+            {
+                int best = -1;
+                uint32_t bestVertex = 0;
+                double excess = GetExcess();
+                for (int s = 0; s < 2; ++s)
+                {
+                    auto& heap = heaps[s];
+                    while (!heap.empty())
+                    {
+                        auto [gain, negVertex, version] = heap.top();
+                        uint32_t v = -negVertex;
+                        if (locked[v] || version != versions[v] || m_sides[v] != s)
+                        {
+                            heap.pop();
+                            continue;
+                        }
+                        if (GetExcessAfterMove(v) <= excess &&
+                            (best < 0 || gain > m_gains[bestVertex]))
+                        {
+                            best = s;
+                            bestVertex = v;
+                        }
+                        break;
+                    }
+                }
+                if (best < 0)
+                {
+                    break;
+                }
+                heaps[best].pop();
+                locked[bestVertex] = true;
+                Move(bestVertex, onUpdate);
+                moves.push_back(bestVertex);
+                double newExcess = GetExcess();
+                if (std::tie(newExcess, m_cut) < std::tie(m_bestExcess, m_bestCut))
+                {
+                    m_bestExcess = GetExcess();
+                    m_bestCut = m_cut;
+                    bestMoves = moves.size();
+                }
+            }
+
+            // Roll back to the best bisection of the pass
+            for (auto it = moves.rbegin(); it != moves.rend() - bestMoves; ++it)
+            {
+                Move(*it, [](uint32_t) {});
+            }
+            if (bestMoves == 0)
+            {
+                break;
+            }
+        }
+    }
+
+    /** @return The sides of the vertices. */
+    const std::vector<uint8_t>& GetSides() const
+    {
+        return m_sides;
+    }
+
+    /** @return The weight of the edges cut. */
+    double GetCut() const
+    {
+        return m_cut;
+    }
+
+    /**
+     * @param [in] v A vertex.
+     * @return The decrease of the cut if the vertex moves.
+     */
+    double GetGain(uint32_t v) const
+    {
+        return m_gains[v];
+    }
+
+  private:
+    const Graph& m_graph;        //!< The graph
+    std::vector<uint8_t> m_sides; //!< Side of each vertex
+    std::vector<double> m_gains;  //!< Decrease of the cut if each vertex moves
+    double m_maxWeights[2];       //!< Maximum weight of each side
+    double m_weights[2];          //!< Weight of each side
+    double m_cut;                 //!< Weight of the edges cut
+    double m_bestExcess{0};       //!< Weight in excess of the best bisection of a pass
+    double m_bestCut{0};          //!< Cut of the best bisection of a pass
+};
+
+/**
+ * Bisect the coarsest graph: side 0 is grown from a seed, by moving the
+ * vertex of highest gain, until it reaches its target weight; the best
+ * refined bisection of several seeds is kept.
+ *
+ * @param [in] graph The graph.
+ * @param [in] target The target weight of side 0.
+ * @param [in] maxWeights The maximum weight of each side.
+ * @return The side of each vertex.
+ */
+std::vector<uint8_t>
+InitialBisection(const Graph& graph, double target, const double maxWeights[2])
+{
+    uint32_t n = graph.GetN();
+    uint32_t trials = std::min(n, INITIAL_TRIALS);
+    std::vector<uint8_t> bestSides(n, 1);
+    double bestExcess = std::numeric_limits<double>::infinity();
+    double bestCut = std::numeric_limits<double>::infinity();
+    for (uint32_t trial = 0; trial < trials; ++trial)
+    {
+        Bisection bisection(graph, maxWeights, std::vector<uint8_t>(n, 1));
+        double weight = 0;
+        std::vector<bool> grown(n, false);
+        // Frontier of side 0: gain, vertex (reversed) and version
+        using Entry = std::tuple<double, int64_t, uint32_t>;
+        std::priority_queue<Entry> frontier;
+        std::vector<uint32_t> versions(n, 0);
+        auto onUpdate = [&](uint32_t u) {
+            if (!grown[u])
+            {
+                frontier.emplace(bisection.GetGain(u), -int64_t(u), ++versions[u]);
+            }
+        };
+        uint32_t next = trial * n / trials; // next seed, if the frontier is empty
+        uint32_t nGrown = 0;
+        while (weight < target && nGrown < n)
+        {
+            uint32_t v;
+            if (frontier.empty())
+            {
+                while (grown[next])
+                {
+                    next = (next + 1) % n;
+                }
+                v = next;
+            }
+            else
+            {
+                v = -std::get<1>(frontier.top());
+                uint32_t version = std::get<2>(frontier.top());
+                frontier.pop();
+                if (grown[v] || version != versions[v])
+                {
+                    continue;
+                }
+            }
+            grown[v] = true;
+            nGrown++;
+            weight += graph.weights[v];
+            bisection.Move(v, onUpdate);
+        }
+        bisection.Refine();
+        double excess = bisection.GetExcess();
+        double cut = bisection.GetCut();
+        if (std::tie(excess, cut) < std::tie(bestExcess, bestCut))
+        {
+            bestExcess = excess;
+            bestCut = cut;
+            bestSides = bisection.GetSides();
+        }
+    }
+    return bestSides;
+}
+
+/**
+ * Bisect a graph by multilevel bisection: the graph is coarsened, its
+ * coarsest version is bisected, and the bisection is projected back and
+ * refined at each level.
+ *
+ * @param [in] graph The graph.
+ * @param [in] share The target share of the weight of side 0.
+ * @param [in] imbalance The imbalance tolerance of the sides.
+ * @return The side of each vertex.
+ */
+std::vector<uint8_t>
+Bisect(const Graph& graph, double share, double imbalance)
+{
+    double total = graph.GetTotalWeight();
+    double targets[2] = {share * total, (1 - share) * total};
+
+    std::vector<Graph> levels;
+    std::vector<std::vector<uint32_t>> maps;
+    const Graph* current = &graph;
+    while (current->GetN() > COARSEN_TO)
+    {
+        std::vector<uint32_t> map;
+        Graph coarse = Coarsen(*current, 1.5 * total / COARSEN_TO, map);
+        if (coarse.GetN() > 0.95 * current->GetN())
+        {
+            break; // the matching does not reduce the graph anymore
+        }
+        levels.push_back(std::move(coarse));
+        maps.push_back(std::move(map));
+        current = &levels.back();
+    }
+
+    // The sides may exceed their target by the tolerance, or, on the
+    // coarse levels, by the heaviest vertex of the level, so that they can
+    // be balanced
+    auto getMaxWeights = [&](const Graph& level, double maxWeights[2]) {
+        for (int s = 0; s < 2; ++s)
+        {
+            maxWeights[s] = targets[s] * (1 + imbalance);
+            if (&level != &graph)
+            {
+                maxWeights[s] = std::max(maxWeights[s], targets[s] + level.GetMaxWeight());
+            }
+        }
+    };
+
+    double maxWeights[2];
+    getMaxWeights(*current, maxWeights);
+    std::vector<uint8_t> sides = InitialBisection(*current, targets[0], maxWeights);
+    for (int level = levels.size() - 1; level >= 0; --level)
+    {
+        const Graph& fine = level > 0 ? levels[level - 1] : graph;
+        std::vector<uint8_t> fineSides(fine.GetN());
+        for (uint32_t v = 0; v < fine.GetN(); ++v)
+        {
+            fineSides[v] = sides[maps[level][v]];
+        }
+        getMaxWeights(fine, maxWeights);
+        Bisection bisection(fine, maxWeights, std::move(fineSides));
+        bisection.Refine();
+        sides = bisection.GetSides();
+    }
+    return sides;
+}
+
+/**
+ * Partition a graph by recursive bisection.
+ *
+ * @param [in] graph The graph.
+ * @param [in] vertices The vertex of the original graph of each vertex.
+ * @param [in] nParts The number of parts.
+ * @param [in] firstPart The first part.
+ * @param [in] imbalance The imbalance tolerance of each bisection.
+ * @param [out] parts The part of each vertex of the original graph.
+ */
+void
+PartitionRecursive(const Graph& graph,
+                   const std::vector<uint32_t>& vertices,
+                   uint32_t nParts,
+                   uint32_t firstPart,
+                   double imbalance,
+                   std::vector<uint32_t>& parts)
+{
+    if (nParts == 1 || graph.GetN() <= 1)
+    {
+        for (uint32_t v : vertices)
+        {
+            parts[v] = firstPart;
+        }
+        return;
+    }
+
+    uint32_t nParts0 = nParts / 2;
+    std::vector<uint8_t> sides = Bisect(graph, double(nParts0) / nParts, imbalance);
+
+    // Extract the subgraph of each side
+    std::vector<uint32_t> index(graph.GetN());
+    Graph subgraphs[2];
+    std::vector<uint32_t> subVertices[2];
+    for (uint32_t v = 0; v < graph.GetN(); ++v)
+    {
+        index[v] = subgraphs[sides[v]].GetN();
+        subgraphs[sides[v]].weights.push_back(graph.weights[v]);
+        subVertices[sides[v]].push_back(vertices[v]);
+    }
+    for (int s = 0; s < 2; ++s)
+    {
+        subgraphs[s].adjList.resize(subgraphs[s].GetN());
+    }
+    for (uint32_t v = 0; v < graph.GetN(); ++v)
+    {
+        for (const Edge& e : graph.adjList[v])
+        {
+            if (sides[e.to] == sides[v])
+            {
+                subgraphs[sides[v]].adjList[index[v]].push_back({index[e.to], e.weight});
+            }
+        }
+    }
+
+    PartitionRecursive(subgraphs[0], subVertices[0], nParts0, firstPart, imbalance, parts);
+    PartitionRecursive(subgraphs[1],
+                       subVertices[1],
+                       nParts - nParts0,
+                       firstPart + nParts0,
+                       imbalance,
+                       parts);
+}
+
+/**
+ * Refine a k-way partition: the vertices of the overloaded parts are moved
+ * to the parts where they increase the cut the least, then the vertices
+ * are moved to the neighboring part where they decrease the cut the most,
+ * as long as the parts stay under the maximum weight.
+ *
+ * @param [in] graph The graph.
+ * @param [in] nParts The number of parts.
+ * @param [in] maxWeight The maximum weight of a part.
+ * @param [in,out] parts The part of each vertex.
+ */
+void
+RefineKWay(const Graph& graph, uint32_t nParts, double maxWeight, std::vector<uint32_t>& parts)
+{
+    uint32_t n = graph.GetN();
+    std::vector<double> weights(nParts, 0);
+    for (uint32_t v = 0; v < n; ++v)
+    {
+        weights[parts[v]] += graph.weights[v];
+    }
+
+    // Weight of the edges of a vertex to each part
+    std::vector<double> connectivity(nParts, 0);
+    std::vector<uint32_t> neighborParts;
+    auto connect = [&](uint32_t v) {
+        for (uint32_t q : neighborParts)
+        {
+            connectivity[q] = 0;
+        }
+        neighborParts.clear();
+        for (const Edge& e : graph.adjList[v])
+        {
+            uint32_t q = parts[e.to];
+            if (connectivity[q] == 0)
+            {
+                neighborParts.push_back(q);
+            }
+            connectivity[q] += e.weight;
+        }
+    };
+    auto move = [&](uint32_t v, uint32_t q) {
+        weights[parts[v]] -= graph.weights[v];
+        weights[q] += graph.weights[v];
+        parts[v] = q;
+    };
+
+    // Balance the parts
+    for (uint32_t iteration = 0; iteration < n; ++iteration)
+    {
+        uint32_t p = std::max_element(weights.begin(), weights.end()) - weights.begin();
+        if (weights[p] <= maxWeight)
+        {
+            break;
+        }
+        uint32_t lightest = std::min_element(weights.begin(), weights.end()) - weights.begin();
+        uint32_t bestVertex = n;
+        uint32_t bestPart = 0;
+        double bestGain = -std::numeric_limits<double>::infinity();
+        for (uint32_t v = 0; v < n; ++v)
+        {
+            if (parts[v] != p)
+            {
+                continue;
+            }
+            connect(v);
+            std::vector<uint32_t> candidates = neighborParts;
+            candidates.push_back(lightest);
+            for (uint32_t q : candidates)
+            {
+                double gain = connectivity[q] - connectivity[p];
+                if (q != p && weights[q] + graph.weights[v] <= maxWeight &&
+                    (gain > bestGain || (gain == bestGain && weights[q] < weights[bestPart])))
+                {
+                    bestVertex = v;
+                    bestPart = q;
+                    bestGain = gain;
+                }
+            }
+        }
+        if (bestVertex == n)
+        {
+            break;
+        }
+        move(bestVertex, bestPart);
+    }
+
+    // Decrease the cut
+    for (uint32_t pass = 0; pass < MAX_PASSES; ++pass)
+    {
+        bool moved = false;
+        for (uint32_t v = 0; v < n; ++v)
+        {
+            uint32_t p = parts[v];
+            connect(v);
+            uint32_t bestPart = p;
+            double bestGain = 0;
+            for (uint32_t q : neighborParts)
+            {
+                double gain = connectivity[q] - connectivity[p];
+                if (q != p && gain > bestGain && weights[q] + graph.weights[v] <= maxWeight)
+                {
+                    bestPart = q;
+                    bestGain = gain;
+                }
+            }
+            if (bestPart != p)
+            {
+                move(v, bestPart);
+                moved = true;
+            }
+        }
+        if (!moved)
+        {
+            break;
+        }
+    }
+}
+
+/**
+ * Find the group of a node, in a union-find forest.
+ *
+ * @param [in,out] parents The parent of each node.
+ * @param [in] v A node.
+ * @return The root of the tree of the node.
+ */
+uint32_t
+FindRoot(std::vector<uint32_t>& parents, uint32_t v)
+{
+    while (parents[v] != v)
+    {
+        parents[v] = parents[parents[v]];
+        v = parents[v];
+    }
+    return v;
+}
+
+} // namespace
+
+GraphPartitionHelper::GraphPartitionHelper()
+    : m_imbalance(0.05),
+      m_nParts(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+uint32_t
+GraphPartitionHelper::AddNode(double load)
+{
+    NS_LOG_FUNCTION(this << load);
+    NS_ABORT_MSG_IF(load < 0, "The load of a node cannot be negative");
+    m_loads.push_back(load);
+    return m_loads.size() - 1;
+}
+
+void
+GraphPartitionHelper::AddLink(uint32_t a, uint32_t b, Time delay, double traffic)
+{
+    NS_LOG_FUNCTION(this << a << b << delay << traffic);
+    NS_ABORT_MSG_IF(a >= m_loads.size() || b >= m_loads.size(), "Unknown node");
+    NS_ABORT_MSG_IF(traffic < 0, "The traffic of a link cannot be negative");
+    m_links.push_back({a, b, delay, traffic});
+}
+
+void
+GraphPartitionHelper::SetImbalance(double imbalance)
+{
+    NS_LOG_FUNCTION(this << imbalance);
+    NS_ABORT_MSG_IF(imbalance < 0, "The imbalance tolerance cannot be negative");
+    m_imbalance = imbalance;
+}
+
+uint32_t
+GraphPartitionHelper::GroupNodes(Time bound, std::vector<uint32_t>& groups) const
+{
+    std::vector<uint32_t> parents(m_loads.size());
+    std::iota(parents.begin(), parents.end(), 0);
+    for (const Link& link : m_links)
+    {
+        if (link.delay < bound)
+        {
+            parents[FindRoot(parents, link.a)] = FindRoot(parents, link.b);
+        }
+    }
+
+    const uint32_t none = std::numeric_limits<uint32_t>::max();
+    std::vector<uint32_t> rootGroups(m_loads.size(), none);
+    uint32_t nGroups = 0;
+    groups.resize(m_loads.size());
+    for (uint32_t v = 0; v < m_loads.size(); ++v)
+    {
+        uint32_t root = FindRoot(parents, v);
+        if (rootGroups[root] == none)
+        {
+            rootGroups[root] = nGroups++;
+        }
+        groups[v] = rootGroups[root];
+    }
+    return nGroups;
+}
+
+Time
+GraphPartitionHelper::FindLookaheadBound(uint32_t nParts) const
+{
+    std::vector<Time> delays;
+    for (const Link& link : m_links)
+    {
+        delays.push_back(link.delay);
+    }
+    std::sort(delays.begin(), delays.end());
+    delays.erase(std::unique(delays.begin(), delays.end()), delays.end());
+    if (delays.empty())
+    {
+        return Time(0);
+    }
+
+    double total = std::accumulate(m_loads.begin(), m_loads.end(), 0.0);
+    double maxLoad = total / nParts * (1 + m_imbalance);
+
+    // The groups can be balanced if the longest-processing-time-first
+    // packing of their loads into the ranks fits under the maximum load
+    auto isBalanced = [&](Time bound) {
+        std::vector<uint32_t> groups;
+        uint32_t nGroups = GroupNodes(bound, groups);
+        std::vector<double> loads(nGroups, 0);
+        for (uint32_t v = 0; v < m_loads.size(); ++v)
+        {
+            loads[groups[v]] += m_loads[v];
+        }
+        std::sort(loads.begin(), loads.end(), std::greater<>());
+        std::priority_queue<double, std::vector<double>, std::greater<>> ranks;
+        for (uint32_t i = 0; i < nParts; ++i)
+        {
+            ranks.push(0);
+        }
+        for (double load : loads)
+        {
+            double rank = ranks.top() + load;
+            if (rank > maxLoad)
+            {
+                return false;
+            }
+            ranks.pop();
+            ranks.push(rank);
+        }
+        return true;
+    };
+
+    // The shortest delay cuts no link: it is the fallback if no larger
+    // bound can be balanced.  The groups only grow with the bound.
+    std::size_t low = 0;
+    std::size_t high = delays.size() - 1;
+    while (low < high)
+    {
+        std::size_t middle = (low + high + 1) / 2;
+        if (isBalanced(delays[middle]))
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+    return delays[low];
+}
+
+const std::vector<uint32_t>&
+GraphPartitionHelper::Partition(uint32_t nParts)
+{
+    NS_LOG_FUNCTION(this << nParts);
+    NS_ABORT_MSG_IF(nParts == 0, "At least one rank is needed");
+
+    m_nParts = nParts;
+    m_parts.assign(m_loads.size(), 0);
+    if (nParts > 1 && !m_loads.empty())
+    {
+        // Never cut the links shorter than the bound
+        Time bound = FindLookaheadBound(nParts);
+        std::vector<uint32_t> groups;
+        uint32_t nGroups = GroupNodes(bound, groups);
+        NS_LOG_INFO("Lookahead bound " << bound.As(Time::MS) << ", " << nGroups << " groups");
+
+        Graph graph;
+        graph.weights.assign(nGroups, 0);
+        graph.adjList.resize(nGroups);
+        for (uint32_t v = 0; v < m_loads.size(); ++v)
+        {
+            graph.weights[groups[v]] += m_loads[v];
+        }
+        std::vector<int64_t> position(nGroups, -1);
+        std::vector<std::vector<std::pair<uint32_t, double>>> groupLinks(nGroups);
+        for (const Link& link : m_links)
+        {
+            uint32_t a = groups[link.a];
+            uint32_t b = groups[link.b];
+            if (a != b)
+            {
+                groupLinks[a].emplace_back(b, link.traffic);
+                groupLinks[b].emplace_back(a, link.traffic);
+            }
+        }
+        // Merge the links between the same groups
+        for (uint32_t a = 0; a < nGroups; ++a)
+        {
+            std::vector<Edge>& edges = graph.adjList[a];
+            for (auto [b, traffic] : groupLinks[a])
+            {
+                if (position[b] < 0)
+                {
+                    position[b] = edges.size();
+                    edges.push_back({b, traffic});
+                }
+                else
+                {
+                    edges[position[b]].weight += traffic;
+                }
+            }
+            for (const Edge& e : edges)
+            {
+                position[e.to] = -1;
+            }
+        }
+
+        // The imbalance compounds over the levels of recursive bisection
+        double levels = std::ceil(std::log2(nParts));
+        double imbalance = std::pow(1 + m_imbalance, 1 / levels) - 1;
+        std::vector<uint32_t> vertices(nGroups);
+        std::iota(vertices.begin(), vertices.end(), 0);
+        std::vector<uint32_t> groupParts(nGroups);
+        PartitionRecursive(graph, vertices, nParts, 0, imbalance, groupParts);
+        RefineKWay(graph,
+                   nParts,
+                   graph.GetTotalWeight() / nParts * (1 + m_imbalance),
+                   groupParts);
+        for (uint32_t v = 0; v < m_loads.size(); ++v)
+        {
+            m_parts[v] = groupParts[groups[v]];
+        }
+    }
+
+    m_partLoads.assign(nParts, 0);
+    for (uint32_t v = 0; v < m_loads.size(); ++v)
+    {
+        m_partLoads[m_parts[v]] += m_loads[v];
+    }
+    return m_parts;
+}
+
+uint32_t
+GraphPartitionHelper::GetSystemId(uint32_t node) const
+{
+    NS_ASSERT_MSG(node < m_parts.size(), "The graph is not partitioned, or the node is unknown");
+    return m_parts[node];
+}
+
+NodeContainer
+GraphPartitionHelper::CreateNodes() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ABORT_MSG_IF(m_parts.size() != m_loads.size(), "The graph is not partitioned");
+    NodeContainer nodes;
+    for (uint32_t systemId : m_parts)
+    {
+        nodes.Add(CreateObject<Node>(systemId));
+    }
+    return nodes;
+}
+
+Time
+GraphPartitionHelper::GetLookahead() const
+{
+    Time lookahead = Time::Max();
+    for (const Link& link : m_links)
+    {
+        if (GetSystemId(link.a) != GetSystemId(link.b))
+        {
+            lookahead = Min(lookahead, link.delay);
+        }
+    }
+    return lookahead;
+}
+
+uint32_t
+GraphPartitionHelper::GetCutLinks() const
+{
+    uint32_t cut = 0;
+    for (const Link& link : m_links)
+    {
+        cut += GetSystemId(link.a) != GetSystemId(link.b);
+    }
+    return cut;
+}
+
+double
+GraphPartitionHelper::GetCutTraffic() const
+{
+    double cut = 0;
+    for (const Link& link : m_links)
+    {
+        cut += GetSystemId(link.a) != GetSystemId(link.b) ? link.traffic : 0;
+    }
+    return cut;
+}
+
+double
+GraphPartitionHelper::GetLoad(uint32_t part) const
+{
+    NS_ASSERT_MSG(part < m_partLoads.size(), "The graph is not partitioned, or the rank is unknown");
+    return m_partLoads[part];
+}
+
+void
+GraphPartitionHelper::Print(std::ostream& os) const
+{
+    double total = std::accumulate(m_loads.begin(), m_loads.end(), 0.0);
+    double traffic = 0;
+    for (const Link& link : m_links)
+    {
+        traffic += link.traffic;
+    }
+    double maxLoad = m_partLoads.empty()
+                         ? 0
+                         : *std::max_element(m_partLoads.begin(), m_partLoads.end());
+    Time lookahead = GetLookahead();
+
+    os << "Partition of " << m_loads.size() << " nodes and " << m_links.size() << " links into "
+       << m_nParts << " ranks:" << std::endl;
+    os << "  lookahead: ";
+    if (lookahead == Time::Max())
+    {
+        os << "unbounded (no link cut)";
+    }
+    else
+    {
+        os << lookahead.As(Time::MS);
+    }
+    os << std::endl;
+    os << "  cut: " << GetCutLinks() << " links, traffic " << GetCutTraffic() << " ("
+       << (traffic > 0 ? 100 * GetCutTraffic() / traffic : 0) << "% of the total)" << std::endl;
+    os << "  imbalance: " << (total > 0 ? 100 * (maxLoad * m_nParts / total - 1) : 0)
+       << "% (max load " << maxLoad << ", mean " << (m_nParts ? total / m_nParts : 0) << ")"
+       << std::endl;
+    os << "  loads:";
+    for (double load : m_partLoads)
+    {
+        os << " " << load;
+    }
+    os << std::endl;
+}
+
+} // namespace ns3
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+/**
+ * @file
+ * @ingroup mpi
+ * Declaration of class ns3::GraphPartitionHelper.
+ */
+
+#ifndef NS3_GRAPH_PARTITION_HELPER_H
+#define NS3_GRAPH_PARTITION_HELPER_H
+
+#include "ns3/node-container.h"
+#include "ns3/nstime.h"
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup mpi
+ *
+ * @brief Assign the nodes of a distributed simulation to the ranks.
+ *
+ * The lookahead of a distributed simulation is the smallest delay of the
+ * links between two ranks, and its cost grows with the traffic between
+ * the ranks and with the load of the most loaded rank.  This helper takes
+ * the graph of the nodes, weighted by their expected load, and of the
+ * links, weighted by their delay and expected traffic, and partitions it
+ * before the nodes are created:
+ *
+ * - it first finds the largest lookahead for which the nodes joined by the
+ *   links of shorter delays, which are never cut, can still be balanced
+ *   over the ranks within the imbalance tolerance;
+ * - it then partitions the graph of these groups of nodes by multilevel
+ *   recursive bisection, as METIS does: the graph is coarsened by
+ *   heavy-edge matching, the coarsest graph is bisected by greedy graph
+ *   growing, and the bisection is refined by Fiduccia-Mattheyses passes
+ *   at each level, to minimize the traffic of the links cut.
+ *
+ * The partition is deterministic, so every rank computes the same one
+ * without any communication, and the nodes are then created with their
+ * system id:
+ *
+ * @code
+ *   GraphPartitionHelper partition;
+ *   for (uint32_t i = 0; i < nNodes; ++i)
+ *   {
+ *       partition.AddNode();
+ *   }
+ *   partition.AddLink(0, 1, MilliSeconds(10), 100);
+ *   ...
+ *   partition.Partition(MpiInterface::GetSize());
+ *   partition.Print(std::cout);
+ *   NodeContainer nodes = partition.CreateNodes();
+ * @endcode
+ */
+class GraphPartitionHelper
+{
+  public:
+    GraphPartitionHelper();
+
+    /**
+     * Add a node to the graph.
+     *
+     * @param [in] load The expected load of the node, e.g. the number of
+     *             packets it sends, forwards and receives per second.
+     * @return The index of the node, the number of nodes added before it.
+     */
+    uint32_t AddNode(double load = 1);
+
+    /**
+     * Add a link between two nodes to the graph.
+     *
+     * @param [in] a The index of the first node.
+     * @param [in] b The index of the second node.
+     * @param [in] delay The delay of the link.
+     * @param [in] traffic The expected traffic of the link, e.g. the
+     *             number of packets it carries per second.
+     */
+    void AddLink(uint32_t a, uint32_t b, Time delay, double traffic = 1);
+
+    /**
+     * Set the imbalance tolerance of the partition: the load of a rank may
+     * exceed the mean load of the ranks by this share.  The default is 0.05.
+     *
+     * @param [in] imbalance The imbalance tolerance.
+     */
+    void SetImbalance(double imbalance);
+
+    /**
+     * Partition the graph.
+     *
+     * @param [in] nParts The number of ranks.
+     * @return The system id of each node.
+     */
+    const std::vector<uint32_t>& Partition(uint32_t nParts);
+
+    /**
+     * @param [in] node The index of a node.
+     * @return The system id of the node.
+     */
+    uint32_t GetSystemId(uint32_t node) const;
+
+    /**
+     * Create the nodes, with their system id, in the order of their index.
+     *
+     * @return The nodes.
+     */
+    NodeContainer CreateNodes() const;
+
+    /**
+     * @return The predicted lookahead: the smallest delay of the links cut,
+     *         or Time::Max() if no link is cut.
+     */
+    Time GetLookahead() const;
+
+    /** @return The number of links cut. */
+    uint32_t GetCutLinks() const;
+
+    /** @return The traffic of the links cut. */
+    double GetCutTraffic() const;
+
+    /**
+     * @param [in] part A system id.
+     * @return The load of the nodes of the rank.
+     */
+    double GetLoad(uint32_t part) const;
+
+    /**
+     * Print the predicted lookahead, cut and loads of the partition.
+     *
+     * @param [in,out] os The output stream.
+     */
+    void Print(std::ostream& os) const;
+
+  private:
+    /** A link of the graph. */
+    struct Link
+    {
+        uint32_t a;     //!< Index of the first node
+        uint32_t b;     //!< Index of the second node
+        Time delay;     //!< Delay of the link
+        double traffic; //!< Expected traffic of the link
+    };
+
+    /**
+     * Find the largest delay such that the groups of nodes joined by the
+     * links of shorter delays can be balanced over the ranks.
+     *
+     * @param [in] nParts The number of ranks.
+     * @return The delay, or 0 if there is no link.
+     */
+    Time FindLookaheadBound(uint32_t nParts) const;
+
+    /**
+     * Group the nodes joined by the links shorter than a delay.
+     *
+     * @param [in] bound The delay.
+     * @param [out] groups The group of each node.
+     * @return The number of groups.
+     */
+    uint32_t GroupNodes(Time bound, std::vector<uint32_t>& groups) const;
+
+    std::vector<double> m_loads;     //!< Loads of the nodes
+    std::vector<Link> m_links;       //!< Links of the graph
+    double m_imbalance;              //!< Imbalance tolerance
+    uint32_t m_nParts;               //!< Number of ranks of the partition
+    std::vector<uint32_t> m_parts;   //!< System ids of the nodes
+    std::vector<double> m_partLoads; //!< Loads of the ranks
+};
+
+} // namespace ns3
+
+#endif /* NS3_GRAPH_PARTITION_HELPER_H */
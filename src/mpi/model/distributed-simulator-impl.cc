@@ -8,7 +8,7 @@
 /**
  * @file
  * @ingroup mpi
- *  Implementation of classes  ns3::LbtsMessage and ns3::DistributedSimulatorImpl.
+ *  Implementation of class ns3::DistributedSimulatorImpl.
  */
 
 #include "distributed-simulator-impl.h"
@@ -18,6 +18,7 @@
 
 #include "ns3/assert.h"
 #include "ns3/channel.h"
+#include "ns3/double.h"
 #include "ns3/event-impl.h"
 #include "ns3/log.h"
 #include "ns3/node-container.h"
@@ -36,40 +37,6 @@ NS_LOG_COMPONENT_DEFINE("DistributedSimulatorImpl");
 
 NS_OBJECT_ENSURE_REGISTERED(DistributedSimulatorImpl);
 
-LbtsMessage::~LbtsMessage()
-{
-}
-
-Time
-LbtsMessage::GetSmallestTime()
-{
-    return m_smallestTime;
-}
-
-uint32_t
-LbtsMessage::GetTxCount() const
-{
-    return m_txCount;
-}
-
-uint32_t
-LbtsMessage::GetRxCount() const
-{
-    return m_rxCount;
-}
-
-uint32_t
-LbtsMessage::GetMyId() const
-{
-    return m_myId;
-}
-
-bool
-LbtsMessage::IsFinished() const
-{
-    return m_isFinished;
-}
-
 /**
  * Initialize m_lookAhead to maximum, it will be constrained by
  * user supplied time via BoundLookAhead and the
@@ -83,7 +50,17 @@ DistributedSimulatorImpl::GetTypeId()
     static TypeId tid = TypeId("ns3::DistributedSimulatorImpl")
                             .SetParent<SimulatorImpl>()
                             .SetGroupName("Mpi")
-                            .AddConstructor<DistributedSimulatorImpl>();
+                            .AddConstructor<DistributedSimulatorImpl>()
+                            .AddAttribute("LbtsOverlap",
+                                          "The share of the lookahead before the end of the "
+                                          "granted time window at which a rank starts the "
+                                          "computation of the next LBTS, while it processes the "
+                                          "rest of the window. With 0, the rank waits for the "
+                                          "computation at the end of the window.",
+                                          DoubleValue(0),
+                                          MakeDoubleAccessor(
+                                              &DistributedSimulatorImpl::m_lbtsOverlap),
+                                          MakeDoubleChecker<double>(0, 1));
     return tid;
 }
 
@@ -94,9 +71,9 @@ DistributedSimulatorImpl::DistributedSimulatorImpl()
     m_myId = MpiInterface::GetSystemId();
     m_systemCount = MpiInterface::GetSize();
 
-    // Allocate the LBTS message buffer
-    m_pLBTS = new LbtsMessage[m_systemCount];
     m_grantedTime = Seconds(0);
+    m_lbtsPending = false;
+    m_lbtsOverlap = 0;
 
     m_stop = false;
     m_globalFinished = false;
@@ -125,7 +102,6 @@ DistributedSimulatorImpl::DoDispose()
         next.impl->Unref();
     }
     m_events = nullptr;
-    delete[] m_pLBTS;
     SimulatorImpl::DoDispose();
 }
 
@@ -346,6 +322,93 @@ DistributedSimulatorImpl::Next() const
     return TimeStep(NextTs());
 }
 
+void
+DistributedSimulatorImpl::StartLbts()
+{
+    NS_LOG_FUNCTION(this);
+
+    // Can't process next event, calculate a new LBTS
+    // First receive any pending messages
+    GrantedTimeWindowMpiInterface::ReceiveMessages();
+    // Then send the messages aggregated since the last LBTS
+    GrantedTimeWindowMpiInterface::FlushSendBuffers();
+    // And check for send completes
+    GrantedTimeWindowMpiInterface::TestSendComplete();
+    // Finally start the reductions.  The counts include all the messages
+    // sent so far; the messages sent while the reductions are pending are
+    // aggregated until the next LBTS, and have a receive time of at least
+    // the time of the next event plus the lookahead, so at least the new
+    // granted time.
+    m_lbtsMin[0] = NextTs();
+    m_lbtsMin[1] = IsLocalFinished() ? 1 : 0;
+    m_lbtsSum[0] = GrantedTimeWindowMpiInterface::GetRxCount();
+    m_lbtsSum[1] = GrantedTimeWindowMpiInterface::GetTxCount();
+    MPI_Iallreduce(m_lbtsMin,
+                   m_lbtsMinResult,
+                   2,
+                   MPI_INT64_T,
+                   MPI_MIN,
+                   MpiInterface::GetCommunicator(),
+                   &m_lbtsRequest[0]);
+    MPI_Iallreduce(m_lbtsSum,
+                   m_lbtsSumResult,
+                   2,
+                   MPI_UINT64_T,
+                   MPI_SUM,
+                   MpiInterface::GetCommunicator(),
+                   &m_lbtsRequest[1]);
+    m_lbtsPending = true;
+}
+
+bool
+DistributedSimulatorImpl::CompleteLbts(bool wait)
+{
+    NS_LOG_FUNCTION(this << wait);
+
+    if (wait)
+    {
+        MPI_Waitall(2, m_lbtsRequest, MPI_STATUSES_IGNORE);
+    }
+    else
+    {
+        int flag = 0;
+        MPI_Testall(2, m_lbtsRequest, &flag, MPI_STATUSES_IGNORE);
+        if (!flag)
+        {
+            return false;
+        }
+    }
+    m_lbtsPending = false;
+
+    Time smallestTime = TimeStep(m_lbtsMinResult[0]);
+    // The totRx and totTx counts insure there are no transient
+    // messages;  If totRx != totTx, there are transients,
+    // so we don't update the granted time.
+    uint64_t totRx = m_lbtsSumResult[0];
+    uint64_t totTx = m_lbtsSumResult[1];
+
+    // Global halting condition is all nodes have empty queue's and
+    // no messages are in-flight.
+    m_globalFinished = m_lbtsMinResult[1] == 1 && totRx == totTx;
+
+    if (totRx == totTx)
+    {
+        // If lookahead is infinite then granted time should be as well.
+        // Covers the edge case if all the tasks have no inter tasks
+        // links, prevents overflow of granted time.
+        if (m_lookAhead == GetMaximumSimulationTime())
+        {
+            m_grantedTime = GetMaximumSimulationTime();
+        }
+        else if (!m_globalFinished)
+        {
+            // Overflow is possible here if near end of representable time.
+            m_grantedTime = Max(m_grantedTime, smallestTime + m_lookAhead);
+        }
+    }
+    return true;
+}
+
 void
 DistributedSimulatorImpl::Run()
 {
@@ -354,81 +417,38 @@ DistributedSimulatorImpl::Run()
     CalculateLookAhead();
     m_stop = false;
     m_globalFinished = false;
+
+    // A rank starts the LBTS computation when its next event is within
+    // this lead of the end of the granted time window
+    Time lead;
+    if (m_lookAhead != GetMaximumSimulationTime())
+    {
+        lead = TimeStep(static_cast<uint64_t>(m_lookAhead.GetTimeStep() * m_lbtsOverlap));
+    }
+
     while (!m_globalFinished)
     {
-        Time nextTime = Next();
-
-        // If local event is beyond grantedTime then need to synchronize
-        // with other tasks to determine new time window. If local task
-        // is finished then continue to participate in allgather
-        // synchronizations with other tasks until all tasks have
-        // completed.
-        if (nextTime > m_grantedTime || IsLocalFinished())
+        // If local event is near or beyond grantedTime then need to
+        // synchronize with other tasks to determine new time window. If
+        // local task is finished then continue to participate in
+        // reductions with other tasks until all tasks have completed.
+        if (!m_lbtsPending && (Next() > m_grantedTime - lead || IsLocalFinished()))
         {
-            // Can't process next event, calculate a new LBTS
-            // First receive any pending messages
-            GrantedTimeWindowMpiInterface::ReceiveMessages();
-            // reset next time
-            nextTime = Next();
-            // And check for send completes
-            GrantedTimeWindowMpiInterface::TestSendComplete();
-            // Finally calculate the lbts
-            LbtsMessage lMsg(GrantedTimeWindowMpiInterface::GetRxCount(),
-                             GrantedTimeWindowMpiInterface::GetTxCount(),
-                             m_myId,
-                             IsLocalFinished(),
-                             nextTime);
-            m_pLBTS[m_myId] = lMsg;
-            MPI_Allgather(&lMsg,
-                          sizeof(LbtsMessage),
-                          MPI_BYTE,
-                          m_pLBTS,
-                          sizeof(LbtsMessage),
-                          MPI_BYTE,
-                          MpiInterface::GetCommunicator());
-            Time smallestTime = m_pLBTS[0].GetSmallestTime();
-            // The totRx and totTx counts insure there are no transient
-            // messages;  If totRx != totTx, there are transients,
-            // so we don't update the granted time.
-            uint32_t totRx = m_pLBTS[0].GetRxCount();
-            uint32_t totTx = m_pLBTS[0].GetTxCount();
-            m_globalFinished = m_pLBTS[0].IsFinished();
-
-            for (uint32_t i = 1; i < m_systemCount; ++i)
-            {
-                if (m_pLBTS[i].GetSmallestTime() < smallestTime)
-                {
-                    smallestTime = m_pLBTS[i].GetSmallestTime();
-                }
-                totRx += m_pLBTS[i].GetRxCount();
-                totTx += m_pLBTS[i].GetTxCount();
-                m_globalFinished &= m_pLBTS[i].IsFinished();
-            }
-
-            // Global halting condition is all nodes have empty queue's and
-            // no messages are in-flight.
-            m_globalFinished &= totRx == totTx;
-
-            if (totRx == totTx)
-            {
-                // If lookahead is infinite then granted time should be as well.
-                // Covers the edge case if all the tasks have no inter tasks
-                // links, prevents overflow of granted time.
-                if (m_lookAhead == GetMaximumSimulationTime())
-                {
-                    m_grantedTime = GetMaximumSimulationTime();
-                }
-                else
-                {
-                    // Overflow is possible here if near end of representable time.
-                    m_grantedTime = smallestTime + m_lookAhead;
-                }
-            }
+            StartLbts();
         }
 
         // Execute next event if it is within the current time window.
         // Local task may be completed.
-        if ((nextTime <= m_grantedTime) && (!IsLocalFinished()))
+        bool canProcess = (Next() <= m_grantedTime) && (!IsLocalFinished());
+        if (m_lbtsPending)
+        {
+            // Wait for the LBTS only if there is nothing else to do
+            if (CompleteLbts(!canProcess))
+            {
+                continue;
+            }
+        }
+        if (canProcess)
         { // Safe to process
             ProcessOneEvent();
         }
@@ -539,6 +559,12 @@ DistributedSimulatorImpl::GetDelayLeft(const EventId& id) const
 void
 DistributedSimulatorImpl::Remove(const EventId& id)
 {
+    if (id.GetUid() == EventId::UID::WHEEL)
+    {
+        // timer wheel events are not in the event list until they are due.
+        Cancel(id);
+        return;
+    }
     if (id.GetUid() == EventId::UID::DESTROY)
     {
         // destroy events.
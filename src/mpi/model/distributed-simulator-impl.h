@@ -8,7 +8,7 @@
 /**
  * @file
  * @ingroup mpi
- *  Declaration of classes  ns3::LbtsMessage and ns3::DistributedSimulatorImpl.
+ *  Declaration of class ns3::DistributedSimulatorImpl.
  */
 
 #ifndef NS3_DISTRIBUTED_SIMULATOR_IMPL_H
@@ -20,78 +20,25 @@
 #include "ns3/simulator-impl.h"
 
 #include <list>
+#include <mpi.h>
 
 namespace ns3
 {
 
-/**
- * @ingroup mpi
- *
- * @brief Structure used for all-reduce LBTS computation
- */
-class LbtsMessage
-{
-  public:
-    LbtsMessage()
-        : m_txCount(0),
-          m_rxCount(0),
-          m_myId(0),
-          m_isFinished(false)
-    {
-    }
-
-    /**
-     * @param rxc received count
-     * @param txc transmitted count
-     * @param id mpi rank
-     * @param isFinished whether message is finished
-     * @param t smallest time
-     */
-    LbtsMessage(uint32_t rxc, uint32_t txc, uint32_t id, bool isFinished, const Time& t)
-        : m_txCount(txc),
-          m_rxCount(rxc),
-          m_myId(id),
-          m_smallestTime(t),
-          m_isFinished(isFinished)
-    {
-    }
-
-    ~LbtsMessage();
-
-    /**
-     * @return smallest time
-     */
-    Time GetSmallestTime();
-    /**
-     * @return transmitted count
-     */
-    uint32_t GetTxCount() const;
-    /**
-     * @return received count
-     */
-    uint32_t GetRxCount() const;
-    /**
-     * @return id which corresponds to mpi rank
-     */
-    uint32_t GetMyId() const;
-    /**
-     * @return true if system is finished
-     */
-    bool IsFinished() const;
-
-  private:
-    uint32_t m_txCount;  /**< Count of transmitted messages. */
-    uint32_t m_rxCount;  /**< Count of received messages. */
-    uint32_t m_myId;     /**< System Id of the rank sending this LBTS. */
-    Time m_smallestTime; /**< Earliest next event timestamp. */
-    bool m_isFinished;   /**< \c true when this rank has no more events. */
-};
-
 /**
  * @ingroup simulator
  * @ingroup mpi
  *
  * @brief Distributed simulator implementation using lookahead
+ *
+ * The ranks compute the lower bound on the time stamp (LBTS) of the
+ * messages they may receive, and thus the end of the time window in which
+ * they can process their events, with nonblocking MPI_Iallreduce
+ * operations: the minimum of the time of their next events, and the sums
+ * of the messages sent and received, which must be equal for the bound to
+ * hold.  With the LbtsOverlap attribute, a rank starts the reduction before
+ * it reaches the end of its window, and processes the rest of its window
+ * while the reduction completes.
  */
 class DistributedSimulatorImpl : public SimulatorImpl
 {
@@ -210,10 +157,28 @@ class DistributedSimulatorImpl : public SimulatorImpl
     int m_unscheduledEvents;
 
     /**
-     * Container for Lbts messages, one per rank.
-     * Allocated once we know how many systems there are.
+     * Start the nonblocking reductions of the LBTS computation, after
+     * sending the aggregated messages and receiving the pending ones.
      */
-    LbtsMessage* m_pLBTS;
+    void StartLbts();
+    /**
+     * Complete the LBTS computation, and update the granted time.
+     *
+     * @param [in] wait Whether to wait for the reductions to complete.
+     * @return \c true if the reductions are complete.
+     */
+    bool CompleteLbts(bool wait);
+
+    /** Time of the next event and local finished flag, reduced with MPI_MIN. */
+    int64_t m_lbtsMin[2];
+    int64_t m_lbtsMinResult[2]; /**< Result of the MPI_MIN reduction. */
+    /** Received and transmitted message counts, reduced with MPI_SUM. */
+    uint64_t m_lbtsSum[2];
+    uint64_t m_lbtsSumResult[2];  /**< Result of the MPI_SUM reduction. */
+    MPI_Request m_lbtsRequest[2]; /**< The pending reductions. */
+    bool m_lbtsPending;           /**< Is an LBTS computation pending. */
+    double m_lbtsOverlap;         /**< Share of the lookahead overlapped with the LBTS. */
+
     uint32_t m_myId;         /**< MPI rank. */
     uint32_t m_systemCount;  /**< MPI communicator size. */
     Time m_grantedTime;      /**< End of current window. */
@@ -26,6 +26,7 @@
 #include "ns3/simulator-impl.h"
 #include "ns3/simulator.h"
 
+#include <cstring>
 #include <iomanip>
 #include <iostream>
 #include <list>
@@ -38,6 +39,37 @@ NS_LOG_COMPONENT_DEFINE("GrantedTimeWindowMpiInterface");
 
 NS_OBJECT_ENSURE_REGISTERED(GrantedTimeWindowMpiInterface);
 
+namespace
+{
+
+/**
+ * @ingroup mpi
+ * The header of a packet record in an aggregated message.
+ *
+ * The records are padded to a multiple of 8 octets, so that the headers
+ * and the serialized packets, which are read as 32-bit words, are aligned.
+ */
+struct PacketRecordHeader
+{
+    uint64_t rxTime; //!< Receive time of the packet, in time steps
+    uint32_t node;   //!< Destination node
+    uint32_t dev;    //!< Destination device
+    uint32_t size;   //!< Serialized size of the packet
+    uint32_t pad;    //!< Padding to 8 octets
+};
+
+/**
+ * @param size A size, in octets.
+ * @return The size, rounded up to a multiple of 8 octets.
+ */
+uint32_t
+PadRecord(uint32_t size)
+{
+    return (size + 7) & ~7U;
+}
+
+} // namespace
+
 SentBuffer::SentBuffer()
 {
     m_buffer = nullptr;
@@ -75,8 +107,8 @@ uint32_t GrantedTimeWindowMpiInterface::g_rxCount = 0;
 uint32_t GrantedTimeWindowMpiInterface::g_txCount = 0;
 std::list<SentBuffer> GrantedTimeWindowMpiInterface::g_pendingTx;
 
-MPI_Request* GrantedTimeWindowMpiInterface::g_requests;
-char** GrantedTimeWindowMpiInterface::g_pRxBuffers;
+std::vector<std::vector<uint8_t>> GrantedTimeWindowMpiInterface::g_txBuffers;
+std::vector<uint8_t> GrantedTimeWindowMpiInterface::g_rxBuffer;
 MPI_Comm GrantedTimeWindowMpiInterface::g_communicator = MPI_COMM_WORLD;
 bool GrantedTimeWindowMpiInterface::g_freeCommunicator = false;
 
@@ -93,13 +125,8 @@ GrantedTimeWindowMpiInterface::Destroy()
 {
     NS_LOG_FUNCTION(this);
 
-    for (uint32_t i = 0; i < GetSize(); ++i)
-    {
-        delete[] g_pRxBuffers[i];
-    }
-    delete[] g_pRxBuffers;
-    delete[] g_requests;
-
+    g_txBuffers.clear();
+    g_rxBuffer.clear();
     g_pendingTx.clear();
 }
 
@@ -181,20 +208,7 @@ GrantedTimeWindowMpiInterface::Enable(MPI_Comm communicator)
     g_size = mpiSize;
 
     g_enabled = true;
-    // Post a non-blocking receive for all peers
-    g_pRxBuffers = new char*[g_size];
-    g_requests = new MPI_Request[g_size];
-    for (uint32_t i = 0; i < GetSize(); ++i)
-    {
-        g_pRxBuffers[i] = new char[MAX_MPI_MSG_SIZE];
-        MPI_Irecv(g_pRxBuffers[i],
-                  MAX_MPI_MSG_SIZE,
-                  MPI_CHAR,
-                  MPI_ANY_SOURCE,
-                  0,
-                  g_communicator,
-                  &g_requests[i]);
-    }
+    g_txBuffers.assign(g_size, std::vector<uint8_t>());
 }
 
 void
@@ -205,35 +219,56 @@ GrantedTimeWindowMpiInterface::SendPacket(Ptr<Packet> p,
 {
     NS_LOG_FUNCTION(this << p << rxTime.GetTimeStep() << node << dev);
 
-    SentBuffer sendBuf;
-    g_pendingTx.push_back(sendBuf);
-    auto i = g_pendingTx.rbegin(); // Points to the last element
-
-    uint32_t serializedSize = p->GetSerializedSize();
-    auto buffer = new uint8_t[serializedSize + 16];
-    i->SetBuffer(buffer);
-    // Add the time, dest node and dest device
-    uint64_t t = rxTime.GetInteger();
-    auto pTime = reinterpret_cast<uint64_t*>(buffer);
-    *pTime++ = t;
-    auto pData = reinterpret_cast<uint32_t*>(pTime);
-    *pData++ = node;
-    *pData++ = dev;
-    // Serialize the packet
-    p->Serialize(reinterpret_cast<uint8_t*>(pData), serializedSize);
-
     // Find the system id for the destination node
     Ptr<Node> destNode = NodeList::GetNode(node);
     uint32_t nodeSysId = destNode->GetSystemId();
 
-    MPI_Isend(reinterpret_cast<void*>(i->GetBuffer()),
-              serializedSize + 16,
-              MPI_CHAR,
-              nodeSysId,
-              0,
-              g_communicator,
-              (i->GetRequest()));
-    g_txCount++;
+    // Append the time, dest node, dest device and the serialized packet
+    // to the buffer of the destination rank
+    PacketRecordHeader header{};
+    header.rxTime = rxTime.GetInteger();
+    header.node = node;
+    header.dev = dev;
+    header.size = p->GetSerializedSize();
+
+    std::vector<uint8_t>& buffer = g_txBuffers[nodeSysId];
+    std::size_t offset = buffer.size();
+    buffer.resize(offset + sizeof(header) + PadRecord(header.size));
+    std::memcpy(buffer.data() + offset, &header, sizeof(header));
+    p->Serialize(buffer.data() + offset + sizeof(header), header.size);
+}
+
+void
+GrantedTimeWindowMpiInterface::FlushSendBuffers()
+{
+    NS_LOG_FUNCTION_NOARGS();
+
+    for (uint32_t rank = 0; rank < g_txBuffers.size(); ++rank)
+    {
+        std::vector<uint8_t>& buffer = g_txBuffers[rank];
+        if (buffer.empty())
+        {
+            continue;
+        }
+
+        SentBuffer sendBuf;
+        g_pendingTx.push_back(sendBuf);
+        auto i = g_pendingTx.rbegin(); // Points to the last element
+
+        auto data = new uint8_t[buffer.size()];
+        std::memcpy(data, buffer.data(), buffer.size());
+        i->SetBuffer(data);
+
+        MPI_Isend(reinterpret_cast<void*>(i->GetBuffer()),
+                  buffer.size(),
+                  MPI_CHAR,
+                  rank,
+                  0,
+                  g_communicator,
+                  (i->GetRequest()));
+        g_txCount++;
+        buffer.clear();
+    }
 }
 
 void
@@ -241,66 +276,65 @@ GrantedTimeWindowMpiInterface::ReceiveMessages()
 {
     NS_LOG_FUNCTION_NOARGS();
 
-    // Poll the non-block reads to see if data arrived
+    // Poll for arrived messages, of any size
     while (true)
     {
         int flag = 0;
-        int index = 0;
         MPI_Status status;
 
-        MPI_Testany(MpiInterface::GetSize(), g_requests, &index, &flag, &status);
+        MPI_Iprobe(MPI_ANY_SOURCE, 0, g_communicator, &flag, &status);
         if (!flag)
         {
             break; // No more messages
         }
         int count;
         MPI_Get_count(&status, MPI_CHAR, &count);
+        g_rxBuffer.resize(count);
+        MPI_Recv(g_rxBuffer.data(),
+                 count,
+                 MPI_CHAR,
+                 status.MPI_SOURCE,
+                 0,
+                 g_communicator,
+                 MPI_STATUS_IGNORE);
         g_rxCount++; // Count this receive
 
-        // Get the meta data first
-        auto pTime = reinterpret_cast<uint64_t*>(g_pRxBuffers[index]);
-        uint64_t time = *pTime++;
-        auto pData = reinterpret_cast<uint32_t*>(pTime);
-        uint32_t node = *pData++;
-        uint32_t dev = *pData++;
-
-        Time rxTime(time);
-
-        count -= sizeof(time) + sizeof(node) + sizeof(dev);
-
-        Ptr<Packet> p = Create<Packet>(reinterpret_cast<uint8_t*>(pData), count, true);
-
-        // Find the correct node/device to schedule receive event
-        Ptr<Node> pNode = NodeList::GetNode(node);
-        Ptr<MpiReceiver> pMpiRec = nullptr;
-        uint32_t nDevices = pNode->GetNDevices();
-        for (uint32_t i = 0; i < nDevices; ++i)
+        std::size_t offset = 0;
+        while (offset < g_rxBuffer.size())
         {
-            Ptr<NetDevice> pThisDev = pNode->GetDevice(i);
-            if (pThisDev->GetIfIndex() == dev)
+            // Get the meta data first
+            PacketRecordHeader header;
+            std::memcpy(&header, g_rxBuffer.data() + offset, sizeof(header));
+            offset += sizeof(header);
+            NS_ASSERT(offset + header.size <= g_rxBuffer.size());
+
+            Time rxTime(header.rxTime);
+            Ptr<Packet> p = Create<Packet>(g_rxBuffer.data() + offset, header.size, true);
+            offset += PadRecord(header.size);
+
+            // Find the correct node/device to schedule receive event
+            Ptr<Node> pNode = NodeList::GetNode(header.node);
+            Ptr<MpiReceiver> pMpiRec = nullptr;
+            uint32_t nDevices = pNode->GetNDevices();
+            for (uint32_t i = 0; i < nDevices; ++i)
             {
-                pMpiRec = pThisDev->GetObject<MpiReceiver>();
-                break;
+                Ptr<NetDevice> pThisDev = pNode->GetDevice(i);
+                if (pThisDev->GetIfIndex() == header.dev)
+                {
+                    pMpiRec = pThisDev->GetObject<MpiReceiver>();
+                    break;
+                }
             }
-        }
-
-        NS_ASSERT(pNode && pMpiRec);
 
-        // Schedule the rx event
-        Simulator::ScheduleWithContext(pNode->GetId(),
-                                       rxTime - Simulator::Now(),
-                                       &MpiReceiver::Receive,
-                                       pMpiRec,
-                                       p);
+            NS_ASSERT(pNode && pMpiRec);
 
-        // Re-queue the next read
-        MPI_Irecv(g_pRxBuffers[index],
-                  MAX_MPI_MSG_SIZE,
-                  MPI_CHAR,
-                  MPI_ANY_SOURCE,
-                  0,
-                  g_communicator,
-                  &g_requests[index]);
+            // Schedule the rx event
+            Simulator::ScheduleWithContext(pNode->GetId(),
+                                           rxTime - Simulator::Now(),
+                                           &MpiReceiver::Receive,
+                                           pMpiRec,
+                                           p);
+        }
     }
 }
 
@@ -24,16 +24,11 @@
 #include <list>
 #include <mpi.h>
 #include <stdint.h>
+#include <vector>
 
 namespace ns3
 {
 
-/**
- * maximum MPI message size for easy
- * buffer creation
- */
-const uint32_t MAX_MPI_MSG_SIZE = 2000;
-
 /**
  * @ingroup mpi
  *
@@ -77,6 +72,12 @@ class DistributedSimulatorImpl;
  * Implements the interface used by the singleton parallel controller
  * to interface between NS3 and the communications layer being
  * used for inter-task packet transfers.
+ *
+ * The packets sent to a rank are aggregated in a buffer, and the buffer
+ * is sent in a single MPI message, of any size, when the rank takes part
+ * in the next LBTS computation.  A message holds a sequence of records,
+ * each with the receive time, the destination node and device, and the
+ * serialized packet.
  */
 class GrantedTimeWindowMpiInterface : public ParallelCommunicationInterface, Object
 {
@@ -111,16 +112,20 @@ class GrantedTimeWindowMpiInterface : public ParallelCommunicationInterface, Obj
      * Check for received messages complete
      */
     static void ReceiveMessages();
+    /**
+     * Send the packets aggregated for each rank, in one message per rank
+     */
+    static void FlushSendBuffers();
     /**
      * Check for completed sends
      */
     static void TestSendComplete();
     /**
-     * @return received count in packets
+     * @return received count in messages
      */
     static uint32_t GetRxCount();
     /**
-     * @return transmitted count in packets
+     * @return transmitted count in messages
      */
     static uint32_t GetTxCount();
 
@@ -129,10 +134,10 @@ class GrantedTimeWindowMpiInterface : public ParallelCommunicationInterface, Obj
     /** Size of the MPI COM_WORLD group. */
     static uint32_t g_size;
 
-    /** Total packets received. */
+    /** Total messages received. */
     static uint32_t g_rxCount;
 
-    /** Total packets sent. */
+    /** Total messages sent. */
     static uint32_t g_txCount;
 
     /** Has this interface been enabled. */
@@ -144,11 +149,11 @@ class GrantedTimeWindowMpiInterface : public ParallelCommunicationInterface, Obj
      */
     static bool g_mpiInitCalled;
 
-    /** Pending non-blocking receives. */
-    static MPI_Request* g_requests;
+    /** Packets not sent yet, aggregated per destination rank. */
+    static std::vector<std::vector<uint8_t>> g_txBuffers;
 
-    /** Data buffers for non-blocking reads. */
-    static char** g_pRxBuffers;
+    /** Data buffer for the received messages. */
+    static std::vector<uint8_t> g_rxBuffer;
 
     /** List of pending non-blocking sends. */
     static std::list<SentBuffer> g_pendingTx;
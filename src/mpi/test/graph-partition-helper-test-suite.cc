@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/graph-partition-helper.h"
+#include "ns3/node.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+
+using namespace ns3;
+
+/**
+ * @ingroup mpi-tests
+ *
+ * Check that the links of shorter delays are not cut, unless the ranks
+ * cannot be balanced otherwise.
+ */
+class GraphPartitionLookaheadTestCase : public TestCase
+{
+  public:
+    GraphPartitionLookaheadTestCase();
+    void DoRun() override;
+
+  private:
+    /**
+     * Build two clusters of nodes joined by 1 ms links, and joined to each
+     * other by a 20 ms link.
+     *
+     * @param [in,out] partition The partition helper.
+     * @param [in] sizeA The number of nodes of the first cluster.
+     * @param [in] sizeB The number of nodes of the second cluster.
+     */
+    void BuildClusters(GraphPartitionHelper& partition, uint32_t sizeA, uint32_t sizeB);
+};
+
+GraphPartitionLookaheadTestCase::GraphPartitionLookaheadTestCase()
+    : TestCase("Check the lookahead of the partition")
+{
+}
+
+void
+GraphPartitionLookaheadTestCase::BuildClusters(GraphPartitionHelper& partition,
+                                               uint32_t sizeA,
+                                               uint32_t sizeB)
+{
+    for (uint32_t i = 0; i < sizeA + sizeB; ++i)
+    {
+        partition.AddNode();
+    }
+    for (uint32_t i = 1; i < sizeA + sizeB; ++i)
+    {
+        partition.AddLink(i - 1, i, i == sizeA ? MilliSeconds(20) : MilliSeconds(1));
+    }
+}
+
+void
+GraphPartitionLookaheadTestCase::DoRun()
+{
+    GraphPartitionHelper balanced;
+    BuildClusters(balanced, 4, 4);
+    balanced.Partition(2);
+    NS_TEST_EXPECT_MSG_EQ(balanced.GetLookahead(), MilliSeconds(20), "Unexpected lookahead");
+    NS_TEST_EXPECT_MSG_EQ(balanced.GetCutLinks(), 1, "Only the 20 ms link should be cut");
+    NS_TEST_EXPECT_MSG_EQ(balanced.GetLoad(0), 4, "Unexpected load of rank 0");
+    NS_TEST_EXPECT_MSG_EQ(balanced.GetLoad(1), 4, "Unexpected load of rank 1");
+
+    // 6 and 2 nodes cannot be balanced within 5% without cutting a 1 ms link
+    GraphPartitionHelper unbalanced;
+    BuildClusters(unbalanced, 6, 2);
+    unbalanced.Partition(2);
+    NS_TEST_EXPECT_MSG_EQ(unbalanced.GetLookahead(), MilliSeconds(1), "Unexpected lookahead");
+    NS_TEST_EXPECT_MSG_EQ(unbalanced.GetCutLinks(), 1, "Unexpected number of links cut");
+    NS_TEST_EXPECT_MSG_EQ(unbalanced.GetLoad(0), 4, "Unexpected load of rank 0");
+    NS_TEST_EXPECT_MSG_EQ(unbalanced.GetLoad(1), 4, "Unexpected load of rank 1");
+
+    // unless the imbalance tolerance allows it
+    GraphPartitionHelper tolerant;
+    BuildClusters(tolerant, 6, 2);
+    tolerant.SetImbalance(0.5);
+    tolerant.Partition(2);
+    NS_TEST_EXPECT_MSG_EQ(tolerant.GetLookahead(), MilliSeconds(20), "Unexpected lookahead");
+    NS_TEST_EXPECT_MSG_EQ(std::max(tolerant.GetLoad(0), tolerant.GetLoad(1)),
+                          6,
+                          "Unexpected load of the most loaded rank");
+}
+
+/**
+ * @ingroup mpi-tests
+ *
+ * Check that the partition avoids cutting the links of heavy traffic.
+ */
+class GraphPartitionTrafficTestCase : public TestCase
+{
+  public:
+    GraphPartitionTrafficTestCase();
+    void DoRun() override;
+};
+
+GraphPartitionTrafficTestCase::GraphPartitionTrafficTestCase()
+    : TestCase("Check the traffic cut by the partition")
+{
+}
+
+void
+GraphPartitionTrafficTestCase::DoRun()
+{
+    // A ring of 8 nodes, where all the links but two carry heavy traffic
+    GraphPartitionHelper partition;
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        partition.AddNode();
+    }
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        partition.AddLink(i, (i + 1) % 8, MilliSeconds(10), (i == 1 || i == 5) ? 1 : 100);
+    }
+    partition.Partition(2);
+    NS_TEST_EXPECT_MSG_EQ(partition.GetCutLinks(), 2, "Unexpected number of links cut");
+    NS_TEST_EXPECT_MSG_EQ(partition.GetCutTraffic(), 2, "The light links should be cut");
+    NS_TEST_EXPECT_MSG_EQ(partition.GetLoad(0), 4, "Unexpected load of rank 0");
+    NS_TEST_EXPECT_MSG_EQ(partition.GetSystemId(2),
+                          partition.GetSystemId(5),
+                          "Nodes 2 to 5 should be on the same rank");
+}
+
+/**
+ * @ingroup mpi-tests
+ *
+ * Check the balance and the determinism of the partition of a grid, and
+ * the nodes created with their system ids.
+ */
+class GraphPartitionGridTestCase : public TestCase
+{
+  public:
+    GraphPartitionGridTestCase();
+    void DoRun() override;
+};
+
+GraphPartitionGridTestCase::GraphPartitionGridTestCase()
+    : TestCase("Check the partition of a grid")
+{
+}
+
+void
+GraphPartitionGridTestCase::DoRun()
+{
+    const uint32_t side = 30;
+    const uint32_t nParts = 6;
+    GraphPartitionHelper partitions[2];
+    for (auto& partition : partitions)
+    {
+        for (uint32_t i = 0; i < side * side; ++i)
+        {
+            partition.AddNode();
+        }
+        for (uint32_t row = 0; row < side; ++row)
+        {
+            for (uint32_t col = 0; col < side; ++col)
+            {
+                uint32_t node = row * side + col;
+                if (col + 1 < side)
+                {
+                    partition.AddLink(node, node + 1, MilliSeconds(5));
+                }
+                if (row + 1 < side)
+                {
+                    partition.AddLink(node, node + side, MilliSeconds(5));
+                }
+            }
+        }
+    }
+
+    std::vector<uint32_t> systemIds = partitions[0].Partition(nParts);
+    NS_TEST_EXPECT_MSG_EQ((systemIds == partitions[1].Partition(nParts)),
+                          true,
+                          "The partition should be deterministic");
+    for (uint32_t part = 0; part < nParts; ++part)
+    {
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(partitions[0].GetLoad(part),
+                                    side * side / nParts * 1.05,
+                                    "Rank " << part << " is overloaded");
+    }
+    // a good partition cuts a few lines of the grid, not a scattering of nodes
+    NS_TEST_EXPECT_MSG_LT(partitions[0].GetCutLinks(), 4 * side, "Too many links cut");
+    NS_TEST_EXPECT_MSG_EQ(partitions[0].GetLookahead(), MilliSeconds(5), "Unexpected lookahead");
+
+    NodeContainer nodes = partitions[0].CreateNodes();
+    NS_TEST_ASSERT_MSG_EQ(nodes.GetN(), side * side, "Unexpected number of nodes");
+    for (uint32_t i = 0; i < nodes.GetN(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(nodes.Get(i)->GetSystemId(),
+                              systemIds[i],
+                              "Unexpected system id of node " << i);
+    }
+    Simulator::Destroy();
+}
+
+/**
+ * @ingroup mpi-tests
+ *
+ * @brief Graph partition helper TestSuite
+ */
+class GraphPartitionHelperTestSuite : public TestSuite
+{
+  public:
+    GraphPartitionHelperTestSuite()
+        : TestSuite("graph-partition-helper", Type::UNIT)
+    {
+        AddTestCase(new GraphPartitionLookaheadTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new GraphPartitionTrafficTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new GraphPartitionGridTestCase(), TestCase::Duration::QUICK);
+    }
+};
+
+static GraphPartitionHelperTestSuite g_graphPartitionHelperTestSuite; //!< The test suite
@@ -72,6 +72,7 @@ NodeContainer::Get(uint32_t i) const
 void
 NodeContainer::Create(uint32_t n)
 {
+    m_nodes.reserve(m_nodes.size() + n);
     for (uint32_t i = 0; i < n; i++)
     {
         m_nodes.push_back(CreateObject<Node>());
@@ -81,6 +82,7 @@ NodeContainer::Create(uint32_t n)
 void
 NodeContainer::Create(uint32_t n, uint32_t systemId)
 {
+    m_nodes.reserve(m_nodes.size() + n);
     for (uint32_t i = 0; i < n; i++)
     {
         m_nodes.push_back(CreateObject<Node>(systemId));
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "pcapng-helper.h"
+
+#include "trace-helper.h"
+
+#include "ns3/abort.h"
+#include "ns3/async-file-buffer.h"
+#include "ns3/log.h"
+#include "ns3/names.h"
+#include "ns3/net-device.h"
+#include "ns3/node.h"
+#include "ns3/packet-annotation-tag.h"
+#include "ns3/simulator.h"
+
+#include <sstream>
+#include <string_view>
+#include <utility>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PcapNgHelper");
+
+PcapNgHelper::PcapNgHelper()
+{
+    NS_LOG_FUNCTION(this);
+    m_dataLinkTypes["ns3::PointToPointNetDevice"] = PcapHelper::DLT_PPP;
+    m_dataLinkTypes["ns3::CsmaNetDevice"] = PcapHelper::DLT_EN10MB;
+    m_dataLinkTypes["ns3::FdNetDevice"] = PcapHelper::DLT_EN10MB;
+}
+
+void
+PcapNgHelper::SetDataLinkType(const std::string& deviceType, uint32_t dataLinkType)
+{
+    NS_LOG_FUNCTION(this << deviceType << dataLinkType);
+    m_dataLinkTypes[deviceType] = dataLinkType;
+}
+
+Ptr<PcapNgFile>
+PcapNgHelper::EnablePcapNg(const std::string& filename, Ptr<Node> node)
+{
+    NS_LOG_FUNCTION(this << filename << node);
+    Ptr<PcapNgFile> file = Create<PcapNgFile>();
+    if (auto buffer = AsyncFileBuffer::CreateForTrace(filename, std::ios::out))
+    {
+        file->Open(std::move(buffer));
+    }
+    else
+    {
+        file->Open(filename);
+    }
+    NS_ABORT_MSG_IF(file->Fail(), "Unable to Open " << filename);
+
+    for (uint32_t i = 0; i < node->GetNDevices(); ++i)
+    {
+        Ptr<NetDevice> device = node->GetDevice(i);
+        TypeId tid = device->GetInstanceTypeId();
+        auto it = m_dataLinkTypes.find(tid.GetName());
+        if (it == m_dataLinkTypes.end() || !tid.LookupTraceSourceByName("PromiscSniffer"))
+        {
+            NS_LOG_INFO("Device " << i << " of node " << node->GetId() << " is not traced");
+            continue;
+        }
+        std::ostringstream name;
+        name << "/NodeList/" << node->GetId() << "/DeviceList/" << i;
+        uint32_t interfaceId = file->AddInterface(it->second, name.str(), tid.GetName());
+        device->TraceConnectWithoutContext("PromiscSniffer",
+                                           MakeBoundCallback(&PcapNgHelper::Sink,
+                                                             file,
+                                                             interfaceId));
+    }
+    return file;
+}
+
+void
+PcapNgHelper::EnablePcapNg(const std::string& prefix, NodeContainer nodes)
+{
+    NS_LOG_FUNCTION(this << prefix);
+    for (auto i = nodes.Begin(); i != nodes.End(); ++i)
+    {
+        std::string name = Names::FindName(*i);
+        EnablePcapNg(prefix + "-" + (name.empty() ? std::to_string((*i)->GetId()) : name) +
+                         ".pcapng",
+                     *i);
+    }
+}
+
+void
+PcapNgHelper::EnablePcapNgAll(const std::string& prefix)
+{
+    NS_LOG_FUNCTION(this << prefix);
+    EnablePcapNg(prefix, NodeContainer::GetGlobal());
+}
+
+void
+PcapNgHelper::Sink(Ptr<PcapNgFile> file, uint32_t interfaceId, Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(file << interfaceId << p);
+    PacketAnnotationTag tag;
+    char comment[128];
+    uint32_t length = 0;
+    if (p->PeekPacketTag(tag))
+    {
+        length = tag.Format(comment, sizeof(comment));
+    }
+    file->Write(interfaceId,
+                Simulator::Now().GetNanoSeconds(),
+                p,
+                std::string_view(comment, length));
+}
+
+} // namespace ns3
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PCAPNG_HELPER_H
+#define PCAPNG_HELPER_H
+
+#include "node-container.h"
+
+#include "ns3/pcapng-file.h"
+
+#include <map>
+#include <string>
+
+namespace ns3
+{
+
+class NetDevice;
+
+/**
+ * @ingroup network
+ *
+ * @brief Write a pcapng file per node, with all the devices of the node.
+ *
+ * The packets seen by the "PromiscSniffer" trace source of the devices are
+ * written in the file of their node, with one interface per device, named
+ * after the configuration path of the device.  The values of the
+ * PacketAnnotationTag of the packets (e.g., the queue disc sojourn time, or
+ * the TCP congestion window) are written as the comments of their records.
+ *
+ * The data link type of a device is found from its TypeId; the devices of
+ * an unknown type, and those without a "PromiscSniffer" trace source, are
+ * not traced.
+ */
+class PcapNgHelper
+{
+  public:
+    /**
+     * @brief Create a pcapng helper, which knows the data link types of the
+     * point-to-point, CSMA and file descriptor devices.
+     */
+    PcapNgHelper();
+
+    /**
+     * @brief Set the data link type of a device type.
+     *
+     * @param deviceType The name of the TypeId of the devices, e.g. "ns3::CsmaNetDevice".
+     * @param dataLinkType The data link type of their packets (see PcapHelper::DataLinkType).
+     */
+    void SetDataLinkType(const std::string& deviceType, uint32_t dataLinkType);
+
+    /**
+     * @brief Enable the pcapng trace of a node.
+     *
+     * @param filename The name of the file.
+     * @param node The node.
+     * @returns The file.
+     */
+    Ptr<PcapNgFile> EnablePcapNg(const std::string& filename, Ptr<Node> node);
+
+    /**
+     * @brief Enable the pcapng traces of nodes, in files named
+     * prefix-node.pcapng, with the name or the identifier of the node.
+     *
+     * @param prefix The prefix of the file names.
+     * @param nodes The nodes.
+     */
+    void EnablePcapNg(const std::string& prefix, NodeContainer nodes);
+
+    /**
+     * @brief Enable the pcapng traces of all the nodes.
+     *
+     * @param prefix The prefix of the file names.
+     */
+    void EnablePcapNgAll(const std::string& prefix);
+
+    /**
+     * @brief The trace sink of the devices: write a packet, with its
+     * annotations as comment.
+     *
+     * @param file The file.
+     * @param interfaceId The interface of the device.
+     * @param p The packet.
+     */
+    static void Sink(Ptr<PcapNgFile> file, uint32_t interfaceId, Ptr<const Packet> p);
+
+  private:
+    std::map<std::string, uint32_t> m_dataLinkTypes; //!< The data link types, by device type
+};
+
+} // namespace ns3
+
+#endif /* PCAPNG_HELPER_H */
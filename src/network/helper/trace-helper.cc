@@ -7,6 +7,7 @@
 #include "trace-helper.h"
 
 #include "ns3/abort.h"
+#include "ns3/async-file-buffer.h"
 #include "ns3/assert.h"
 #include "ns3/log.h"
 #include "ns3/names.h"
@@ -18,6 +19,7 @@
 #include <cstdint>
 #include <fstream>
 #include <string>
+#include <utility>
 
 namespace ns3
 {
@@ -44,7 +46,14 @@ PcapHelper::CreateFile(std::string filename,
     NS_LOG_FUNCTION(filename << filemode << dataLinkType << snapLen << tzCorrection);
 
     Ptr<PcapFileWrapper> file = CreateObject<PcapFileWrapper>();
-    file->Open(filename, filemode);
+    if (auto buffer = AsyncFileBuffer::CreateForTrace(filename, filemode))
+    {
+        file->Open(std::move(buffer));
+    }
+    else
+    {
+        file->Open(filename, filemode);
+    }
     NS_ABORT_MSG_IF(file->Fail(), "Unable to Open " << filename << " for mode " << filemode);
 
     file->Init(dataLinkType, snapLen, tzCorrection);
@@ -183,7 +192,18 @@ AsciiTraceHelper::CreateFileStream(std::string filename, std::ios::openmode file
 {
     NS_LOG_FUNCTION(filename << filemode);
 
-    Ptr<OutputStreamWrapper> StreamWrapper = Create<OutputStreamWrapper>(filename, filemode);
+    Ptr<OutputStreamWrapper> StreamWrapper;
+    if (auto buffer = AsyncFileBuffer::CreateForTrace(filename, filemode))
+    {
+        NS_ABORT_MSG_UNLESS(buffer->IsOpen(),
+                            "AsciiTraceHelper::CreateFileStream(): Unable to Open "
+                                << filename << " for mode " << filemode);
+        StreamWrapper = Create<OutputStreamWrapper>(std::move(buffer));
+    }
+    else
+    {
+        StreamWrapper = Create<OutputStreamWrapper>(filename, filemode);
+    }
 
     //
     // Note that the ascii trace helper promptly forgets all about the trace file.
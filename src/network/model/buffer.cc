@@ -43,47 +43,58 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("Buffer");
 
-uint32_t Buffer::g_recommendedStart = 0;
+thread_local uint32_t Buffer::g_recommendedStart = 0;
 #ifdef BUFFER_FREE_LIST
-/* The following macros are pretty evil but they are needed to allow us to
- * keep track of 3 possible states for the g_freeList variable:
- *  - uninitialized means that no one has created a buffer yet
- *    so no one has created the associated free list (it is created
- *    on-demand when the first buffer is created)
- *  - initialized means that the free list exists and is valid
- *  - destroyed means that the static destructors of this compilation unit
- *    have run so, the free list has been cleared from its content
- * The key is that in destroyed state, we are careful not re-create it
- * which is a typical weakness of lazy evaluation schemes which use
- * '0' as a special value to indicate both un-initialized and destroyed.
- * Note that it is important to use '0' as the marker for un-initialized state
- * because the variable holding this state information is initialized to zero
- * which the compiler assigns to zero-memory which is initialized to _zero_
- * before the constructors run so this ensures perfect handling of crazy
- * constructor orderings.
+/** Maximum number of data storage blocks kept in the pool of a thread. */
+constexpr std::size_t FREE_LIST_SIZE = 1000;
+
+/**
+ * The pool of buffer data storage of a thread.
+ *
+ * Since each thread has its own pool, the Buffers of different threads
+ * never share it.  Data storage released by another thread than the
+ * one which created it simply moves to the pool of the releasing thread.
  */
-#define MAGIC_DESTROYED (~(long)0)
-#define IS_UNINITIALIZED(x) (x == (Buffer::FreeList*)0)
-#define IS_DESTROYED(x) (x == (Buffer::FreeList*)MAGIC_DESTROYED)
-#define IS_INITIALIZED(x) (!IS_UNINITIALIZED(x) && !IS_DESTROYED(x))
-#define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
-#define UNINITIALIZED ((Buffer::FreeList*)0)
-uint32_t Buffer::g_maxSize = 0;
-Buffer::FreeList* Buffer::g_freeList = nullptr;
-Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
-
-Buffer::LocalStaticDestructor::~LocalStaticDestructor()
+struct Buffer::Pool
 {
-    NS_LOG_FUNCTION(this);
-    if (IS_INITIALIZED(g_freeList))
+    /** Destructor: release the pooled data storage. */
+    ~Pool();
+
+    std::vector<Buffer::Data*> freeList; //!< Released data storage
+    uint32_t maxSize{0};                 //!< Max observed data size
+    PoolStats stats{0, 0, 0, 0};         //!< Statistics
+};
+
+namespace
+{
+
+/**
+ * Set when the pool of the current thread has been destroyed, so buffers
+ * released later during thread (or program) exit go back to the heap.
+ */
+thread_local bool g_poolDestroyed = false;
+
+} // namespace
+
+Buffer::Pool::~Pool()
+{
+    g_poolDestroyed = true;
+    for (auto data : freeList)
     {
-        for (auto i = g_freeList->begin(); i != g_freeList->end(); i++)
-        {
-            Buffer::Deallocate(*i);
-        }
-        delete g_freeList;
-        g_freeList = DESTROYED;
+        Buffer::Deallocate(data);
     }
+    freeList.clear();
+}
+
+Buffer::Pool*
+Buffer::GetPool()
+{
+    if (g_poolDestroyed)
+    {
+        return nullptr;
+    }
+    static thread_local Pool pool;
+    return &pool;
 }
 
 void
@@ -91,17 +102,22 @@ Buffer::Recycle(Buffer::Data* data)
 {
     NS_LOG_FUNCTION(data);
     NS_ASSERT(data->m_count == 0);
-    NS_ASSERT(!IS_UNINITIALIZED(g_freeList));
-    g_maxSize = std::max(g_maxSize, data->m_size);
+    Pool* pool = GetPool();
+    if (pool == nullptr)
+    {
+        Buffer::Deallocate(data);
+        return;
+    }
+    pool->stats.releases++;
+    pool->maxSize = std::max(pool->maxSize, data->m_size);
     /* feed into free list */
-    if (data->m_size < g_maxSize || IS_DESTROYED(g_freeList) || g_freeList->size() > 1000)
+    if (data->m_size < pool->maxSize || pool->freeList.size() >= FREE_LIST_SIZE)
     {
         Buffer::Deallocate(data);
     }
     else
     {
-        NS_ASSERT(IS_INITIALIZED(g_freeList));
-        g_freeList->push_back(data);
+        pool->freeList.push_back(data);
     }
 }
 
@@ -109,19 +125,18 @@ Buffer::Data*
 Buffer::Create(uint32_t dataSize)
 {
     NS_LOG_FUNCTION(dataSize);
-    /* try to find a buffer correctly sized. */
-    if (IS_UNINITIALIZED(g_freeList))
-    {
-        g_freeList = new Buffer::FreeList();
-    }
-    else if (IS_INITIALIZED(g_freeList))
+    Pool* pool = GetPool();
+    if (pool != nullptr)
     {
-        while (!g_freeList->empty())
+        pool->stats.allocations++;
+        /* try to find a buffer correctly sized. */
+        while (!pool->freeList.empty())
         {
-            Buffer::Data* data = g_freeList->back();
-            g_freeList->pop_back();
+            Buffer::Data* data = pool->freeList.back();
+            pool->freeList.pop_back();
             if (data->m_size >= dataSize)
             {
+                pool->stats.poolHits++;
                 data->m_count = 1;
                 return data;
             }
@@ -132,6 +147,19 @@ Buffer::Create(uint32_t dataSize)
     NS_ASSERT(data->m_count == 1);
     return data;
 }
+
+Buffer::PoolStats
+Buffer::GetPoolStats()
+{
+    Pool* pool = GetPool();
+    if (pool == nullptr)
+    {
+        return {0, 0, 0, 0};
+    }
+    PoolStats stats = pool->stats;
+    stats.pooled = pool->freeList.size();
+    return stats;
+}
 #else  /* BUFFER_FREE_LIST */
 void
 Buffer::Recycle(Buffer::Data* data)
@@ -147,6 +175,12 @@ Buffer::Create(uint32_t size)
     NS_LOG_FUNCTION(size);
     return Allocate(size);
 }
+
+Buffer::PoolStats
+Buffer::GetPoolStats()
+{
+    return {0, 0, 0, 0};
+}
 #endif /* BUFFER_FREE_LIST */
 
 constexpr uint32_t ALLOC_OVER_PROVISION = 100; //!< Additional bytes to over-provision.
@@ -396,15 +430,20 @@ Buffer::AddAtEnd(const Buffer& o)
 {
     NS_LOG_FUNCTION(this << &o);
 
-    if (m_data->m_count == 1 && (m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd) &&
-        m_end == m_data->m_dirtyEnd && o.m_start == o.m_zeroAreaStart &&
-        o.m_zeroAreaEnd - o.m_zeroAreaStart > 0)
+    if ((m_end == m_zeroAreaEnd || m_zeroAreaStart == m_zeroAreaEnd) &&
+        o.m_start == o.m_zeroAreaStart && o.m_zeroAreaEnd - o.m_zeroAreaStart > 0)
     {
         /**
          * This is an optimization which kicks in when
          * we attempt to aggregate two buffers which contain
          * adjacent zero areas.
          */
+        if (m_data->m_count != 1 || m_end != m_data->m_dirtyEnd)
+        {
+            // The zero area is about to be extended: stop sharing the
+            // internal data, without writing the zero area.
+            *this = CreateCompactCopy();
+        }
         if (m_zeroAreaStart == m_zeroAreaEnd)
         {
             m_zeroAreaStart = m_end;
@@ -424,12 +463,48 @@ Buffer::AddAtEnd(const Buffer& o)
         return;
     }
 
-    *this = CreateFullCopy();
-    AddAtEnd(o.GetSize());
-    Buffer::Iterator destStart = End();
-    destStart.Prev(o.GetSize());
-    destStart.Write(o.Begin(), o.End());
-    NS_ASSERT(CheckInternalState());
+    if (o.m_zeroAreaEnd == o.m_zeroAreaStart && m_data != o.m_data)
+    {
+        /**
+         * The other buffer holds real bytes only: append them after
+         * our own, whose zero area, if any, stays virtual.
+         */
+        AddAtEnd(o.GetSize());
+        Buffer::Iterator destStart = End();
+        destStart.Prev(o.GetSize());
+        destStart.Write(o.Begin(), o.End());
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+
+    if (m_zeroAreaEnd == m_zeroAreaStart && m_data != o.m_data)
+    {
+        /**
+         * This buffer holds real bytes only: prepend them to the other
+         * buffer, whose zero area stays virtual.
+         */
+        Buffer tmp = o;
+        tmp.AddAtStart(GetSize());
+        tmp.Begin().Write(Begin(), End());
+        *this = tmp;
+        NS_ASSERT(CheckInternalState());
+        return;
+    }
+
+    /**
+     * Either both buffers have a zero area, with real bytes between
+     * them, or they share the same internal data.  Write our zero area,
+     * or just copy our internal data, and try again.
+     */
+    if (m_zeroAreaEnd != m_zeroAreaStart)
+    {
+        *this = CreateFullCopy();
+    }
+    else
+    {
+        *this = CreateCompactCopy();
+    }
+    AddAtEnd(o);
 }
 
 void
@@ -551,6 +626,24 @@ Buffer::CreateFullCopy() const
     return *this;
 }
 
+Buffer
+Buffer::CreateCompactCopy() const
+{
+    NS_LOG_FUNCTION(this);
+    NS_ASSERT(CheckInternalState());
+    Buffer tmp(m_zeroAreaEnd - m_zeroAreaStart);
+    uint32_t dataStart = m_zeroAreaStart - m_start;
+    tmp.AddAtStart(dataStart);
+    tmp.Begin().Write(m_data->m_data + m_start, dataStart);
+    uint32_t dataEnd = m_end - m_zeroAreaEnd;
+    tmp.AddAtEnd(dataEnd);
+    Buffer::Iterator i = tmp.End();
+    i.Prev(dataEnd);
+    i.Write(m_data->m_data + m_zeroAreaStart, dataEnd);
+    NS_ASSERT(tmp.CheckInternalState());
+    return tmp;
+}
+
 uint32_t
 Buffer::GetSerializedSize() const
 {
@@ -741,14 +834,8 @@ Buffer::CopyData(uint8_t* buffer, uint32_t size) const
         if (size > 0)
         {
             tmpsize = std::min(m_zeroAreaEnd - m_zeroAreaStart, size);
-            uint32_t left = tmpsize;
-            while (left > 0)
-            {
-                uint32_t toWrite = std::min(left, g_zeroes.size);
-                memcpy(buffer, g_zeroes.buffer, toWrite);
-                left -= toWrite;
-                buffer += toWrite;
-            }
+            memset(buffer, 0, tmpsize);
+            buffer += tmpsize;
             size -= tmpsize;
             if (size > 0)
             {
@@ -821,25 +908,36 @@ Buffer::Iterator::Write(Iterator start, Iterator end)
     NS_ASSERT(m_data != start.m_data);
     uint32_t size = end.m_current - start.m_current;
     NS_ASSERT_MSG(CheckNoZero(m_current, m_current + size), GetWriteErrorMessage());
+    // The destination does not overlap our zero area, but may follow it.
+    uint8_t* to;
+    if (m_current <= m_zeroStart)
+    {
+        to = &m_data[m_current];
+    }
+    else
+    {
+        to = &m_data[m_current - (m_zeroEnd - m_zeroStart)];
+    }
     if (start.m_current <= start.m_zeroStart)
     {
         uint32_t toCopy = std::min(size, start.m_zeroStart - start.m_current);
-        memcpy(&m_data[m_current], &start.m_data[start.m_current], toCopy);
+        memcpy(to, &start.m_data[start.m_current], toCopy);
         start.m_current += toCopy;
         m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     if (start.m_current <= start.m_zeroEnd)
     {
         uint32_t toCopy = std::min(size, start.m_zeroEnd - start.m_current);
-        memset(&m_data[m_current], 0, toCopy);
+        memset(to, 0, toCopy);
         start.m_current += toCopy;
         m_current += toCopy;
+        to += toCopy;
         size -= toCopy;
     }
     uint32_t toCopy = std::min(size, start.m_dataEnd - start.m_current);
     uint8_t* from = &start.m_data[start.m_current - (start.m_zeroEnd - start.m_zeroStart)];
-    uint8_t* to = &m_data[m_current];
     memcpy(to, from, toCopy);
     m_current += toCopy;
 }
@@ -32,6 +32,11 @@ namespace ns3
  * The correct maximum size is learned at runtime during use by
  * recording the maximum size of each packet.
  *
+ * The data storage of the released buffers is kept in a pool, one
+ * per thread, for reuse by the next buffers created by the same
+ * thread.  GetPoolStats() reports the pool efficiency for the
+ * calling thread.
+ *
  * @internal
  * The implementation of the Buffer class uses a COW (Copy On Write)
  * technique to ensure that the underlying data buffer which holds
@@ -82,6 +87,15 @@ namespace ns3
 class Buffer
 {
   public:
+    /** Memory pool statistics, for the calling thread. */
+    struct PoolStats
+    {
+        uint64_t allocations; /**< Data storage requests. */
+        uint64_t poolHits;    /**< Requests served from the pool. */
+        uint64_t releases;    /**< Data storage released. */
+        uint64_t pooled;      /**< Data storage currently held in the pool. */
+    };
+
     /**
      * @brief iterator in a Buffer instance
      */
@@ -517,6 +531,10 @@ class Buffer
      * Add bytes at the end of the Buffer.
      * Any call to this method invalidates any Iterator
      * pointing to this Buffer.
+     *
+     * The zero areas of both buffers stay virtual whenever the result
+     * can be represented with a single zero area, that is, unless both
+     * buffers have a zero area and real bytes between them.
      */
     void AddAtEnd(const Buffer& o);
     /**
@@ -633,6 +651,12 @@ class Buffer
     Buffer(uint32_t dataSize, bool initialize);
     ~Buffer();
 
+    /**
+     * @brief Get the data storage pool statistics of the calling thread
+     * @returns the statistics
+     */
+    static PoolStats GetPoolStats();
+
   private:
     /**
      * This data structure is variable-sized through its last member whose size
@@ -684,6 +708,14 @@ class Buffer
      */
     Buffer CreateFullCopy() const;
 
+    /**
+     * @brief Create a copy of the buffer which does not share its
+     * internal data, but keeps the zero area virtual.
+     *
+     * @returns a copy of the buffer
+     */
+    Buffer CreateCompactCopy() const;
+
     /**
      * @brief Transform a "Virtual byte buffer" into a "Real byte buffer"
      */
@@ -758,7 +790,7 @@ class Buffer
      * writing data. i.e., m_start should be initialized to this
      * value.
      */
-    static uint32_t g_recommendedStart;
+    static thread_local uint32_t g_recommendedStart;
 
     /**
      * offset to the start of the virtual zero area from the start
@@ -782,18 +814,14 @@ class Buffer
     uint32_t m_end;
 
 #ifdef BUFFER_FREE_LIST
-    /// Container for buffer data
-    typedef std::vector<Buffer::Data*> FreeList;
+    /// Per-thread pool of buffer data storage
+    struct Pool;
 
-    /// Local static destructor structure
-    struct LocalStaticDestructor
-    {
-        ~LocalStaticDestructor();
-    };
-
-    static uint32_t g_maxSize;                            //!< Max observed data size
-    static FreeList* g_freeList;                          //!< Buffer data container
-    static LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
+    /**
+     * @brief Get the buffer data pool of the calling thread
+     * @returns the pool, or nullptr once it has been destroyed on thread exit
+     */
+    static Pool* GetPool();
 #endif
 };
 
@@ -38,30 +38,47 @@ struct ByteTagListData
 };
 
 #ifdef USE_FREE_LIST
+namespace
+{
+
 /**
  * @ingroup packet
  *
- * @brief Container class for struct ByteTagListData
+ * @brief The pool of struct ByteTagListData of a thread.
  *
  * Internal use only.
  */
-static class ByteTagListDataFreeList : public std::vector<ByteTagListData*>
+struct ByteTagListDataPool
 {
-  public:
-    ~ByteTagListDataFreeList();
-} g_freeList; //!< Container for struct ByteTagListData
+    /** Destructor: release the pooled data. */
+    ~ByteTagListDataPool();
+
+    std::vector<ByteTagListData*> freeList;   //!< Released ByteTagListData
+    uint32_t maxSize{0};                      //!< maximum data size (used for allocation)
+    ByteTagList::PoolStats stats{0, 0, 0, 0}; //!< Statistics
+};
 
-static uint32_t g_maxSize = 0; //!< maximum data size (used for allocation)
+/**
+ * Set when the pool of the current thread has been destroyed, so tag
+ * lists released later during thread (or program) exit go back to the heap.
+ */
+thread_local bool g_poolDestroyed = false;
+/** The ByteTagListData pool of the current thread. */
+thread_local ByteTagListDataPool g_pool;
 
-ByteTagListDataFreeList::~ByteTagListDataFreeList()
+ByteTagListDataPool::~ByteTagListDataPool()
 {
     NS_LOG_FUNCTION(this);
-    for (auto i = begin(); i != end(); i++)
+    g_poolDestroyed = true;
+    for (auto data : freeList)
     {
-        auto buffer = (uint8_t*)(*i);
+        auto buffer = (uint8_t*)data;
         delete[] buffer;
     }
+    freeList.clear();
 }
+
+} // namespace
 #endif /* USE_FREE_LIST */
 
 ByteTagList::Iterator::Item::Item(TagBuffer buf_)
@@ -344,21 +361,29 @@ ByteTagListData*
 ByteTagList::Allocate(uint32_t size)
 {
     NS_LOG_FUNCTION(this << size);
-    while (!g_freeList.empty())
+    uint32_t maxSize = size;
+    if (!g_poolDestroyed)
     {
-        ByteTagListData* data = g_freeList.back();
-        g_freeList.pop_back();
-        NS_ASSERT(data != nullptr);
-        if (data->size >= size)
+        ByteTagListDataPool& pool = g_pool;
+        pool.stats.allocations++;
+        while (!pool.freeList.empty())
         {
-            data->count = 1;
-            data->dirty = 0;
-            return data;
+            ByteTagListData* data = pool.freeList.back();
+            pool.freeList.pop_back();
+            NS_ASSERT(data != nullptr);
+            if (data->size >= size)
+            {
+                pool.stats.poolHits++;
+                data->count = 1;
+                data->dirty = 0;
+                return data;
+            }
+            auto buffer = (uint8_t*)data;
+            delete[] buffer;
         }
-        auto buffer = (uint8_t*)data;
-        delete[] buffer;
+        maxSize = std::max(size, pool.maxSize);
     }
-    auto buffer = new uint8_t[std::max(size, g_maxSize) + sizeof(ByteTagListData) - 4];
+    auto buffer = new uint8_t[maxSize + sizeof(ByteTagListData) - 4];
     auto data = (ByteTagListData*)buffer;
     data->count = 1;
     data->size = size;
@@ -374,22 +399,42 @@ ByteTagList::Deallocate(ByteTagListData* data)
     {
         return;
     }
-    g_maxSize = std::max(g_maxSize, data->size);
     data->count--;
     if (data->count == 0)
     {
-        if (g_freeList.size() > FREE_LIST_SIZE || data->size < g_maxSize)
+        if (g_poolDestroyed)
+        {
+            auto buffer = (uint8_t*)data;
+            delete[] buffer;
+            return;
+        }
+        ByteTagListDataPool& pool = g_pool;
+        pool.stats.releases++;
+        pool.maxSize = std::max(pool.maxSize, data->size);
+        if (pool.freeList.size() > FREE_LIST_SIZE || data->size < pool.maxSize)
         {
             auto buffer = (uint8_t*)data;
             delete[] buffer;
         }
         else
         {
-            g_freeList.push_back(data);
+            pool.freeList.push_back(data);
         }
     }
 }
 
+ByteTagList::PoolStats
+ByteTagList::GetPoolStats()
+{
+    if (g_poolDestroyed)
+    {
+        return {0, 0, 0, 0};
+    }
+    PoolStats stats = g_pool.stats;
+    stats.pooled = g_pool.freeList.size();
+    return stats;
+}
+
 #else /* USE_FREE_LIST */
 
 ByteTagListData*
@@ -420,6 +465,12 @@ ByteTagList::Deallocate(ByteTagListData* data)
     }
 }
 
+ByteTagList::PoolStats
+ByteTagList::GetPoolStats()
+{
+    return {0, 0, 0, 0};
+}
+
 #endif /* USE_FREE_LIST */
 
 uint32_t
@@ -50,10 +50,22 @@ struct ByteTagListData;
  *     the boundaries before returning item. However, when packet is extending,
  *     it calls ByteTagList::AddAtStart or ByteTagList::AddAtEnd to cut byte
  *     tags that will otherwise cover new bytes.
+ *
+ *   - The released ByteTagListData structures are kept in a pool, one per
+ *     thread, for reuse by the next lists of the same thread.
  */
 class ByteTagList
 {
   public:
+    /** Memory pool statistics, for the calling thread. */
+    struct PoolStats
+    {
+        uint64_t allocations; /**< Tag buffer allocations. */
+        uint64_t poolHits;    /**< Allocations served from the pool. */
+        uint64_t releases;    /**< Tag buffers released. */
+        uint64_t pooled;      /**< Tag buffers currently held in the pool. */
+    };
+
     /**
      * @brief An iterator for iterating through a byte tag list
      *
@@ -165,6 +177,12 @@ class ByteTagList
     ByteTagList& operator=(const ByteTagList& o);
     ~ByteTagList();
 
+    /**
+     * @brief Get the tag buffer pool statistics of the calling thread
+     * @returns the statistics
+     */
+    static PoolStats GetPoolStats();
+
     /**
      * @param tid the typeid of the tag added
      * @param bufferSize the size of the tag when its serialization will
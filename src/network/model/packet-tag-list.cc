@@ -19,6 +19,8 @@
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <cstring>
 
 namespace ns3
@@ -26,6 +28,70 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("PacketTagList");
 
+namespace
+{
+
+/** Size class granularity of the TagData pool, in bytes. */
+constexpr std::size_t POOL_GRANULARITY = 16;
+/** Number of size classes; larger TagData bypass the pool. */
+constexpr std::size_t POOL_CLASSES = 8;
+/** Maximum number of free TagData kept per size class. */
+constexpr std::size_t POOL_MAX_FREE = 1024;
+
+/** A free block, linked in its size class free list. */
+struct FreeBlock
+{
+    FreeBlock* next; /**< Next free block. */
+};
+
+/** Per-thread pool of TagData storage. */
+struct TagDataPool
+{
+    /** Destructor: release the free blocks. */
+    ~TagDataPool();
+
+    FreeBlock* free[POOL_CLASSES]{};            /**< Free lists, one per size class. */
+    std::size_t nFree[POOL_CLASSES]{};          /**< Free list lengths. */
+    PacketTagList::PoolStats stats{0, 0, 0, 0}; /**< Statistics. */
+};
+
+/**
+ * Set when the pool of the current thread has been destroyed, so tags
+ * released later during thread (or program) exit go back to the heap.
+ */
+thread_local bool g_poolDestroyed = false;
+/** The TagData pool of the current thread. */
+thread_local TagDataPool g_pool;
+
+TagDataPool::~TagDataPool()
+{
+    g_poolDestroyed = true;
+    for (std::size_t i = 0; i < POOL_CLASSES; ++i)
+    {
+        while (free[i] != nullptr)
+        {
+            FreeBlock* block = free[i];
+            free[i] = block->next;
+            std::free(block);
+        }
+        nFree[i] = 0;
+    }
+}
+
+/**
+ * Get the size class of a TagData.
+ * @param [in] dataSize The serialized size of the Tag.
+ * @returns The size class, POOL_CLASSES if too large for the pool.
+ */
+inline std::size_t
+SizeClass(std::size_t dataSize)
+{
+    std::size_t size = sizeof(PacketTagList::TagData) + dataSize - 1;
+    return std::min((size + POOL_GRANULARITY - 1) / POOL_GRANULARITY - 1, POOL_CLASSES);
+}
+
+} // namespace
+
 PacketTagList::TagData*
 PacketTagList::CreateTagData(size_t dataSize)
 {
@@ -33,14 +99,75 @@ PacketTagList::CreateTagData(size_t dataSize)
                   "Requested TagData size " << dataSize << " exceeds maximum "
                                             << std::numeric_limits<decltype(TagData::size)>::max());
 
-    void* p = std::malloc(sizeof(TagData) + dataSize - 1);
-    // The matching frees are in RemoveAll and RemoveWriter
+    // The matching releases are in FreeTagData
+    void* p = nullptr;
+    std::size_t sizeClass = SizeClass(dataSize);
+    if (sizeClass == POOL_CLASSES || g_poolDestroyed)
+    {
+        p = std::malloc(sizeof(TagData) + dataSize - 1);
+    }
+    else
+    {
+        TagDataPool& pool = g_pool;
+        ++pool.stats.allocations;
+        FreeBlock* block = pool.free[sizeClass];
+        if (block != nullptr)
+        {
+            pool.free[sizeClass] = block->next;
+            --pool.nFree[sizeClass];
+            ++pool.stats.poolHits;
+            p = block;
+        }
+        else
+        {
+            p = std::malloc((sizeClass + 1) * POOL_GRANULARITY);
+        }
+    }
 
     auto tag = new (p) TagData;
     tag->size = dataSize;
     return tag;
 }
 
+void
+PacketTagList::FreeTagData(TagData* tag)
+{
+    std::size_t sizeClass = SizeClass(tag->size);
+    tag->~TagData();
+    if (sizeClass == POOL_CLASSES || g_poolDestroyed)
+    {
+        std::free(tag);
+        return;
+    }
+    TagDataPool& pool = g_pool;
+    ++pool.stats.releases;
+    if (pool.nFree[sizeClass] >= POOL_MAX_FREE)
+    {
+        std::free(tag);
+        return;
+    }
+    auto block = reinterpret_cast<FreeBlock*>(tag);
+    block->next = pool.free[sizeClass];
+    pool.free[sizeClass] = block;
+    ++pool.nFree[sizeClass];
+}
+
+PacketTagList::PoolStats
+PacketTagList::GetPoolStats()
+{
+    if (g_poolDestroyed)
+    {
+        return {0, 0, 0, 0};
+    }
+    PoolStats stats = g_pool.stats;
+    stats.pooled = 0;
+    for (std::size_t i = 0; i < POOL_CLASSES; ++i)
+    {
+        stats.pooled += g_pool.nFree[i];
+    }
+    return stats;
+}
+
 bool
 PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
 {
@@ -164,6 +291,11 @@ PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
 bool
 PacketTagList::Remove(Tag& tag)
 {
+    uint8_t slot = FindSlot(tag.GetInstanceTypeId());
+    if (slot != SLOT_COUNT)
+    {
+        return Remove(tag, slot);
+    }
     return COWTraverse(tag, &PacketTagList::RemoveWriter);
 }
 
@@ -184,8 +316,7 @@ PacketTagList::RemoveWriter(Tag& tag,
     if (preMerge)
     {
         // found tid before first merge, so delete cur
-        cur->~TagData();
-        std::free(cur);
+        FreeTagData(cur);
     }
     else
     {
@@ -204,6 +335,11 @@ PacketTagList::RemoveWriter(Tag& tag,
 bool
 PacketTagList::Replace(Tag& tag)
 {
+    uint8_t slot = FindSlot(tag.GetInstanceTypeId());
+    if (slot != SLOT_COUNT)
+    {
+        return Replace(tag, slot);
+    }
     bool found = COWTraverse(tag, &PacketTagList::ReplaceWriter);
     if (!found)
     {
@@ -212,6 +348,34 @@ PacketTagList::Replace(Tag& tag)
     return found;
 }
 
+bool
+PacketTagList::Replace(Tag& tag, uint8_t slot)
+{
+    NS_ASSERT(slot < SLOT_COUNT);
+    TagSlot& tagSlot = m_slot[slot];
+    if ((m_slots & (1 << slot)) != 0 && tagSlot.tid == tag.GetInstanceTypeId())
+    {
+        uint32_t size = tag.GetSerializedSize();
+        if (size <= SLOT_SIZE)
+        {
+            tagSlot.size = size;
+            tag.Serialize(TagBuffer(tagSlot.data, tagSlot.data + size));
+        }
+        else
+        {
+            m_slots &= ~(1 << slot);
+            Add(tag);
+        }
+        return true;
+    }
+    bool found = COWTraverse(tag, &PacketTagList::ReplaceWriter);
+    if (!found)
+    {
+        Add(tag, slot);
+    }
+    return found;
+}
+
 // COWWriter implementing Replace
 bool
 PacketTagList::ReplaceWriter(Tag& tag,
@@ -258,6 +422,9 @@ PacketTagList::Add(const Tag& tag) const
                       "Error: cannot add the same kind of tag twice. The tag type is "
                           << tag.GetInstanceTypeId().GetName());
     }
+    NS_ASSERT_MSG(FindSlot(tag.GetInstanceTypeId()) == SLOT_COUNT,
+                  "Error: cannot add the same kind of tag twice. The tag type is "
+                      << tag.GetInstanceTypeId().GetName());
     TagData* head = CreateTagData(tag.GetSerializedSize());
     head->count = 1;
     head->next = nullptr;
@@ -273,6 +440,11 @@ PacketTagList::Peek(Tag& tag) const
 {
     NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
     TypeId tid = tag.GetInstanceTypeId();
+    uint8_t slot = FindSlot(tid);
+    if (slot != SLOT_COUNT)
+    {
+        return Peek(tag, slot);
+    }
     for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
     {
         if (cur->tid == tid)
@@ -289,9 +461,28 @@ PacketTagList::Peek(Tag& tag) const
 const PacketTagList::TagData*
 PacketTagList::Head() const
 {
+    Spill();
     return m_next;
 }
 
+void
+PacketTagList::Spill() const
+{
+    NS_LOG_FUNCTION(this);
+    auto self = const_cast<PacketTagList*>(this);
+    for (uint8_t slots = m_slots; slots != 0; slots &= slots - 1)
+    {
+        const TagSlot& tagSlot = m_slot[std::countr_zero(slots)];
+        TagData* head = CreateTagData(tagSlot.size);
+        head->count = 1;
+        head->tid = tagSlot.tid;
+        head->next = m_next;
+        memcpy(head->data, tagSlot.data, tagSlot.size);
+        self->m_next = head;
+    }
+    self->m_slots = 0;
+}
+
 uint32_t
 PacketTagList::GetSerializedSize() const
 {
@@ -301,6 +492,8 @@ PacketTagList::GetSerializedSize() const
 
     size = 4; // numberOfTags
 
+    Spill();
+
     for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
     {
         size += 4; // TagData -> size
@@ -322,6 +515,8 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
 {
     NS_LOG_FUNCTION(this << buffer << maxSize);
 
+    Spill();
+
     uint32_t* p = buffer;
     uint32_t size = 0;
 
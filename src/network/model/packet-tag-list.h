@@ -13,16 +13,19 @@
 \brief  Defines a linked list of Packet tags, including copy-on-write semantics.
 */
 
+#include "tag-buffer.h"
+#include "tag.h"
+
+#include "ns3/assert.h"
 #include "ns3/type-id.h"
 
+#include <bit>
 #include <ostream>
 #include <stdint.h>
 
 namespace ns3
 {
 
-class Tag;
-
 /**
  * @ingroup packet
  *
@@ -109,10 +112,56 @@ class Tag;
  *       The portion of the list between the first branch and the target is
  *       shared. This portion is copied before the #Remove or #Replace is
  *       performed.
+ *
+ * @par <b> Memory </b>
+ *
+ *   - The TagData structures released are kept in a pool, one per thread,
+ *     sorted in size classes, for reuse by the next tags of the same thread.
+ *     GetPoolStats() reports the pool efficiency for the calling thread.
+ *
+ * @par <b> Hot tag store </b>
+ *
+ *   - The few tag types added to most packets, such as the SocketIpTosTag
+ *     set by the sockets, are assigned a slot by a specialization of
+ *     PacketTagSlot.  The typed Packet tag methods store such a tag in its
+ *     slot, an inline fixed-size buffer, instead of the list, which
+ *     makes adding, finding and removing it a constant time operation
+ *     without allocation.  The slots are copied with the list.
+ *
+ *   - The Tag methods of this class also find the tags stored in a slot.
+ *     The slots are moved to the list before iterating over it.
  */
 class PacketTagList
 {
   public:
+    /** Memory pool statistics, for the calling thread. */
+    struct PoolStats
+    {
+        uint64_t allocations; /**< TagData allocated in a pooled size class. */
+        uint64_t poolHits;    /**< Allocations served from the pool. */
+        uint64_t releases;    /**< TagData released in a pooled size class. */
+        uint64_t pooled;      /**< Free TagData currently held in the pool. */
+    };
+
+    /**
+     * Slots of the hot tag store.
+     *
+     * A tag type is assigned a slot by specializing PacketTagSlot.
+     */
+    enum Slot : uint8_t
+    {
+        SLOT_IP_TOS = 0,       //!< SocketIpTosTag
+        SLOT_IP_TTL,           //!< SocketIpTtlTag
+        SLOT_PRIORITY,         //!< SocketPriorityTag
+        SLOT_IPV4_PACKET_INFO, //!< Ipv4PacketInfoTag
+        SLOT_FLOW_ID,          //!< FlowIdTag
+        SLOT_TIMESTAMP,        //!< TimestampTag
+        SLOT_COUNT             //!< Number of slots, also used for no slot
+    };
+
+    /// Maximum serialized size of a tag stored in a slot; larger tags go to the list.
+    static constexpr uint32_t SLOT_SIZE = 13;
+
     /**
      * Tree node for sharing serialized tags.
      *
@@ -200,10 +249,50 @@ class PacketTagList
      */
     bool Peek(Tag& tag) const;
     /**
-     * Remove all tags from this list (up to the first merge).
+     * Add a tag to its slot of the hot tag store.
+     *
+     * The tag is added to the list instead if the slot holds a tag of
+     * another type, or if the tag is larger than SLOT_SIZE.
+     *
+     * @param [in] tag The tag to add
+     * @param [in] slot The slot of the tag type
+     */
+    inline void Add(const Tag& tag, uint8_t slot) const;
+    /**
+     * Remove a tag, looking up its slot first.
+     *
+     * @param [in,out] tag The tag type to remove.  If found,
+     *          \pname{tag} is set to the value of the tag found.
+     * @param [in] slot The slot of the tag type
+     * @returns True if \pname{tag} is found, false otherwise.
+     */
+    inline bool Remove(Tag& tag, uint8_t slot);
+    /**
+     * Replace the value of a tag, looking up its slot first.
+     *
+     * @param [in] tag The tag type to replace.
+     * @param [in] slot The slot of the tag type
+     * @returns True if \pname{tag} is found, false otherwise.
+     *        If \pname{tag} wasn't found, it is added to its slot.
+     */
+    bool Replace(Tag& tag, uint8_t slot);
+    /**
+     * Find a tag and return its value, looking up its slot first.
+     *
+     * @param [in,out] tag The tag type to find.  If found,
+     *          \pname{tag} is set to the value of the tag found.
+     * @param [in] slot The slot of the tag type
+     * @returns True if \pname{tag} is found, false otherwise.
+     */
+    inline bool Peek(Tag& tag, uint8_t slot) const;
+    /**
+     * Remove all tags from this list (up to the first merge), and from
+     * the hot tag store.
      */
     inline void RemoveAll();
     /**
+     * Move the tags of the hot tag store to the list.
+     *
      * @returns pointer to head of tag list
      */
     const PacketTagList::TagData* Head() const;
@@ -232,6 +321,13 @@ class PacketTagList
      */
     uint32_t Deserialize(const uint32_t* buffer, uint32_t size);
 
+    /**
+     * Get the TagData pool statistics of the calling thread.
+     *
+     * @returns The statistics.
+     */
+    static PoolStats GetPoolStats();
+
   private:
     /**
      * Allocate and construct a TagData struct, sizing the data area
@@ -241,6 +337,12 @@ class PacketTagList
      * @returns The newly constructed TagData object.
      */
     static TagData* CreateTagData(size_t dataSize);
+    /**
+     * Destroy and release a TagData struct allocated by CreateTagData().
+     *
+     * @param [in] tag The TagData object.
+     */
+    static void FreeTagData(TagData* tag);
 
     /**
      * Typedef of method function pointer for copy-on-write operations
@@ -290,10 +392,57 @@ class PacketTagList
      */
     bool ReplaceWriter(Tag& tag, bool preMerge, TagData* cur, TagData** prevNext);
 
+    /** A slot of the hot tag store. */
+    struct TagSlot
+    {
+        TypeId tid;              //!< Type of the tag serialized into #data
+        uint8_t size;            //!< Size of the serialized tag
+        uint8_t data[SLOT_SIZE]; //!< Serialization buffer
+    };
+
+    /**
+     * Find the slot holding a tag type.
+     *
+     * @param [in] tid The tag type.
+     * @returns The slot, or SLOT_COUNT if no slot holds this type.
+     */
+    inline uint8_t FindSlot(TypeId tid) const;
+    /**
+     * Copy the hot tag store of another list.
+     *
+     * @param [in] o The list to copy.
+     */
+    inline void CopySlots(const PacketTagList& o);
+    /**
+     * Move the tags of the hot tag store to the list, so that the list
+     * holds all the tags.
+     */
+    void Spill() const;
+
     /**
      * Pointer to first \ref TagData on the list
      */
     TagData* m_next;
+    uint8_t m_slots;            //!< Bitmask of the occupied slots
+    TagSlot m_slot[SLOT_COUNT]; //!< The hot tag store
+};
+
+/**
+ * @ingroup packet
+ *
+ * Slot of a tag type in the hot tag store of the PacketTagList.
+ *
+ * The tag types without a specialization of this template, which
+ * defines \c index as one of the PacketTagList::Slot values, are stored
+ * in the list.  Each slot must be assigned to a single tag type, whose
+ * serialized size is at most PacketTagList::SLOT_SIZE.
+ *
+ * @tparam T The tag type.
+ */
+template <typename T>
+struct PacketTagSlot
+{
+    static constexpr uint8_t index = PacketTagList::SLOT_COUNT; //!< The slot
 };
 
 } // namespace ns3
@@ -306,7 +455,8 @@ namespace ns3
 {
 
 PacketTagList::PacketTagList()
-    : m_next()
+    : m_next(),
+      m_slots(0)
 {
 }
 
@@ -317,25 +467,109 @@ PacketTagList::PacketTagList(const PacketTagList& o)
     {
         m_next->count++;
     }
+    CopySlots(o);
 }
 
 PacketTagList&
 PacketTagList::operator=(const PacketTagList& o)
 {
     // self assignment
-    if (m_next == o.m_next)
+    if (this == &o)
     {
         return *this;
     }
-    RemoveAll();
-    m_next = o.m_next;
-    if (m_next != nullptr)
+    if (m_next != o.m_next)
     {
-        m_next->count++;
+        RemoveAll();
+        m_next = o.m_next;
+        if (m_next != nullptr)
+        {
+            m_next->count++;
+        }
     }
+    CopySlots(o);
     return *this;
 }
 
+void
+PacketTagList::CopySlots(const PacketTagList& o)
+{
+    m_slots = o.m_slots;
+    for (uint8_t slots = m_slots; slots != 0; slots &= slots - 1)
+    {
+        m_slot[std::countr_zero(slots)] = o.m_slot[std::countr_zero(slots)];
+    }
+}
+
+uint8_t
+PacketTagList::FindSlot(TypeId tid) const
+{
+    for (uint8_t slots = m_slots; slots != 0; slots &= slots - 1)
+    {
+        uint8_t slot = std::countr_zero(slots);
+        if (m_slot[slot].tid == tid)
+        {
+            return slot;
+        }
+    }
+    return SLOT_COUNT;
+}
+
+void
+PacketTagList::Add(const Tag& tag, uint8_t slot) const
+{
+    NS_ASSERT(slot < SLOT_COUNT);
+    uint32_t size = tag.GetSerializedSize();
+    if ((m_slots & (1 << slot)) != 0 || size > SLOT_SIZE)
+    {
+        Add(tag);
+        return;
+    }
+    TypeId tid = tag.GetInstanceTypeId();
+#ifdef NS3_ASSERT_ENABLE
+    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    {
+        NS_ASSERT_MSG(cur->tid != tid,
+                      "Error: cannot add the same kind of tag twice. The tag type is "
+                          << tid.GetName());
+    }
+#endif
+    auto self = const_cast<PacketTagList*>(this);
+    TagSlot& tagSlot = self->m_slot[slot];
+    tagSlot.tid = tid;
+    tagSlot.size = size;
+    tag.Serialize(TagBuffer(tagSlot.data, tagSlot.data + size));
+    self->m_slots |= (1 << slot);
+}
+
+bool
+PacketTagList::Remove(Tag& tag, uint8_t slot)
+{
+    NS_ASSERT(slot < SLOT_COUNT);
+    TagSlot& tagSlot = m_slot[slot];
+    if ((m_slots & (1 << slot)) != 0 && tagSlot.tid == tag.GetInstanceTypeId())
+    {
+        tag.Deserialize(TagBuffer(tagSlot.data, tagSlot.data + tagSlot.size));
+        m_slots &= ~(1 << slot);
+        return true;
+    }
+    return Remove(tag);
+}
+
+bool
+PacketTagList::Peek(Tag& tag, uint8_t slot) const
+{
+    NS_ASSERT(slot < SLOT_COUNT);
+    const TagSlot& tagSlot = m_slot[slot];
+    if ((m_slots & (1 << slot)) != 0 && tagSlot.tid == tag.GetInstanceTypeId())
+    {
+        auto data = const_cast<uint8_t*>(tagSlot.data);
+        tag.Deserialize(TagBuffer(data, data + tagSlot.size));
+        return true;
+    }
+    return Peek(tag);
+}
+
 PacketTagList::~PacketTagList()
 {
     RemoveAll();
@@ -354,17 +588,16 @@ PacketTagList::RemoveAll()
         }
         if (prev != nullptr)
         {
-            prev->~TagData();
-            std::free(prev);
+            FreeTagData(prev);
         }
         prev = cur;
     }
     if (prev != nullptr)
     {
-        prev->~TagData();
-        std::free(prev);
+        FreeTagData(prev);
     }
     m_next = nullptr;
+    m_slots = 0;
 }
 
 } // namespace ns3
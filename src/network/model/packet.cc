@@ -21,6 +21,105 @@ NS_LOG_COMPONENT_DEFINE("Packet");
 
 uint32_t Packet::m_globalUid = 0;
 
+namespace
+{
+
+/** Maximum number of free packets kept in the pool of a thread. */
+constexpr std::size_t POOL_MAX_FREE = 4096;
+
+/** A free packet storage block, linked in the free list. */
+struct FreeBlock
+{
+    FreeBlock* next; /**< Next free block. */
+};
+
+/** Per-thread pool of packet storage. */
+struct PacketPool
+{
+    /** Destructor: release the free blocks. */
+    ~PacketPool();
+
+    FreeBlock* free{nullptr};            /**< Free list. */
+    std::size_t nFree{0};                /**< Free list length. */
+    Packet::PoolStats stats{0, 0, 0, 0}; /**< Statistics. */
+};
+
+/**
+ * Set when the pool of the current thread has been destroyed, so packets
+ * released later during thread (or program) exit go back to the heap.
+ */
+thread_local bool g_poolDestroyed = false;
+/** The packet pool of the current thread. */
+thread_local PacketPool g_pool;
+
+PacketPool::~PacketPool()
+{
+    g_poolDestroyed = true;
+    while (free != nullptr)
+    {
+        FreeBlock* block = free;
+        free = block->next;
+        ::operator delete(block);
+    }
+    nFree = 0;
+}
+
+} // namespace
+
+void*
+Packet::operator new(std::size_t size)
+{
+    // Subclasses, if any, bypass the pool.
+    if (size != sizeof(Packet) || g_poolDestroyed)
+    {
+        return ::operator new(size);
+    }
+    PacketPool& pool = g_pool;
+    ++pool.stats.allocations;
+    FreeBlock* block = pool.free;
+    if (block != nullptr)
+    {
+        pool.free = block->next;
+        --pool.nFree;
+        ++pool.stats.poolHits;
+        return block;
+    }
+    return ::operator new(size);
+}
+
+void
+Packet::operator delete(void* p, std::size_t size)
+{
+    if (size != sizeof(Packet) || g_poolDestroyed)
+    {
+        ::operator delete(p);
+        return;
+    }
+    PacketPool& pool = g_pool;
+    ++pool.stats.releases;
+    if (pool.nFree >= POOL_MAX_FREE)
+    {
+        ::operator delete(p);
+        return;
+    }
+    auto block = static_cast<FreeBlock*>(p);
+    block->next = pool.free;
+    pool.free = block;
+    ++pool.nFree;
+}
+
+Packet::PoolStats
+Packet::GetPoolStats()
+{
+    if (g_poolDestroyed)
+    {
+        return {0, 0, 0, 0};
+    }
+    PoolStats stats = g_pool.stats;
+    stats.pooled = g_pool.nFree;
+    return stats;
+}
+
 TypeId
 ByteTagIterator::Item::GetTypeId() const
 {
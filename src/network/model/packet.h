@@ -223,6 +223,10 @@ class PacketTagIterator
  *
  * The performance aspects copy-on-write semantics of the
  * Packet API are discussed in \ref packetperf
+ *
+ * Packet objects, as well as the storage of their buffer and tags, are
+ * allocated from pools, one per thread, which keep the storage released
+ * by the thread for reuse by its next packets.
  */
 class Packet : public SimpleRefCount<Packet>
 {
@@ -655,6 +659,50 @@ class Packet : public SimpleRefCount<Packet>
      *          otherwise.
      */
     bool PeekPacketTag(Tag& tag) const;
+    /**
+     * @brief Add a packet tag of a known type.
+     *
+     * If the tag type has a slot in the hot tag store (see PacketTagSlot),
+     * the tag is stored in it in constant time, else it is added to the
+     * tag list as with AddPacketTag(const Tag&).
+     *
+     * @tparam T \deduced The tag type.
+     * @param tag the packet tag to add.
+     */
+    template <typename T>
+    void AddPacketTag(const T& tag) const;
+    /**
+     * @brief Remove a packet tag of a known type.
+     *
+     * @tparam T \deduced The tag type.
+     * @param tag the packet tag type to remove from this packet.
+     *        The tag parameter is set to the value of the tag found.
+     * @returns true if the requested tag is found, false
+     *          otherwise.
+     */
+    template <typename T>
+    bool RemovePacketTag(T& tag);
+    /**
+     * @brief Replace the value of a packet tag of a known type.
+     *
+     * @tparam T \deduced The tag type.
+     * @param tag the packet tag type to replace.
+     * @returns true if the requested tag is found, false otherwise.
+     *        If the tag isn't found, Add is performed instead.
+     */
+    template <typename T>
+    bool ReplacePacketTag(T& tag);
+    /**
+     * @brief Search a matching tag of a known type and call
+     * Tag::Deserialize if it is found.
+     *
+     * @tparam T \deduced The tag type.
+     * @param tag the tag to search in this packet
+     * @returns true if the requested tag is found, false
+     *          otherwise.
+     */
+    template <typename T>
+    bool PeekPacketTag(T& tag) const;
     /**
      * @brief Remove all packet tags.
      */
@@ -755,6 +803,37 @@ class Packet : public SimpleRefCount<Packet>
      */
     typedef void (*SinrTracedCallback)(Ptr<const Packet> packet, double sinr);
 
+    /** Memory pool statistics, for the calling thread. */
+    struct PoolStats
+    {
+        uint64_t allocations; /**< Packets allocated. */
+        uint64_t poolHits;    /**< Allocations served from the pool. */
+        uint64_t releases;    /**< Packets released. */
+        uint64_t pooled;      /**< Free packets currently held in the pool. */
+    };
+
+    /**
+     * Allocate storage for a packet from the pool of the calling thread.
+     * @param [in] size The size of the packet object.
+     * @returns The storage.
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * Release the storage of a packet to the pool of the calling thread.
+     * @param [in] p The storage.
+     * @param [in] size The size of the packet object.
+     */
+    static void operator delete(void* p, std::size_t size);
+    /**
+     * Get the packet memory pool statistics of the calling thread.
+     *
+     * The pools of the Buffer, ByteTagList and PacketTagList storage
+     * report their own statistics.
+     *
+     * @returns The statistics.
+     */
+    static PoolStats GetPoolStats();
+
   private:
     /**
      * @brief Constructor
@@ -852,6 +931,62 @@ Packet::GetSize() const
     return m_buffer.GetSize();
 }
 
+template <typename T>
+void
+Packet::AddPacketTag(const T& tag) const
+{
+    if constexpr (PacketTagSlot<T>::index < PacketTagList::SLOT_COUNT)
+    {
+        m_packetTagList.Add(tag, PacketTagSlot<T>::index);
+    }
+    else
+    {
+        AddPacketTag(static_cast<const Tag&>(tag));
+    }
+}
+
+template <typename T>
+bool
+Packet::RemovePacketTag(T& tag)
+{
+    if constexpr (PacketTagSlot<T>::index < PacketTagList::SLOT_COUNT)
+    {
+        return m_packetTagList.Remove(tag, PacketTagSlot<T>::index);
+    }
+    else
+    {
+        return RemovePacketTag(static_cast<Tag&>(tag));
+    }
+}
+
+template <typename T>
+bool
+Packet::ReplacePacketTag(T& tag)
+{
+    if constexpr (PacketTagSlot<T>::index < PacketTagList::SLOT_COUNT)
+    {
+        return m_packetTagList.Replace(tag, PacketTagSlot<T>::index);
+    }
+    else
+    {
+        return ReplacePacketTag(static_cast<Tag&>(tag));
+    }
+}
+
+template <typename T>
+bool
+Packet::PeekPacketTag(T& tag) const
+{
+    if constexpr (PacketTagSlot<T>::index < PacketTagList::SLOT_COUNT)
+    {
+        return m_packetTagList.Peek(tag, PacketTagSlot<T>::index);
+    }
+    else
+    {
+        return PeekPacketTag(static_cast<Tag&>(tag));
+    }
+}
+
 } // namespace ns3
 
 #endif /* PACKET_H */
@@ -13,6 +13,7 @@
 
 #include "address.h"
 #include "net-device.h"
+#include "packet-tag-list.h"
 #include "tag.h"
 
 #include "ns3/callback.h"
@@ -1153,6 +1154,15 @@ class SocketIpTtlTag : public Tag
     uint8_t m_ttl; //!< the ttl carried by the tag
 };
 
+/**
+ * @brief SocketIpTtlTag is stored in a slot of the PacketTagList hot tag store.
+ */
+template <>
+struct PacketTagSlot<SocketIpTtlTag>
+{
+    static constexpr uint8_t index = PacketTagList::SLOT_IP_TTL; //!< The slot
+};
+
 /**
  * @brief This class implements a tag that carries the socket-specific
  * HOPLIMIT of a packet to the IPv6 layer
@@ -1300,6 +1310,15 @@ class SocketIpTosTag : public Tag
     uint8_t m_ipTos; //!< the TOS carried by the tag
 };
 
+/**
+ * @brief SocketIpTosTag is stored in a slot of the PacketTagList hot tag store.
+ */
+template <>
+struct PacketTagSlot<SocketIpTosTag>
+{
+    static constexpr uint8_t index = PacketTagList::SLOT_IP_TOS; //!< The slot
+};
+
 /**
  * @brief indicates whether the socket has a priority set.
  */
@@ -1347,6 +1366,15 @@ class SocketPriorityTag : public Tag
     uint8_t m_priority; //!< the priority carried by the tag
 };
 
+/**
+ * @brief SocketPriorityTag is stored in a slot of the PacketTagList hot tag store.
+ */
+template <>
+struct PacketTagSlot<SocketPriorityTag>
+{
+    static constexpr uint8_t index = PacketTagList::SLOT_PRIORITY; //!< The slot
+};
+
 /**
  * @brief indicates whether the socket has IPV6_TCLASS set.
  * This tag is for IPv6 socket.
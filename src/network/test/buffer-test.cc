@@ -11,6 +11,9 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/test.h"
 
+#include <string>
+#include <vector>
+
 using namespace ns3;
 
 /**
@@ -384,6 +387,133 @@ BufferTest::DoRun()
     NS_TEST_ASSERT_MSG_EQ(val1, val2, "Bad ReadNtohU16()");
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Check that appending buffers keeps their zero areas virtual.
+ */
+class BufferZeroAreaTest : public TestCase
+{
+  private:
+    /**
+     * Create a buffer with real bytes around a zero area.
+     * @param start The number of bytes before the zero area.
+     * @param zero The size of the zero area.
+     * @param end The number of bytes after the zero area.
+     * @param value The value of the real bytes.
+     * @returns The buffer.
+     */
+    Buffer Create(uint32_t start, uint32_t zero, uint32_t end, uint8_t value);
+    /**
+     * Check the content of a buffer, and that its zero area is virtual.
+     * @param b The buffer.
+     * @param expected The expected bytes.
+     * @param real The maximum number of real bytes.
+     * @param name The name of the case.
+     */
+    void Check(const Buffer& b,
+               const std::vector<uint8_t>& expected,
+               uint32_t real,
+               const std::string& name);
+    /**
+     * Get the bytes of the concatenation of two buffers.
+     * @param a The first buffer.
+     * @param b The second buffer.
+     * @returns The bytes.
+     */
+    std::vector<uint8_t> Concatenate(const Buffer& a, const Buffer& b);
+
+  public:
+    void DoRun() override;
+    BufferZeroAreaTest();
+};
+
+BufferZeroAreaTest::BufferZeroAreaTest()
+    : TestCase("Buffer zero areas")
+{
+}
+
+Buffer
+BufferZeroAreaTest::Create(uint32_t start, uint32_t zero, uint32_t end, uint8_t value)
+{
+    Buffer b(zero);
+    b.AddAtStart(start);
+    b.Begin().WriteU8(value, start);
+    b.AddAtEnd(end);
+    Buffer::Iterator i = b.End();
+    i.Prev(end);
+    i.WriteU8(value + 1, end);
+    return b;
+}
+
+std::vector<uint8_t>
+BufferZeroAreaTest::Concatenate(const Buffer& a, const Buffer& b)
+{
+    std::vector<uint8_t> bytes(a.GetSize() + b.GetSize());
+    a.CopyData(bytes.data(), a.GetSize());
+    b.CopyData(bytes.data() + a.GetSize(), b.GetSize());
+    return bytes;
+}
+
+void
+BufferZeroAreaTest::Check(const Buffer& b,
+                          const std::vector<uint8_t>& expected,
+                          uint32_t real,
+                          const std::string& name)
+{
+    NS_TEST_EXPECT_MSG_EQ(b.GetSize(), expected.size(), "Wrong size: " << name);
+    std::vector<uint8_t> bytes(b.GetSize());
+    b.CopyData(bytes.data(), b.GetSize());
+    NS_TEST_EXPECT_MSG_EQ((bytes == expected), true, "Wrong content: " << name);
+    // Three sizes, and the real bytes rounded to 4 bytes.
+    NS_TEST_EXPECT_MSG_LT_OR_EQ(b.GetSerializedSize(),
+                                12 + real + 6,
+                                "Zero area written: " << name);
+}
+
+void
+BufferZeroAreaTest::DoRun()
+{
+    // Adjacent zero areas, while the first buffer shares its data.
+    Buffer a = Create(20, 1000, 0, 1);
+    Buffer shared = a;
+    Buffer b = Create(0, 500, 8, 3);
+    std::vector<uint8_t> expected = Concatenate(a, b);
+    a.AddAtEnd(b);
+    Check(a, expected, 28, "adjacent zero areas");
+    Check(shared, Concatenate(Create(20, 1000, 0, 1), Buffer()), 20, "original buffer");
+
+    // Fragments of the same buffer.
+    Buffer whole = Create(0, 3000, 0, 5);
+    Buffer first = whole.CreateFragment(0, 1000);
+    first.AddAtEnd(whole.CreateFragment(1000, 2000));
+    Check(first, std::vector<uint8_t>(3000, 0), 0, "fragments");
+
+    // Real bytes after a zero area.
+    a = Create(4, 1000, 0, 7);
+    shared = a;
+    b = Create(12, 0, 0, 9);
+    expected = Concatenate(a, b);
+    a.AddAtEnd(b);
+    Check(a, expected, 16, "bytes after a zero area");
+
+    // Real bytes before a zero area.
+    a = Create(8, 0, 0, 11);
+    shared = a;
+    b = Create(4, 1000, 4, 13);
+    expected = Concatenate(a, b);
+    a.AddAtEnd(b);
+    Check(a, expected, 16, "bytes before a zero area");
+
+    // Two zero areas separated by real bytes: one is written.
+    a = Create(0, 100, 4, 15);
+    b = Create(0, 1000, 0, 17);
+    expected = Concatenate(a, b);
+    a.AddAtEnd(b);
+    Check(a, expected, 104, "separated zero areas");
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -400,6 +530,7 @@ BufferTestSuite::BufferTestSuite()
     : TestSuite("buffer", Type::UNIT)
 {
     AddTestCase(new BufferTest, TestCase::Duration::QUICK);
+    AddTestCase(new BufferZeroAreaTest, TestCase::Duration::QUICK);
 }
 
 static BufferTestSuite g_bufferTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/dynamic-queue-limits.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Check that the limit is only recomputed once a batch of objects is
+ * completed, or once the queue is empty.
+ */
+class DynamicQueueLimitsBatchTestCase : public TestCase
+{
+  public:
+    DynamicQueueLimitsBatchTestCase();
+    void DoRun() override;
+};
+
+DynamicQueueLimitsBatchTestCase::DynamicQueueLimitsBatchTestCase()
+    : TestCase("Check the completion batch of the dynamic queue limits")
+{
+}
+
+void
+DynamicQueueLimitsBatchTestCase::DoRun()
+{
+    Ptr<DynamicQueueLimits> dql = CreateObject<DynamicQueueLimits>();
+    dql->SetAttribute("CompletionBatch", UintegerValue(3000));
+
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        dql->Queued(1000);
+    }
+    int32_t available = dql->Available();
+    NS_TEST_EXPECT_MSG_EQ(available, -10000, "Unexpected number of bytes available");
+
+    for (uint32_t i = 1; i <= 10; ++i)
+    {
+        dql->Completed(1000);
+        // 3000 bytes are completed at the 3rd, 6th and 9th completion, and
+        // the queue is empty at the 10th
+        bool updated = (i % 3 == 0 || i == 10);
+        NS_TEST_EXPECT_MSG_EQ((dql->Available() != available),
+                              updated,
+                              "Unexpected update of the limit at completion " << i);
+        available = dql->Available();
+    }
+    NS_TEST_EXPECT_MSG_GT_OR_EQ(available, 0, "The queue is empty");
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * Check the stall detector of the dynamic queue limits.
+ */
+class DynamicQueueLimitsStallTestCase : public TestCase
+{
+  public:
+    DynamicQueueLimitsStallTestCase();
+    void DoRun() override;
+
+  private:
+    /**
+     * Record a stall.
+     * @param duration The duration of the stall.
+     */
+    void Stall(Time duration);
+
+    std::vector<Time> m_stalls; //!< Stalls reported
+};
+
+DynamicQueueLimitsStallTestCase::DynamicQueueLimitsStallTestCase()
+    : TestCase("Check the stall detector of the dynamic queue limits")
+{
+}
+
+void
+DynamicQueueLimitsStallTestCase::Stall(Time duration)
+{
+    m_stalls.push_back(duration);
+}
+
+void
+DynamicQueueLimitsStallTestCase::DoRun()
+{
+    Ptr<DynamicQueueLimits> dql = CreateObject<DynamicQueueLimits>();
+    dql->SetAttribute("StallThreshold", TimeValue(MilliSeconds(1)));
+    dql->TraceConnectWithoutContext("Stall",
+                                    MakeCallback(&DynamicQueueLimitsStallTestCase::Stall, this));
+
+    Simulator::Schedule(Seconds(0), [=]() { dql->Queued(3000); });
+    Simulator::Schedule(MicroSeconds(500), [=]() { dql->Completed(1000); });
+    // no completion for 2.5 ms, while 2000 bytes are queued
+    Simulator::Schedule(MicroSeconds(3000), [=]() { dql->Completed(1000); });
+    Simulator::Schedule(MicroSeconds(3500), [=]() { dql->Completed(1000); });
+    // the queue is empty until 10 ms: this is not a stall
+    Simulator::Schedule(MicroSeconds(10000), [=]() { dql->Queued(1000); });
+    Simulator::Schedule(MicroSeconds(10500), [=]() { dql->Completed(1000); });
+    Simulator::Run();
+    Simulator::Destroy();
+
+    NS_TEST_ASSERT_MSG_EQ(m_stalls.size(), 1, "Unexpected number of stalls");
+    NS_TEST_EXPECT_MSG_EQ(m_stalls[0], MicroSeconds(2500), "Unexpected duration of the stall");
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Dynamic Queue Limits TestSuite
+ */
+class DynamicQueueLimitsTestSuite : public TestSuite
+{
+  public:
+    DynamicQueueLimitsTestSuite()
+        : TestSuite("dynamic-queue-limits", Type::UNIT)
+    {
+        AddTestCase(new DynamicQueueLimitsBatchTestCase(), TestCase::Duration::QUICK);
+        AddTestCase(new DynamicQueueLimitsStallTestCase(), TestCase::Duration::QUICK);
+    }
+};
+
+static DynamicQueueLimitsTestSuite g_dynamicQueueLimitsTestSuite; //!< The test suite
@@ -5,9 +5,12 @@
  *
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
+#include "ns3/flow-id-tag.h"
 #include "ns3/packet-tag-list.h"
 #include "ns3/packet.h"
+#include "ns3/socket.h"
 #include "ns3/test.h"
+#include "ns3/timestamp-tag.h"
 
 #include <cstdarg>
 #include <ctime>
@@ -15,6 +18,8 @@
 #include <iostream>
 #include <limits> // std:numeric_limits
 #include <string>
+#include <thread>
+#include <vector>
 
 using namespace ns3;
 
@@ -1257,6 +1262,229 @@ PacketTagListTest::DoRun()
     }
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Packet hot tag store unit tests.
+ *
+ * Check that the tags stored in the slots of the hot tag store behave as
+ * those of the list, whether they are accessed by their type or as Tag.
+ */
+class PacketHotTagTest : public TestCase
+{
+  public:
+    PacketHotTagTest();
+    void DoRun() override;
+};
+
+PacketHotTagTest::PacketHotTagTest()
+    : TestCase("Check the packet hot tag store")
+{
+}
+
+void
+PacketHotTagTest::DoRun()
+{
+    Ptr<Packet> p = Create<Packet>(100);
+    SocketIpTosTag tos;
+    tos.SetTos(0x2e);
+    p->AddPacketTag(tos);
+    p->AddPacketTag(FlowIdTag(42));
+    p->AddPacketTag(ATestTag<1>(3));
+
+    SocketIpTosTag tosFound;
+    NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(tosFound), true, "Tag not found in its slot");
+    NS_TEST_EXPECT_MSG_EQ(+tosFound.GetTos(), 0x2e, "Wrong tag value in its slot");
+    FlowIdTag flowId;
+    Tag& flowIdTag = flowId;
+    NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(flowIdTag), true, "Slot tag not found as Tag");
+    NS_TEST_EXPECT_MSG_EQ(flowId.GetFlowId(), 42, "Wrong slot tag value as Tag");
+    TimestampTag timestamp;
+    NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(timestamp), false, "Empty slot found");
+    NS_TEST_EXPECT_MSG_EQ(p->ReplacePacketTag(timestamp), false, "Empty slot replaced");
+    NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(timestamp), true, "Replace did not add the tag");
+
+    // The slots are copied with the packet
+    Ptr<Packet> c = p->Copy();
+    tos.SetTos(0x01);
+    NS_TEST_EXPECT_MSG_EQ(c->ReplacePacketTag(tos), true, "Slot tag not replaced");
+    NS_TEST_EXPECT_MSG_EQ(c->RemovePacketTag(flowId), true, "Slot tag not removed");
+    NS_TEST_EXPECT_MSG_EQ(c->PeekPacketTag(flowId), false, "Removed slot tag found");
+    NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(tosFound), true, "Copy modified the original");
+    NS_TEST_EXPECT_MSG_EQ(+tosFound.GetTos(), 0x2e, "Copy modified the original value");
+    NS_TEST_EXPECT_MSG_EQ(c->PeekPacketTag(tosFound), true, "Replaced tag not found");
+    NS_TEST_EXPECT_MSG_EQ(+tosFound.GetTos(), 0x01, "Wrong replaced value");
+    NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(flowId), true, "Copy removed the original tag");
+
+    // Iterating moves the slot tags to the list, where they are still found
+    uint32_t count = 0;
+    PacketTagIterator i = p->GetPacketTagIterator();
+    while (i.HasNext())
+    {
+        i.Next();
+        count++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(count, 4, "Wrong number of tags iterated over");
+    NS_TEST_EXPECT_MSG_EQ(p->PeekPacketTag(tosFound), true, "Tag not found after iterating");
+    NS_TEST_EXPECT_MSG_EQ(+tosFound.GetTos(), 0x2e, "Wrong tag value after iterating");
+
+    // Serialization
+    c->AddPacketTag(flowId);
+    uint32_t size = c->GetSerializedSize();
+    std::vector<uint8_t> buffer(size + 16);
+    NS_TEST_EXPECT_MSG_EQ(c->Serialize(buffer.data(), size), 1, "Serialization failed");
+    Ptr<Packet> d = Create<Packet>(buffer.data(), size, true);
+    NS_TEST_EXPECT_MSG_EQ(d->PeekPacketTag(tosFound), true, "Slot tag not deserialized");
+    NS_TEST_EXPECT_MSG_EQ(+tosFound.GetTos(), 0x01, "Wrong deserialized value");
+    NS_TEST_EXPECT_MSG_EQ(d->PeekPacketTag(flowId), true, "Slot tag not deserialized");
+    NS_TEST_EXPECT_MSG_EQ(flowId.GetFlowId(), 42, "Wrong deserialized value");
+
+    // Removal as Tag
+    Tag& tosTag = tosFound;
+    NS_TEST_EXPECT_MSG_EQ(c->RemovePacketTag(tosTag), true, "Slot tag not removed as Tag");
+    NS_TEST_EXPECT_MSG_EQ(c->PeekPacketTag(tosFound), false, "Removed slot tag found");
+    c->AddPacketTag(tos);
+    c->RemoveAllPacketTags();
+    NS_TEST_EXPECT_MSG_EQ(c->PeekPacketTag(tosFound), false, "Slot tag not removed by RemoveAll");
+    NS_TEST_EXPECT_MSG_EQ(c->PeekPacketTag(timestamp), false, "Slot tag not removed by RemoveAll");
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Packet memory pools unit tests.
+ *
+ * Check that the packets, buffers and tags of a steady flow of packets
+ * are all served from the pools of the thread, and that each thread
+ * has its own pools.
+ */
+class PacketPoolTest : public TestCase
+{
+  public:
+    PacketPoolTest();
+    void DoRun() override;
+
+  private:
+    /// Allocation counters of all the pools
+    struct Counters
+    {
+        uint64_t allocations[4]; //!< Allocations, by pool
+        uint64_t poolHits[4];    //!< Allocations served from the pool, by pool
+        uint64_t releases;       //!< Releases, all pools
+    };
+
+    /**
+     * Get the counters of the calling thread.
+     * @returns the counters
+     */
+    static Counters GetCounters();
+    /**
+     * Create, copy, tag and release packets.
+     * @param n The number of packets
+     * @returns the number of packets with a wrong content
+     */
+    static uint32_t Lifecycles(uint32_t n);
+};
+
+PacketPoolTest::PacketPoolTest()
+    : TestCase("Check the packet memory pools")
+{
+}
+
+PacketPoolTest::Counters
+PacketPoolTest::GetCounters()
+{
+    Packet::PoolStats packets = Packet::GetPoolStats();
+    Buffer::PoolStats buffers = Buffer::GetPoolStats();
+    PacketTagList::PoolStats packetTags = PacketTagList::GetPoolStats();
+    ByteTagList::PoolStats byteTags = ByteTagList::GetPoolStats();
+    return {{packets.allocations,
+             buffers.allocations,
+             packetTags.allocations,
+             byteTags.allocations},
+            {packets.poolHits, buffers.poolHits, packetTags.poolHits, byteTags.poolHits},
+            packets.releases + buffers.releases + packetTags.releases + byteTags.releases};
+}
+
+uint32_t
+PacketPoolTest::Lifecycles(uint32_t n)
+{
+    uint32_t errors = 0;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        Ptr<Packet> p = Create<Packet>(1000);
+        p->AddPacketTag(ATestTag<4>(i % 256));
+        p->AddByteTag(ATestTag<5>(i % 256));
+        p->AddHeader(ATestHeader<10>());
+        Ptr<Packet> copy = p->Copy();
+        ATestHeader<10> header;
+        copy->RemoveHeader(header);
+        ATestTag<4> tag;
+        if (!copy->RemovePacketTag(tag) || tag.m_data != i % 256 || copy->GetSize() != 1000 ||
+            p->GetSize() != 1010)
+        {
+            errors++;
+        }
+    }
+    return errors;
+}
+
+void
+PacketPoolTest::DoRun()
+{
+    // Warm up the pools of this thread
+    NS_TEST_EXPECT_MSG_EQ(Lifecycles(10), 0, "Wrong packet content");
+
+    Counters start = GetCounters();
+    NS_TEST_EXPECT_MSG_EQ(Lifecycles(100), 0, "Wrong packet content");
+    Counters end = GetCounters();
+    const char* names[] = {"Packet", "Buffer", "PacketTagList", "ByteTagList"};
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        NS_TEST_EXPECT_MSG_GT(end.allocations[i] - start.allocations[i],
+                              0,
+                              "No allocation from the " << names[i] << " pool");
+        NS_TEST_EXPECT_MSG_EQ(end.poolHits[i] - start.poolHits[i],
+                              end.allocations[i] - start.allocations[i],
+                              "Heap allocations in steady state for the " << names[i] << " pool");
+    }
+
+    // Another thread starts with empty pools, and leaves those of this
+    // thread untouched; the packets it releases go to its own pools.
+    Ptr<Packet> sent = Create<Packet>(500);
+    sent->AddPacketTag(ATestTag<6>(7));
+    start = GetCounters();
+    Counters first{};
+    Counters last{};
+    uint32_t errors = 0;
+    std::thread thread([&]() {
+        first = GetCounters();
+        errors = Lifecycles(100);
+        ATestTag<6> tag;
+        if (!sent->PeekPacketTag(tag) || tag.m_data != 7)
+        {
+            errors++;
+        }
+        sent = nullptr;
+        last = GetCounters();
+    });
+    thread.join();
+    end = GetCounters();
+    NS_TEST_EXPECT_MSG_EQ(errors, 0, "Wrong packet content in another thread");
+    NS_TEST_EXPECT_MSG_EQ(sent, nullptr, "Packet not released by the other thread");
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(first.allocations[i], 0, "Shared " << names[i] << " pool");
+        NS_TEST_EXPECT_MSG_GT(last.allocations[i], 0, "Unused " << names[i] << " pool");
+        NS_TEST_EXPECT_MSG_EQ(end.allocations[i],
+                              start.allocations[i],
+                              "Allocation from the " << names[i] << " pool of another thread");
+    }
+    NS_TEST_EXPECT_MSG_EQ(end.releases, start.releases, "Release to the pool of another thread");
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -1274,6 +1502,8 @@ PacketTestSuite::PacketTestSuite()
 {
     AddTestCase(new PacketTest, TestCase::Duration::QUICK);
     AddTestCase(new PacketTagListTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketHotTagTest, TestCase::Duration::QUICK);
+    AddTestCase(new PacketPoolTest, TestCase::Duration::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
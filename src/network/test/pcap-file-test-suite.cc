@@ -4,15 +4,26 @@
  * Author:  Craig Dowell (craigdo@ee.washington.edu)
  */
 
+#include "ns3/async-file-buffer.h"
 #include "ns3/log.h"
+#include "ns3/packet.h"
 #include "ns3/pcap-file.h"
 #include "ns3/test.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <iostream>
+#include <iterator>
+#include <memory>
 #include <sstream>
+#include <vector>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
 
 using namespace ns3;
 
@@ -1364,6 +1375,262 @@ DiffTestCase::DoRun()
     NS_TEST_EXPECT_MSG_EQ(usec, 3696, "Files are different from 2.3696 seconds");
 }
 
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Test case to make sure that a pcap file written through an
+ * AsyncFileBuffer is the same as one written directly.
+ */
+class AsyncWriteTestCase : public TestCase
+{
+  public:
+    AsyncWriteTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Write the known packets many times in a pcap file.
+     * @param f The pcap file, opened for writing.
+     */
+    void WritePackets(PcapFile& f);
+
+    /**
+     * Read a file.
+     * @param filename The file name.
+     * @returns The content of the file.
+     */
+    static std::string ReadFile(const std::string& filename);
+};
+
+AsyncWriteTestCase::AsyncWriteTestCase()
+    : TestCase("Check that a pcap file written through an AsyncFileBuffer is the same")
+{
+}
+
+void
+AsyncWriteTestCase::WritePackets(PcapFile& f)
+{
+    // the snaplen truncates some packets
+    f.Init(1, 12);
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Init (1, 12) returns error");
+    for (uint32_t round = 0; round < 500; ++round)
+    {
+        for (uint32_t i = 0; i < N_KNOWN_PACKETS; ++i)
+        {
+            const PacketEntry& p = knownPackets[i];
+            f.Write(p.tsSec + round, p.tsUsec, (const uint8_t*)p.data, p.origLen);
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(f.Fail(), false, "Write must not fail");
+    f.Close();
+}
+
+std::string
+AsyncWriteTestCase::ReadFile(const std::string& filename)
+{
+    std::ifstream is(filename, std::ios::binary);
+    return {std::istreambuf_iterator<char>(is), std::istreambuf_iterator<char>()};
+}
+
+void
+AsyncWriteTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("direct.pcap");
+    PcapFile f;
+    f.Open(filename, std::ios::out);
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Open (" << filename << ") returns error");
+    WritePackets(f);
+    std::string expected = ReadFile(filename);
+
+    // small blocks, so that the writer thread is waited for
+    std::string asyncFilename = CreateTempDirFilename("async.pcap");
+    PcapFile async;
+    async.Open(std::make_unique<AsyncFileBuffer>(asyncFilename,
+                                                 std::ios::out,
+                                                 AsyncFileBuffer::NONE,
+                                                 512,
+                                                 2));
+    NS_TEST_ASSERT_MSG_EQ(async.Fail(), false, "Open (" << asyncFilename << ") returns error");
+    WritePackets(async);
+    NS_TEST_EXPECT_MSG_EQ(ReadFile(asyncFilename).size(), expected.size(), "Wrong file size");
+    NS_TEST_EXPECT_MSG_EQ((ReadFile(asyncFilename) == expected), true, "The files differ");
+
+    PcapFile bad;
+    bad.Open(std::make_unique<AsyncFileBuffer>(CreateTempDirFilename("missing/bad.pcap"),
+                                               std::ios::out));
+    NS_TEST_EXPECT_MSG_EQ(bad.Fail(), true, "Opening a file in a missing directory succeeds");
+
+#ifdef HAVE_ZLIB
+    std::string gzFilename = CreateTempDirFilename("async.pcap.gz");
+    PcapFile compressed;
+    compressed.Open(std::make_unique<AsyncFileBuffer>(gzFilename,
+                                                      std::ios::out,
+                                                      AsyncFileBuffer::GZIP,
+                                                      512,
+                                                      2));
+    NS_TEST_ASSERT_MSG_EQ(compressed.Fail(), false, "Open (" << gzFilename << ") returns error");
+    WritePackets(compressed);
+    gzFile gz = gzopen(gzFilename.c_str(), "rb");
+    NS_TEST_ASSERT_MSG_NE(gz, nullptr, "Unable to read " << gzFilename);
+    std::string uncompressed(expected.size() + 1, '\0');
+    int length = gzread(gz, uncompressed.data(), uncompressed.size());
+    gzclose(gz);
+    uncompressed.resize(std::max(length, 0));
+    NS_TEST_EXPECT_MSG_EQ((uncompressed == expected), true, "The compressed file differs");
+    NS_TEST_EXPECT_MSG_LT(ReadFile(gzFilename).size(), expected.size(), "Not compressed");
+    std::remove(gzFilename.c_str());
+#endif
+
+    std::remove(filename.c_str());
+    std::remove(asyncFilename.c_str());
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Test case to make sure that only the headers of the packets are
+ * written in the headers-only mode, with the original length of the packets.
+ */
+class HeadersOnlyTestCase : public TestCase
+{
+  public:
+    HeadersOnlyTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// A packet and the expected length of its headers
+    struct TestPacket
+    {
+        std::vector<uint8_t> data; //!< The packet
+        uint32_t headersLength;    //!< The expected length of the headers
+    };
+
+    /**
+     * Write packets in a headers-only pcap file, and check the records read.
+     * @param dataLinkType The data link type.
+     * @param snapLen The snaplen.
+     * @param packets The packets.
+     */
+    void CheckPackets(uint32_t dataLinkType,
+                      uint32_t snapLen,
+                      const std::vector<TestPacket>& packets);
+};
+
+HeadersOnlyTestCase::HeadersOnlyTestCase()
+    : TestCase("Check that only the headers are written in the headers-only mode")
+{
+}
+
+void
+HeadersOnlyTestCase::CheckPackets(uint32_t dataLinkType,
+                                  uint32_t snapLen,
+                                  const std::vector<TestPacket>& packets)
+{
+    std::string filename = CreateTempDirFilename("headers-only.pcap");
+    PcapFile f;
+    f.Open(filename, std::ios::out);
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Open (" << filename << ") returns error");
+    f.Init(dataLinkType, snapLen);
+    f.SetHeadersOnly(true);
+    for (const auto& packet : packets)
+    {
+        f.Write(1, 0, packet.data.data(), packet.data.size());
+        // the same packet, copied from a Packet
+        f.Write(2, 0, Create<Packet>(packet.data.data(), packet.data.size()));
+    }
+    f.Close();
+
+    f.Open(filename, std::ios::in);
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Open (" << filename << ") returns error");
+    uint8_t data[PcapFile::SNAPLEN_DEFAULT];
+    for (const auto& packet : packets)
+    {
+        uint32_t expected = std::min(packet.headersLength, snapLen);
+        for (uint32_t i = 0; i < 2; ++i)
+        {
+            uint32_t tsSec;
+            uint32_t tsUsec;
+            uint32_t inclLen;
+            uint32_t origLen;
+            uint32_t readLen;
+            f.Read(data, sizeof(data), tsSec, tsUsec, inclLen, origLen, readLen);
+            NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Read() returns error");
+            NS_TEST_EXPECT_MSG_EQ(inclLen, expected, "Wrong length of the headers");
+            NS_TEST_EXPECT_MSG_EQ(origLen, packet.data.size(), "Wrong original length");
+            NS_TEST_EXPECT_MSG_EQ(std::memcmp(data, packet.data.data(), readLen),
+                                  0,
+                                  "Wrong headers");
+        }
+    }
+    f.Close();
+    std::remove(filename.c_str());
+}
+
+void
+HeadersOnlyTestCase::DoRun()
+{
+    // IPv4 header with a 4 bytes option, and a TCP header with 12 bytes of options
+    std::vector<uint8_t> ipv4Tcp = {0x46, 0, 0, 0, 0, 0, 0, 0, 64, 6};
+    ipv4Tcp.resize(24);
+    ipv4Tcp.resize(24 + 12);
+    ipv4Tcp.push_back(0x80);
+    ipv4Tcp.resize(24 + 32 + 1000, 0xab);
+
+    // IPv4 fragment (with a non-zero offset) of a UDP datagram
+    std::vector<uint8_t> ipv4Fragment = {0x45, 0, 0, 0, 0, 0, 0x00, 0xb9, 64, 17};
+    ipv4Fragment.resize(20 + 600, 0xab);
+
+    // IPv6 header, with a Hop-by-Hop Options header of 16 bytes, and a UDP header
+    std::vector<uint8_t> ipv6Udp = {0x60, 0, 0, 0, 0, 0, 0};
+    ipv6Udp.resize(40);
+    ipv6Udp.push_back(17);
+    ipv6Udp.push_back(1);
+    ipv6Udp.resize(40 + 16 + 8 + 500, 0xab);
+
+    // ICMPv6
+    std::vector<uint8_t> icmpv6 = {0x60, 0, 0, 0, 0, 0, 58};
+    icmpv6.resize(40 + 8 + 100, 0xab);
+
+    auto prefix = [](std::vector<uint8_t> header, const std::vector<uint8_t>& data) {
+        header.insert(header.end(), data.begin(), data.end());
+        return header;
+    };
+
+    std::vector<uint8_t> ppp4 = {0x00, 0x21};
+    std::vector<uint8_t> ppp6 = {0x00, 0x57};
+    // not IP (LCP): truncated
+    std::vector<uint8_t> lcp = {0xc0, 0x21};
+    lcp.resize(1000, 0xab);
+    std::vector<TestPacket> pppPackets = {{prefix(ppp4, ipv4Tcp), 2 + 24 + 32},
+                                          {prefix(ppp4, ipv4Fragment), 2 + 20},
+                                          {prefix(ppp6, ipv6Udp), 2 + 40 + 16 + 8},
+                                          {prefix(ppp6, icmpv6), 2 + 40 + 8},
+                                          {lcp, PcapFile::HEADERS_MAX_LENGTH},
+                                          {ppp4, 2}};
+    CheckPackets(9, PcapFile::SNAPLEN_DEFAULT, pppPackets);
+    // the snaplen still applies
+    CheckPackets(9, 40, pppPackets);
+
+    std::vector<uint8_t> ethernet(12);
+    std::vector<uint8_t> ethernet4 = prefix(ethernet, {0x08, 0x00});
+    std::vector<uint8_t> vlan6 = prefix(ethernet, {0x81, 0x00, 0x00, 0x01, 0x86, 0xdd});
+    // the headers of a truncated packet
+    std::vector<uint8_t> truncated = prefix(ethernet4, ipv4Tcp);
+    truncated.resize(14 + 30);
+    CheckPackets(1,
+                 PcapFile::SNAPLEN_DEFAULT,
+                 {{prefix(ethernet4, ipv4Tcp), 14 + 24 + 32},
+                  {prefix(vlan6, ipv6Udp), 18 + 40 + 16 + 8},
+                  {truncated, 14 + 30}});
+
+    // unknown data link type: truncated
+    CheckPackets(105, PcapFile::SNAPLEN_DEFAULT, {{ipv4Tcp, PcapFile::HEADERS_MAX_LENGTH}});
+}
+
 /**
  * @ingroup network-test
  * @ingroup tests
@@ -1387,6 +1654,8 @@ PcapFileTestSuite::PcapFileTestSuite()
     AddTestCase(new RecordHeaderTestCase, TestCase::Duration::QUICK);
     AddTestCase(new ReadFileTestCase, TestCase::Duration::QUICK);
     AddTestCase(new DiffTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new AsyncWriteTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new HeadersOnlyTestCase, TestCase::Duration::QUICK);
 }
 
 static PcapFileTestSuite pcapFileTestSuite; //!< Static variable for test initialization
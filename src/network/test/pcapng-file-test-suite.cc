@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "ns3/packet-annotation-tag.h"
+#include "ns3/packet.h"
+#include "ns3/pcapng-file.h"
+#include "ns3/pcapng-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Test case to make sure that a PacketAnnotationTag keeps and
+ * formats its values.
+ */
+class PacketAnnotationTagTestCase : public TestCase
+{
+  public:
+    PacketAnnotationTagTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PacketAnnotationTagTestCase::PacketAnnotationTagTestCase()
+    : TestCase("Check the values and the format of a PacketAnnotationTag")
+{
+}
+
+void
+PacketAnnotationTagTestCase::DoRun()
+{
+    char buffer[128];
+    PacketAnnotationTag tag;
+    NS_TEST_EXPECT_MSG_EQ(tag.Format(buffer, sizeof(buffer)), 0, "An empty tag is formatted");
+    NS_TEST_EXPECT_MSG_EQ(std::string(buffer), "", "An empty tag is formatted");
+
+    tag.SetCongestionWindow(14480);
+    tag.SetQueueLength(3);
+    Ptr<Packet> p = Create<Packet>(100);
+    p->AddPacketTag(tag);
+
+    PacketAnnotationTag found;
+    NS_TEST_ASSERT_MSG_EQ(p->PeekPacketTag(found), true, "The tag is not found");
+    NS_TEST_EXPECT_MSG_EQ(found.HasSojournTime(), false, "The sojourn time is set");
+    NS_TEST_EXPECT_MSG_EQ(found.HasQueueLength(), true, "The queue length is not set");
+    NS_TEST_EXPECT_MSG_EQ(found.GetQueueLength(), 3, "Wrong queue length");
+    NS_TEST_EXPECT_MSG_EQ(found.GetCongestionWindow(), 14480, "Wrong congestion window");
+    NS_TEST_EXPECT_MSG_EQ(found.HasAlpha(), false, "The alpha is set");
+    found.SetSojournTime(MicroSeconds(1500));
+    found.SetAlpha(0.0625);
+    p->ReplacePacketTag(found);
+
+    NS_TEST_ASSERT_MSG_EQ(p->PeekPacketTag(tag), true, "The tag is not found");
+    NS_TEST_EXPECT_MSG_EQ(tag.GetSojournTime(), MicroSeconds(1500), "Wrong sojourn time");
+    NS_TEST_EXPECT_MSG_EQ(tag.GetAlpha(), 0.0625, "Wrong alpha");
+    uint32_t length = tag.Format(buffer, sizeof(buffer));
+    std::string expected = "sojourn=1500000ns qlen=3 cwnd=14480 alpha=0.0625";
+    NS_TEST_EXPECT_MSG_EQ(std::string(buffer), expected, "Wrong format");
+    NS_TEST_EXPECT_MSG_EQ(length, expected.size(), "Wrong length");
+
+    // truncated
+    length = tag.Format(buffer, 10);
+    NS_TEST_EXPECT_MSG_EQ(length, 9, "Wrong truncated length");
+    NS_TEST_EXPECT_MSG_EQ(std::string(buffer), expected.substr(0, 9), "Wrong truncated format");
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief Test case to make sure that the blocks of a pcapng file are written
+ * as specified.
+ */
+class PcapNgFileTestCase : public TestCase
+{
+  public:
+    PcapNgFileTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// A block of the file
+    struct Block
+    {
+        uint32_t type;             //!< The block type
+        std::vector<uint8_t> body; //!< The block body, between the lengths
+    };
+
+    /**
+     * Read the blocks of a file.
+     * @param filename The file name.
+     * @returns The blocks.
+     */
+    std::vector<Block> ReadBlocks(const std::string& filename);
+
+    /**
+     * Get a value of a block.
+     * @param block The block.
+     * @param offset The offset of the value in the body.
+     * @returns The value.
+     */
+    static uint32_t GetU32(const Block& block, uint32_t offset);
+
+    /**
+     * Find an option of a block.
+     * @param block The block.
+     * @param offset The offset of the options in the body.
+     * @param code The code of the option.
+     * @returns The value of the option, or "-" if it is not found.
+     */
+    std::string GetOption(const Block& block, uint32_t offset, uint16_t code);
+};
+
+PcapNgFileTestCase::PcapNgFileTestCase()
+    : TestCase("Check the blocks of a pcapng file")
+{
+}
+
+uint32_t
+PcapNgFileTestCase::GetU32(const Block& block, uint32_t offset)
+{
+    uint32_t value = 0;
+    if (offset + 4 <= block.body.size())
+    {
+        std::memcpy(&value, block.body.data() + offset, 4);
+    }
+    return value;
+}
+
+std::string
+PcapNgFileTestCase::GetOption(const Block& block, uint32_t offset, uint16_t code)
+{
+    while (offset + 4 <= block.body.size())
+    {
+        uint16_t optionCode;
+        uint16_t length;
+        std::memcpy(&optionCode, block.body.data() + offset, 2);
+        std::memcpy(&length, block.body.data() + offset + 2, 2);
+        if (optionCode == 0)
+        {
+            NS_TEST_EXPECT_MSG_EQ(offset + 4, block.body.size(), "Data after the last option");
+            break;
+        }
+        NS_TEST_EXPECT_MSG_LT_OR_EQ(offset + 4 + length, block.body.size(), "Truncated option");
+        if (offset + 4 + length > block.body.size())
+        {
+            break;
+        }
+        if (optionCode == code)
+        {
+            return std::string(block.body.begin() + offset + 4,
+                               block.body.begin() + offset + 4 + length);
+        }
+        offset += 4 + ((length + 3) & ~3U);
+    }
+    return "-";
+}
+
+std::vector<PcapNgFileTestCase::Block>
+PcapNgFileTestCase::ReadBlocks(const std::string& filename)
+{
+    std::ifstream is(filename, std::ios::binary);
+    std::vector<uint8_t> data{std::istreambuf_iterator<char>(is),
+                              std::istreambuf_iterator<char>()};
+    std::vector<Block> blocks;
+    uint32_t offset = 0;
+    while (offset + 12 <= data.size())
+    {
+        uint32_t type;
+        uint32_t length;
+        uint32_t trailingLength;
+        std::memcpy(&type, data.data() + offset, 4);
+        std::memcpy(&length, data.data() + offset + 4, 4);
+        NS_TEST_EXPECT_MSG_EQ(length % 4, 0, "The block length is not a multiple of 4");
+        if (length < 12 || offset + length > data.size())
+        {
+            break;
+        }
+        std::memcpy(&trailingLength, data.data() + offset + length - 4, 4);
+        NS_TEST_EXPECT_MSG_EQ(trailingLength, length, "The block lengths differ");
+        blocks.push_back({type,
+                          std::vector<uint8_t>(data.begin() + offset + 8,
+                                               data.begin() + offset + length - 4)});
+        offset += length;
+    }
+    NS_TEST_EXPECT_MSG_EQ(offset, data.size(), "Truncated file");
+    return blocks;
+}
+
+void
+PcapNgFileTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("test.pcapng");
+    Ptr<PcapNgFile> f = Create<PcapNgFile>();
+    f->Open(filename);
+    NS_TEST_ASSERT_MSG_EQ(f->Fail(), false, "Open (" << filename << ") returns error");
+    NS_TEST_EXPECT_MSG_EQ(f->AddInterface(9, "ppp0"), 0, "Wrong interface identifier");
+    NS_TEST_EXPECT_MSG_EQ(f->AddInterface(1, "eth0", "Ethernet", 10),
+                          1,
+                          "Wrong interface identifier");
+    NS_TEST_EXPECT_MSG_EQ(f->GetNInterfaces(), 2, "Wrong number of interfaces");
+
+    const uint8_t data[] = {0x00, 0x21, 0x45, 0x00, 0x00, 0x14, 0xab};
+    f->Write(0, 0x123456789aULL, data, sizeof(data), "first");
+    // truncated by the snaplen
+    f->Write(1, 2000, Create<Packet>(100), "");
+    PacketAnnotationTag tag;
+    tag.SetQueueLength(7);
+    Ptr<Packet> p = Create<Packet>(data, sizeof(data));
+    p->AddPacketTag(tag);
+    Simulator::Schedule(Seconds(1), &PcapNgHelper::Sink, f, 0, p);
+    Simulator::Run();
+    Simulator::Destroy();
+    NS_TEST_EXPECT_MSG_EQ(f->Fail(), false, "Write must not fail");
+    f->Close();
+
+    std::vector<Block> blocks = ReadBlocks(filename);
+    NS_TEST_ASSERT_MSG_EQ(blocks.size(), 6, "Wrong number of blocks");
+
+    // Section Header Block
+    NS_TEST_EXPECT_MSG_EQ(blocks[0].type, 0x0a0d0d0a, "Wrong block type");
+    NS_TEST_EXPECT_MSG_EQ(GetU32(blocks[0], 0), 0x1a2b3c4d, "Wrong byte order magic");
+    NS_TEST_EXPECT_MSG_EQ(GetOption(blocks[0], 16, 4), "ns-3", "Wrong application");
+
+    // Interface Description Blocks
+    NS_TEST_EXPECT_MSG_EQ(blocks[1].type, 1, "Wrong block type");
+    NS_TEST_EXPECT_MSG_EQ(GetU32(blocks[1], 0), 9, "Wrong data link type");
+    NS_TEST_EXPECT_MSG_EQ(GetU32(blocks[1], 4), 65535, "Wrong snaplen");
+    NS_TEST_EXPECT_MSG_EQ(GetOption(blocks[1], 8, 2), "ppp0", "Wrong name");
+    NS_TEST_EXPECT_MSG_EQ(GetOption(blocks[1], 8, 3), "-", "Unexpected description");
+    NS_TEST_EXPECT_MSG_EQ(GetOption(blocks[1], 8, 9), "\x09", "Wrong timestamp resolution");
+    NS_TEST_EXPECT_MSG_EQ(blocks[2].type, 1, "Wrong block type");
+    NS_TEST_EXPECT_MSG_EQ(GetU32(blocks[2], 0), 1, "Wrong data link type");
+    NS_TEST_EXPECT_MSG_EQ(GetU32(blocks[2], 4), 10, "Wrong snaplen");
+    NS_TEST_EXPECT_MSG_EQ(GetOption(blocks[2], 8, 2), "eth0", "Wrong name");
+    NS_TEST_EXPECT_MSG_EQ(GetOption(blocks[2], 8, 3), "Ethernet", "Wrong description");
+
+    // Enhanced Packet Blocks: interface, timestamp, lengths, data, options
+    NS_TEST_EXPECT_MSG_EQ(blocks[3].type, 6, "Wrong block type");
+    NS_TEST_EXPECT_MSG_EQ(GetU32(blocks[3], 0), 0, "Wrong interface");
+    NS_TEST_EXPECT_MSG_EQ(GetU32(blocks[3], 4), 0x12, "Wrong timestamp (high)");
+    NS_TEST_EXPECT_MSG_EQ(GetU32(blocks[3], 8), 0x3456789a, "Wrong timestamp (low)");
+    NS_TEST_EXPECT_MSG_EQ(GetU32(blocks[3], 12), sizeof(data), "Wrong captured length");
+    NS_TEST_EXPECT_MSG_EQ(GetU32(blocks[3], 16), sizeof(data), "Wrong original length");
+    NS_TEST_EXPECT_MSG_EQ(std::memcmp(blocks[3].body.data() + 20, data, sizeof(data)),
+                          0,
+                          "Wrong packet data");
+    NS_TEST_EXPECT_MSG_EQ(GetOption(blocks[3], 28, 1), "first", "Wrong comment");
+
+    NS_TEST_EXPECT_MSG_EQ(GetU32(blocks[4], 0), 1, "Wrong interface");
+    NS_TEST_EXPECT_MSG_EQ(GetU32(blocks[4], 8), 2000, "Wrong timestamp");
+    NS_TEST_EXPECT_MSG_EQ(GetU32(blocks[4], 12), 10, "Wrong captured length");
+    NS_TEST_EXPECT_MSG_EQ(GetU32(blocks[4], 16), 100, "Wrong original length");
+    NS_TEST_EXPECT_MSG_EQ(blocks[4].body.size(), 20 + 12, "Unexpected options");
+
+    NS_TEST_EXPECT_MSG_EQ(GetU32(blocks[5], 0), 0, "Wrong interface");
+    NS_TEST_EXPECT_MSG_EQ(GetU32(blocks[5], 4), 0, "Wrong timestamp (high)");
+    NS_TEST_EXPECT_MSG_EQ(GetU32(blocks[5], 8), 1000000000, "Wrong timestamp (low)");
+    NS_TEST_EXPECT_MSG_EQ(GetOption(blocks[5], 28, 1), "qlen=7", "Wrong annotation");
+
+    std::remove(filename.c_str());
+}
+
+/**
+ * @ingroup network-test
+ * @ingroup tests
+ *
+ * @brief pcapng file TestSuite
+ */
+class PcapNgFileTestSuite : public TestSuite
+{
+  public:
+    PcapNgFileTestSuite();
+};
+
+PcapNgFileTestSuite::PcapNgFileTestSuite()
+    : TestSuite("pcapng-file", Type::UNIT)
+{
+    AddTestCase(new PacketAnnotationTagTestCase, TestCase::Duration::QUICK);
+    AddTestCase(new PcapNgFileTestCase, TestCase::Duration::QUICK);
+}
+
+static PcapNgFileTestSuite pcapNgFileTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,425 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "async-file-buffer.h"
+
+#include "ns3/boolean.h"
+#include "ns3/enum.h"
+#include "ns3/fatal-error.h"
+#include "ns3/global-value.h"
+#include "ns3/log.h"
+#include "ns3/uinteger.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("AsyncFileBuffer");
+
+/**
+ * @relates AsyncFileBuffer
+ * Whether the trace helpers write their files through an AsyncFileBuffer.
+ */
+static GlobalValue g_asyncTraceEnabled(
+    "AsyncTraceEnabled",
+    "Write the pcap and ASCII trace files of the helpers from a background thread",
+    BooleanValue(false),
+    MakeBooleanChecker());
+
+/**
+ * @relates AsyncFileBuffer
+ * The size of the blocks of the trace files written from a background thread.
+ */
+static GlobalValue g_asyncTraceBufferSize(
+    "AsyncTraceBufferSize",
+    "The size of the blocks of the trace files written from a background thread",
+    UintegerValue(65536),
+    MakeUintegerChecker<uint32_t>(512));
+
+/**
+ * @relates AsyncFileBuffer
+ * The compression of the trace files written from a background thread.
+ */
+static GlobalValue g_asyncTraceCompression(
+    "AsyncTraceCompression",
+    "The compression of the trace files written from a background thread",
+    EnumValue(AsyncFileBuffer::NONE),
+    MakeEnumChecker(AsyncFileBuffer::NONE, "none", AsyncFileBuffer::GZIP, "gzip"));
+
+/**
+ * @ingroup network
+ *
+ * The writer thread of the AsyncFileBuffer instances: it runs while a
+ * buffer is open.
+ */
+class AsyncFileWriter
+{
+  public:
+    ~AsyncFileWriter();
+
+    /**
+     * @returns The writer.
+     */
+    static AsyncFileWriter& Get();
+
+    /// Register an open buffer, and start the thread if needed.
+    void Register();
+    /// Unregister a closed buffer, and stop the thread if it was the last one.
+    void Unregister();
+
+    std::mutex m_mutex;                //!< Protects the queue and the blocks of the buffers
+    std::condition_variable m_queued;  //!< Notified when a block is queued
+    std::condition_variable m_written; //!< Notified when a block is written
+    /// The blocks to write, with their buffer
+    std::deque<std::pair<AsyncFileBuffer*, std::vector<char>>> m_queue;
+
+  private:
+    /// Write the queued blocks, until stopped.
+    void Run();
+    /// Stop the thread.
+    void Stop();
+
+    std::thread m_thread; //!< The thread
+    uint32_t m_nFiles{0}; //!< The number of open buffers
+    bool m_stop{false};   //!< Whether the thread must stop
+};
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+    Stop();
+}
+
+AsyncFileWriter&
+AsyncFileWriter::Get()
+{
+    static AsyncFileWriter writer;
+    return writer;
+}
+
+void
+AsyncFileWriter::Register()
+{
+    std::unique_lock lock(m_mutex);
+    if (m_nFiles++ == 0 && !m_thread.joinable())
+    {
+        m_stop = false;
+        m_thread = std::thread(&AsyncFileWriter::Run, this);
+    }
+}
+
+void
+AsyncFileWriter::Unregister()
+{
+    {
+        std::unique_lock lock(m_mutex);
+        if (--m_nFiles > 0)
+        {
+            return;
+        }
+    }
+    Stop();
+}
+
+void
+AsyncFileWriter::Stop()
+{
+    {
+        std::unique_lock lock(m_mutex);
+        m_stop = true;
+    }
+    m_queued.notify_one();
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+void
+AsyncFileWriter::Run()
+{
+    std::unique_lock lock(m_mutex);
+    while (true)
+    {
+        m_queued.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+        if (m_queue.empty())
+        {
+            return;
+        }
+        auto [file, block] = std::move(m_queue.front());
+        m_queue.pop_front();
+        lock.unlock();
+        file->WriteBlock(block);
+        lock.lock();
+        file->m_pendingBlocks--;
+        file->m_free.push_back(std::move(block));
+        m_written.notify_all();
+    }
+}
+
+AsyncFileBuffer::AsyncFileBuffer(const std::string& filename,
+                                 std::ios::openmode mode,
+                                 Compression compression,
+                                 uint32_t blockSize,
+                                 uint32_t nBlocks)
+    : m_file(nullptr),
+      m_compression(compression),
+      m_blockSize(blockSize),
+      m_nBlocks(std::max<uint32_t>(nBlocks, 2)),
+      m_allocatedBlocks(0),
+      m_pendingBlocks(0),
+      m_submitted(0),
+      m_error(false)
+{
+    NS_LOG_FUNCTION(this << filename << mode << compression << blockSize << nBlocks);
+    const char* fileMode = (mode & std::ios::app) ? "ab" : "wb";
+    if (compression == GZIP)
+    {
+#ifdef HAVE_ZLIB
+        m_file = gzopen(filename.c_str(), fileMode);
+#else
+        NS_FATAL_ERROR("Compressed trace files require ns-3 to be built with zlib");
+#endif
+    }
+    else
+    {
+        m_file = std::fopen(filename.c_str(), fileMode);
+        if (m_file)
+        {
+            // the blocks are written whole: no stdio buffering
+            std::setvbuf(static_cast<FILE*>(m_file), nullptr, _IONBF, 0);
+        }
+    }
+    if (m_file)
+    {
+        AsyncFileWriter::Get().Register();
+    }
+    else
+    {
+        NS_LOG_WARN("Unable to open " << filename);
+        m_error = true;
+    }
+}
+
+AsyncFileBuffer::~AsyncFileBuffer()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+std::unique_ptr<AsyncFileBuffer>
+AsyncFileBuffer::CreateForTrace(const std::string& filename, std::ios::openmode mode)
+{
+    NS_LOG_FUNCTION(filename << mode);
+    BooleanValue enabled;
+    g_asyncTraceEnabled.GetValue(enabled);
+    if (!enabled.Get() || (mode & std::ios::in))
+    {
+        return nullptr;
+    }
+    UintegerValue blockSize;
+    g_asyncTraceBufferSize.GetValue(blockSize);
+    EnumValue<Compression> compression;
+    g_asyncTraceCompression.GetValue(compression);
+    std::string name = filename;
+    if (compression.Get() == GZIP && !name.ends_with(".gz"))
+    {
+        name += ".gz";
+    }
+    return std::make_unique<AsyncFileBuffer>(name, mode, compression.Get(), blockSize.Get());
+}
+
+bool
+AsyncFileBuffer::IsOpen() const
+{
+    return m_file && !m_error;
+}
+
+void
+AsyncFileBuffer::Submit()
+{
+    AsyncFileWriter& writer = AsyncFileWriter::Get();
+    std::unique_lock lock(writer.m_mutex);
+    auto size = static_cast<uint32_t>(pptr() - pbase());
+    if (size > 0)
+    {
+        m_submitted += size;
+        m_block.resize(size);
+        writer.m_queue.emplace_back(this, std::move(m_block));
+        m_pendingBlocks++;
+        writer.m_queued.notify_one();
+    }
+    // wait for the writer thread when all the blocks are queued
+    writer.m_written.wait(lock,
+                          [this] { return !m_free.empty() || m_allocatedBlocks < m_nBlocks; });
+    if (!m_free.empty())
+    {
+        m_block = std::move(m_free.back());
+        m_free.pop_back();
+    }
+    else
+    {
+        m_allocatedBlocks++;
+        m_block = std::vector<char>();
+    }
+    lock.unlock();
+    m_block.resize(m_blockSize);
+    setp(m_block.data(), m_block.data() + m_block.size());
+}
+
+void
+AsyncFileBuffer::WriteBlock(const std::vector<char>& block)
+{
+    // called in the writer thread: no logging
+    if (m_compression == GZIP)
+    {
+#ifdef HAVE_ZLIB
+        if (gzwrite(static_cast<gzFile>(m_file), block.data(), block.size()) !=
+            static_cast<int>(block.size()))
+        {
+            m_error = true;
+        }
+#endif
+    }
+    else if (std::fwrite(block.data(), 1, block.size(), static_cast<FILE*>(m_file)) !=
+             block.size())
+    {
+        m_error = true;
+    }
+}
+
+AsyncFileBuffer::int_type
+AsyncFileBuffer::overflow(int_type c)
+{
+    if (!IsOpen())
+    {
+        return traits_type::eof();
+    }
+    Submit();
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+    {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+    }
+    return traits_type::not_eof(c);
+}
+
+std::streamsize
+AsyncFileBuffer::xsputn(const char* s, std::streamsize n)
+{
+    std::streamsize written = 0;
+    while (written < n)
+    {
+        std::streamsize room = epptr() - pptr();
+        if (room == 0)
+        {
+            if (!IsOpen())
+            {
+                break;
+            }
+            Submit();
+            continue;
+        }
+        std::streamsize count = std::min(room, n - written);
+        std::memcpy(pptr(), s + written, count);
+        pbump(static_cast<int>(count));
+        written += count;
+    }
+    return written;
+}
+
+int
+AsyncFileBuffer::sync()
+{
+    return m_error ? -1 : 0;
+}
+
+AsyncFileBuffer::pos_type
+AsyncFileBuffer::seekoff(off_type off, std::ios::seekdir dir, std::ios::openmode which)
+{
+    auto position = static_cast<off_type>(m_submitted + (pptr() - pbase()));
+    if ((which & std::ios::out) && ((dir == std::ios::cur && off == 0) ||
+                                    (dir == std::ios::beg && off == position)))
+    {
+        return pos_type(position);
+    }
+    return pos_type(off_type(-1));
+}
+
+AsyncFileBuffer::pos_type
+AsyncFileBuffer::seekpos(pos_type pos, std::ios::openmode which)
+{
+    return seekoff(off_type(pos), std::ios::beg, which);
+}
+
+void
+AsyncFileBuffer::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_file)
+    {
+        return;
+    }
+    if (pptr() != pbase())
+    {
+        Submit();
+    }
+    AsyncFileWriter& writer = AsyncFileWriter::Get();
+    std::unique_lock lock(writer.m_mutex);
+    writer.m_written.wait(lock, [this] { return m_pendingBlocks == 0; });
+    lock.unlock();
+    // the writer thread is done with the file
+    if (m_compression == GZIP)
+    {
+#ifdef HAVE_ZLIB
+        gzflush(static_cast<gzFile>(m_file), Z_SYNC_FLUSH);
+#endif
+    }
+    else
+    {
+        std::fflush(static_cast<FILE*>(m_file));
+    }
+}
+
+void
+AsyncFileBuffer::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_file)
+    {
+        return;
+    }
+    Flush();
+    if (m_compression == GZIP)
+    {
+#ifdef HAVE_ZLIB
+        if (gzclose(static_cast<gzFile>(m_file)) != Z_OK)
+        {
+            m_error = true;
+        }
+#endif
+    }
+    else if (std::fclose(static_cast<FILE*>(m_file)) != 0)
+    {
+        m_error = true;
+    }
+    m_file = nullptr;
+    setp(nullptr, nullptr);
+    AsyncFileWriter::Get().Unregister();
+}
+
+} // namespace ns3
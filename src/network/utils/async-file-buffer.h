@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef ASYNC_FILE_BUFFER_H
+#define ASYNC_FILE_BUFFER_H
+
+#include <atomic>
+#include <cstdint>
+#include <ios>
+#include <memory>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * @ingroup network
+ *
+ * @brief A stream buffer writing a file from a background thread.
+ *
+ * The data written in the buffer is copied in blocks, and the full blocks
+ * are handed to a writer thread, shared by all the open buffers, which
+ * writes them to the files, compressing them if requested.  The simulation
+ * thread therefore only copies the data, and only waits for the writer
+ * thread when all the blocks of a file are in its queue.
+ *
+ * Flushing the stream (e.g., with std::endl) does not wait for the data to
+ * be written, so that the ASCII traces, which flush every line, are
+ * buffered too: the data is written when the blocks are full and when the
+ * buffer is closed.  The data still buffered if the program aborts is lost.
+ *
+ * The trace helpers (PcapHelper::CreateFile() and
+ * AsciiTraceHelper::CreateFileStream()) write their files through this
+ * buffer when the "AsyncTraceEnabled" GlobalValue is true; see
+ * CreateForTrace().
+ */
+class AsyncFileBuffer : public std::streambuf
+{
+  public:
+    /// The compression of the files
+    enum Compression
+    {
+        NONE, //!< Not compressed
+        GZIP  //!< Compressed with gzip (.gz)
+    };
+
+    /**
+     * Open a file.
+     * @param filename The file name.
+     * @param mode The open mode: the file is truncated unless std::ios::app is set.
+     * @param compression The compression of the file.
+     * @param blockSize The size of the blocks handed to the writer thread.
+     * @param nBlocks The maximum number of blocks of the file.
+     */
+    AsyncFileBuffer(const std::string& filename,
+                    std::ios::openmode mode,
+                    Compression compression = NONE,
+                    uint32_t blockSize = 65536,
+                    uint32_t nBlocks = 4);
+    ~AsyncFileBuffer() override;
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    AsyncFileBuffer(const AsyncFileBuffer&) = delete;
+    AsyncFileBuffer& operator=(const AsyncFileBuffer&) = delete;
+
+    /**
+     * Create the buffer of a trace file, as configured by the
+     * "AsyncTraceEnabled", "AsyncTraceBufferSize" and "AsyncTraceCompression"
+     * GlobalValues.  The ".gz" extension is added to the names of the
+     * compressed files.
+     * @param filename The file name.
+     * @param mode The open mode.
+     * @returns The buffer, or nullptr if the asynchronous trace files are
+     * not enabled or the file is opened for reading.
+     */
+    static std::unique_ptr<AsyncFileBuffer> CreateForTrace(const std::string& filename,
+                                                           std::ios::openmode mode);
+
+    /**
+     * @returns true if the file was opened and no write failed.
+     */
+    bool IsOpen() const;
+
+    /**
+     * Write all the buffered data and close the file.
+     */
+    void Close();
+
+    /**
+     * Write all the buffered data, and wait until it is written.
+     */
+    void Flush();
+
+  protected:
+    /**
+     * Hand the current block to the writer thread, and store a character in the next one.
+     * @param c The character, or EOF.
+     * @returns The character, or EOF on error.
+     */
+    int_type overflow(int_type c) override;
+    /**
+     * Store characters in the blocks.
+     * @param s The characters.
+     * @param n The number of characters.
+     * @returns The number of characters stored.
+     */
+    std::streamsize xsputn(const char* s, std::streamsize n) override;
+    /**
+     * Do nothing: the data is written when the blocks are full.
+     * @returns 0, or -1 if a write failed.
+     */
+    int sync() override;
+    /**
+     * Get the write position; the buffer cannot seek.
+     * @param off The offset.
+     * @param dir The origin of the offset.
+     * @param which The position to get.
+     * @returns The write position if the offset is that position, else -1.
+     */
+    pos_type seekoff(off_type off,
+                     std::ios::seekdir dir,
+                     std::ios::openmode which = std::ios::out) override;
+    /**
+     * Get the write position; the buffer cannot seek.
+     * @param pos The position.
+     * @param which The position to get.
+     * @returns The write position if pos is that position, else -1.
+     */
+    pos_type seekpos(pos_type pos, std::ios::openmode which = std::ios::out) override;
+
+  private:
+    friend class AsyncFileWriter;
+
+    /// Hand the current block to the writer thread, and take a free block.
+    void Submit();
+
+    /**
+     * Write a block to the file, in the writer thread.
+     * @param block The block.
+     */
+    void WriteBlock(const std::vector<char>& block);
+
+    void* m_file;                          //!< The FILE, or gzFile if compressed
+    Compression m_compression;             //!< The compression
+    uint32_t m_blockSize;                  //!< The size of the blocks
+    uint32_t m_nBlocks;                    //!< The maximum number of blocks
+    uint32_t m_allocatedBlocks;            //!< The number of blocks allocated
+    uint32_t m_pendingBlocks;              //!< The blocks queued for the writer thread
+    std::vector<char> m_block;             //!< The block being filled
+    std::vector<std::vector<char>> m_free; //!< The free blocks
+    uint64_t m_submitted;                  //!< The number of bytes handed to the writer thread
+    std::atomic<bool> m_error;             //!< Whether a write failed
+};
+
+} // namespace ns3
+
+#endif /* ASYNC_FILE_BUFFER_H */
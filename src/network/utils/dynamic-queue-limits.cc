@@ -53,10 +53,31 @@ DynamicQueueLimits::GetTypeId()
                                           UintegerValue(0),
                                           MakeUintegerAccessor(&DynamicQueueLimits::m_minLimit),
                                           MakeUintegerChecker<uint32_t>())
+                            .AddAttribute("CompletionBatch",
+                                          "The number of completed objects accumulated before "
+                                          "the limit is recomputed (0 to recompute it at each "
+                                          "completion).  It is also recomputed once all the "
+                                          "queued objects are completed.",
+                                          UintegerValue(0),
+                                          MakeUintegerAccessor(
+                                              &DynamicQueueLimits::m_completionBatch),
+                                          MakeUintegerChecker<uint32_t>())
+                            .AddAttribute("StallThreshold",
+                                          "The time without completion, while objects are "
+                                          "queued, reported as a stall (0 to disable)",
+                                          TimeValue(Seconds(0)),
+                                          MakeTimeAccessor(&DynamicQueueLimits::m_stallThreshold),
+                                          MakeTimeChecker())
                             .AddTraceSource("Limit",
                                             "Limit value calculated by DQL",
                                             MakeTraceSourceAccessor(&DynamicQueueLimits::m_limit),
-                                            "ns3::TracedValueCallback::Uint32");
+                                            "ns3::TracedValueCallback::Uint32")
+                            .AddTraceSource("Stall",
+                                            "A completion came after a stall, whose duration "
+                                            "is longer than the StallThreshold",
+                                            MakeTraceSourceAccessor(
+                                                &DynamicQueueLimits::m_stallTrace),
+                                            "ns3::Time::TracedCallback");
     return tid;
 }
 
@@ -85,10 +106,43 @@ DynamicQueueLimits::Reset()
     m_prevOvlimit = 0;
     m_lowestSlack = UINTMAX;
     m_slackStartTime = Simulator::Now();
+    m_pendingCompleted = 0;
+    m_lastProgressTime = Simulator::Now();
 }
 
 void
 DynamicQueueLimits::Completed(uint32_t count)
+{
+    NS_LOG_FUNCTION(this << count);
+
+    if (!m_stallThreshold.IsZero())
+    {
+        Time now = Simulator::Now();
+        if (now - m_lastProgressTime > m_stallThreshold)
+        {
+            NS_LOG_DEBUG("Stall of " << (now - m_lastProgressTime).As(Time::US));
+            m_stallTrace(now - m_lastProgressTime);
+        }
+        m_lastProgressTime = now;
+    }
+
+    m_pendingCompleted += count;
+
+    // Can't complete more than what's in queue
+    NS_ASSERT(m_pendingCompleted <= m_numQueued - m_numCompleted);
+
+    // Only recompute the limit once a batch is completed, or the queue is empty
+    if (m_pendingCompleted < m_completionBatch &&
+        m_numCompleted + m_pendingCompleted != m_numQueued)
+    {
+        return;
+    }
+    UpdateLimit(m_pendingCompleted);
+    m_pendingCompleted = 0;
+}
+
+void
+DynamicQueueLimits::UpdateLimit(uint32_t count)
 {
     NS_LOG_FUNCTION(this << count);
     uint32_t inprogress;
@@ -101,9 +155,6 @@ DynamicQueueLimits::Completed(uint32_t count)
 
     numQueued = m_numQueued;
 
-    // Can't complete more than what's in queue
-    NS_ASSERT(count <= numQueued - m_numCompleted);
-
     completed = m_numCompleted + count;
     limit = m_limit;
     ovlimit = Posdiff(numQueued - m_numCompleted, limit);
@@ -209,6 +260,12 @@ DynamicQueueLimits::Queued(uint32_t count)
     NS_LOG_FUNCTION(this << count);
     NS_ASSERT(count <= DQL_MAX_OBJECT);
 
+    if (!m_stallThreshold.IsZero() && m_numQueued == m_numCompleted + m_pendingCompleted)
+    {
+        // the queue was empty: the time without completion starts now
+        m_lastProgressTime = Simulator::Now();
+    }
+
     m_lastObjCnt = count;
     m_numQueued += count;
 }
@@ -17,6 +17,7 @@
 #include "queue-limits.h"
 
 #include "ns3/nstime.h"
+#include "ns3/traced-callback.h"
 #include "ns3/traced-value.h"
 
 #include <limits.h>
@@ -49,6 +50,16 @@ namespace ns3
  *           on the object limit and how many objects are already enqueued
  *   Queued - called when objects are enqueued to record number of objects
  *
+ * On fast links, where a completion is recorded for every packet, the
+ * limit can be recomputed less often: with the CompletionBatch attribute,
+ * the completed objects are accumulated until their number reaches the
+ * batch, or until all the queued objects are completed, much like the
+ * completions batched by the interrupts of a real device.  The objects
+ * available are only updated when the limit is recomputed.
+ *
+ * With the StallThreshold attribute, a completion which comes after more
+ * than this time without completion, while objects were queued, is
+ * reported by the Stall trace source, with the duration of the stall.
  */
 
 class DynamicQueueLimits : public QueueLimits
@@ -78,6 +89,12 @@ class DynamicQueueLimits : public QueueLimits
      */
     int32_t Posdiff(int32_t a, int32_t b);
 
+    /**
+     * Recompute the limit after objects are completed.
+     * @param count The number of objects completed since the last computation.
+     */
+    void UpdateLimit(uint32_t count);
+
     // Fields accessed in enqueue path
     uint32_t m_numQueued{0};  //!< Total ever queued
     uint32_t m_adjLimit{0};   //!< limit + num_completed
@@ -94,10 +111,16 @@ class DynamicQueueLimits : public QueueLimits
     uint32_t m_lowestSlack{std::numeric_limits<uint32_t>::max()}; //!< Lowest slack found
     Time m_slackStartTime{Seconds(0)};                            //!< Time slacks seen
 
+    uint32_t m_pendingCompleted{0};    //!< Completed, not yet accounted in the limit
+    Time m_lastProgressTime;           //!< Time of the last completion, or first queuing
+    TracedCallback<Time> m_stallTrace; //!< Duration of the stalls
+
     // Configuration
-    uint32_t m_maxLimit;  //!< Max limit
-    uint32_t m_minLimit;  //!< Minimum limit
-    Time m_slackHoldTime; //!< Time to measure slack
+    uint32_t m_maxLimit;        //!< Max limit
+    uint32_t m_minLimit;        //!< Minimum limit
+    Time m_slackHoldTime;       //!< Time to measure slack
+    uint32_t m_completionBatch; //!< Completed objects accumulated before computing the limit
+    Time m_stallThreshold;      //!< Time without completion reported as a stall
 };
 
 } // namespace ns3
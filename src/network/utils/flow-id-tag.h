@@ -8,6 +8,7 @@
 #ifndef FLOW_ID_TAG_H
 #define FLOW_ID_TAG_H
 
+#include "ns3/packet-tag-list.h"
 #include "ns3/tag.h"
 
 namespace ns3
@@ -54,6 +55,15 @@ class FlowIdTag : public Tag
     uint32_t m_flowId; //!< Flow ID
 };
 
+/**
+ * @brief FlowIdTag is stored in a slot of the PacketTagList hot tag store.
+ */
+template <>
+struct PacketTagSlot<FlowIdTag>
+{
+    static constexpr uint8_t index = PacketTagList::SLOT_FLOW_ID; //!< The slot
+};
+
 } // namespace ns3
 
 #endif /* FLOW_ID_TAG_H */
@@ -353,6 +353,13 @@ NetDeviceQueue::PacketDequeued(QueueType* queue, Ptr<const typename QueueType::I
     NS_LOG_FUNCTION(this << queue << item);
     NS_ASSERT_MSG(m_device, "Aggregated NetDevice not set");
 
+    // Without BQL, the event below has nothing to do unless the queue is
+    // stopped: save it, as a packet is dequeued at every transmission
+    if (!m_queueLimits && !m_stoppedByDevice)
+    {
+        return;
+    }
+
     Simulator::ScheduleNow([=, this]() {
         // Inform BQL
         NotifyTransmittedBytes(item->GetSize());
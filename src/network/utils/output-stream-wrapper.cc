@@ -11,6 +11,7 @@
 #include "ns3/log.h"
 
 #include <fstream>
+#include <utility>
 
 namespace ns3
 {
@@ -39,6 +40,16 @@ OutputStreamWrapper::OutputStreamWrapper(std::ostream* os)
     NS_ABORT_MSG_UNLESS(m_ostream->good(), "Output stream is not valid for writing.");
 }
 
+OutputStreamWrapper::OutputStreamWrapper(std::unique_ptr<AsyncFileBuffer> buffer)
+    : m_destroyable(true),
+      m_buffer(std::move(buffer))
+{
+    NS_LOG_FUNCTION(this << m_buffer.get());
+    m_ostream = new std::ostream(m_buffer.get());
+    FatalImpl::RegisterStream(m_ostream);
+    NS_ABORT_MSG_UNLESS(m_buffer->IsOpen(), "Output buffer is not valid for writing.");
+}
+
 OutputStreamWrapper::~OutputStreamWrapper()
 {
     NS_LOG_FUNCTION(this);
@@ -7,11 +7,14 @@
 #ifndef OUTPUT_STREAM_WRAPPER_H
 #define OUTPUT_STREAM_WRAPPER_H
 
+#include "async-file-buffer.h"
+
 #include "ns3/object.h"
 #include "ns3/ptr.h"
 #include "ns3/simple-ref-count.h"
 
 #include <fstream>
+#include <memory>
 
 namespace ns3
 {
@@ -71,6 +74,12 @@ class OutputStreamWrapper : public SimpleRefCount<OutputStreamWrapper>
      * @param os output stream
      */
     OutputStreamWrapper(std::ostream* os);
+    /**
+     * Constructor
+     * @param buffer the buffer written by the stream, such as an
+     * AsyncFileBuffer writing a file from a background thread
+     */
+    OutputStreamWrapper(std::unique_ptr<AsyncFileBuffer> buffer);
     ~OutputStreamWrapper();
 
     /**
@@ -83,8 +92,9 @@ class OutputStreamWrapper : public SimpleRefCount<OutputStreamWrapper>
     std::ostream* GetStream();
 
   private:
-    std::ostream* m_ostream; //!< The output stream
-    bool m_destroyable;      //!< Can be destroyed
+    std::ostream* m_ostream;                   //!< The output stream
+    bool m_destroyable;                        //!< Can be destroyed
+    std::unique_ptr<AsyncFileBuffer> m_buffer; //!< The buffer of the stream, if owned
 };
 
 } // namespace ns3
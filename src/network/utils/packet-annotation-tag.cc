@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "packet-annotation-tag.h"
+
+#include "ns3/tag-buffer.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+
+namespace ns3
+{
+
+NS_OBJECT_ENSURE_REGISTERED(PacketAnnotationTag);
+
+TypeId
+PacketAnnotationTag::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::PacketAnnotationTag")
+                            .SetParent<Tag>()
+                            .SetGroupName("Network")
+                            .AddConstructor<PacketAnnotationTag>();
+    return tid;
+}
+
+TypeId
+PacketAnnotationTag::GetInstanceTypeId() const
+{
+    return GetTypeId();
+}
+
+PacketAnnotationTag::PacketAnnotationTag()
+    : m_flags(0),
+      m_sojournTime(0),
+      m_queueLength(0),
+      m_cwnd(0),
+      m_alpha(0)
+{
+}
+
+uint32_t
+PacketAnnotationTag::GetSerializedSize() const
+{
+    return 1 + 8 + 4 + 4 + 8;
+}
+
+void
+PacketAnnotationTag::Serialize(TagBuffer i) const
+{
+    i.WriteU8(m_flags);
+    i.WriteU64(m_sojournTime);
+    i.WriteU32(m_queueLength);
+    i.WriteU32(m_cwnd);
+    i.WriteDouble(m_alpha);
+}
+
+void
+PacketAnnotationTag::Deserialize(TagBuffer i)
+{
+    m_flags = i.ReadU8();
+    m_sojournTime = i.ReadU64();
+    m_queueLength = i.ReadU32();
+    m_cwnd = i.ReadU32();
+    m_alpha = i.ReadDouble();
+}
+
+void
+PacketAnnotationTag::Print(std::ostream& os) const
+{
+    char buffer[128];
+    Format(buffer, sizeof(buffer));
+    os << buffer;
+}
+
+void
+PacketAnnotationTag::SetSojournTime(Time sojournTime)
+{
+    m_sojournTime = sojournTime.GetNanoSeconds();
+    m_flags |= SOJOURN_TIME;
+}
+
+Time
+PacketAnnotationTag::GetSojournTime() const
+{
+    return NanoSeconds(m_sojournTime);
+}
+
+bool
+PacketAnnotationTag::HasSojournTime() const
+{
+    return m_flags & SOJOURN_TIME;
+}
+
+void
+PacketAnnotationTag::SetQueueLength(uint32_t queueLength)
+{
+    m_queueLength = queueLength;
+    m_flags |= QUEUE_LENGTH;
+}
+
+uint32_t
+PacketAnnotationTag::GetQueueLength() const
+{
+    return m_queueLength;
+}
+
+bool
+PacketAnnotationTag::HasQueueLength() const
+{
+    return m_flags & QUEUE_LENGTH;
+}
+
+void
+PacketAnnotationTag::SetCongestionWindow(uint32_t cwnd)
+{
+    m_cwnd = cwnd;
+    m_flags |= CWND;
+}
+
+uint32_t
+PacketAnnotationTag::GetCongestionWindow() const
+{
+    return m_cwnd;
+}
+
+bool
+PacketAnnotationTag::HasCongestionWindow() const
+{
+    return m_flags & CWND;
+}
+
+void
+PacketAnnotationTag::SetAlpha(double alpha)
+{
+    m_alpha = alpha;
+    m_flags |= ALPHA;
+}
+
+double
+PacketAnnotationTag::GetAlpha() const
+{
+    return m_alpha;
+}
+
+bool
+PacketAnnotationTag::HasAlpha() const
+{
+    return m_flags & ALPHA;
+}
+
+uint32_t
+PacketAnnotationTag::Format(char* buffer, uint32_t size) const
+{
+    uint32_t length = 0;
+    auto append = [&](int written) {
+        if (written > 0)
+        {
+            length = std::min<uint32_t>(length + written, size > 0 ? size - 1 : 0);
+        }
+    };
+    if (size > 0)
+    {
+        buffer[0] = '\0';
+    }
+    if (HasSojournTime())
+    {
+        append(std::snprintf(buffer + length,
+                             size - length,
+                             "sojourn=%" PRId64 "ns ",
+                             m_sojournTime));
+    }
+    if (HasQueueLength())
+    {
+        append(std::snprintf(buffer + length, size - length, "qlen=%u ", m_queueLength));
+    }
+    if (HasCongestionWindow())
+    {
+        append(std::snprintf(buffer + length, size - length, "cwnd=%u ", m_cwnd));
+    }
+    if (HasAlpha())
+    {
+        append(std::snprintf(buffer + length, size - length, "alpha=%g ", m_alpha));
+    }
+    // remove the trailing space
+    if (length > 0 && buffer[length - 1] == ' ')
+    {
+        buffer[--length] = '\0';
+    }
+    return length;
+}
+
+} // namespace ns3
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PACKET_ANNOTATION_TAG_H
+#define PACKET_ANNOTATION_TAG_H
+
+#include "ns3/nstime.h"
+#include "ns3/tag.h"
+
+#include <cstdint>
+
+namespace ns3
+{
+
+/**
+ * @ingroup network
+ *
+ * @brief Tag holding the state of the models which handled a packet.
+ *
+ * The queue discs and the TCP sockets with the "AnnotatePackets" attribute
+ * set record in this tag the sojourn time of the packet and the length of
+ * the queue when it was enqueued, or the congestion window (and the DCTCP
+ * alpha) when it was sent; each value is set by the last model which
+ * handled the packet.  The pcapng traces (see PcapNgHelper) write the
+ * values as the comment of the packet records.
+ */
+class PacketAnnotationTag : public Tag
+{
+  public:
+    /**
+     * @brief Get the type ID.
+     * @return the object TypeId
+     */
+    static TypeId GetTypeId();
+    TypeId GetInstanceTypeId() const override;
+
+    PacketAnnotationTag();
+
+    void Serialize(TagBuffer i) const override;
+    void Deserialize(TagBuffer i) override;
+    uint32_t GetSerializedSize() const override;
+    void Print(std::ostream& os) const override;
+
+    /**
+     * @param sojournTime The sojourn time of the packet in the queue disc.
+     */
+    void SetSojournTime(Time sojournTime);
+    /**
+     * @returns The sojourn time of the packet in the queue disc.
+     */
+    Time GetSojournTime() const;
+    /**
+     * @returns true if the sojourn time is set.
+     */
+    bool HasSojournTime() const;
+
+    /**
+     * @param queueLength The number of packets in the queue disc when the packet was enqueued.
+     */
+    void SetQueueLength(uint32_t queueLength);
+    /**
+     * @returns The number of packets in the queue disc when the packet was enqueued.
+     */
+    uint32_t GetQueueLength() const;
+    /**
+     * @returns true if the queue length is set.
+     */
+    bool HasQueueLength() const;
+
+    /**
+     * @param cwnd The congestion window (in bytes) when the packet was sent.
+     */
+    void SetCongestionWindow(uint32_t cwnd);
+    /**
+     * @returns The congestion window (in bytes) when the packet was sent.
+     */
+    uint32_t GetCongestionWindow() const;
+    /**
+     * @returns true if the congestion window is set.
+     */
+    bool HasCongestionWindow() const;
+
+    /**
+     * @param alpha The DCTCP alpha when the packet was sent.
+     */
+    void SetAlpha(double alpha);
+    /**
+     * @returns The DCTCP alpha when the packet was sent.
+     */
+    double GetAlpha() const;
+    /**
+     * @returns true if the alpha is set.
+     */
+    bool HasAlpha() const;
+
+    /**
+     * Write the values set, e.g. "sojourn=1200000ns qlen=3 cwnd=14480 alpha=0.0625",
+     * in a buffer, without allocation.
+     * @param buffer The buffer.
+     * @param size The size of the buffer.
+     * @returns The length of the text written, without the terminating null character.
+     */
+    uint32_t Format(char* buffer, uint32_t size) const;
+
+  private:
+    /// The values set
+    enum Flags : uint8_t
+    {
+        SOJOURN_TIME = 1,
+        QUEUE_LENGTH = 2,
+        CWND = 4,
+        ALPHA = 8
+    };
+
+    uint8_t m_flags;        //!< The values set
+    int64_t m_sojournTime;  //!< The sojourn time, in ns
+    uint32_t m_queueLength; //!< The queue length at enqueue, in packets
+    uint32_t m_cwnd;        //!< The congestion window, in bytes
+    double m_alpha;         //!< The DCTCP alpha
+};
+
+} // namespace ns3
+
+#endif /* PACKET_ANNOTATION_TAG_H */
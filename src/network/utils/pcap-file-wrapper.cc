@@ -37,6 +37,12 @@ PcapFileWrapper::GetTypeId()
                           "microseconds(default).",
                           BooleanValue(false),
                           MakeBooleanAccessor(&PcapFileWrapper::m_nanosecMode),
+                          MakeBooleanChecker())
+            .AddAttribute("CaptureHeadersOnly",
+                          "Whether only the headers of the packets are captured, with "
+                          "their original length (cf. PcapFile::SetHeadersOnly).",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PcapFileWrapper::m_headersOnly),
                           MakeBooleanChecker());
     return tid;
 }
@@ -87,6 +93,13 @@ PcapFileWrapper::Open(const std::string& filename, std::ios::openmode mode)
     m_file.Open(filename, mode);
 }
 
+void
+PcapFileWrapper::Open(std::unique_ptr<AsyncFileBuffer> buffer)
+{
+    NS_LOG_FUNCTION(this << buffer.get());
+    m_file.Open(std::move(buffer));
+}
+
 void
 PcapFileWrapper::Init(uint32_t dataLinkType, uint32_t snapLen, int32_t tzCorrection)
 {
@@ -104,6 +117,7 @@ PcapFileWrapper::Init(uint32_t dataLinkType, uint32_t snapLen, int32_t tzCorrect
     {
         m_file.Init(dataLinkType, m_snapLen, tzCorrection, false, m_nanosecMode);
     }
+    m_file.SetHeadersOnly(m_headersOnly);
 }
 
 void
@@ -67,6 +67,14 @@ class PcapFileWrapper : public Object
      */
     void Open(const std::string& filename, std::ios::openmode mode);
 
+    /**
+     * Create a new pcap file written through a buffer, such as an
+     * AsyncFileBuffer writing it from a background thread.
+     *
+     * @param buffer The buffer, opened for writing.
+     */
+    void Open(std::unique_ptr<AsyncFileBuffer> buffer);
+
     /**
      * Close the underlying pcap file.
      */
@@ -214,6 +222,7 @@ class PcapFileWrapper : public Object
     PcapFile m_file;    //!< Pcap file
     uint32_t m_snapLen; //!< max length of saved packets
     bool m_nanosecMode; //!< Timestamps in nanosecond mode
+    bool m_headersOnly; //!< Only the headers of the packets are captured
 };
 
 } // namespace ns3
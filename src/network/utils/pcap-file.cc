@@ -17,6 +17,7 @@
 #include "ns3/log.h"
 #include "ns3/packet.h"
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 
@@ -40,10 +41,149 @@ const uint32_t NS_SWAPPED_MAGIC = 0x4d3cb2a1; /**< Looks this way if byte swappi
 const uint16_t VERSION_MAJOR = 2; /**< Major version of supported pcap file format */
 const uint16_t VERSION_MINOR = 4; /**< Minor version of supported pcap file format */
 
+/**
+ * @brief Read a 16-bit value in network byte order
+ * @param data the first octet of the value
+ * @returns the value
+ */
+static uint16_t
+ReadNetworkU16(const uint8_t* data)
+{
+    return static_cast<uint16_t>((data[0] << 8) | data[1]);
+}
+
+/**
+ * @brief Get the length of the IPv4 or IPv6 and transport headers of a packet
+ * @param data the first octets of the IP packet
+ * @param length the number of octets in data
+ * @returns the length of the headers (which may exceed length if they are
+ * truncated), or 0 if the packet is not IPv4 or IPv6
+ */
+static uint32_t
+GetIpHeadersLength(const uint8_t* data, uint32_t length)
+{
+    uint32_t offset;
+    uint8_t protocol;
+    bool fragment;
+    uint8_t version = length > 0 ? data[0] >> 4 : 0;
+    if (version == 4 && length >= 20)
+    {
+        offset = (data[0] & 0x0f) * 4;
+        protocol = data[9];
+        fragment = (ReadNetworkU16(data + 6) & 0x1fff) != 0;
+    }
+    else if (version == 6 && length >= 40)
+    {
+        offset = 40;
+        protocol = data[6];
+        fragment = false;
+        // extension headers
+        while (!fragment && offset + 8 <= length)
+        {
+            uint8_t next = data[offset];
+            if (protocol == 0 || protocol == 43 || protocol == 60)
+            {
+                offset += (data[offset + 1] + 1) * 8;
+            }
+            else if (protocol == 44)
+            {
+                fragment = (ReadNetworkU16(data + offset + 2) & 0xfff8) != 0;
+                offset += 8;
+            }
+            else if (protocol == 51)
+            {
+                offset += (data[offset + 1] + 2) * 4;
+            }
+            else
+            {
+                break;
+            }
+            protocol = next;
+        }
+    }
+    else
+    {
+        return 0;
+    }
+
+    if (fragment)
+    {
+        // the transport header is in the first fragment
+        return offset;
+    }
+    switch (protocol)
+    {
+    case 6: // TCP
+        return offset + 12 < length ? offset + (data[offset + 12] >> 4) * 4 : length;
+    case 1:  // ICMP
+    case 17: // UDP
+    case 58: // ICMPv6
+        return offset + 8;
+    default:
+        return offset;
+    }
+}
+
+/**
+ * @brief Get the length of the link-layer, network and transport headers of a packet
+ * @param dataLinkType the data link type of the packet
+ * @param data the first octets of the packet
+ * @param length the number of octets in data
+ * @returns the length of the headers, at most length
+ */
+static uint32_t
+GetHeadersLength(uint32_t dataLinkType, const uint8_t* data, uint32_t length)
+{
+    uint32_t offset;
+    switch (dataLinkType)
+    {
+    case 0: // DLT_NULL
+        offset = 4;
+        break;
+    case 1: // DLT_EN10MB
+        offset = 14;
+        if (length >= 18 && ReadNetworkU16(data + 12) == 0x8100)
+        {
+            offset += 4; // 802.1Q tag
+        }
+        if (length >= offset + 8 && ReadNetworkU16(data + offset - 2) <= 1500 &&
+            data[offset] == 0xaa)
+        {
+            offset += 8; // LLC/SNAP
+        }
+        break;
+    case 9: // DLT_PPP
+        offset = 2;
+        break;
+    case 101: // DLT_RAW
+    case 228: // DLT_IPV4
+    case 229: // DLT_IPV6
+        offset = 0;
+        break;
+    case 113: // DLT_LINUX_SLL
+        offset = 16;
+        break;
+    default:
+        return length;
+    }
+    if (offset >= length)
+    {
+        return length;
+    }
+    uint32_t ipLength = GetIpHeadersLength(data + offset, length - offset);
+    if (ipLength == 0)
+    {
+        // not IP: the packet is only truncated
+        return length;
+    }
+    return std::min(offset + ipLength, length);
+}
+
 PcapFile::PcapFile()
     : m_file(),
       m_swapMode(false),
-      m_nanosecMode(false)
+      m_nanosecMode(false),
+      m_headersOnly(false)
 {
     NS_LOG_FUNCTION(this);
     FatalImpl::RegisterStream(&m_file);
@@ -81,6 +221,13 @@ void
 PcapFile::Close()
 {
     NS_LOG_FUNCTION(this);
+    if (m_buffer)
+    {
+        // restore the file buffer of the stream, then write and close the file
+        m_file.std::ios::rdbuf(m_file.rdbuf());
+        m_buffer.reset();
+        return;
+    }
     m_file.close();
 }
 
@@ -336,6 +483,22 @@ PcapFile::Open(const std::string& filename, std::ios::openmode mode)
     }
 }
 
+void
+PcapFile::Open(std::unique_ptr<AsyncFileBuffer> buffer)
+{
+    NS_LOG_FUNCTION(this << buffer.get());
+    NS_ASSERT(!m_file.fail());
+    NS_ASSERT(!m_file.is_open() && !m_buffer);
+
+    m_filename = "";
+    m_buffer = std::move(buffer);
+    m_file.std::ios::rdbuf(m_buffer.get());
+    if (!m_buffer->IsOpen())
+    {
+        m_file.setstate(std::ios::failbit);
+    }
+}
+
 void
 PcapFile::Init(uint32_t dataLinkType,
                uint32_t snapLen,
@@ -402,15 +565,22 @@ uint32_t
 PcapFile::WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << totalLen);
-    NS_ASSERT(m_file.good());
-
     uint32_t inclLen = totalLen > m_fileHeader.m_snapLen ? m_fileHeader.m_snapLen : totalLen;
+    WriteRecordHeader(tsSec, tsUsec, inclLen, totalLen);
+    return inclLen;
+}
+
+void
+PcapFile::WriteRecordHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t inclLen, uint32_t origLen)
+{
+    NS_LOG_FUNCTION(this << tsSec << tsUsec << inclLen << origLen);
+    NS_ASSERT(m_file.good());
 
     PcapRecordHeader header;
     header.m_tsSec = tsSec;
     header.m_tsUsec = tsUsec;
     header.m_inclLen = inclLen;
-    header.m_origLen = totalLen;
+    header.m_origLen = origLen;
 
     if (m_swapMode)
     {
@@ -426,13 +596,39 @@ PcapFile::WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen)
     m_file.write((const char*)&header.m_inclLen, sizeof(header.m_inclLen));
     m_file.write((const char*)&header.m_origLen, sizeof(header.m_origLen));
     NS_BUILD_DEBUG(m_file.flush());
-    return inclLen;
+}
+
+void
+PcapFile::SetHeadersOnly(bool headersOnly)
+{
+    NS_LOG_FUNCTION(this << headersOnly);
+    m_headersOnly = headersOnly;
+}
+
+void
+PcapFile::WriteHeaders(uint32_t tsSec,
+                       uint32_t tsUsec,
+                       const uint8_t* data,
+                       uint32_t length,
+                       uint32_t totalLen)
+{
+    NS_LOG_FUNCTION(this << tsSec << tsUsec << &data << length << totalLen);
+    uint32_t inclLen = GetHeadersLength(m_fileHeader.m_type, data, length);
+    inclLen = std::min(inclLen, m_fileHeader.m_snapLen);
+    WriteRecordHeader(tsSec, tsUsec, inclLen, totalLen);
+    m_file.write((const char*)data, inclLen);
+    NS_BUILD_DEBUG(m_file.flush());
 }
 
 void
 PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, const uint8_t* const data, uint32_t totalLen)
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << &data << totalLen);
+    if (m_headersOnly)
+    {
+        WriteHeaders(tsSec, tsUsec, data, std::min(totalLen, HEADERS_MAX_LENGTH), totalLen);
+        return;
+    }
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, totalLen);
     m_file.write((const char*)data, inclLen);
     NS_BUILD_DEBUG(m_file.flush());
@@ -442,6 +638,13 @@ void
 PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << tsSec << tsUsec << p);
+    if (m_headersOnly)
+    {
+        uint8_t data[HEADERS_MAX_LENGTH];
+        uint32_t length = p->CopyData(data, HEADERS_MAX_LENGTH);
+        WriteHeaders(tsSec, tsUsec, data, length, p->GetSize());
+        return;
+    }
     uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, p->GetSize());
     p->CopyData(&m_file, inclLen);
     NS_BUILD_DEBUG(m_file.flush());
@@ -453,11 +656,21 @@ PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, const Header& header, Ptr<const
     NS_LOG_FUNCTION(this << tsSec << tsUsec << &header << p);
     uint32_t headerSize = header.GetSerializedSize();
     uint32_t totalSize = headerSize + p->GetSize();
-    uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, totalSize);
 
     Buffer headerBuffer;
     headerBuffer.AddAtStart(headerSize);
     header.Serialize(headerBuffer.Begin());
+
+    if (m_headersOnly)
+    {
+        uint8_t data[HEADERS_MAX_LENGTH];
+        uint32_t length = headerBuffer.CopyData(data, std::min(headerSize, HEADERS_MAX_LENGTH));
+        length += p->CopyData(data + length, HEADERS_MAX_LENGTH - length);
+        WriteHeaders(tsSec, tsUsec, data, length, totalSize);
+        return;
+    }
+
+    uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, totalSize);
     uint32_t toCopy = std::min(headerSize, inclLen);
     headerBuffer.CopyData(&m_file, toCopy);
     inclLen -= toCopy;
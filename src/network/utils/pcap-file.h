@@ -9,9 +9,12 @@
 #ifndef PCAP_FILE_H
 #define PCAP_FILE_H
 
+#include "async-file-buffer.h"
+
 #include "ns3/ptr.h"
 
 #include <fstream>
+#include <memory>
 #include <stdint.h>
 #include <string>
 
@@ -34,6 +37,8 @@ class PcapFile
     static const int32_t ZONE_DEFAULT = 0; //!< Time zone offset for current location
     static const uint32_t SNAPLEN_DEFAULT =
         65535; //!< Default value for maximum octets to save per packet
+    static constexpr uint32_t HEADERS_MAX_LENGTH =
+        256; //!< Maximum octets to save per packet when only the headers are saved
 
   public:
     PcapFile();
@@ -70,6 +75,15 @@ class PcapFile
      */
     void Open(const std::string& filename, std::ios::openmode mode);
 
+    /**
+     * Create a new pcap file written through a buffer, such as an
+     * AsyncFileBuffer writing it from a background thread.  The file can then
+     * be initialized and written, but not read.
+     *
+     * @param buffer The buffer, opened for writing.
+     */
+    void Open(std::unique_ptr<AsyncFileBuffer> buffer);
+
     /**
      * Close the underlying file.
      */
@@ -110,6 +124,22 @@ class PcapFile
               bool swapMode = false,
               bool nanosecMode = false);
 
+    /**
+     * @brief Set whether only the headers of the packets are written to the file.
+     *
+     * When set, the link-layer, IPv4 or IPv6 (with its extension headers)
+     * and TCP, UDP or ICMP headers of the packets are written, and their
+     * payload is not, although the original length of the records is the
+     * full length of the packets: the analysis tools thus see the packets
+     * with their real size.  The payload of the packets is not copied,
+     * and at most HEADERS_MAX_LENGTH octets of a packet are saved; the
+     * packets of the unsupported data link types are only truncated at
+     * that length.  The snapLen still applies.
+     *
+     * @param headersOnly Whether only the headers are written.
+     */
+    void SetHeadersOnly(bool headersOnly);
+
     /**
      * @brief Write next packet to file
      *
@@ -356,17 +386,42 @@ class PcapFile
      * @returns the length of the packet to write in the Pcap file
      */
     uint32_t WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen);
+    /**
+     * @brief Write a Pcap record header
+     *
+     * @param tsSec Time stamp (seconds part)
+     * @param tsUsec Time stamp (microseconds part)
+     * @param inclLen length of the packet written in the Pcap file
+     * @param origLen total packet length
+     */
+    void WriteRecordHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t inclLen, uint32_t origLen);
+    /**
+     * @brief Write the headers of a packet, in headers-only mode
+     *
+     * @param tsSec Time stamp (seconds part)
+     * @param tsUsec Time stamp (microseconds part)
+     * @param data the first octets of the packet, at most HEADERS_MAX_LENGTH
+     * @param length the number of octets in data
+     * @param totalLen total packet length
+     */
+    void WriteHeaders(uint32_t tsSec,
+                      uint32_t tsUsec,
+                      const uint8_t* data,
+                      uint32_t length,
+                      uint32_t totalLen);
 
     /**
      * @brief Read and verify a Pcap file header
      */
     void ReadAndVerifyFileHeader();
 
-    std::string m_filename;      //!< file name
-    std::fstream m_file;         //!< file stream
-    PcapFileHeader m_fileHeader; //!< file header
-    bool m_swapMode;             //!< swap mode
-    bool m_nanosecMode;          //!< nanosecond timestamp mode
+    std::string m_filename;                    //!< file name
+    std::fstream m_file;                       //!< file stream
+    std::unique_ptr<AsyncFileBuffer> m_buffer; //!< buffer the file is written through, if any
+    PcapFileHeader m_fileHeader;               //!< file header
+    bool m_swapMode;                           //!< swap mode
+    bool m_nanosecMode;                        //!< nanosecond timestamp mode
+    bool m_headersOnly;                        //!< whether only the headers are written
 };
 
 } // namespace ns3
@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#include "pcapng-file.h"
+
+#include "ns3/assert.h"
+#include "ns3/build-profile.h"
+#include "ns3/fatal-impl.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PcapNgFile");
+
+const uint32_t SECTION_HEADER_BLOCK = 0x0a0d0d0a; //!< Block type of a Section Header Block
+const uint32_t INTERFACE_DESCRIPTION_BLOCK = 1;   //!< Block type of an Interface Description
+const uint32_t ENHANCED_PACKET_BLOCK = 6;         //!< Block type of an Enhanced Packet Block
+const uint32_t BYTE_ORDER_MAGIC = 0x1a2b3c4d;     //!< Identifies the byte order of a section
+const uint16_t OPT_ENDOFOPT = 0;                  //!< End of the options
+const uint16_t OPT_COMMENT = 1;                   //!< Comment option
+const uint16_t SHB_USERAPPL = 4;                  //!< Application which wrote the section
+const uint16_t IF_NAME = 2;                       //!< Name of an interface
+const uint16_t IF_DESCRIPTION = 3;                //!< Description of an interface
+const uint16_t IF_TSRESOL = 9;                    //!< Resolution of the timestamps
+const uint32_t MAX_OPTION_LENGTH = 0xfffc;        //!< Longest option value written
+
+/**
+ * @param length A length
+ * @returns The length padded to a multiple of 4 octets
+ */
+static uint32_t
+Pad(uint32_t length)
+{
+    return (length + 3) & ~3U;
+}
+
+/**
+ * @param value The value of an option.
+ * @returns The length of the option, with its padding.
+ */
+static uint32_t
+GetOptionLength(std::string_view value)
+{
+    return 4 + Pad(std::min<uint32_t>(value.size(), MAX_OPTION_LENGTH));
+}
+
+/**
+ * @param capLen The number of octets of the packet written.
+ * @param comment The comment of the packet.
+ * @returns The length of the Enhanced Packet Block.
+ */
+static uint32_t
+GetPacketBlockLength(uint32_t capLen, std::string_view comment)
+{
+    // the comment option is followed by the end of the options
+    return 32 + Pad(capLen) + (comment.empty() ? 0 : GetOptionLength(comment) + 4);
+}
+
+PcapNgFile::PcapNgFile()
+{
+    NS_LOG_FUNCTION(this);
+    FatalImpl::RegisterStream(&m_file);
+}
+
+PcapNgFile::~PcapNgFile()
+{
+    NS_LOG_FUNCTION(this);
+    FatalImpl::UnregisterStream(&m_file);
+    Close();
+}
+
+void
+PcapNgFile::Open(const std::string& filename)
+{
+    NS_LOG_FUNCTION(this << filename);
+    NS_ASSERT(!m_file.is_open() && !m_buffer);
+    m_file.open(filename, std::ios::out | std::ios::binary);
+    WriteSectionHeader();
+}
+
+void
+PcapNgFile::Open(std::unique_ptr<AsyncFileBuffer> buffer)
+{
+    NS_LOG_FUNCTION(this << buffer.get());
+    NS_ASSERT(!m_file.is_open() && !m_buffer);
+    m_buffer = std::move(buffer);
+    m_file.std::ios::rdbuf(m_buffer.get());
+    if (!m_buffer->IsOpen())
+    {
+        m_file.setstate(std::ios::failbit);
+    }
+    WriteSectionHeader();
+}
+
+void
+PcapNgFile::Close()
+{
+    NS_LOG_FUNCTION(this);
+    m_snapLens.clear();
+    if (m_buffer)
+    {
+        // restore the file buffer of the stream, then write and close the file
+        m_file.std::ios::rdbuf(m_file.rdbuf());
+        m_buffer.reset();
+        return;
+    }
+    m_file.close();
+}
+
+bool
+PcapNgFile::Fail() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_file.fail();
+}
+
+template <typename T>
+void
+PcapNgFile::WriteValue(T value)
+{
+    m_file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void
+PcapNgFile::WritePadding(uint32_t length)
+{
+    static const char zeros[4] = {0, 0, 0, 0};
+    m_file.write(zeros, Pad(length) - length);
+}
+
+void
+PcapNgFile::WriteOption(uint16_t code, std::string_view value)
+{
+    auto length = static_cast<uint16_t>(std::min<uint32_t>(value.size(), MAX_OPTION_LENGTH));
+    WriteValue(code);
+    WriteValue(length);
+    m_file.write(value.data(), length);
+    WritePadding(length);
+}
+
+void
+PcapNgFile::WriteSectionHeader()
+{
+    NS_LOG_FUNCTION(this);
+    const std::string_view application = "ns-3";
+    uint32_t blockLength = 28 + GetOptionLength(application) + 4;
+
+    // The values are written in host byte order, which the readers find
+    // from the byte order magic
+    WriteValue(SECTION_HEADER_BLOCK);
+    WriteValue(blockLength);
+    WriteValue(BYTE_ORDER_MAGIC);
+    WriteValue<uint16_t>(1); // major version
+    WriteValue<uint16_t>(0); // minor version
+    WriteValue<int64_t>(-1); // unknown section length
+    WriteOption(SHB_USERAPPL, application);
+    WriteOption(OPT_ENDOFOPT, {});
+    WriteValue(blockLength);
+    NS_BUILD_DEBUG(m_file.flush());
+}
+
+uint32_t
+PcapNgFile::AddInterface(uint32_t dataLinkType,
+                         const std::string& name,
+                         const std::string& description,
+                         uint32_t snapLen)
+{
+    NS_LOG_FUNCTION(this << dataLinkType << name << description << snapLen);
+    const char resolution = 9; // nanoseconds
+    uint32_t blockLength = 20 + GetOptionLength({&resolution, 1}) + 4;
+    if (!name.empty())
+    {
+        blockLength += GetOptionLength(name);
+    }
+    if (!description.empty())
+    {
+        blockLength += GetOptionLength(description);
+    }
+
+    WriteValue(INTERFACE_DESCRIPTION_BLOCK);
+    WriteValue(blockLength);
+    WriteValue(static_cast<uint16_t>(dataLinkType));
+    WriteValue<uint16_t>(0); // reserved
+    WriteValue(snapLen);
+    if (!name.empty())
+    {
+        WriteOption(IF_NAME, name);
+    }
+    if (!description.empty())
+    {
+        WriteOption(IF_DESCRIPTION, description);
+    }
+    WriteOption(IF_TSRESOL, {&resolution, 1});
+    WriteOption(OPT_ENDOFOPT, {});
+    WriteValue(blockLength);
+    NS_BUILD_DEBUG(m_file.flush());
+
+    m_snapLens.push_back(snapLen);
+    return m_snapLens.size() - 1;
+}
+
+uint32_t
+PcapNgFile::GetNInterfaces() const
+{
+    return m_snapLens.size();
+}
+
+uint32_t
+PcapNgFile::WritePacketHeader(uint32_t interfaceId,
+                              uint64_t timestamp,
+                              uint32_t totalLen,
+                              std::string_view comment)
+{
+    NS_ASSERT_MSG(interfaceId < m_snapLens.size(), "Unknown interface " << interfaceId);
+    uint32_t capLen = std::min(totalLen, m_snapLens[interfaceId]);
+
+    WriteValue(ENHANCED_PACKET_BLOCK);
+    WriteValue(GetPacketBlockLength(capLen, comment));
+    WriteValue(interfaceId);
+    WriteValue(static_cast<uint32_t>(timestamp >> 32));
+    WriteValue(static_cast<uint32_t>(timestamp));
+    WriteValue(capLen);
+    WriteValue(totalLen);
+    return capLen;
+}
+
+void
+PcapNgFile::WritePacketTrailer(uint32_t capLen, std::string_view comment)
+{
+    WritePadding(capLen);
+    if (!comment.empty())
+    {
+        WriteOption(OPT_COMMENT, comment);
+        WriteOption(OPT_ENDOFOPT, {});
+    }
+    WriteValue(GetPacketBlockLength(capLen, comment));
+    NS_BUILD_DEBUG(m_file.flush());
+}
+
+void
+PcapNgFile::Write(uint32_t interfaceId,
+                  uint64_t timestamp,
+                  Ptr<const Packet> p,
+                  std::string_view comment)
+{
+    NS_LOG_FUNCTION(this << interfaceId << timestamp << p << comment);
+    uint32_t capLen = WritePacketHeader(interfaceId, timestamp, p->GetSize(), comment);
+    p->CopyData(&m_file, capLen);
+    WritePacketTrailer(capLen, comment);
+}
+
+void
+PcapNgFile::Write(uint32_t interfaceId,
+                  uint64_t timestamp,
+                  const uint8_t* data,
+                  uint32_t totalLen,
+                  std::string_view comment)
+{
+    NS_LOG_FUNCTION(this << interfaceId << timestamp << &data << totalLen << comment);
+    uint32_t capLen = WritePacketHeader(interfaceId, timestamp, totalLen, comment);
+    m_file.write(reinterpret_cast<const char*>(data), capLen);
+    WritePacketTrailer(capLen, comment);
+}
+
+} // namespace ns3
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+#ifndef PCAPNG_FILE_H
+#define PCAPNG_FILE_H
+
+#include "async-file-buffer.h"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ns3
+{
+
+class Packet;
+
+/**
+ * @ingroup network
+ *
+ * @brief A pcapng file writer.
+ *
+ * The file holds a single section, with any number of interfaces, each
+ * with its own data link type, and its packets, each with an optional
+ * comment, in Enhanced Packet Blocks.  The timestamps are in nanoseconds.
+ * The blocks are written as they are created, directly in the stream: no
+ * memory is allocated per packet.
+ *
+ * See https://datatracker.ietf.org/doc/draft-ietf-opsawg-pcapng/
+ */
+class PcapNgFile : public SimpleRefCount<PcapNgFile>
+{
+  public:
+    static const uint32_t SNAPLEN_DEFAULT =
+        65535; //!< Default value for maximum octets to save per packet
+
+    PcapNgFile();
+    ~PcapNgFile();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    PcapNgFile(const PcapNgFile&) = delete;
+    PcapNgFile& operator=(const PcapNgFile&) = delete;
+
+    /**
+     * @brief Create a file, and write its Section Header Block.
+     *
+     * @param filename The name of the file.
+     */
+    void Open(const std::string& filename);
+
+    /**
+     * @brief Write the file through an AsyncFileBuffer, and write its
+     * Section Header Block.
+     *
+     * @param buffer The buffer, which is owned by this object until Close().
+     */
+    void Open(std::unique_ptr<AsyncFileBuffer> buffer);
+
+    /**
+     * Close the file.
+     */
+    void Close();
+
+    /**
+     * @return true if the 'fail' bit is set in the underlying iostream, false otherwise.
+     */
+    bool Fail() const;
+
+    /**
+     * @brief Add an interface, and write its Interface Description Block.
+     *
+     * @param dataLinkType The data link type of the packets of the interface.
+     * @param name The name of the interface, or an empty string.
+     * @param description The description of the interface, or an empty string.
+     * @param snapLen The maximum number of octets saved per packet.
+     * @returns The identifier of the interface.
+     */
+    uint32_t AddInterface(uint32_t dataLinkType,
+                          const std::string& name,
+                          const std::string& description = "",
+                          uint32_t snapLen = SNAPLEN_DEFAULT);
+
+    /**
+     * @returns The number of interfaces.
+     */
+    uint32_t GetNInterfaces() const;
+
+    /**
+     * @brief Write a packet in an Enhanced Packet Block.
+     *
+     * @param interfaceId The identifier of the interface.
+     * @param timestamp The timestamp, in nanoseconds.
+     * @param p The packet.
+     * @param comment The comment of the packet, or an empty string.
+     */
+    void Write(uint32_t interfaceId,
+               uint64_t timestamp,
+               Ptr<const Packet> p,
+               std::string_view comment = {});
+
+    /**
+     * @brief Write a packet in an Enhanced Packet Block.
+     *
+     * @param interfaceId The identifier of the interface.
+     * @param timestamp The timestamp, in nanoseconds.
+     * @param data The packet.
+     * @param totalLen The length of the packet.
+     * @param comment The comment of the packet, or an empty string.
+     */
+    void Write(uint32_t interfaceId,
+               uint64_t timestamp,
+               const uint8_t* data,
+               uint32_t totalLen,
+               std::string_view comment = {});
+
+  private:
+    /// Write the Section Header Block.
+    void WriteSectionHeader();
+
+    /**
+     * Write the header of an Enhanced Packet Block.
+     * @param interfaceId The identifier of the interface.
+     * @param timestamp The timestamp, in nanoseconds.
+     * @param totalLen The length of the packet.
+     * @param comment The comment of the packet.
+     * @returns The number of octets of the packet to write.
+     */
+    uint32_t WritePacketHeader(uint32_t interfaceId,
+                               uint64_t timestamp,
+                               uint32_t totalLen,
+                               std::string_view comment);
+
+    /**
+     * Write the end of an Enhanced Packet Block, after the packet.
+     * @param capLen The number of octets of the packet written.
+     * @param comment The comment of the packet.
+     */
+    void WritePacketTrailer(uint32_t capLen, std::string_view comment);
+
+    /**
+     * Write an option of a block.
+     * @param code The code of the option.
+     * @param value The value of the option.
+     */
+    void WriteOption(uint16_t code, std::string_view value);
+
+    /**
+     * Write a value in host byte order.
+     * @param value The value.
+     */
+    template <typename T>
+    void WriteValue(T value);
+
+    /**
+     * Write the padding of a value to a multiple of 4 octets.
+     * @param length The length of the value.
+     */
+    void WritePadding(uint32_t length);
+
+    std::ofstream m_file;                      //!< file stream
+    std::unique_ptr<AsyncFileBuffer> m_buffer; //!< buffer the file is written through, if any
+    std::vector<uint32_t> m_snapLens;          //!< snapLen of the interfaces
+};
+
+} // namespace ns3
+
+#endif /* PCAPNG_FILE_H */
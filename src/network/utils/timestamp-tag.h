@@ -8,6 +8,7 @@
 #define TIMESTAMP_TAG_H
 
 #include "ns3/nstime.h"
+#include "ns3/packet-tag-list.h"
 #include "ns3/tag-buffer.h"
 #include "ns3/tag.h"
 #include "ns3/type-id.h"
@@ -66,6 +67,15 @@ class TimestampTag : public Tag
     Time m_timestamp{0}; //!< Timestamp
 };
 
+/**
+ * @brief TimestampTag is stored in a slot of the PacketTagList hot tag store.
+ */
+template <>
+struct PacketTagSlot<TimestampTag>
+{
+    static constexpr uint8_t index = PacketTagList::SLOT_TIMESTAMP; //!< The slot
+};
+
 } // namespace ns3
 
 #endif // TIMESTAMP_TAG_H
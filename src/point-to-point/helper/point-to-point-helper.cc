@@ -15,6 +15,7 @@
 #include "ns3/point-to-point-channel.h"
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/simulator.h"
+#include "ns3/startup-timer.h"
 
 #ifdef NS3_MPI
 #include "ns3/mpi-interface.h"
@@ -294,6 +295,19 @@ PointToPointHelper::Install(Ptr<Node> a, Ptr<Node> b)
     return container;
 }
 
+NetDeviceContainer
+PointToPointHelper::Install(const NodeContainer& a, const NodeContainer& b)
+{
+    NS_ASSERT_MSG(a.GetN() == b.GetN(), "The links need as many first nodes as second nodes");
+    StartupTimer timer("PointToPointHelper::Install");
+    NetDeviceContainer container;
+    for (uint32_t i = 0; i < a.GetN(); i++)
+    {
+        container.Add(Install(a.Get(i), b.Get(i)));
+    }
+    return container;
+}
+
 NetDeviceContainer
 PointToPointHelper::Install(Ptr<Node> a, std::string bName)
 {
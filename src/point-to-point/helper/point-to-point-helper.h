@@ -142,6 +142,18 @@ class PointToPointHelper : public PcapHelperForDevice, public AsciiTraceHelperFo
      */
     NetDeviceContainer Install(std::string aNode, std::string bNode);
 
+    /**
+     * @param a the first nodes of the links
+     * @param b the second nodes of the links
+     * @return a NetDeviceContainer for nodes, which holds the two devices of
+     * each link in turn
+     *
+     * Install a link between each node of \p a and the node of \p b with the
+     * same index, as Install(Ptr<Node>, Ptr<Node>) does.  The time spent is
+     * accounted to the "PointToPointHelper::Install" phase of StartupTimer.
+     */
+    NetDeviceContainer Install(const NodeContainer& a, const NodeContainer& b);
+
   private:
     /**
      * @brief Enable pcap output the indicated net device.
@@ -9,6 +9,7 @@
 #include "point-to-point-channel.h"
 #include "ppp-header.h"
 
+#include "ns3/boolean.h"
 #include "ns3/error-model.h"
 #include "ns3/llc-snap-header.h"
 #include "ns3/log.h"
@@ -60,6 +61,14 @@ PointToPointNetDevice::GetTypeId()
                           TimeValue(Seconds(0)),
                           MakeTimeAccessor(&PointToPointNetDevice::m_tInterframeGap),
                           MakeTimeChecker())
+            .AddAttribute("AnalyticLink",
+                          "Whether the end of the transmissions is computed from the data "
+                          "rate, rather than scheduled as an event, when no packet waits in "
+                          "the queue and the PhyTxEnd trace source is not connected.  The "
+                          "timestamps of the packets are the same.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PointToPointNetDevice::m_analyticLink),
+                          MakeBooleanChecker())
 
             //
             // Transmit queueing discipline for the device which includes its own set
@@ -167,7 +176,8 @@ PointToPointNetDevice::PointToPointNetDevice()
     : m_txMachineState(READY),
       m_channel(nullptr),
       m_linkUp(false),
-      m_currentPkt(nullptr)
+      m_currentPkt(nullptr),
+      m_analyticLink(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -205,6 +215,7 @@ PointToPointNetDevice::DoDispose()
     m_receiveErrorModel = nullptr;
     m_currentPkt = nullptr;
     m_queue = nullptr;
+    m_txCompleteEvent.Cancel();
     NetDevice::DoDispose();
 }
 
@@ -240,9 +251,20 @@ PointToPointNetDevice::TransmitStart(Ptr<Packet> p)
 
     Time txTime = m_bps.CalculateBytesTxTime(p->GetSize());
     Time txCompleteTime = txTime + m_tInterframeGap;
+    m_txEnd = Simulator::Now() + txCompleteTime;
 
-    NS_LOG_LOGIC("Schedule TransmitCompleteEvent in " << txCompleteTime.As(Time::S));
-    Simulator::Schedule(txCompleteTime, &PointToPointNetDevice::TransmitComplete, this);
+    //
+    // The end of the transmission only needs an event if a packet is waiting
+    // to be sent, or if the PhyTxEnd trace source is connected.  Otherwise,
+    // the transmission is ended by UpdateTxMachineState when the next packet
+    // is sent, and Send schedules the event if the packet has to wait.
+    //
+    if (!m_analyticLink || !m_queue->IsEmpty() || !m_phyTxEndTrace.IsEmpty())
+    {
+        NS_LOG_LOGIC("Schedule TransmitCompleteEvent in " << txCompleteTime.As(Time::S));
+        m_txCompleteEvent =
+            Simulator::Schedule(txCompleteTime, &PointToPointNetDevice::TransmitComplete, this);
+    }
 
     bool result = m_channel->TransmitStart(p, this, txTime);
     if (!result)
@@ -286,6 +308,18 @@ PointToPointNetDevice::TransmitComplete()
     TransmitStart(p);
 }
 
+void
+PointToPointNetDevice::UpdateTxMachineState()
+{
+    if (m_txMachineState == BUSY && !m_txCompleteEvent.IsPending() &&
+        Simulator::Now() >= m_txEnd)
+    {
+        NS_LOG_LOGIC("Transmission ended at " << m_txEnd.As(Time::S));
+        m_txMachineState = READY;
+        m_currentPkt = nullptr;
+    }
+}
+
 bool
 PointToPointNetDevice::Attach(Ptr<PointToPointChannel> ch)
 {
@@ -528,6 +562,11 @@ PointToPointNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t pr
     //
     if (m_queue->Enqueue(packet))
     {
+        if (m_analyticLink)
+        {
+            UpdateTxMachineState();
+        }
+
         //
         // If the channel is ready for transition we send the packet right now
         //
@@ -539,6 +578,16 @@ PointToPointNetDevice::Send(Ptr<Packet> packet, const Address& dest, uint16_t pr
             bool ret = TransmitStart(packet);
             return ret;
         }
+
+        //
+        // Otherwise, the packet is sent at the end of the current transmission
+        //
+        if (!m_txCompleteEvent.IsPending())
+        {
+            m_txCompleteEvent = Simulator::Schedule(m_txEnd - Simulator::Now(),
+                                                    &PointToPointNetDevice::TransmitComplete,
+                                                    this);
+        }
         return true;
     }
 
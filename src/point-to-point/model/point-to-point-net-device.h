@@ -10,6 +10,7 @@
 #include "ns3/address.h"
 #include "ns3/callback.h"
 #include "ns3/data-rate.h"
+#include "ns3/event-id.h"
 #include "ns3/mac48-address.h"
 #include "ns3/net-device.h"
 #include "ns3/node.h"
@@ -48,6 +49,12 @@ class ErrorModel;
  * Key parameters or objects that can be specified for this device
  * include a queue, data rate, and interframe transmission gap (the
  * propagation delay is set in the PointToPointChannel).
+ *
+ * With the AnalyticLink attribute, the end of a transmission is only
+ * scheduled as an event when a packet waits in the queue, or when the
+ * PhyTxEnd trace source is connected: otherwise, it is computed from the
+ * data rate when the next packet is sent, and the packet only costs the
+ * event of its reception by the peer device.
  */
 class PointToPointNetDevice : public NetDevice
 {
@@ -250,6 +257,12 @@ class PointToPointNetDevice : public NetDevice
      */
     void TransmitComplete();
 
+    /**
+     * With the AnalyticLink attribute, end the current transmission if it
+     * is over, and its end was not scheduled as a TransmitComplete event.
+     */
+    void UpdateTxMachineState();
+
     /**
      * @brief Make the link up and running
      *
@@ -431,7 +444,10 @@ class PointToPointNetDevice : public NetDevice
      */
     uint32_t m_mtu;
 
-    Ptr<Packet> m_currentPkt; //!< Current packet processed
+    Ptr<Packet> m_currentPkt;  //!< Current packet processed
+    bool m_analyticLink;       //!< Whether the end of the transmissions is computed analytically
+    Time m_txEnd;              //!< End of the current transmission, with the interframe gap
+    EventId m_txCompleteEvent; //!< The TransmitComplete event, if scheduled
 
     /**
      * @brief PPP to Ethernet protocol number mapping
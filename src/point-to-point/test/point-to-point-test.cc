@@ -6,6 +6,8 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 
+#include "ns3/boolean.h"
+#include "ns3/data-rate.h"
 #include "ns3/drop-tail-queue.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/point-to-point-channel.h"
@@ -13,7 +15,9 @@
 #include "ns3/simulator.h"
 #include "ns3/test.h"
 
+#include <sstream>
 #include <string>
+#include <vector>
 
 using namespace ns3;
 
@@ -128,6 +132,166 @@ PointToPointTest::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * @brief Test the AnalyticLink attribute of the PointToPointNetDevice
+ *
+ * The same packets are sent, in bursts and alone, with and without the
+ * attribute: the trace sources must fire at the same times, with fewer
+ * events.
+ */
+class PointToPointAnalyticLinkTest : public TestCase
+{
+  public:
+    /**
+     * @brief Create the test
+     */
+    PointToPointAnalyticLinkTest();
+
+    /**
+     * @brief Run the test
+     */
+    void DoRun() override;
+
+  private:
+    /**
+     * @brief Run a simulation
+     *
+     * @param analyticLink The value of the AnalyticLink attribute.
+     * @param traceTxEnd Whether the PhyTxEnd trace source is connected.
+     * @param nEvents The number of events executed.
+     * @return The trace sources fired, with their times.
+     */
+    std::vector<std::string> RunSimulation(bool analyticLink, bool traceTxEnd, uint64_t& nEvents);
+
+    /**
+     * @brief Record a trace source.
+     *
+     * @param name The name of the trace source.
+     * @param p The packet.
+     */
+    void Trace(std::string name, Ptr<const Packet> p);
+
+    /**
+     * @brief Send packets.
+     *
+     * @param device The device.
+     * @param n The number of packets.
+     */
+    static void Send(Ptr<PointToPointNetDevice> device, uint32_t n);
+
+    std::vector<std::string> m_traces; //!< The trace sources fired
+};
+
+PointToPointAnalyticLinkTest::PointToPointAnalyticLinkTest()
+    : TestCase("Analytic link keeps the times of the trace sources")
+{
+}
+
+void
+PointToPointAnalyticLinkTest::Trace(std::string name, Ptr<const Packet> p)
+{
+    std::ostringstream oss;
+    oss << name << " " << p->GetSize() << " " << Simulator::Now().GetNanoSeconds();
+    m_traces.push_back(oss.str());
+}
+
+void
+PointToPointAnalyticLinkTest::Send(Ptr<PointToPointNetDevice> device, uint32_t n)
+{
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        device->Send(Create<Packet>(998), device->GetBroadcast(), 0x800);
+    }
+}
+
+std::vector<std::string>
+PointToPointAnalyticLinkTest::RunSimulation(bool analyticLink, bool traceTxEnd, uint64_t& nEvents)
+{
+    m_traces.clear();
+    Ptr<Node> a = CreateObject<Node>();
+    Ptr<Node> b = CreateObject<Node>();
+    Ptr<PointToPointNetDevice> devA = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointNetDevice> devB = CreateObject<PointToPointNetDevice>();
+    Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel>();
+    channel->SetAttribute("Delay", TimeValue(MilliSeconds(2)));
+
+    for (auto [node, dev] : {std::pair{a, devA}, std::pair{b, devB}})
+    {
+        dev->SetAttribute("AnalyticLink", BooleanValue(analyticLink));
+        dev->SetDataRate(DataRate("8Mbps"));
+        dev->SetInterframeGap(MicroSeconds(1));
+        dev->Attach(channel);
+        dev->SetAddress(Mac48Address::Allocate());
+        dev->SetQueue(CreateObject<DropTailQueue<Packet>>());
+        node->AddDevice(dev);
+        dev->SetReceiveCallback(NetDevice::ReceiveCallback(
+            [](Ptr<NetDevice>, Ptr<const Packet>, uint16_t, const Address&) { return true; }));
+    }
+    devA->TraceConnectWithoutContext("MacTx",
+                                     MakeCallback(&PointToPointAnalyticLinkTest::Trace, this)
+                                         .Bind(std::string("MacTx")));
+    devA->GetQueue()->TraceConnectWithoutContext(
+        "Dequeue",
+        MakeCallback(&PointToPointAnalyticLinkTest::Trace, this).Bind(std::string("Dequeue")));
+    devB->TraceConnectWithoutContext("PhyRxEnd",
+                                     MakeCallback(&PointToPointAnalyticLinkTest::Trace, this)
+                                         .Bind(std::string("PhyRxEnd")));
+    if (traceTxEnd)
+    {
+        devA->TraceConnectWithoutContext("PhyTxEnd",
+                                         MakeCallback(&PointToPointAnalyticLinkTest::Trace, this)
+                                             .Bind(std::string("PhyTxEnd")));
+    }
+
+    // A packet (1000 bytes with the PPP header) takes 1 ms, with the
+    // interframe gap, to transmit: a burst, packets sent alone, a packet
+    // sent at the end of the previous transmission, and one sent during it
+    Simulator::Schedule(Seconds(1), &PointToPointAnalyticLinkTest::Send, devA, 5);
+    Simulator::Schedule(Seconds(2), &PointToPointAnalyticLinkTest::Send, devA, 1);
+    Simulator::Schedule(Seconds(3), &PointToPointAnalyticLinkTest::Send, devA, 1);
+    Simulator::Schedule(Seconds(3) + MicroSeconds(1001),
+                        &PointToPointAnalyticLinkTest::Send,
+                        devA,
+                        1);
+    Simulator::Schedule(Seconds(3) + MicroSeconds(1500),
+                        &PointToPointAnalyticLinkTest::Send,
+                        devA,
+                        2);
+    Simulator::Run();
+    nEvents = Simulator::GetEventCount();
+    Simulator::Destroy();
+    return m_traces;
+}
+
+void
+PointToPointAnalyticLinkTest::DoRun()
+{
+    uint64_t nEvents = 0;
+    uint64_t nAnalyticEvents = 0;
+    std::vector<std::string> traces = RunSimulation(false, false, nEvents);
+    std::vector<std::string> analyticTraces = RunSimulation(true, false, nAnalyticEvents);
+
+    NS_TEST_ASSERT_MSG_EQ(traces.size(), 3 * 10, "Unexpected number of traces");
+    NS_TEST_ASSERT_MSG_EQ(analyticTraces.size(), traces.size(), "Unexpected number of traces");
+    for (std::size_t i = 0; i < traces.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(analyticTraces[i], traces[i], "Different trace " << i);
+    }
+    // the packets sent alone, or last of their burst, need no TransmitComplete event
+    NS_TEST_EXPECT_MSG_EQ(nEvents - nAnalyticEvents, 4, "Unexpected number of events");
+
+    // with the PhyTxEnd trace source, the end of each transmission is an event
+    traces = RunSimulation(false, true, nEvents);
+    analyticTraces = RunSimulation(true, true, nAnalyticEvents);
+    NS_TEST_ASSERT_MSG_EQ(traces.size(), 4 * 10, "Unexpected number of traces");
+    NS_TEST_ASSERT_MSG_EQ(analyticTraces.size(), traces.size(), "Unexpected number of traces");
+    for (std::size_t i = 0; i < traces.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(analyticTraces[i], traces[i], "Different trace " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(nAnalyticEvents, nEvents, "Unexpected number of events");
+}
+
 /**
  * @brief TestSuite for PointToPoint module
  */
@@ -144,6 +308,7 @@ PointToPointTestSuite::PointToPointTestSuite()
     : TestSuite("devices-point-to-point", Type::UNIT)
 {
     AddTestCase(new PointToPointTest, TestCase::Duration::QUICK);
+    AddTestCase(new PointToPointAnalyticLinkTest, TestCase::Duration::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
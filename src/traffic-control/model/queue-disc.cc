@@ -8,9 +8,11 @@
 #include "queue-disc.h"
 
 #include "ns3/abort.h"
+#include "ns3/boolean.h"
 #include "ns3/log.h"
 #include "ns3/net-device-queue-interface.h"
 #include "ns3/object-vector.h"
+#include "ns3/packet-annotation-tag.h"
 #include "ns3/packet.h"
 #include "ns3/pointer.h"
 #include "ns3/queue.h"
@@ -261,6 +263,12 @@ QueueDisc::GetTypeId()
                           ObjectVectorValue(),
                           MakeObjectVectorAccessor(&QueueDisc::m_classes),
                           MakeObjectVectorChecker<QueueDiscClass>())
+            .AddAttribute("AnnotatePackets",
+                          "Whether the queue length at enqueue and the sojourn time of the "
+                          "packets are recorded in their PacketAnnotationTag.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&QueueDisc::m_annotatePackets),
+                          MakeBooleanChecker())
             .AddTraceSource("Enqueue",
                             "Enqueue a packet in the queue disc",
                             MakeTraceSourceAccessor(&QueueDisc::m_traceEnqueue),
@@ -310,6 +318,7 @@ QueueDisc::QueueDisc(QueueDiscSizePolicy policy)
       m_maxSize(QueueSize("1p")), // to avoid that setting the mode at construction time is ignored
       m_running(false),
       m_peeked(false),
+      m_annotatePackets(false),
       m_sizePolicy(policy),
       m_prohibitChangeMode(false)
 {
@@ -674,6 +683,14 @@ QueueDisc::GetWakeMode() const
 void
 QueueDisc::PacketEnqueued(Ptr<const QueueDiscItem> item)
 {
+    if (m_annotatePackets)
+    {
+        PacketAnnotationTag tag;
+        item->GetPacket()->PeekPacketTag(tag);
+        tag.SetQueueLength(m_nPackets);
+        item->GetPacket()->ReplacePacketTag(tag);
+    }
+
     m_nPackets++;
     m_nBytes += item->GetSize();
     m_stats.nTotalEnqueuedPackets++;
@@ -700,6 +717,14 @@ QueueDisc::PacketDequeued(Ptr<const QueueDiscItem> item)
 
         m_sojourn(Simulator::Now() - item->GetTimeStamp());
 
+        if (m_annotatePackets)
+        {
+            PacketAnnotationTag tag;
+            item->GetPacket()->PeekPacketTag(tag);
+            tag.SetSojournTime(Simulator::Now() - item->GetTimeStamp());
+            item->GetPacket()->ReplacePacketTag(tag);
+        }
+
         NS_LOG_LOGIC("m_traceDequeue (p)");
         m_traceDequeue(item);
     }
@@ -166,6 +166,11 @@ enum QueueDiscSizePolicy
  * the additional time the packet is retained within the traffic control
  * infrastructure in case it is requeued.
  *
+ * When the AnnotatePackets attribute is true, the number of packets in the
+ * queue disc when a packet is enqueued, and its sojourn time when it is
+ * dequeued, are recorded in the PacketAnnotationTag of the packet, which the
+ * pcapng traces (see PcapNgHelper) write with the packet.
+ *
  * The design and implementation of this class is heavily inspired by Linux.
  * For more details, see the traffic-control model page.
  */
@@ -692,6 +697,7 @@ class QueueDisc : public Object
     bool m_running;                //!< The queue disc is performing multiple dequeue operations
     Ptr<QueueDiscItem> m_requeued; //!< The last packet that failed to be transmitted
     bool m_peeked;                 //!< A packet was dequeued because Peek was called
+    bool m_annotatePackets;        //!< Record the queue state in the PacketAnnotationTag
     std::string m_childQueueDiscDropMsg; //!< Reason why a packet was dropped by a child queue disc
     std::string m_childQueueDiscMarkMsg; //!< Reason why a packet was marked by a child queue disc
     QueueDiscSizePolicy m_sizePolicy;    //!< The queue disc size policy
@@ -251,6 +251,15 @@ class TrafficControlLayer : public Object
     TracedCallback<Ptr<const Packet>> m_dropped;
 };
 
+/**
+ * @brief TrafficControlLayer is stored in a slot of the aggregation cache of Object::GetObject().
+ */
+template <>
+struct ObjectCacheSlot<TrafficControlLayer>
+{
+    static constexpr uint8_t index = Object::CACHE_SLOT_TRAFFIC_CONTROL; //!< The slot
+};
+
 } // namespace ns3
 
 #endif // TRAFFICCONTROLLAYER_H
@@ -7,10 +7,12 @@
  *
  */
 
+#include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/fifo-queue-disc.h"
 #include "ns3/log.h"
 #include "ns3/object-factory.h"
+#include "ns3/packet-annotation-tag.h"
 #include "ns3/packet.h"
 #include "ns3/queue.h"
 #include "ns3/simulator.h"
@@ -92,6 +94,10 @@ class FifoQueueDiscTestCase : public TestCase
      * @param pktSize the packet size
      */
     void DoRunFifoTest(Ptr<FifoQueueDisc> q, uint32_t qSize, uint32_t pktSize);
+    /**
+     * Check the annotations of the packets, when the AnnotatePackets attribute is set
+     */
+    void RunAnnotationTest();
 };
 
 FifoQueueDiscTestCase::FifoQueueDiscTestCase()
@@ -246,11 +252,44 @@ FifoQueueDiscTestCase::RunFifoTest(QueueSizeUnit mode)
     DoRunFifoTest(queue, numPackets * modeSize, pktSize);
 }
 
+void
+FifoQueueDiscTestCase::RunAnnotationTest()
+{
+    Ptr<FifoQueueDisc> queue = CreateObject<FifoQueueDisc>();
+    queue->SetAttribute("AnnotatePackets", BooleanValue(true));
+    queue->Initialize();
+    Address dest;
+
+    // the packets are enqueued at 0, 1 and 2 ms, and dequeued at 5 ms
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        Simulator::Schedule(MilliSeconds(i), [queue, dest]() {
+            queue->Enqueue(Create<FifoQueueDiscTestItem>(Create<Packet>(100), dest));
+        });
+    }
+    Simulator::Schedule(MilliSeconds(5), [this, queue]() {
+        for (uint32_t i = 0; i < 3; i++)
+        {
+            Ptr<QueueDiscItem> item = queue->Dequeue();
+            NS_TEST_ASSERT_MSG_NE(item, nullptr, "A packet should have been dequeued");
+            PacketAnnotationTag tag;
+            NS_TEST_ASSERT_MSG_EQ(item->GetPacket()->PeekPacketTag(tag),
+                                  true,
+                                  "The packet is not annotated");
+            NS_TEST_EXPECT_MSG_EQ(tag.GetQueueLength(), i, "Wrong queue length at enqueue");
+            NS_TEST_EXPECT_MSG_EQ(tag.GetSojournTime(), MilliSeconds(5 - i), "Wrong sojourn time");
+            NS_TEST_EXPECT_MSG_EQ(tag.HasCongestionWindow(), false, "Unexpected annotation");
+        }
+    });
+    Simulator::Run();
+}
+
 void
 FifoQueueDiscTestCase::DoRun()
 {
     RunFifoTest(QueueSizeUnit::PACKETS);
     RunFifoTest(QueueSizeUnit::BYTES);
+    RunAnnotationTest();
     Simulator::Destroy();
 }
 
@@ -349,20 +349,61 @@ runBenchOneIteration(void (*bench)(uint32_t), uint32_t n)
     return deltaMs;
 }
 
+/// Allocation counters of the packet memory pools
+struct PoolCounters
+{
+    uint64_t packets;    //!< Packet objects allocated
+    uint64_t buffers;    //!< Buffer data allocated
+    uint64_t packetTags; //!< Packet tags allocated
+    uint64_t byteTags;   //!< Byte tag lists allocated
+    uint64_t poolHits;   //!< Allocations served from the pools
+};
+
+/**
+ * Get the allocation counters of the pools of the calling thread.
+ * @returns the counters
+ */
+static PoolCounters
+GetPoolCounters()
+{
+    Packet::PoolStats packets = Packet::GetPoolStats();
+    Buffer::PoolStats buffers = Buffer::GetPoolStats();
+    PacketTagList::PoolStats packetTags = PacketTagList::GetPoolStats();
+    ByteTagList::PoolStats byteTags = ByteTagList::GetPoolStats();
+    return {packets.allocations,
+            buffers.allocations,
+            packetTags.allocations,
+            byteTags.allocations,
+            packets.poolHits + buffers.poolHits + packetTags.poolHits + byteTags.poolHits};
+}
+
 static void
 runBench(void (*bench)(uint32_t), uint32_t n, uint32_t minIterations, const char* name)
 {
     uint64_t minDelay = std::numeric_limits<uint64_t>::max();
+    PoolCounters start = GetPoolCounters();
     for (uint32_t i = 0; i < minIterations; i++)
     {
         uint64_t delay = runBenchOneIteration(bench, n);
         minDelay = std::min(minDelay, delay);
     }
+    PoolCounters end = GetPoolCounters();
     double ps = n;
     ps *= 1000;
     ps /= minDelay;
     std::cout << ps << " packets/s"
               << " (" << minDelay << " ms elapsed)\t" << name << std::endl;
+
+    // Allocations per packet lifecycle, that is, per iteration of the benchmark
+    double lifecycles = static_cast<double>(n) * minIterations;
+    uint64_t allocations = (end.packets - start.packets) + (end.buffers - start.buffers) +
+                           (end.packetTags - start.packetTags) + (end.byteTags - start.byteTags);
+    uint64_t heap = allocations - (end.poolHits - start.poolHits);
+    std::cout << "\tallocations/packet: " << (end.packets - start.packets) / lifecycles
+              << " packets, " << (end.buffers - start.buffers) / lifecycles << " buffers, "
+              << (end.packetTags - start.packetTags) / lifecycles << " packet tags, "
+              << (end.byteTags - start.byteTags) / lifecycles << " byte tags; "
+              << heap / lifecycles << " from the heap" << std::endl;
 }
 
 int
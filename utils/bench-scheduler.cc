@@ -8,6 +8,7 @@
 
 #include "ns3/core-module.h"
 
+#include <algorithm>
 #include <cmath> // sqrt
 #include <fstream>
 #include <iomanip>
@@ -89,6 +90,24 @@ class Bench
         m_total = total;
     }
 
+    /**
+     * Emulate TCP protocol timers.
+     *
+     * Each executed event re-arms one of \p timers timers, by cancelling
+     * its pending expiration and scheduling a new one, as TCP does with
+     * its retransmission timer on every ACK.  The cancelled expirations
+     * stay in the scheduler until they are reached.
+     *
+     * @param [in] timers The number of timers; zero disables timer emulation.
+     * @param [in] stream The random variable stream to be used to generate
+     *              the timer delays.
+     */
+    void SetTimers(const uint64_t timers, Ptr<RandomVariableStream> stream)
+    {
+        m_timers.resize(timers);
+        m_timerRand = stream;
+    }
+
     /** The output. */
     struct Result
     {
@@ -112,10 +131,15 @@ class Bench
      */
     void Cb();
 
-    Ptr<RandomVariableStream> m_rand; /**< Stream for event delays. */
-    uint64_t m_population;            /**< Event population size. */
-    uint64_t m_total;                 /**< Total number of events to execute. */
-    uint64_t m_count;                 /**< Count of events executed so far. */
+    /** Timer expiration event function.  This does nothing. */
+    void Timeout();
+
+    Ptr<RandomVariableStream> m_rand;      /**< Stream for event delays. */
+    uint64_t m_population;                 /**< Event population size. */
+    uint64_t m_total;                      /**< Total number of events to execute. */
+    uint64_t m_count;                      /**< Count of events executed so far. */
+    std::vector<EventId> m_timers;         /**< Emulated protocol timers. */
+    Ptr<RandomVariableStream> m_timerRand; /**< Stream for timer delays. */
 };
 
 Bench::Result
@@ -134,15 +158,32 @@ Bench::Run()
         Time at = NanoSeconds(m_rand->GetValue());
         Simulator::Schedule(at, &Bench::Cb, this);
     }
+    for (auto& t : m_timers)
+    {
+        t = Simulator::Schedule(NanoSeconds(m_timerRand->GetValue()), &Bench::Timeout, this);
+    }
     init = timer.End() / 1000.0;
     DEB("initialization took " << init << "s");
 
     DEB("running");
+    auto pool = EventImpl::GetPoolStats();
     timer.Start();
     Simulator::Run();
     simu = timer.End() / 1000.0;
     DEB("run took " << simu << "s");
 
+    auto impl = DynamicCast<DefaultSimulatorImpl>(Simulator::GetImplementation());
+    if (impl)
+    {
+        auto stats = impl->GetEventStats();
+        DEB("events scheduled: " << stats.scheduled << ", cancelled: " << stats.cancelled
+                                 << ", purged: " << stats.compacted << " in "
+                                 << stats.compactions << " compactions");
+    }
+    auto poolEnd = EventImpl::GetPoolStats();
+    DEB("event allocations: " << poolEnd.allocations - pool.allocations
+                              << ", from pool: " << poolEnd.poolHits - pool.poolHits);
+
     Simulator::Destroy();
 
     return Result{init, simu, m_population, m_count};
@@ -160,9 +201,21 @@ Bench::Cb()
 
     Time after = NanoSeconds(m_rand->GetValue());
     Simulator::Schedule(after, &Bench::Cb, this);
+
+    if (!m_timers.empty())
+    {
+        EventId& t = m_timers[m_count % m_timers.size()];
+        t.Cancel();
+        t = Simulator::Schedule(NanoSeconds(m_timerRand->GetValue()), &Bench::Timeout, this);
+    }
     ++m_count;
 }
 
+void
+Bench::Timeout()
+{
+}
+
 /** Benchmark which performs an ensemble of runs. */
 class BenchSuite
 {
@@ -181,13 +234,17 @@ class BenchSuite
      * @param [in] runs The number of replications.
      * @param [in] eventStream The random stream of event delays.
      * @param [in] calRev For the CalendarScheduler, whether the Reverse attribute was set.
+     * @param [in] timers The number of emulated protocol timers.
+     * @param [in] timerStream The random stream of timer delays.
      */
     BenchSuite(ObjectFactory& factory,
                uint64_t pop,
                uint64_t total,
                uint64_t runs,
                Ptr<RandomVariableStream> eventStream,
-               bool calRev);
+               bool calRev,
+               uint64_t timers,
+               Ptr<RandomVariableStream> timerStream);
 
     /** Write the results to \c LOG() */
     void Log() const;
@@ -257,7 +314,9 @@ BenchSuite::BenchSuite(ObjectFactory& factory,
                        uint64_t total,
                        uint64_t runs,
                        Ptr<RandomVariableStream> eventStream,
-                       bool calRev)
+                       bool calRev,
+                       uint64_t timers,
+                       Ptr<RandomVariableStream> timerStream)
 {
     Simulator::SetScheduler(factory);
 
@@ -275,6 +334,7 @@ BenchSuite::BenchSuite(ObjectFactory& factory,
     bench.SetRandomStream(eventStream);
     bench.SetPopulation(pop);
     bench.SetTotal(total);
+    bench.SetTimers(timers, timerStream);
 
     m_results.reserve(runs);
     Header();
@@ -443,6 +503,7 @@ main(int argc, char* argv[])
     bool allSched = false;
     bool schedCal = false;
     bool schedHeap = false;
+    bool schedLadder = false;
     bool schedList = false;
     bool schedMap = false; // default scheduler
     bool schedPQ = false;
@@ -452,6 +513,9 @@ main(int argc, char* argv[])
     uint64_t runs = 1;
     std::string filename = "";
     bool calRev = false;
+    bool tcp = false;
+    uint64_t timers = 0;
+    double rto = 200000;
 
     CommandLine cmd(__FILE__);
     cmd.Usage("Benchmark the simulator scheduler.\n"
@@ -463,11 +527,16 @@ main(int argc, char* argv[])
               "In the case of either --file form, the input is expected\n"
               "to be ascii, giving the relative event times in ns.\n"
               "\n"
+              "With --tcp, every event also re-arms one of --timers\n"
+              "protocol timers (cancel and reschedule), with delays\n"
+              "uniform in [rto, 2*rto] ns, like a TCP retransmission timer.\n"
+              "\n"
               "If no scheduler is specified the MapScheduler will be run.");
     cmd.AddValue("all", "use all schedulers", allSched);
     cmd.AddValue("cal", "use CalendarScheduler", schedCal);
     cmd.AddValue("calrev", "reverse ordering in the CalendarScheduler", calRev);
     cmd.AddValue("heap", "use HeapScheduler", schedHeap);
+    cmd.AddValue("ladder", "use LadderScheduler", schedLadder);
     cmd.AddValue("list", "use ListScheduler", schedList);
     cmd.AddValue("map", "use MapScheduler (default)", schedMap);
     cmd.AddValue("pri", "use PriorityQueue", schedPQ);
@@ -476,6 +545,9 @@ main(int argc, char* argv[])
     cmd.AddValue("total", "total number of events to run", total);
     cmd.AddValue("runs", "number of runs", runs);
     cmd.AddValue("file", "file of relative event times", filename);
+    cmd.AddValue("tcp", "emulate TCP-like timers with frequent cancels", tcp);
+    cmd.AddValue("timers", "number of emulated timers (default pop/10)", timers);
+    cmd.AddValue("rto", "minimum emulated timer delay, in ns", rto);
     cmd.AddValue("prec", "printed output precision", g_fwidth);
     cmd.Parse(argc, argv);
 
@@ -491,32 +563,55 @@ main(int argc, char* argv[])
 
     if (allSched)
     {
-        schedCal = schedHeap = schedList = schedMap = schedPQ = true;
+        schedCal = schedHeap = schedLadder = schedList = schedMap = schedPQ = true;
     }
     // Set the default case if nothing else is set
-    if (!(schedCal || schedHeap || schedList || schedMap || schedPQ))
+    if (!(schedCal || schedHeap || schedLadder || schedList || schedMap || schedPQ))
     {
         schedMap = true;
     }
 
     auto eventStream = GetRandomStream(filename);
 
+    Ptr<UniformRandomVariable> timerStream = nullptr;
+    if (tcp)
+    {
+        if (timers == 0)
+        {
+            timers = std::max<uint64_t>(pop / 10, 1);
+        }
+        timerStream = CreateObject<UniformRandomVariable>();
+        timerStream->SetAttribute("Min", DoubleValue(rto));
+        timerStream->SetAttribute("Max", DoubleValue(2 * rto));
+        LOG("  Emulated TCP timers:          " << timers << ", delay " << rto << "-" << 2 * rto
+                                                << " ns");
+    }
+    else
+    {
+        timers = 0;
+    }
+
     ObjectFactory factory("ns3::MapScheduler");
     if (schedCal)
     {
         factory.SetTypeId("ns3::CalendarScheduler");
         factory.Set("Reverse", BooleanValue(calRev));
-        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        BenchSuite(factory, pop, total, runs, eventStream, calRev, timers, timerStream).Log();
         if (allSched)
         {
             factory.Set("Reverse", BooleanValue(!calRev));
-            BenchSuite(factory, pop, total, runs, eventStream, !calRev).Log();
+            BenchSuite(factory, pop, total, runs, eventStream, !calRev, timers, timerStream).Log();
         }
     }
     if (schedHeap)
     {
         factory.SetTypeId("ns3::HeapScheduler");
-        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        BenchSuite(factory, pop, total, runs, eventStream, calRev, timers, timerStream).Log();
+    }
+    if (schedLadder)
+    {
+        factory.SetTypeId("ns3::LadderScheduler");
+        BenchSuite(factory, pop, total, runs, eventStream, calRev, timers, timerStream).Log();
     }
     if (schedList)
     {
@@ -527,17 +622,18 @@ main(int argc, char* argv[])
             LOG("Running List scheduler with 1/10 total events");
             listTotal /= 10;
         }
-        BenchSuite(factory, pop, listTotal, runs, eventStream, calRev).Log();
+        BenchSuite(factory, pop, listTotal, runs, eventStream, calRev, timers, timerStream)
+            .Log();
     }
     if (schedMap)
     {
         factory.SetTypeId("ns3::MapScheduler");
-        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        BenchSuite(factory, pop, total, runs, eventStream, calRev, timers, timerStream).Log();
     }
     if (schedPQ)
     {
         factory.SetTypeId("ns3::PriorityQueueScheduler");
-        BenchSuite(factory, pop, total, runs, eventStream, calRev).Log();
+        BenchSuite(factory, pop, total, runs, eventStream, calRev, timers, timerStream).Log();
     }
 
     return 0;
@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2026
+ *
+ * SPDX-License-Identifier: GPL-2.0-only
+ */
+
+// This program benchmarks the cost of the trace sources: the invocation of
+// a TracedCallback and the assignment of TracedValues, without and with
+// connected Callbacks, compared to plain variables.
+// Sample usage:  ./ns3 run 'bench-traced --n=10000000'
+
+#include "ns3/command-line.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/traced-callback.h"
+#include "ns3/traced-value.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib> // for exit ()
+#include <iostream>
+#include <limits>
+
+using namespace ns3;
+
+/**
+ * Congestion control state updated on every ACK, with the variables
+ * traced by TcpSocketState.
+ *
+ * @tparam U \explicit The type of the integer variables.
+ * @tparam T \explicit The type of the time variables.
+ */
+template <typename U, typename T>
+struct CongestionState
+{
+    U cWnd;          //!< Congestion window
+    U cWndInfl;      //!< Inflated congestion window
+    U ssThresh;      //!< Slow start threshold
+    U bytesInFlight; //!< Bytes in flight
+    U highTxMark;    //!< Highest sequence number sent
+    U nextTxSeq;     //!< Next sequence number to send
+    T lastRtt;       //!< Last RTT sample
+    T minRtt;        //!< Minimum RTT
+};
+
+/// Untraced state
+static CongestionState<uint32_t, Time> g_plain;
+/// Traced state
+static CongestionState<TracedValue<uint32_t>, TracedValue<Time>> g_traced;
+/// Trace source of the packets
+static TracedCallback<uint32_t, uint32_t> g_trace;
+/// Number of calls of the sinks
+static uint64_t g_calls = 0;
+
+/**
+ * Sink of an integer variable.
+ * @param oldValue The previous value.
+ * @param newValue The new value.
+ */
+static void
+ValueSink(uint32_t /* oldValue */, uint32_t /* newValue */)
+{
+    g_calls++;
+}
+
+/**
+ * Sink of a time variable.
+ * @param oldValue The previous value.
+ * @param newValue The new value.
+ */
+static void
+TimeSink(Time /* oldValue */, Time /* newValue */)
+{
+    g_calls++;
+}
+
+/**
+ * Sink of the trace source.
+ * @param size The packet size.
+ * @param seq The sequence number.
+ */
+static void
+PacketSink(uint32_t /* size */, uint32_t /* seq */)
+{
+    g_calls++;
+}
+
+/**
+ * Update the congestion state as an ACK would.
+ * @tparam S \deduced The type of the state.
+ * @param s The state.
+ * @param i The iteration.
+ */
+template <typename S>
+static void
+UpdateState(S& s, uint32_t i)
+{
+    s.bytesInFlight = s.bytesInFlight - 1448;
+    s.cWnd = s.cWnd + 1448;
+    s.cWndInfl = s.cWnd;
+    if (i % 64 == 0)
+    {
+        s.ssThresh = s.cWnd / 2;
+    }
+    s.highTxMark = s.highTxMark + 1448;
+    s.nextTxSeq = s.highTxMark;
+    s.lastRtt = NanoSeconds(10000 + i % 100);
+    s.minRtt = std::min<Time>(s.minRtt, s.lastRtt);
+    s.bytesInFlight = s.bytesInFlight + 2896;
+}
+
+/**
+ * Update the untraced state.
+ * @param i The iteration.
+ */
+static void
+benchPlain(uint32_t i)
+{
+    UpdateState(g_plain, i);
+}
+
+/**
+ * Update the traced state.
+ * @param i The iteration.
+ */
+static void
+benchTraced(uint32_t i)
+{
+    UpdateState(g_traced, i);
+}
+
+/**
+ * Invoke the trace source.
+ * @param i The iteration.
+ */
+static void
+benchTrace(uint32_t i)
+{
+    g_trace(1448, i);
+}
+
+/**
+ * Connect a sink to each traced value of the state.
+ */
+static void
+ConnectState()
+{
+    g_traced.cWnd.ConnectWithoutContext(MakeCallback(&ValueSink));
+    g_traced.cWndInfl.ConnectWithoutContext(MakeCallback(&ValueSink));
+    g_traced.ssThresh.ConnectWithoutContext(MakeCallback(&ValueSink));
+    g_traced.bytesInFlight.ConnectWithoutContext(MakeCallback(&ValueSink));
+    g_traced.highTxMark.ConnectWithoutContext(MakeCallback(&ValueSink));
+    g_traced.nextTxSeq.ConnectWithoutContext(MakeCallback(&ValueSink));
+    g_traced.lastRtt.ConnectWithoutContext(MakeCallback(&TimeSink));
+    g_traced.minRtt.ConnectWithoutContext(MakeCallback(&TimeSink));
+}
+
+/// The benchmark function, read on each iteration so that it is not inlined
+static void (*volatile g_bench)(uint32_t) = nullptr;
+
+/**
+ * Run a benchmark.
+ * @param bench The function to benchmark.
+ * @param n The number of iterations.
+ * @param minIterations The number of runs, of which the fastest is reported.
+ * @param name The benchmark name.
+ */
+static void
+runBench(void (*bench)(uint32_t), uint32_t n, uint32_t minIterations, const char* name)
+{
+    g_bench = bench;
+    int64_t minDelay = std::numeric_limits<int64_t>::max();
+    uint64_t calls = g_calls;
+    for (uint32_t j = 0; j < minIterations; j++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < n; i++)
+        {
+            g_bench(i);
+        }
+        auto end = std::chrono::steady_clock::now();
+        int64_t delay = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+        minDelay = std::min(minDelay, delay);
+    }
+    double callsPerOp = static_cast<double>(g_calls - calls) / n / minIterations;
+    std::cout << static_cast<double>(minDelay) / n << " ns/op"
+              << " (" << callsPerOp << " sink calls/op)\t" << name << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t n = 0;
+    uint32_t minIterations = 1;
+
+    CommandLine cmd(__FILE__);
+    cmd.Usage("Benchmark the trace sources");
+    cmd.AddValue("n", "number of iterations", n);
+    cmd.AddValue("min-iterations",
+                 "number of subiterations to minimize iteration time over",
+                 minIterations);
+    cmd.Parse(argc, argv);
+
+    if (n == 0)
+    {
+        std::cerr << "Error-- number of iterations must be specified "
+                  << "by command-line argument --n=(number of iterations)" << std::endl;
+        exit(1);
+    }
+    std::cout << "Running bench-traced with n=" << n << std::endl;
+#ifdef NS3_TRACING_DISABLE
+    std::cout << "The trace sources are compiled out (NS3_TRACING=OFF)." << std::endl;
+#endif
+    std::cout << "An ACK updates 8 variables of the congestion state." << std::endl;
+
+    // Until the simulation starts, every Time is recorded in case the
+    // resolution changes: start an empty simulation to stop that.
+    Simulator::Run();
+
+    runBench(&benchPlain, n, minIterations, "ACK, plain variables");
+    runBench(&benchTraced, n, minIterations, "ACK, traced values without sink");
+    ConnectState();
+    runBench(&benchTraced, n, minIterations, "ACK, traced values with one sink each");
+
+    runBench(&benchTrace, n, minIterations, "Trace source without sink");
+    g_trace.ConnectWithoutContext(MakeCallback(&PacketSink));
+    runBench(&benchTrace, n, minIterations, "Trace source with one sink");
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        g_trace.ConnectWithoutContext(MakeCallback(&PacketSink));
+    }
+    runBench(&benchTrace, n, minIterations, "Trace source with four sinks");
+
+    Simulator::Destroy();
+    return 0;
+}